@@ -2,20 +2,52 @@
 #define CONFIG_H
 
 // SECURITY: Resource limits to prevent DoS
-#define MAX_PROCESSES_PER_UPDATE 2000
+#define MAX_PROCESSES_PER_UPDATE 2000          // Rows per collection per core (see get_max_processes_per_update)
+#define MAX_PROCESSES_HARD_LIMIT 131072         // Never more rows than this, even when overridden
 #define MAX_COMMAND_OUTPUT_SIZE (1024 * 1024)  // 1MB limit
 #define MAX_UPDATE_TIME_MS 5000  // 5 second timeout
 
-// OPTIMIZATION: Memory pool configuration
-#define PROCESS_POOL_SIZE 512
+// OPTIMIZATION: Slab caches behind the memory pools (see utils/slab.h)
+#define PROCESS_POOL_SIZE 512       // ProcessSample objects per slab
+#define SLAB_MAGAZINE_SIZE 32       // Objects a thread exchanges with the shared depot at once
+
+// OPTIMIZATION: Interned process names (see utils/string_intern.h)
+#define STRING_INTERN_GRACE_CYCLES 4    // Unreferenced names survive this many cycles for reuse
+
+// OPTIMIZATION: Per-process rate state (see utils/rate_store.h)
+#define RATE_STORE_STALE_CYCLES 3       // Entries not updated for this many cycles are swept
+#define RATE_STORE_SWEEP_CYCLES 4       // Cycles per full sweep of the store
+#define RATE_STORE_SWEEP_SLOTS 1024     // Slots swept per cycle at least
+#define RATE_STORE_MAX_ENTRIES 65536    // SECURITY: Processes tracked at once, ~7MB at most
 
 // OPTIMIZATION: String buffer cache configuration  
 #define STRING_CACHE_SIZE 16
 
-// Update intervals
-#define UI_UPDATE_INTERVAL_MS 1000  // 1 second for smooth UI (data collection is async)
+// Headless collector socket (see system/collector_server.h)
+#define COLLECTOR_SOCKET_NAME "taskmini.sock"   // In the user runtime directory
+#define COLLECTOR_SERVER_POLL_MS 100            // Client read / shutdown latency
+#define COLLECTOR_CLIENT_RETRY_MS 1000          // Reconnect delay after losing the server
+
+// SECURITY: Collector socket limits
+#define MAX_COLLECTOR_CLIENTS 32
+#define MAX_COLLECTOR_FRAME_SIZE (16 * 1024 * 1024)  // 16MB, ~170k processes
+
+// Streaming top/nettop sources (see system/stream_source.h)
+#define STREAM_SAMPLE_INTERVAL_S 1              // top -s / nettop -s delay
+#define STREAM_STOP_CHECK_MS 100               // Reader thread stop latency
+#define STREAM_RESTART_DELAY_MS 1000            // Relaunch delay after the child exits
+#define MAX_STREAM_FRAME_SIZE (8 * 1024 * 1024) // SECURITY: Larger frames are discarded
+
+// Sampling periods of the continuous collector (see system/sample_scheduler.h)
+#define SAMPLE_PERIOD_PROCESSES_MS 500  // Process list, CPU and memory
+#define SAMPLE_PERIOD_NETWORK_MS 1000   // Per-process network rates
+#define SAMPLE_PERIOD_GPU_MS 2000       // GPU usage
+#define SAMPLE_SCHEDULER_TICK_MS 50     // Timer wheel resolution
+#define SAMPLE_PERIOD_BACKGROUND_MS 10000  // Process list while the window is hidden (network and
+                                           // GPU stop); TASKMINI_BACKGROUND_PERIOD_MS, 0 = pause
 
-// Network and GPU monitoring intervals
+// Network and GPU caches of the one-shot paths (the continuous collector
+// uses SAMPLE_PERIOD_* instead)
 #define GPU_CHECK_INTERVAL 2        // Cache GPU result for 2 seconds
 #define NETWORK_CACHE_INTERVAL 1    // Cache network data for 1 second
 
@@ -3,6 +3,7 @@
 
 #include <gtk/gtk.h>
 #include <glib.h>
+#include <sys/types.h>
 
 // Column enumeration for TreeView
 enum {
@@ -17,35 +18,49 @@ enum {
     NUM_COLS
 };
 
-// Process data structure
+// Process flags
+#define PROCESS_FLAG_SYSTEM      (1u << 0)  // Critical system process (not killable from the UI)
+#define PROCESS_FLAG_HAS_GPU     (1u << 1)  // gpu holds a per-process measurement
+#define PROCESS_FLAG_HAS_START   (1u << 2)  // start_time is known
+
+#define PROCESS_UID_UNKNOWN (-1)
+
+// Canonical collected form of one process. Everything is numeric; text is
+// produced lazily by the UI only for rows that are actually drawn. The name
+// is an ID into the string intern table (process_name() / process_set_name()).
+typedef struct {
+    pid_t pid;
+    gint32 uid;             // Effective UID, PROCESS_UID_UNKNOWN if not known
+    guint32 flags;          // PROCESS_FLAG_*
+    float cpu;              // CPU usage percentage, normalized across cores
+    float gpu;              // GPU usage percentage (valid with PROCESS_FLAG_HAS_GPU)
+    guint32 name_id;        // Interned process name/command, 0 = none
+    guint64 rss_bytes;      // Resident memory in bytes
+    guint64 net_bps;        // Network throughput in bytes per second
+    gint64 start_time;      // Start time, seconds since the epoch (PROCESS_FLAG_HAS_START)
+} ProcessSample;
+
+// Packed table of samples for one collection cycle with a PID -> index
+// lookup. Storage is kept across clears so steady-state cycles don't
+// allocate (see utils/process_table.h).
 typedef struct {
-    char pid[10];           // Max PID on macOS + safety margin 
-    char name[50];          // Process name/command
-    char cpu[10];           // CPU usage percentage
-    char mem[20];           // Memory usage (human readable)
-    char gpu[20];           // GPU usage
-    char net[20];           // Network usage rate
-    char runtime[20];       // Process runtime
-    char type[20];          // Process type (System/User)
-    gboolean is_system;     // TRUE if system process
-} Process;
+    ProcessSample *items;   // items[0 .. count-1], contiguous
+    guint count;
+    guint capacity;
+    gint32 *index;          // Open-addressing slots holding item indices, -1 = empty
+    guint index_mask;       // Slot count - 1 (power of two)
+} ProcessTable;
 
 // Data structure for passing between threads
 typedef struct {
-    GList *processes;       // List of Process structs
+    ProcessTable *processes; // Samples in collection order (may be NULL)
     char *gpu_usage;        // GPU usage string
     char *system_summary;   // System summary info
     float system_cpu_usage; // System-wide CPU usage percentage
     float system_memory_usage; // System-wide memory usage percentage
+    struct SampleArena *arena; // Owns the strings (and the struct) if set; NULL = heap
 } UpdateData;
 
-// Process cache entry for incremental updates
-typedef struct {
-    Process *process;           // Process data
-    GtkTreeRowReference *row_ref;  // Stable reference to TreeView row
-    gboolean valid;             // Whether the row reference is valid
-} ProcessCacheEntry;
-
 // Filter criteria structure
 typedef struct {
     char pid_filter[20];        // PID filter (e.g., "100+", "50-", "123")
@@ -1,27 +1,132 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <signal.h>
 #include <gtk/gtk.h>
+#include <glib-unix.h>
 
 #include "ui/ui.h"
 #include "system/system.h"
 #include "system/performance.h"
+#include "system/collector_server.h"
+#include "system/collector_client.h"
 #include "utils/utils.h"
 #include "utils/memory_pool.h"
 
 #ifndef TESTING
+typedef enum {
+    MODE_UI,
+    MODE_HEADLESS,      // --headless[=SOCKET]: collect and serve, no window
+    MODE_ATTACH,        // --attach[=SOCKET]: UI reading a headless collector
+    MODE_QUERY          // --query[=SOCKET]: print one snapshot as TSV
+} RunMode;
+
+// Match --name or --name=SOCKET; *socket_path is NULL for the default socket
+static gboolean match_option(const char *arg, const char *name, const char **socket_path) {
+    size_t len = strlen(name);
+    if (strncmp(arg, name, len) != 0) return FALSE;
+    if (arg[len] == '\0') {
+        *socket_path = NULL;
+        return TRUE;
+    }
+    if (arg[len] == '=' && arg[len + 1] != '\0') {
+        *socket_path = arg + len + 1;
+        return TRUE;
+    }
+    return FALSE;
+}
+
+// Take our options out of argv so GApplication only sees its own
+static RunMode parse_mode(int *argc, char **argv, const char **socket_path) {
+    RunMode mode = MODE_UI;
+    int kept = 1;
+
+    for (int i = 1; i < *argc; i++) {
+        if (match_option(argv[i], "--headless", socket_path)) {
+            mode = MODE_HEADLESS;
+        } else if (match_option(argv[i], "--attach", socket_path)) {
+            mode = MODE_ATTACH;
+        } else if (match_option(argv[i], "--query", socket_path)) {
+            mode = MODE_QUERY;
+        } else {
+            argv[kept++] = argv[i];
+        }
+    }
+    *argc = kept;
+    argv[kept] = NULL;
+    return mode;
+}
+
+static gboolean quit_main_loop(gpointer user_data) {
+    g_main_loop_quit(user_data);
+    return G_SOURCE_REMOVE;
+}
+
+// One collector for the host, served to every viewer and script
+static int run_headless(const char *socket_path) {
+    ThreadedCollector *collector = threaded_collector_create();
+    threaded_collector_start_continuous_collection(collector);
+
+    CollectorServer *server = collector_server_start(collector, socket_path);
+    if (!server) {
+        threaded_collector_destroy(collector);
+        return EXIT_FAILURE;
+    }
+    printf("TaskMini collector serving %s (backend: %s)\n",
+           collector_server_get_path(server), collector_backend_name(collector->backend));
+
+    GMainLoop *loop = g_main_loop_new(NULL, FALSE);
+    g_unix_signal_add(SIGINT, quit_main_loop, loop);
+    g_unix_signal_add(SIGTERM, quit_main_loop, loop);
+    g_main_loop_run(loop);
+    g_main_loop_unref(loop);
+
+    collector_server_stop(server);
+    threaded_collector_destroy(collector);
+    return EXIT_SUCCESS;
+}
+
+static int run_query(const char *socket_path) {
+    UpdateData *data = collector_client_query(socket_path);
+    if (!data) {
+        fprintf(stderr, "No headless collector is running (start one with --headless)\n");
+        return EXIT_FAILURE;
+    }
+
+    printf("pid\tuid\tcpu\tgpu\trss_bytes\tnet_bps\tstart_time\tsystem\tname\n");
+    for (guint i = 0; data->processes && i < data->processes->count; i++) {
+        const ProcessSample *proc = &data->processes->items[i];
+        printf("%d\t%d\t%.1f\t%.1f\t%llu\t%llu\t%lld\t%d\t%s\n",
+               (int)proc->pid, (int)proc->uid, proc->cpu,
+               (proc->flags & PROCESS_FLAG_HAS_GPU) ? proc->gpu : -1.0f,
+               (unsigned long long)proc->rss_bytes, (unsigned long long)proc->net_bps,
+               (proc->flags & PROCESS_FLAG_HAS_START) ? (long long)proc->start_time : -1LL,
+               (proc->flags & PROCESS_FLAG_SYSTEM) ? 1 : 0, process_name(proc));
+    }
+    free_update_data(data);
+    return EXIT_SUCCESS;
+}
+
 int main(int argc, char **argv) {
+    const char *socket_path = NULL;
+    RunMode mode = parse_mode(&argc, argv, &socket_path);
+
     // Register cleanup handler
     atexit(cleanup_resources);
-    
+
     // Initialize optimized memory pools early
     init_memory_pools();
     init_process_pool();
-    
+
+    if (mode == MODE_HEADLESS) return run_headless(socket_path);
+    if (mode == MODE_QUERY) return run_query(socket_path);
+    if (mode == MODE_ATTACH) ui_attach_collector(socket_path);
+
     app = gtk_application_new("com.example.TaskMini", G_APPLICATION_DEFAULT_FLAGS);
     g_signal_connect(app, "activate", G_CALLBACK(activate), NULL);
     int status = g_application_run(G_APPLICATION(app), argc, argv);
     g_object_unref(app);
-    
+
     return status;
 }
 #endif
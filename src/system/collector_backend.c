@@ -0,0 +1,158 @@
+#include "collector_backend.h"
+#include "threaded_collector.h"
+#include "system.h"
+#include "../utils/utils.h"
+#include <string.h>
+
+// ============================================================================
+// TOP BACKEND - wraps the original popen("top") pipeline
+// ============================================================================
+
+static gboolean top_backend_open(CollectorBackend *backend) {
+    (void)backend; // Stateless: every sample launches its own top process
+    return TRUE;
+}
+
+static UpdateData* top_backend_collect(CollectorBackend *backend) {
+    (void)backend;
+    return collect_complete_data_sync();
+}
+
+static void top_backend_close(CollectorBackend *backend) {
+    (void)backend;
+}
+
+// Shared by the macOS backends: powermetrics, or the WindowServer fallback
+char* collector_backend_sample_system_gpu(CollectorBackend *backend) {
+    (void)backend;
+    return sample_gpu_usage();
+}
+
+static const CollectorBackendOps top_backend_ops = {
+    .name = "top",
+    .open = top_backend_open,
+    .collect = top_backend_collect,
+    .close = top_backend_close,
+    .sample_gpu = collector_backend_sample_system_gpu,
+    .min_period_ms = 2000,      // top -l 2 -s 1 alone takes over a second
+};
+
+const CollectorBackendOps* collector_backend_top_ops(void) {
+    return &top_backend_ops;
+}
+
+// ============================================================================
+// BACKEND SELECTION
+// ============================================================================
+
+// Look up a backend by name; returns NULL if unknown or unsupported here
+static const CollectorBackendOps* find_backend_ops(const char *name) {
+    const CollectorBackendOps *candidates[] = {
+        collector_backend_proc_ops(),
+        collector_backend_stream_ops(),
+        collector_backend_top_ops(),
+    };
+
+    for (size_t i = 0; i < G_N_ELEMENTS(candidates); i++) {
+        if (candidates[i] && strcmp(candidates[i]->name, name) == 0) {
+            return candidates[i];
+        }
+    }
+    return NULL;
+}
+
+CollectorBackend* collector_backend_create(const char *name) {
+    if (!name || *name == '\0') {
+        return collector_backend_create_default();
+    }
+
+    const CollectorBackendOps *ops = find_backend_ops(name);
+    if (!ops) return NULL;
+
+    CollectorBackend *backend = g_malloc0(sizeof(CollectorBackend));
+    backend->ops = ops;
+
+    if (ops->open && !ops->open(backend)) {
+        g_free(backend);
+        return NULL;
+    }
+
+    return backend;
+}
+
+CollectorBackend* collector_backend_create_default(void) {
+    // Explicit override first (e.g. TASKMINI_BACKEND=top for comparisons)
+    const char *requested = g_getenv("TASKMINI_BACKEND");
+    if (requested && *requested) {
+        CollectorBackend *backend = collector_backend_create(requested);
+        if (backend) return backend;
+    }
+
+    // Prefer the native reader, then the long-lived top stream; fall back to
+    // launching top per sample
+    CollectorBackend *backend = NULL;
+    if (collector_backend_proc_ops()) {
+        backend = collector_backend_create("proc");
+    }
+    if (!backend) {
+        backend = collector_backend_create("stream");
+    }
+    if (!backend) {
+        backend = collector_backend_create("top");
+    }
+    return backend;
+}
+
+void collector_backend_destroy(CollectorBackend *backend) {
+    if (!backend) return;
+
+    if (backend->ops && backend->ops->close) {
+        backend->ops->close(backend);
+    }
+    g_free(backend);
+}
+
+UpdateData* collector_backend_collect(CollectorBackend *backend) {
+    if (!backend || !backend->ops || !backend->ops->collect) return NULL;
+
+    // Counter is process-wide; children spawned by other threads during the
+    // sample are attributed to it as well
+    reset_spawned_child_count();
+    gint64 start = g_get_monotonic_time();
+    UpdateData *data = backend->ops->collect(backend);
+    backend->last_collect_us = g_get_monotonic_time() - start;
+    backend->last_spawned_children = get_spawned_child_count();
+
+    if (data) {
+        backend->samples++;
+    } else {
+        backend->failures++;
+    }
+    return data;
+}
+
+const char* collector_backend_name(const CollectorBackend *backend) {
+    return (backend && backend->ops) ? backend->ops->name : "none";
+}
+
+void collector_backend_refresh_network(CollectorBackend *backend) {
+    if (collector_backend_has_network(backend)) backend->ops->refresh_network(backend);
+}
+
+char* collector_backend_sample_gpu(CollectorBackend *backend) {
+    return collector_backend_has_gpu(backend) ? backend->ops->sample_gpu(backend) : NULL;
+}
+
+void collector_backend_set_background(CollectorBackend *backend, gboolean background) {
+    if (backend && backend->ops && backend->ops->set_background) {
+        backend->ops->set_background(backend, background);
+    }
+}
+
+gboolean collector_backend_has_network(const CollectorBackend *backend) {
+    return backend && backend->ops && backend->ops->refresh_network;
+}
+
+gboolean collector_backend_has_gpu(const CollectorBackend *backend) {
+    return backend && backend->ops && backend->ops->sample_gpu;
+}
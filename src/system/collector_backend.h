@@ -0,0 +1,68 @@
+#ifndef COLLECTOR_BACKEND_H
+#define COLLECTOR_BACKEND_H
+
+#include <glib.h>
+#include "../common/types.h"
+#include "../utils/worker_pool.h"
+
+// Pluggable data source for the collector. Each backend produces a complete
+// UpdateData snapshot per call; the ThreadedCollector only sees this interface.
+typedef struct CollectorBackend CollectorBackend;
+
+typedef struct {
+    const char *name;                                   // Short identifier ("top", "stream", "proc")
+    gboolean (*open)(CollectorBackend *backend);        // Allocate buffers / open long-lived fds
+    UpdateData* (*collect)(CollectorBackend *backend);  // Produce one complete sample (NULL on failure)
+    void (*close)(CollectorBackend *backend);           // Release everything opened in open()
+
+    // Optional metrics sampled at their own period by the collector's
+    // scheduler, possibly while collect() runs on another thread;
+    // collect() merges the latest values
+    void (*refresh_network)(CollectorBackend *backend); // Update per-process network rates
+    char* (*sample_gpu)(CollectorBackend *backend);     // GPU usage string, or NULL
+    guint min_period_ms;                                // Fastest useful collect() period (0 = any)
+
+    // Optional: the window is hidden and collect() runs at the background
+    // period; release what costs CPU between collections. Called on the
+    // collecting thread.
+    void (*set_background)(CollectorBackend *backend, gboolean background);
+} CollectorBackendOps;
+
+struct CollectorBackend {
+    const CollectorBackendOps *ops;
+    void *state;                // Backend-private state
+    WorkerPool *pool;           // Owner's workers for parallel reads, NULL = calling thread only
+
+    // Per-backend statistics
+    guint64 samples;            // Successful collections
+    guint64 failures;           // Collections that returned NULL
+    gint64 last_collect_us;     // Wall time of the last collection
+    guint last_spawned_children; // Child processes spawned during the last collection
+    guint64 last_file_syscalls; // Syscalls on per-process files during the last collection (proc)
+};
+
+// Backend selection. NULL or "" picks the best backend for this platform;
+// the TASKMINI_BACKEND environment variable overrides the default.
+CollectorBackend* collector_backend_create(const char *name);
+CollectorBackend* collector_backend_create_default(void);
+void collector_backend_destroy(CollectorBackend *backend);
+
+UpdateData* collector_backend_collect(CollectorBackend *backend);
+const char* collector_backend_name(const CollectorBackend *backend);
+
+// Optional hooks; no-op / NULL when the backend has none
+void collector_backend_refresh_network(CollectorBackend *backend);
+char* collector_backend_sample_gpu(CollectorBackend *backend);
+void collector_backend_set_background(CollectorBackend *backend, gboolean background);
+gboolean collector_backend_has_network(const CollectorBackend *backend);
+gboolean collector_backend_has_gpu(const CollectorBackend *backend);
+
+// Built-in backends
+const CollectorBackendOps* collector_backend_top_ops(void);   // popen("top") pipeline (macOS)
+const CollectorBackendOps* collector_backend_stream_ops(void); // Long-lived top/nettop streams (macOS)
+const CollectorBackendOps* collector_backend_proc_ops(void);  // Native /proc reader (Linux), NULL elsewhere
+
+// sample_gpu hook of the macOS backends
+char* collector_backend_sample_system_gpu(CollectorBackend *backend);
+
+#endif // COLLECTOR_BACKEND_H
@@ -0,0 +1,230 @@
+#define _GNU_SOURCE
+#include "collector_client.h"
+#include "../common/config.h"
+#include "../utils/utils.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#ifdef MSG_NOSIGNAL
+#define SEND_FLAGS MSG_NOSIGNAL
+#else
+#define SEND_FLAGS 0            // SO_NOSIGPIPE is set per socket instead
+#endif
+
+struct CollectorClient {
+    gchar *socket_path;
+    GThread *thread;
+    gint stop_requested;
+    SnapshotSlot slot;          // Republished snapshots for readers
+
+    // Reader thread only
+    int fd;
+    Snapshot *base;             // Last snapshot published, base for the next DELTA
+    guint64 server_sequence;    // Server sequence of base
+    guint8 *payload;            // Frame payload buffer, reused
+    gsize payload_capacity;
+
+    GMutex stats_mutex;
+    CollectorClientStats stats;
+};
+
+// Connect and send request; -1 if no server is listening
+static int open_connection(const char *path, char request) {
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (strlen(path) >= sizeof(addr.sun_path)) return -1;
+    strcpy(addr.sun_path, path);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+    fcntl(fd, F_SETFD, FD_CLOEXEC);
+#ifdef SO_NOSIGPIPE
+    int one = 1;
+    setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+#endif
+
+    if (connect(fd, (const struct sockaddr*)&addr, sizeof(addr)) != 0 ||
+        send(fd, &request, 1, SEND_FLAGS) != 1) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// Read exactly len bytes. Waits in COLLECTOR_SERVER_POLL_MS steps so a stop
+// request is noticed; with stop NULL, gives up after MAX_UPDATE_TIME_MS of
+// silence instead.
+static gboolean read_exact(int fd, void *buffer, gsize len, const gint *stop) {
+    guint8 *dest = buffer;
+    gint idle_ms = 0;
+
+    while (len > 0) {
+        if (stop ? g_atomic_int_get(stop) : idle_ms >= MAX_UPDATE_TIME_MS) return FALSE;
+
+        struct pollfd pfd = { fd, POLLIN, 0 };
+        int ready = poll(&pfd, 1, COLLECTOR_SERVER_POLL_MS);
+        if (ready < 0 && errno != EINTR) return FALSE;
+        if (ready <= 0) {
+            idle_ms += COLLECTOR_SERVER_POLL_MS;
+            continue;
+        }
+
+        ssize_t n = recv(fd, dest, len, 0);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return FALSE;
+        dest += n;
+        len -= (gsize)n;
+        idle_ms = 0;
+    }
+    return TRUE;
+}
+
+// Read one frame; the payload lands in *payload, grown as needed
+static gboolean read_frame(int fd, CollectorFrameHeader *header, guint8 **payload,
+                           gsize *capacity, const gint *stop) {
+    if (!read_exact(fd, header, sizeof(*header), stop)) return FALSE;
+    if (!collector_frame_header_valid(header)) return FALSE;
+
+    if (header->payload_len > *capacity) {
+        *capacity = header->payload_len;
+        *payload = g_realloc(*payload, *capacity);
+    }
+    return read_exact(fd, *payload, header->payload_len, stop);
+}
+
+static void set_connected(CollectorClient *client, gboolean connected) {
+    g_mutex_lock(&client->stats_mutex);
+    if (connected && !client->stats.connected && client->stats.frames_full > 0) {
+        client->stats.reconnects++;
+    }
+    client->stats.connected = connected;
+    g_mutex_unlock(&client->stats_mutex);
+}
+
+// Decode and republish one frame. FALSE means the stream is unusable (bad
+// payload, or a DELTA that does not follow our base) and must be restarted.
+static gboolean apply_frame(CollectorClient *client, const CollectorFrameHeader *header) {
+    const UpdateData *base = client->base ? client->base->data : NULL;
+    UpdateData *data = collector_frame_decode(header, client->payload, base, client->server_sequence);
+    if (!data) return FALSE;
+
+    // The local slot recomputes the delta for readers; we are its only writer,
+    // so the snapshot we acquire back is the one just published
+    snapshot_slot_publish(&client->slot, data);
+    if (client->base) snapshot_unref(client->base);
+    client->base = snapshot_slot_acquire(&client->slot);
+    client->server_sequence = header->sequence;
+    string_intern_advance();  // Names only the replaced snapshot used can go
+
+    g_mutex_lock(&client->stats_mutex);
+    if (header->type == COLLECTOR_FRAME_FULL) client->stats.frames_full++;
+    else client->stats.frames_delta++;
+    client->stats.bytes_received += sizeof(*header) + header->payload_len;
+    g_mutex_unlock(&client->stats_mutex);
+    return TRUE;
+}
+
+static gpointer collector_client_thread(gpointer data) {
+    CollectorClient *client = data;
+
+    while (!g_atomic_int_get(&client->stop_requested)) {
+        if (client->fd < 0) {
+            client->fd = open_connection(client->socket_path, COLLECTOR_REQUEST_WATCH);
+            if (client->fd < 0) {
+                // Retry in short sleeps so destroy() is not held up
+                for (gint waited = 0; waited < COLLECTOR_CLIENT_RETRY_MS &&
+                     !g_atomic_int_get(&client->stop_requested); waited += COLLECTOR_SERVER_POLL_MS) {
+                    g_usleep(COLLECTOR_SERVER_POLL_MS * 1000);
+                }
+                continue;
+            }
+            set_connected(client, TRUE);
+        }
+
+        CollectorFrameHeader header;
+        if (!read_frame(client->fd, &header, &client->payload, &client->payload_capacity,
+                        &client->stop_requested) ||
+            !apply_frame(client, &header)) {
+            // The server starts every connection with a FULL frame
+            close(client->fd);
+            client->fd = -1;
+            set_connected(client, FALSE);
+        }
+    }
+
+    return NULL;
+}
+
+CollectorClient* collector_client_connect(const char *socket_path) {
+    gchar *path = socket_path ? g_strdup(socket_path) : collector_socket_default_path();
+    int fd = open_connection(path, COLLECTOR_REQUEST_WATCH);
+    if (fd < 0) {
+        g_free(path);
+        return NULL;
+    }
+
+    CollectorClient *client = g_new0(CollectorClient, 1);
+    client->socket_path = path;
+    client->fd = fd;
+    snapshot_slot_init(&client->slot);
+    g_mutex_init(&client->stats_mutex);
+    client->stats.connected = TRUE;
+    client->thread = g_thread_new("collector_client", collector_client_thread, client);
+    return client;
+}
+
+void collector_client_destroy(CollectorClient *client) {
+    if (!client) return;
+
+    g_atomic_int_set(&client->stop_requested, 1);
+    g_thread_join(client->thread);
+
+    if (client->fd >= 0) close(client->fd);
+    if (client->base) snapshot_unref(client->base);
+    snapshot_slot_clear(&client->slot);
+    g_free(client->payload);
+    g_free(client->socket_path);
+    g_mutex_clear(&client->stats_mutex);
+    g_free(client);
+}
+
+Snapshot* collector_client_acquire_snapshot(CollectorClient *client) {
+    return client ? snapshot_slot_acquire(&client->slot) : NULL;
+}
+
+void collector_client_set_publish_notify(CollectorClient *client, SnapshotNotifyFunc func, gpointer user_data) {
+    if (client) snapshot_slot_set_notify(&client->slot, func, user_data);
+}
+
+void collector_client_get_stats(CollectorClient *client, CollectorClientStats *stats) {
+    if (!client || !stats) return;
+
+    g_mutex_lock(&client->stats_mutex);
+    *stats = client->stats;
+    g_mutex_unlock(&client->stats_mutex);
+}
+
+UpdateData* collector_client_query(const char *socket_path) {
+    gchar *path = socket_path ? g_strdup(socket_path) : collector_socket_default_path();
+    int fd = open_connection(path, COLLECTOR_REQUEST_SNAPSHOT);
+    g_free(path);
+    if (fd < 0) return NULL;
+
+    CollectorFrameHeader header;
+    guint8 *payload = NULL;
+    gsize capacity = 0;
+    UpdateData *data = NULL;
+    if (read_frame(fd, &header, &payload, &capacity, NULL) && header.type == COLLECTOR_FRAME_FULL) {
+        data = collector_frame_decode(&header, payload, NULL, 0);
+    }
+
+    g_free(payload);
+    close(fd);
+    return data;
+}
@@ -0,0 +1,43 @@
+#ifndef COLLECTOR_CLIENT_H
+#define COLLECTOR_CLIENT_H
+
+#include <glib.h>
+#include "../common/types.h"
+#include "collector_protocol.h"
+#include "snapshot.h"
+
+// Client of a headless collector (collector_server.h). A background thread
+// follows the server's FULL/DELTA stream and republishes every snapshot in a
+// local SnapshotSlot, so readers use it exactly like a ThreadedCollector.
+// If the server goes away the thread keeps retrying; readers keep seeing the
+// last snapshot until it is back.
+typedef struct CollectorClient CollectorClient;
+
+typedef struct {
+    gboolean connected;
+    guint64 frames_full;        // FULL frames applied
+    guint64 frames_delta;       // DELTA frames applied
+    guint64 bytes_received;
+    guint64 reconnects;         // Connections re-established after a loss
+} CollectorClientStats;
+
+// Connect to socket_path (NULL for collector_socket_default_path()) and start
+// following it. Returns NULL if no server is listening.
+CollectorClient* collector_client_connect(const char *socket_path);
+void collector_client_destroy(CollectorClient *client);
+
+// Latest snapshot received, or NULL before the first frame.
+// Release with snapshot_unref().
+Snapshot* collector_client_acquire_snapshot(CollectorClient *client);
+
+// Called on the client thread after every frame is republished
+// (see snapshot_slot_set_notify)
+void collector_client_set_publish_notify(CollectorClient *client, SnapshotNotifyFunc func, gpointer user_data);
+
+void collector_client_get_stats(CollectorClient *client, CollectorClientStats *stats);
+
+// One-shot query for scripts: the server's current snapshot, or NULL if the
+// server cannot be reached. Free with free_update_data().
+UpdateData* collector_client_query(const char *socket_path);
+
+#endif // COLLECTOR_CLIENT_H
@@ -0,0 +1,297 @@
+#include "collector_protocol.h"
+#include "../common/config.h"
+#include "../utils/utils.h"
+#include <string.h>
+
+gchar* collector_socket_default_path(void) {
+    const char *override = g_getenv("TASKMINI_SOCKET");
+    if (override && *override) {
+        return g_strdup(override);
+    }
+    return g_build_filename(g_get_user_runtime_dir(), COLLECTOR_SOCKET_NAME, NULL);
+}
+
+// ---- Encoding ----
+
+static void append_u32(GByteArray *frame, guint32 value) {
+    g_byte_array_append(frame, (const guint8*)&value, sizeof(value));
+}
+
+static void append_float(GByteArray *frame, float value) {
+    g_byte_array_append(frame, (const guint8*)&value, sizeof(value));
+}
+
+static void append_text(GByteArray *frame, const char *text) {
+    guint32 len = text ? (guint32)strlen(text) : 0;
+    append_u32(frame, len);
+    if (len > 0) g_byte_array_append(frame, (const guint8*)text, len);
+}
+
+// Name block for rows: each distinct name ID once, with its text
+typedef struct {
+    GByteArray *frame;
+    guint count_offset;
+    guint32 count;
+    GHashTable *sent;
+} NameBlock;
+
+static void name_block_begin(NameBlock *block, GByteArray *frame) {
+    block->frame = frame;
+    block->count_offset = frame->len;
+    block->count = 0;
+    block->sent = g_hash_table_new(g_direct_hash, g_direct_equal);
+    append_u32(frame, 0);  // Patched by name_block_finish()
+}
+
+static void name_block_add(NameBlock *block, const ProcessSample *proc) {
+    guint32 id = proc->name_id;
+    if (id == 0 || !g_hash_table_add(block->sent, GUINT_TO_POINTER(id))) return;
+    append_u32(block->frame, id);
+    append_text(block->frame, string_intern_text(id));
+    block->count++;
+}
+
+static void name_block_finish(NameBlock *block) {
+    memcpy(block->frame->data + block->count_offset, &block->count, sizeof(block->count));
+    g_hash_table_destroy(block->sent);
+}
+
+static GByteArray* frame_begin(guint16 type, const Snapshot *snapshot, guint64 base_sequence,
+                               guint record_count) {
+    const UpdateData *data = snapshot->data;
+    GByteArray *frame = g_byte_array_sized_new(sizeof(CollectorFrameHeader) + 256 +
+                                               record_count * sizeof(ProcessSample));
+
+    CollectorFrameHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = COLLECTOR_PROTOCOL_MAGIC;
+    header.version = COLLECTOR_PROTOCOL_VERSION;
+    header.type = type;
+    header.sequence = snapshot->sequence;
+    header.base_sequence = base_sequence;
+    header.record_size = sizeof(ProcessSample);
+    g_byte_array_append(frame, (const guint8*)&header, sizeof(header));
+
+    append_float(frame, data->system_cpu_usage);
+    append_float(frame, data->system_memory_usage);
+    append_text(frame, data->gpu_usage);
+    append_text(frame, data->system_summary);
+    return frame;
+}
+
+static GBytes* frame_finish(GByteArray *frame) {
+    guint32 payload_len = frame->len - sizeof(CollectorFrameHeader);
+    memcpy(frame->data + G_STRUCT_OFFSET(CollectorFrameHeader, payload_len),
+           &payload_len, sizeof(payload_len));
+    return g_byte_array_free_to_bytes(frame);
+}
+
+GBytes* collector_frame_encode_full(const Snapshot *snapshot) {
+    if (!snapshot || !snapshot->data) return NULL;
+
+    const ProcessTable *table = snapshot->data->processes;
+    guint count = table ? table->count : 0;
+
+    GByteArray *frame = frame_begin(COLLECTOR_FRAME_FULL, snapshot, 0, count);
+    NameBlock names;
+    name_block_begin(&names, frame);
+    for (guint i = 0; i < count; i++) name_block_add(&names, &table->items[i]);
+    name_block_finish(&names);
+
+    append_u32(frame, count);
+    if (count > 0) {
+        // OPTIMIZATION: The table is already one contiguous array of records
+        g_byte_array_append(frame, (const guint8*)table->items, count * sizeof(ProcessSample));
+    }
+    return frame_finish(frame);
+}
+
+GBytes* collector_frame_encode_delta(const Snapshot *snapshot) {
+    if (!snapshot || !snapshot->data || !snapshot->delta || snapshot->sequence < 2) return NULL;
+
+    const ProcessDelta *delta = snapshot->delta;
+    const ProcessTable *table = snapshot->data->processes;
+    guint upserted = delta->added->len + delta->changed->len;
+    if (upserted > 0 && !table) return NULL;
+
+    GByteArray *frame = frame_begin(COLLECTOR_FRAME_DELTA, snapshot, snapshot->sequence - 1, upserted);
+
+    append_u32(frame, delta->removed->len);
+    for (guint i = 0; i < delta->removed->len; i++) {
+        gint32 pid = (gint32)g_array_index(delta->removed, pid_t, i);
+        g_byte_array_append(frame, (const guint8*)&pid, sizeof(pid));
+    }
+
+    NameBlock names;
+    name_block_begin(&names, frame);
+    for (guint i = 0; i < delta->added->len; i++) {
+        name_block_add(&names, &table->items[g_array_index(delta->added, guint32, i)]);
+    }
+    for (guint i = 0; i < delta->changed->len; i++) {
+        name_block_add(&names, &table->items[g_array_index(delta->changed, ProcessChange, i).index]);
+    }
+    name_block_finish(&names);
+
+    // Changed rows are sent whole: a record is small and the receiver can
+    // then overwrite it without knowing which fields moved
+    append_u32(frame, upserted);
+    for (guint i = 0; i < delta->added->len; i++) {
+        guint32 index = g_array_index(delta->added, guint32, i);
+        g_byte_array_append(frame, (const guint8*)&table->items[index], sizeof(ProcessSample));
+    }
+    for (guint i = 0; i < delta->changed->len; i++) {
+        guint32 index = g_array_index(delta->changed, ProcessChange, i).index;
+        g_byte_array_append(frame, (const guint8*)&table->items[index], sizeof(ProcessSample));
+    }
+    return frame_finish(frame);
+}
+
+// ---- Decoding ----
+
+gboolean collector_frame_header_valid(const CollectorFrameHeader *header) {
+    if (header->magic != COLLECTOR_PROTOCOL_MAGIC ||
+        header->version != COLLECTOR_PROTOCOL_VERSION ||
+        header->record_size != sizeof(ProcessSample)) {
+        return FALSE;
+    }
+    if (header->type != COLLECTOR_FRAME_FULL && header->type != COLLECTOR_FRAME_DELTA) {
+        return FALSE;
+    }
+    // SECURITY: Bound what a peer can make us allocate
+    return header->payload_len <= MAX_COLLECTOR_FRAME_SIZE;
+}
+
+typedef struct {
+    const guint8 *data;
+    gsize len;
+    gsize pos;
+} FrameReader;
+
+static const guint8* read_span(FrameReader *reader, gsize len) {
+    if (len > reader->len - reader->pos) return NULL;
+    const guint8 *span = reader->data + reader->pos;
+    reader->pos += len;
+    return span;
+}
+
+static gboolean read_u32(FrameReader *reader, guint32 *value) {
+    const guint8 *span = read_span(reader, sizeof(*value));
+    if (span) memcpy(value, span, sizeof(*value));
+    return span != NULL;
+}
+
+static gboolean read_float(FrameReader *reader, float *value) {
+    const guint8 *span = read_span(reader, sizeof(*value));
+    if (span) memcpy(value, span, sizeof(*value));
+    return span != NULL;
+}
+
+// Text field of data, copied into its arena
+static gboolean read_text(FrameReader *reader, UpdateData *data, char **text) {
+    guint32 len;
+    if (!read_u32(reader, &len)) return FALSE;
+    const guint8 *span = read_span(reader, len);
+    if (!span) return FALSE;
+    *text = len > 0 ? update_data_strndup(data, (const char*)span, len) : NULL;
+    return TRUE;
+}
+
+// Span of count records, NULL if the payload is shorter than that
+static const guint8* read_records(FrameReader *reader, guint32 count, gsize record_size) {
+    if (count > (reader->len - reader->pos) / record_size) return NULL;
+    return read_span(reader, (gsize)count * record_size);
+}
+
+// Intern the name block; names maps the sender's IDs to ours
+static gboolean read_names(FrameReader *reader, GHashTable *names) {
+    guint32 count;
+    if (!read_u32(reader, &count)) return FALSE;
+    for (guint32 i = 0; i < count; i++) {
+        guint32 id, len;
+        if (!read_u32(reader, &id) || !read_u32(reader, &len)) return FALSE;
+        const guint8 *text = read_span(reader, len);
+        if (!text) return FALSE;
+        g_hash_table_insert(names, GUINT_TO_POINTER(id),
+                            GUINT_TO_POINTER(string_intern((const char*)text, len)));
+    }
+    return TRUE;
+}
+
+static void add_record(ProcessTable *table, const guint8 *record, GHashTable *names) {
+    ProcessSample sample;
+    memcpy(&sample, record, sizeof(sample));  // Records are not aligned in the payload
+    // SECURITY: Never trust the sender's ID as ours; unknown IDs become unnamed
+    sample.name_id = GPOINTER_TO_UINT(g_hash_table_lookup(names, GUINT_TO_POINTER(sample.name_id)));
+    process_table_add(table, &sample);
+}
+
+static gboolean decode_full(FrameReader *reader, ProcessTable *table, GHashTable *names) {
+    guint32 count;
+    if (!read_names(reader, names) || !read_u32(reader, &count)) return FALSE;
+    const guint8 *records = read_records(reader, count, sizeof(ProcessSample));
+    if (!records) return FALSE;
+
+    for (guint32 i = 0; i < count; i++) {
+        add_record(table, records + (gsize)i * sizeof(ProcessSample), names);
+    }
+    return TRUE;
+}
+
+// Surviving base rows keep their order, new PIDs are appended
+static gboolean decode_delta(FrameReader *reader, const ProcessTable *base, ProcessTable *table,
+                             GHashTable *names) {
+    guint32 removed_count, upserted;
+    if (!read_u32(reader, &removed_count)) return FALSE;
+    const guint8 *removed = read_records(reader, removed_count, sizeof(gint32));
+    if (!removed || !read_names(reader, names) || !read_u32(reader, &upserted)) return FALSE;
+    const guint8 *records = read_records(reader, upserted, sizeof(ProcessSample));
+    if (!records) return FALSE;
+
+    guint base_count = base ? base->count : 0;
+    guint8 *dropped = g_new0(guint8, base_count + 1);
+    for (guint32 i = 0; i < removed_count; i++) {
+        gint32 pid;
+        memcpy(&pid, removed + (gsize)i * sizeof(pid), sizeof(pid));
+        const ProcessSample *row = base ? process_table_lookup(base, (pid_t)pid) : NULL;
+        if (row) dropped[row - base->items] = 1;
+    }
+    for (guint i = 0; i < base_count; i++) {
+        if (!dropped[i]) process_table_add(table, &base->items[i]);
+    }
+    g_free(dropped);
+
+    for (guint32 i = 0; i < upserted; i++) {
+        add_record(table, records + (gsize)i * sizeof(ProcessSample), names);
+    }
+    return TRUE;
+}
+
+UpdateData* collector_frame_decode(const CollectorFrameHeader *header, const guint8 *payload,
+                                   const UpdateData *base, guint64 base_sequence) {
+    if (header->type == COLLECTOR_FRAME_DELTA &&
+        (!base || header->base_sequence != base_sequence)) {
+        return NULL;
+    }
+
+    FrameReader reader = { payload, header->payload_len, 0 };
+    UpdateData *data = update_data_new();
+    data->processes = process_table_acquire();
+
+    gboolean ok = read_float(&reader, &data->system_cpu_usage) &&
+                  read_float(&reader, &data->system_memory_usage) &&
+                  read_text(&reader, data, &data->gpu_usage) &&
+                  read_text(&reader, data, &data->system_summary);
+    if (ok) {
+        GHashTable *names = g_hash_table_new(g_direct_hash, g_direct_equal);
+        ok = header->type == COLLECTOR_FRAME_FULL
+            ? decode_full(&reader, data->processes, names)
+            : decode_delta(&reader, base->processes, data->processes, names);
+        g_hash_table_destroy(names);
+    }
+
+    if (!ok || reader.pos != reader.len) {
+        free_update_data(data);
+        return NULL;
+    }
+    return data;
+}
@@ -0,0 +1,73 @@
+#ifndef COLLECTOR_PROTOCOL_H
+#define COLLECTOR_PROTOCOL_H
+
+#include <glib.h>
+#include "../common/types.h"
+#include "snapshot.h"
+
+// Binary framing used between the headless collector (collector_server.h)
+// and its clients (collector_client.h) over a local Unix domain socket.
+//
+// A client connects and sends one request byte:
+//   COLLECTOR_REQUEST_WATCH     - one FULL frame, then a DELTA frame for every
+//                                 new snapshot (a FULL again if it fell behind)
+//   COLLECTOR_REQUEST_SNAPSHOT  - one FULL frame, then the server hangs up
+//
+// Every frame is a CollectorFrameHeader followed by payload_len bytes:
+//   system block: float cpu, float memory, u32 gpu_len, gpu text,
+//                 u32 summary_len, summary text (no terminators)
+//   name block:   u32 names, then per name u32 id, u32 len, text - every
+//                 name ID used by the frame's records with its text
+//   FULL:         system block, name block, u32 count, count ProcessSample
+//                 records
+//   DELTA:        system block, u32 removed, removed pid_t values, name
+//                 block, u32 upserted, upserted ProcessSample records (added
+//                 and changed rows, replacing any row with the same PID)
+//
+// Both ends run on the same host, so integers and records are in native
+// layout; record_size rejects peers built with a different ProcessSample.
+// Name IDs are local to each process (utils/string_intern.h): the receiver
+// interns the name block and rewrites the IDs of the records.
+
+#define COLLECTOR_PROTOCOL_MAGIC    0x4e534d54u  // "TMSN"
+#define COLLECTOR_PROTOCOL_VERSION  2
+
+#define COLLECTOR_REQUEST_WATCH     'W'
+#define COLLECTOR_REQUEST_SNAPSHOT  'S'
+
+#define COLLECTOR_FRAME_FULL        1
+#define COLLECTOR_FRAME_DELTA       2
+
+typedef struct {
+    guint32 magic;              // COLLECTOR_PROTOCOL_MAGIC
+    guint16 version;            // COLLECTOR_PROTOCOL_VERSION
+    guint16 type;               // COLLECTOR_FRAME_*
+    guint64 sequence;           // Server snapshot sequence carried by this frame
+    guint64 base_sequence;      // DELTA: sequence the delta applies to, 0 for FULL
+    guint32 payload_len;        // Bytes following the header
+    guint32 record_size;        // sizeof(ProcessSample) of the sender
+} CollectorFrameHeader;
+
+// Socket path: $TASKMINI_SOCKET, else taskmini.sock in the user runtime
+// directory. Free with g_free().
+gchar* collector_socket_default_path(void);
+
+// Encode snapshot as a FULL frame, or as a DELTA frame against
+// snapshot->sequence - 1. The DELTA encoder returns NULL for snapshots
+// without a delta. Frames are immutable and shared by every client.
+GBytes* collector_frame_encode_full(const Snapshot *snapshot);
+GBytes* collector_frame_encode_delta(const Snapshot *snapshot);
+
+// Validate a received header. Returns FALSE for frames from another
+// protocol/build and for payloads over the size limit.
+gboolean collector_frame_header_valid(const CollectorFrameHeader *header);
+
+// Build the UpdateData described by a frame. DELTA frames are applied to
+// base, the data decoded from the frame with server sequence base_sequence
+// (unchanged); surviving rows keep their base order and new PIDs are
+// appended. Returns NULL for malformed payloads and for a DELTA without a
+// base or against another sequence. Free with free_update_data().
+UpdateData* collector_frame_decode(const CollectorFrameHeader *header, const guint8 *payload,
+                                   const UpdateData *base, guint64 base_sequence);
+
+#endif // COLLECTOR_PROTOCOL_H
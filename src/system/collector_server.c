@@ -0,0 +1,416 @@
+#define _GNU_SOURCE
+#include "collector_server.h"
+#include "../common/config.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+
+#ifdef MSG_NOSIGNAL
+#define SEND_FLAGS MSG_NOSIGNAL
+#else
+#define SEND_FLAGS 0            // SO_NOSIGPIPE is set per socket instead
+#endif
+
+typedef struct {
+    int fd;
+    gboolean requested;         // Request byte received
+    gboolean watching;          // COLLECTOR_REQUEST_WATCH, else one snapshot
+    guint64 sequence;           // Snapshot last queued to this client, 0 = none
+    GBytes *out;                // Frame being written, NULL when idle
+    gsize out_offset;
+} ServerClient;
+
+struct CollectorServer {
+    ThreadedCollector *collector;
+    gchar *socket_path;
+    int listen_fd;
+    int wake_fds[2];            // Written on publish and stop, read by the server thread
+    GThread *thread;
+    gint stop_requested;
+
+    // Server thread only
+    ServerClient clients[MAX_COLLECTOR_CLIENTS];
+    guint client_count;
+    Snapshot *current;          // Latest snapshot seen
+    GBytes *full_frame;         // Encoded lazily for current
+    GBytes *delta_frame;
+    gboolean delta_tried;       // delta_frame was attempted (may be NULL)
+
+    GMutex stats_mutex;
+    CollectorServerStats stats;
+};
+
+// ---- Socket setup ----
+
+static void set_socket_flags(int fd) {
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+    fcntl(fd, F_SETFD, FD_CLOEXEC);
+#ifdef SO_NOSIGPIPE
+    int one = 1;
+    setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+#endif
+}
+
+static gboolean fill_address(struct sockaddr_un *addr, const char *path) {
+    memset(addr, 0, sizeof(*addr));
+    addr->sun_family = AF_UNIX;
+    if (strlen(path) >= sizeof(addr->sun_path)) return FALSE;
+    strcpy(addr->sun_path, path);
+    return TRUE;
+}
+
+// TRUE if a server is accepting connections on path
+static gboolean socket_is_live(const struct sockaddr_un *addr) {
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) return FALSE;
+    gboolean live = connect(fd, (const struct sockaddr*)addr, sizeof(*addr)) == 0;
+    close(fd);
+    return live;
+}
+
+static int open_listen_socket(const char *path) {
+    struct sockaddr_un addr;
+    if (!fill_address(&addr, path)) {
+        g_warning("Collector socket path too long: %s", path);
+        return -1;
+    }
+
+    // SECURITY: Only ever replace a stale socket, never another kind of file
+    struct stat st;
+    if (lstat(path, &st) == 0) {
+        if (!S_ISSOCK(st.st_mode)) {
+            g_warning("Collector socket path exists and is not a socket: %s", path);
+            return -1;
+        }
+        if (socket_is_live(&addr)) {
+            g_warning("A collector is already serving %s", path);
+            return -1;
+        }
+        unlink(path);
+    }
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+
+    if (bind(fd, (const struct sockaddr*)&addr, sizeof(addr)) != 0 ||
+        chmod(path, S_IRUSR | S_IWUSR) != 0 ||    // SECURITY: Owner only
+        listen(fd, MAX_COLLECTOR_CLIENTS) != 0) {
+        g_warning("Cannot serve collector socket %s: %s", path, g_strerror(errno));
+        close(fd);
+        return -1;
+    }
+
+    set_socket_flags(fd);
+    return fd;
+}
+
+// SECURITY: The socket file is owner-only, but also check the peer in case
+// the runtime directory or the file mode is not what we expect
+static gboolean peer_is_same_user(int fd) {
+#if defined(__linux__)
+    struct ucred cred;
+    socklen_t len = sizeof(cred);
+    if (getsockopt(fd, SOL_SOCKET, SO_PEERCRED, &cred, &len) != 0) return FALSE;
+    return cred.uid == geteuid();
+#else
+    uid_t uid;
+    gid_t gid;
+    if (getpeereid(fd, &uid, &gid) != 0) return FALSE;
+    return uid == geteuid();
+#endif
+}
+
+// ---- Clients ----
+
+static void count_stat(CollectorServer *server, guint64 *counter, guint64 amount) {
+    g_mutex_lock(&server->stats_mutex);
+    *counter += amount;
+    g_mutex_unlock(&server->stats_mutex);
+}
+
+static void update_client_count(CollectorServer *server) {
+    g_mutex_lock(&server->stats_mutex);
+    server->stats.clients = server->client_count;
+    g_mutex_unlock(&server->stats_mutex);
+}
+
+static void drop_client(CollectorServer *server, guint index) {
+    ServerClient *client = &server->clients[index];
+    close(client->fd);
+    if (client->out) g_bytes_unref(client->out);
+
+    server->clients[index] = server->clients[--server->client_count];
+    update_client_count(server);
+}
+
+static void accept_clients(CollectorServer *server) {
+    for (;;) {
+        int fd = accept(server->listen_fd, NULL, NULL);
+        if (fd < 0) return;     // EAGAIN: backlog drained
+
+        if (server->client_count >= MAX_COLLECTOR_CLIENTS || !peer_is_same_user(fd)) {
+            close(fd);
+            count_stat(server, &server->stats.rejected, 1);
+            continue;
+        }
+
+        set_socket_flags(fd);
+        ServerClient *client = &server->clients[server->client_count++];
+        memset(client, 0, sizeof(*client));
+        client->fd = fd;
+        count_stat(server, &server->stats.accepted, 1);
+        update_client_count(server);
+    }
+}
+
+// Read the request byte. Returns FALSE if the client must be dropped.
+static gboolean read_request(CollectorServer *server, ServerClient *client) {
+    char request[16];
+    ssize_t n = recv(client->fd, request, sizeof(request), 0);
+    if (n < 0) return errno == EAGAIN || errno == EINTR;
+    if (n == 0) return FALSE;   // Watchers only hang up to leave
+    if (client->requested) return TRUE;
+
+    if (request[0] == COLLECTOR_REQUEST_WATCH || request[0] == COLLECTOR_REQUEST_SNAPSHOT) {
+        client->requested = TRUE;
+        client->watching = request[0] == COLLECTOR_REQUEST_WATCH;
+        return TRUE;
+    }
+    count_stat(server, &server->stats.rejected, 1);
+    return FALSE;
+}
+
+// Write as much of the pending frame as the socket takes. Returns FALSE if
+// the client must be dropped (error, or a one-shot request completed).
+static gboolean flush_client(CollectorServer *server, ServerClient *client) {
+    gsize size;
+    const guint8 *data = g_bytes_get_data(client->out, &size);
+
+    while (client->out_offset < size) {
+        ssize_t n = send(client->fd, data + client->out_offset, size - client->out_offset, SEND_FLAGS);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return errno == EAGAIN || errno == EWOULDBLOCK;
+        }
+        client->out_offset += (gsize)n;
+        count_stat(server, &server->stats.bytes_sent, (guint64)n);
+    }
+
+    g_bytes_unref(client->out);
+    client->out = NULL;
+    return client->watching;
+}
+
+// ---- Frames ----
+
+static void set_current(CollectorServer *server, Snapshot *snapshot) {
+    if (server->current) snapshot_unref(server->current);
+    if (server->full_frame) g_bytes_unref(server->full_frame);
+    if (server->delta_frame) g_bytes_unref(server->delta_frame);
+
+    server->current = snapshot;
+    server->full_frame = NULL;
+    server->delta_frame = NULL;
+    server->delta_tried = FALSE;
+}
+
+// Pick up the collector's latest snapshot; cached frames belong to the old one
+static void refresh_snapshot(CollectorServer *server) {
+    Snapshot *snapshot = threaded_collector_acquire_snapshot(server->collector);
+    if (!snapshot) return;
+
+    if (server->current && snapshot->sequence == server->current->sequence) {
+        snapshot_unref(snapshot);
+        return;
+    }
+    set_current(server, snapshot);
+}
+
+static GBytes* current_full_frame(CollectorServer *server) {
+    if (!server->full_frame) {
+        server->full_frame = collector_frame_encode_full(server->current);
+        count_stat(server, &server->stats.frames_encoded, 1);
+    }
+    return server->full_frame;
+}
+
+static GBytes* current_delta_frame(CollectorServer *server) {
+    if (!server->delta_tried) {
+        server->delta_frame = collector_frame_encode_delta(server->current);
+        server->delta_tried = TRUE;
+        if (server->delta_frame) count_stat(server, &server->stats.frames_encoded, 1);
+    }
+    return server->delta_frame;
+}
+
+// Give an idle client the current snapshot: a DELTA if it holds the previous
+// one, otherwise a FULL frame
+static void queue_current(CollectorServer *server, ServerClient *client) {
+    GBytes *frame = NULL;
+    if (client->sequence != 0 && client->sequence + 1 == server->current->sequence) {
+        frame = current_delta_frame(server);
+    }
+    if (frame) {
+        count_stat(server, &server->stats.frames_delta, 1);
+    } else {
+        frame = current_full_frame(server);
+        count_stat(server, &server->stats.frames_full, 1);
+    }
+
+    client->out = g_bytes_ref(frame);
+    client->out_offset = 0;
+    client->sequence = server->current->sequence;
+}
+
+// ---- Server thread ----
+
+// OPTIMIZATION: The server sleeps in poll() until a snapshot is published or
+// a socket is ready instead of checking the collector on a timer
+static void wake_server(CollectorServer *server) {
+    char byte = 1;
+    // EAGAIN: a wakeup is already pending
+    while (write(server->wake_fds[1], &byte, 1) < 0 && errno == EINTR) {}
+}
+
+// Runs on the collector thread after every publish
+static void on_snapshot_published(guint64 sequence, gpointer user_data) {
+    (void)sequence;
+    wake_server(user_data);
+}
+
+static void drain_wakeups(CollectorServer *server) {
+    char buffer[64];
+    while (read(server->wake_fds[0], buffer, sizeof(buffer)) > 0) {}
+}
+
+static gpointer collector_server_thread(gpointer data) {
+    CollectorServer *server = data;
+    struct pollfd fds[MAX_COLLECTOR_CLIENTS + 2];
+
+    while (!g_atomic_int_get(&server->stop_requested)) {
+        refresh_snapshot(server);
+
+        // Hand the latest snapshot to every idle client that lacks it. The
+        // first write is attempted right away; the rest waits for POLLOUT.
+        for (guint i = server->client_count; i-- > 0;) {
+            ServerClient *client = &server->clients[i];
+            if (!server->current || !client->requested || client->out ||
+                client->sequence == server->current->sequence) {
+                continue;
+            }
+            queue_current(server, client);
+            if (!flush_client(server, client)) drop_client(server, i);
+        }
+
+        fds[0].fd = server->listen_fd;
+        fds[0].events = POLLIN;
+        fds[1].fd = server->wake_fds[0];
+        fds[1].events = POLLIN;
+        for (guint i = 0; i < server->client_count; i++) {
+            ServerClient *client = &server->clients[i];
+            fds[i + 2].fd = client->fd;
+            fds[i + 2].events = (short)((client->out ? POLLOUT : 0) |
+                                        (client->requested && !client->watching ? 0 : POLLIN));
+            fds[i + 2].revents = 0;
+        }
+
+        guint polled = server->client_count;
+        if (poll(fds, polled + 2, -1) <= 0) continue;
+        if (fds[1].revents & POLLIN) drain_wakeups(server);
+
+        // Descending, so dropping a client (swap with the last) keeps the
+        // remaining fds[] entries lined up
+        for (guint i = polled; i-- > 0;) {
+            ServerClient *client = &server->clients[i];
+            short revents = fds[i + 2].revents;
+            gboolean keep = !(revents & (POLLERR | POLLNVAL));
+
+            if (keep && (revents & (POLLIN | POLLHUP))) keep = read_request(server, client);
+            if (keep && (revents & POLLOUT) && client->out) keep = flush_client(server, client);
+            if (!keep) drop_client(server, i);
+        }
+
+        if (fds[0].revents & POLLIN) accept_clients(server);
+    }
+
+    return NULL;
+}
+
+CollectorServer* collector_server_start(ThreadedCollector *collector, const char *socket_path) {
+    if (!collector) return NULL;
+
+    gchar *path = socket_path ? g_strdup(socket_path) : collector_socket_default_path();
+    int fd = open_listen_socket(path);
+    if (fd < 0) {
+        g_free(path);
+        return NULL;
+    }
+
+    int wake_fds[2];
+    if (pipe(wake_fds) != 0) {
+        g_warning("Cannot create collector server wakeup pipe: %s", g_strerror(errno));
+        close(fd);
+        unlink(path);
+        g_free(path);
+        return NULL;
+    }
+    for (int i = 0; i < 2; i++) {
+        fcntl(wake_fds[i], F_SETFL, fcntl(wake_fds[i], F_GETFL) | O_NONBLOCK);
+        fcntl(wake_fds[i], F_SETFD, FD_CLOEXEC);
+    }
+
+    CollectorServer *server = g_new0(CollectorServer, 1);
+    server->collector = collector;
+    server->socket_path = path;
+    server->listen_fd = fd;
+    server->wake_fds[0] = wake_fds[0];
+    server->wake_fds[1] = wake_fds[1];
+    g_mutex_init(&server->stats_mutex);
+
+    // Before the thread starts: its first pass picks up anything published
+    // earlier, later publishes wake it
+    threaded_collector_set_publish_notify(collector, on_snapshot_published, server);
+    server->thread = g_thread_new("collector_server", collector_server_thread, server);
+    return server;
+}
+
+void collector_server_stop(CollectorServer *server) {
+    if (!server) return;
+
+    // Returns once no publish is still inside on_snapshot_published()
+    threaded_collector_set_publish_notify(server->collector, NULL, NULL);
+
+    g_atomic_int_set(&server->stop_requested, 1);
+    wake_server(server);
+    g_thread_join(server->thread);
+
+    while (server->client_count > 0) {
+        drop_client(server, server->client_count - 1);
+    }
+    set_current(server, NULL);
+
+    close(server->listen_fd);
+    close(server->wake_fds[0]);
+    close(server->wake_fds[1]);
+    unlink(server->socket_path);
+    g_free(server->socket_path);
+    g_mutex_clear(&server->stats_mutex);
+    g_free(server);
+}
+
+const char* collector_server_get_path(const CollectorServer *server) {
+    return server ? server->socket_path : NULL;
+}
+
+void collector_server_get_stats(CollectorServer *server, CollectorServerStats *stats) {
+    if (!server || !stats) return;
+
+    g_mutex_lock(&server->stats_mutex);
+    *stats = server->stats;
+    g_mutex_unlock(&server->stats_mutex);
+}
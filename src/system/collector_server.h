@@ -0,0 +1,42 @@
+#ifndef COLLECTOR_SERVER_H
+#define COLLECTOR_SERVER_H
+
+#include <glib.h>
+#include "threaded_collector.h"
+#include "collector_protocol.h"
+
+// Headless mode: serves the snapshots of one ThreadedCollector to any number
+// of local clients over a Unix domain socket (framing in collector_protocol.h).
+//
+// OPTIMIZATION: Collection runs once per host instead of once per viewer.
+// Each snapshot is encoded at most once as a FULL and once as a DELTA frame
+// and the same bytes are written to every client. A client that cannot keep
+// up never queues more than the frame it is reading; when it catches up it
+// gets the latest snapshot as a FULL frame instead of the deltas it missed.
+typedef struct CollectorServer CollectorServer;
+
+typedef struct {
+    guint clients;              // Currently connected
+    guint64 accepted;           // Connections accepted since start
+    guint64 rejected;           // Refused (other user, client limit, bad request)
+    guint64 frames_encoded;     // Frames built, shared by all clients
+    guint64 frames_full;        // FULL frames queued to clients
+    guint64 frames_delta;       // DELTA frames queued to clients
+    guint64 bytes_sent;
+} CollectorServerStats;
+
+// Bind socket_path (NULL for collector_socket_default_path()) and start
+// serving collector's snapshots from a background thread. The collector must
+// be collecting continuously and outlive the server; the server installs its
+// publish notification (threaded_collector_set_publish_notify) to wake up.
+// Returns NULL if the socket cannot be created or another server already
+// owns it.
+CollectorServer* collector_server_start(ThreadedCollector *collector, const char *socket_path);
+
+// Disconnect all clients, remove the socket file and free the server
+void collector_server_stop(CollectorServer *server);
+
+const char* collector_server_get_path(const CollectorServer *server);
+void collector_server_get_stats(CollectorServer *server, CollectorServerStats *stats);
+
+#endif // COLLECTOR_SERVER_H
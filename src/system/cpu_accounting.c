@@ -0,0 +1,197 @@
+#include "cpu_accounting.h"
+#include "../utils/rate_store.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define CPU_ACCOUNTING_MAX_CORES 1024
+
+struct CpuAccounting {
+    double ticks_per_second;
+    int cpu_count;
+
+    // Per-process ticks of earlier samples, by (pid, start_time)
+    RateStore *rates;
+    gint64 sample_us;
+
+    // System and per-core counters from the previous update
+    CpuTicks prev_total;
+    CpuTicks *prev_cores;
+    CpuTicks *scratch_cores;        // Parse target for /proc/stat
+    CpuUsage total_usage;
+    CpuUsage *core_usage;
+    int core_count;
+    guint system_updates;
+};
+
+CpuAccounting* cpu_accounting_new(long ticks_per_second, int cpu_count) {
+    CpuAccounting *acct = g_new0(CpuAccounting, 1);
+    acct->ticks_per_second = ticks_per_second > 0 ? (double)ticks_per_second : 100.0;
+    acct->cpu_count = cpu_count > 0 ? cpu_count : 1;
+
+    acct->rates = rate_store_new(0);
+
+    acct->prev_cores = g_new0(CpuTicks, CPU_ACCOUNTING_MAX_CORES);
+    acct->scratch_cores = g_new0(CpuTicks, CPU_ACCOUNTING_MAX_CORES);
+    acct->core_usage = g_new0(CpuUsage, CPU_ACCOUNTING_MAX_CORES);
+    acct->total_usage.idle = 100.0f;
+    return acct;
+}
+
+void cpu_accounting_free(CpuAccounting *acct) {
+    if (!acct) return;
+    rate_store_free(acct->rates);
+    g_free(acct->prev_cores);
+    g_free(acct->scratch_cores);
+    g_free(acct->core_usage);
+    g_free(acct);
+}
+
+// ---- Per-process ----
+
+void cpu_accounting_begin(CpuAccounting *acct, gint64 now_us) {
+    acct->sample_us = now_us;
+}
+
+float cpu_accounting_process(CpuAccounting *acct, int pid, guint64 start_time,
+                             guint64 cpu_ticks, double run_seconds) {
+    // Interval since the previous sample, or the whole run for a newcomer
+    RateDelta delta;
+    double seconds, elapsed;
+    if (rate_store_update(acct->rates, pid, start_time, RATE_COUNTER_CPU_TICKS,
+                          cpu_ticks, acct->sample_us, &delta)) {
+        seconds = delta.increase / acct->ticks_per_second;
+        elapsed = delta.seconds;
+    } else {
+        seconds = cpu_ticks / acct->ticks_per_second;
+        elapsed = run_seconds;
+    }
+    if (elapsed <= 0.0) return 0.0f;
+
+    // Normalized per core like top's summary
+    float cpu = (float)(seconds / elapsed * 100.0 / acct->cpu_count);
+    return cpu > 100.0f ? 100.0f : cpu;
+}
+
+void cpu_accounting_end(CpuAccounting *acct) {
+    rate_store_advance(acct->rates);
+}
+
+// ---- System and per-core ----
+
+// Counters can step backwards (iowait on Linux, hotplugged cores)
+static guint64 tick_delta(guint64 now, guint64 prev) {
+    return now > prev ? now - prev : 0;
+}
+
+static gboolean compute_usage(const CpuTicks *now, const CpuTicks *prev, CpuUsage *usage) {
+    guint64 user = tick_delta(now->user, prev->user) + tick_delta(now->nice, prev->nice);
+    guint64 sys = tick_delta(now->system, prev->system) + tick_delta(now->irq, prev->irq) +
+                  tick_delta(now->softirq, prev->softirq);
+    guint64 idle = tick_delta(now->idle, prev->idle) + tick_delta(now->iowait, prev->iowait);
+    guint64 total = user + sys + idle + tick_delta(now->steal, prev->steal);
+    if (total == 0) return FALSE;
+
+    usage->user = (float)(100.0 * user / total);
+    usage->system = (float)(100.0 * sys / total);
+    usage->idle = (float)(100.0 * idle / total);
+    usage->busy = 100.0f - usage->idle;
+    return TRUE;
+}
+
+gboolean cpu_accounting_update_system(CpuAccounting *acct, const CpuTicks *total,
+                                      const CpuTicks *cores, int core_count) {
+    if (!total) return FALSE;
+
+    // First update: prev is zero, so this is the average since boot
+    gboolean changed = compute_usage(total, &acct->prev_total, &acct->total_usage);
+    acct->prev_total = *total;
+
+    if (!cores) core_count = 0;
+    core_count = MIN(core_count, CPU_ACCOUNTING_MAX_CORES);
+    for (int i = 0; i < core_count; i++) {
+        // A core without new ticks (offline) keeps its last figures
+        if (!compute_usage(&cores[i], &acct->prev_cores[i], &acct->core_usage[i])) continue;
+        acct->prev_cores[i] = cores[i];
+    }
+    acct->core_count = core_count;
+
+    if (changed) acct->system_updates++;
+    return changed;
+}
+
+gboolean cpu_accounting_parse_proc_stat(const char *text, CpuTicks *total,
+                                        CpuTicks *cores, int max_cores, int *core_count) {
+    gboolean have_total = FALSE;
+    int count = 0;
+
+    // The cpu lines come first; stop at the first other line. A buffer cut
+    // off mid-line (hundreds of cores) drops the partial line.
+    for (const char *line = text; line && strncmp(line, "cpu", 3) == 0;) {
+        const char *end = strchr(line, '\n');
+        if (!end) break;
+
+        char *pos;
+        long core = -1;
+        if (line[3] == ' ') {
+            pos = (char *)line + 3;
+        } else {
+            core = strtol(line + 3, &pos, 10);
+            if (pos == line + 3 || core < 0) break;
+        }
+
+        guint64 values[8] = { 0 };
+        int fields = 0;
+        while (fields < 8 && pos < end) {
+            char *next;
+            values[fields] = g_ascii_strtoull(pos, &next, 10);
+            if (next == pos) break;
+            pos = next;
+            fields++;
+        }
+
+        if (fields >= 4) {
+            CpuTicks ticks = { values[0], values[1], values[2], values[3],
+                               values[4], values[5], values[6], values[7] };
+            if (core < 0) {
+                *total = ticks;
+                have_total = TRUE;
+            } else if (cores && core < max_cores) {
+                cores[core] = ticks;
+                if (core + 1 > count) count = (int)core + 1;
+            }
+        }
+        line = end + 1;
+    }
+
+    if (core_count) *core_count = count;
+    return have_total;
+}
+
+gboolean cpu_accounting_update_proc_stat(CpuAccounting *acct, const char *text) {
+    CpuTicks total;
+    int core_count = 0;
+    // Cores missing from the text (offline) keep last time's counters, so
+    // they show no delta
+    if (!text || !cpu_accounting_parse_proc_stat(text, &total, acct->scratch_cores,
+                                                 CPU_ACCOUNTING_MAX_CORES, &core_count)) {
+        return FALSE;
+    }
+    return cpu_accounting_update_system(acct, &total, acct->scratch_cores, core_count);
+}
+
+const CpuUsage* cpu_accounting_system(const CpuAccounting *acct) {
+    return &acct->total_usage;
+}
+
+int cpu_accounting_core_count(const CpuAccounting *acct) {
+    return acct->core_count;
+}
+
+const CpuUsage* cpu_accounting_core(const CpuAccounting *acct, int core) {
+    if (core < 0 || core >= acct->core_count) return NULL;
+    return &acct->core_usage[core];
+}
+
+gboolean cpu_accounting_has_interval(const CpuAccounting *acct) {
+    return acct->system_updates > 1;
+}
@@ -0,0 +1,80 @@
+#ifndef CPU_ACCOUNTING_H
+#define CPU_ACCOUNTING_H
+
+#include <glib.h>
+
+// Delta-based CPU accounting. Callers hand in cumulative counters (process
+// utime+stime, per-core /proc/stat or Mach ticks) whenever they sample; the
+// engine keeps the previous values and turns two consecutive samples into
+// exact interval percentages. Nothing here sleeps or forks.
+//
+// The very first sample has nothing to diff against, so it reports the
+// average since boot (system) or since process start (processes). That is
+// the same figure `ps pcpu` gives, and it lets the first paint show real
+// numbers instead of zeros or waiting a full interval.
+
+// Cumulative CPU time of one core (or all cores), in ticks
+typedef struct {
+    guint64 user;
+    guint64 nice;
+    guint64 system;
+    guint64 idle;
+    guint64 iowait;
+    guint64 irq;
+    guint64 softirq;
+    guint64 steal;
+} CpuTicks;
+
+// Share of the last interval, in percent
+typedef struct {
+    float user;             // user + nice
+    float system;           // system + irq + softirq
+    float idle;             // idle + iowait
+    float busy;             // 100 - idle
+} CpuUsage;
+
+typedef struct CpuAccounting CpuAccounting;
+
+// ticks_per_second: unit of the process counters (clock ticks, or 1e9 for
+// nanoseconds). cpu_count: process percentages are normalized per core.
+CpuAccounting* cpu_accounting_new(long ticks_per_second, int cpu_count);
+void cpu_accounting_free(CpuAccounting *acct);
+
+// ---- Per-process ----
+
+// Start a sample taken at now_us (monotonic clock)
+void cpu_accounting_begin(CpuAccounting *acct, gint64 now_us);
+
+// CPU% of a process since its previous sample. A (pid, start_time) pair
+// not seen before - new process or reused PID - gets its lifetime average
+// over run_seconds.
+float cpu_accounting_process(CpuAccounting *acct, int pid, guint64 start_time,
+                             guint64 cpu_ticks, double run_seconds);
+
+// Finish the sample; processes not reported for RATE_STORE_STALE_CYCLES
+// samples are forgotten
+void cpu_accounting_end(CpuAccounting *acct);
+
+// ---- System and per-core ----
+
+// Update from cumulative counters; cores may be NULL. Returns FALSE if
+// nothing changed since the previous update.
+gboolean cpu_accounting_update_system(CpuAccounting *acct, const CpuTicks *total,
+                                      const CpuTicks *cores, int core_count);
+
+// Update from the text of /proc/stat ("cpu" and "cpuN" lines)
+gboolean cpu_accounting_update_proc_stat(CpuAccounting *acct, const char *text);
+
+// Split /proc/stat into the aggregate and per-core counters. cores[N] is
+// filled from the "cpuN" line; *core_count is the highest N + 1 seen.
+gboolean cpu_accounting_parse_proc_stat(const char *text, CpuTicks *total,
+                                        CpuTicks *cores, int max_cores, int *core_count);
+
+const CpuUsage* cpu_accounting_system(const CpuAccounting *acct);
+int cpu_accounting_core_count(const CpuAccounting *acct);
+const CpuUsage* cpu_accounting_core(const CpuAccounting *acct, int core);
+
+// TRUE once system figures cover an interval rather than the time since boot
+gboolean cpu_accounting_has_interval(const CpuAccounting *acct);
+
+#endif // CPU_ACCOUNTING_H
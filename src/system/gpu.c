@@ -12,64 +12,71 @@ int gpu_check_interval = GPU_CHECK_INTERVAL;
 // Forward declaration
 char* get_gpu_usage_fallback(void);
 
+// The GPU source samples while the process source may read the cache
+static GMutex gpu_cache_mutex;
+
 // OPTIMIZATION: GPU usage with caching and reduced system calls
 char* get_gpu_usage(void) {
     time_t now = time(NULL);
+    char *cached = NULL;
     
     // OPTIMIZATION: Return cached result if still fresh
+    g_mutex_lock(&gpu_cache_mutex);
     if (cached_gpu_result && (now - last_gpu_check) < gpu_check_interval) {
-        return strdup(cached_gpu_result);
-    }
-    
-    // Clear old cache
-    if (cached_gpu_result) {
-        free(cached_gpu_result);
-        cached_gpu_result = NULL;
+        cached = strdup(cached_gpu_result);
     }
+    g_mutex_unlock(&gpu_cache_mutex);
     
-    // If we've already determined powermetrics won't work, use fallback immediately
-    if (powermetrics_unavailable) {
-        cached_gpu_result = get_gpu_usage_fallback();
-        last_gpu_check = now;
-        return strdup(cached_gpu_result);
-    }
-    
-    // Try powermetrics once - if it fails, mark it as unavailable and use fallback
+    return cached ? cached : sample_gpu_usage();
+}
+
+// GPU active residency from powermetrics, NULL if it cannot be read
+static char* sample_powermetrics(void) {
     char *output = get_full_output("powermetrics --samplers gpu_power -n1 -i100 2>/dev/null");
     if (!output || strstr(output, "must be invoked as the superuser") || strlen(output) < 10) {
         if (output) free(output);
-        powermetrics_unavailable = TRUE;  // Mark as unavailable permanently
-        return get_gpu_usage_fallback();
+        return NULL;
     }
 
+    char *result = NULL;
     char *pos = strstr(output, "GPU active residency:");
     if (pos) {
         pos += strlen("GPU active residency:");
         float perc = 0.0;
         if (sscanf(pos, " %f%%", &perc) == 1) {
-            char *result = malloc(20);
+            result = malloc(20);
             sprintf(result, "%.2f%%", perc);
-            free(output);
-            
-            // Cache the result
-            cached_gpu_result = strdup(result);
-            last_gpu_check = now;
-            return result;
         }
     }
-    
     free(output);
-    // If parsing failed, also mark powermetrics as unavailable and use fallback
-    powermetrics_unavailable = TRUE;
-    cached_gpu_result = get_gpu_usage_fallback();
-    last_gpu_check = now;
-    return strdup(cached_gpu_result);
+    return result;
+}
+
+// Fresh GPU measurement; also refreshes the cache get_gpu_usage() serves.
+// The continuous collector calls this on its own GPU period.
+char* sample_gpu_usage(void) {
+    // Try powermetrics once - if it fails, mark it as unavailable permanently
+    // and use the fallback from then on
+    char *result = NULL;
+    if (!g_atomic_int_get(&powermetrics_unavailable)) {
+        result = sample_powermetrics();
+        if (!result) g_atomic_int_set(&powermetrics_unavailable, TRUE);
+    }
+    if (!result) result = get_gpu_usage_fallback();
+    
+    // Cache the result
+    g_mutex_lock(&gpu_cache_mutex);
+    free(cached_gpu_result);
+    cached_gpu_result = strdup(result);
+    last_gpu_check = time(NULL);
+    g_mutex_unlock(&gpu_cache_mutex);
+    return result;
 }
 
 // Fallback GPU usage detection using alternative methods
 char* get_gpu_usage_fallback(void) {
-    static int fallback_call_count = 0;
-    fallback_call_count++;
+    static gint fallback_calls = 0;
+    int fallback_call_count = g_atomic_int_add(&fallback_calls, 1) + 1;
     
     // Method 1: Check WindowServer CPU usage as a GPU activity indicator
     char *ws_output = get_full_output("ps -eo pid,pcpu,comm | grep -E 'WindowServer|kernel_task' | head -2");
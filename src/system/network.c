@@ -6,13 +6,13 @@
 // OPTIMIZATION: Network monitoring with reduced calls and improved parsing
 // Cache network data collection to avoid excessive nettop calls
 time_t last_net_collection = 0;
-GHashTable *net_cache = NULL;
+PidMap *net_cache = NULL;                     // PID -> long long bytes
 
 // Individual network lookup (for specific PID when needed) - Currently unused
 __attribute__((unused)) static long long get_net_bytes_individual(const char *pid) {
     char cmd[100];
     snprintf(cmd, sizeof(cmd), "nettop -p %s -L1", pid);
-    FILE *fp = popen(cmd, "r");
+    FILE *fp = tracked_popen(cmd, "r");
     if (fp == NULL) return 0;
 
     char line[512];
@@ -56,13 +56,38 @@ __attribute__((unused)) static long long get_net_bytes_individual(const char *pi
     return total;
 }
 
-long long get_net_bytes(const char *pid) {
+// One `nettop -P -x` CSV row: time,processname.pid,interface,state,bytes_in,bytes_out,...
+// OPTIMIZATION: Fields are views into the line; header rows fail the PID check
+gboolean parse_nettop_line(StrView line, pid_t *pid, guint64 *total_bytes) {
+    StrView fields[8];
+    if (str_view_split(line, ',', fields, 8) < 6) return FALSE;
+    
+    // PID is after the last dot of "processname.pid" (names may contain dots)
+    StrView process_pid = fields[1];
+    gsize dot = process_pid.len;
+    while (dot > 0 && process_pid.ptr[dot - 1] != '.') dot--;
+    if (dot == 0) return FALSE;
+    
+    StrView pid_view = { process_pid.ptr + dot, process_pid.len - dot };
+    gint64 pid_value;
+    if (!str_view_to_int64(pid_view, &pid_value) || pid_value < 0 || pid_value > G_MAXINT32) return FALSE;
+    
+    gint64 bytes_in = 0, bytes_out = 0;
+    str_view_to_int64(str_view_trim(fields[4]), &bytes_in);
+    str_view_to_int64(str_view_trim(fields[5]), &bytes_out);
+    
+    *pid = (pid_t)pid_value;
+    *total_bytes = (guint64)MAX(bytes_in, 0) + (guint64)MAX(bytes_out, 0);
+    return TRUE;
+}
+
+long long get_net_bytes(pid_t pid) {
     time_t now = time(NULL);
     
     // OPTIMIZATION: Use cached network data if collected recently (within 1 second)
     if (net_cache && (now - last_net_collection) < NETWORK_CACHE_INTERVAL) {
-        gpointer value = g_hash_table_lookup(net_cache, pid);
-        return value ? *(long long*)value : 0;
+        long long *value = pid_map_lookup(net_cache, pid);
+        return value ? *value : 0;
     }
     
     // Return 0 if no cached data available
@@ -72,13 +97,13 @@ long long get_net_bytes(const char *pid) {
 // OPTIMIZATION: Collect network data for all processes in one nettop call
 void collect_all_network_data(void) {
     if (!net_cache) {
-        net_cache = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_free);
+        net_cache = pid_map_new(sizeof(long long), 0);
     } else {
-        g_hash_table_remove_all(net_cache);  // Clear old data
+        pid_map_clear(net_cache);  // Clear old data, keep the storage
     }
     
     // Single nettop call for all processes (much more efficient)
-    FILE *fp = popen("nettop -L1 -P", "r");
+    FILE *fp = tracked_popen("nettop -L1 -P", "r");
     if (fp == NULL) return;
 
     char line[512];
@@ -92,36 +117,14 @@ void collect_all_network_data(void) {
         
         if (strlen(line) < 10) continue;
         
-        // OPTIMIZATION: Fast CSV parsing with direct pointer manipulation
-        char *pos = line;
-        char *fields[8];  // We need at least 6 fields
-        int field_count = 0;
-        
-        // Parse CSV fields
-        while (*pos && field_count < 8) {
-            fields[field_count] = pos;
-            
-            // Find next comma or end
-            while (*pos && *pos != ',') pos++;
-            if (*pos) {
-                *pos = '\0';  // Null terminate field
-                pos++;
-            }
-            field_count++;
-        }
+        // PID from "processname.pid", the same rows the collector parses
+        StrView view = { line, strcspn(line, "\r\n") };
+        pid_t pid;
+        guint64 total;
+        if (!parse_nettop_line(view, &pid, &total)) continue;
         
-        if (field_count >= 6) {
-            // PID is field 0, bytes_in is field 4, bytes_out is field 5
-            char *pid_str = fields[0];
-            long long bytes_in = atoll(fields[4]);
-            long long bytes_out = atoll(fields[5]);
-            long long total = bytes_in + bytes_out;
-            
-            if (total > 0) {  // Only cache processes with network activity
-                long long *cache_value = malloc(sizeof(long long));
-                *cache_value = total;
-                g_hash_table_insert(net_cache, g_strdup(pid_str), cache_value);
-            }
+        if (total > 0) {  // Only cache processes with network activity
+            *(long long*)pid_map_insert(net_cache, pid) = (long long)total;
         }
     }
     pclose(fp);
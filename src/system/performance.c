@@ -5,12 +5,12 @@
 #include <unistd.h>
 #include <time.h>
 #include <math.h>
-#include <mach/mach.h>
 
 // Cache durations (in seconds)
 #define CPU_CACHE_DURATION 1    // Update CPU every second for accuracy
 #define MEMORY_CACHE_DURATION 2 // Memory can be cached for 2 seconds
 #define PROCESS_BUFFER_SIZE (2 * 1024 * 1024)  // 2MB buffer
+#define MAX_SAMPLED_CORES 256
 
 // Global system cache
 static SystemCache g_system_cache = {0};
@@ -20,6 +20,7 @@ static int cache_initialized = 0;
 int init_system_cache(SystemCache *cache) {
     if (!cache) return -1;
     
+#ifdef __APPLE__
     // Get total memory (only needs to be read once)
     size_t size = sizeof(cache->total_memory);
     if (sysctlbyname("hw.memsize", &cache->total_memory, &size, NULL, 0) != 0) {
@@ -32,6 +33,10 @@ int init_system_cache(SystemCache *cache) {
     if (sysctlbyname("hw.ncpu", &cache->cpu_count, &size, NULL, 0) != 0) {
         cache->cpu_count = 1;
     }
+#else
+    // No Mach host statistics here; the proc backend reports system usage
+    return -1;
+#endif
     
     // Get page size (only needs to be read once)
     cache->page_size = getpagesize();
@@ -47,55 +52,75 @@ int init_system_cache(SystemCache *cache) {
     cache->last_cpu_update = 0;
     cache->last_memory_update = 0;
     
-    // Initialize CPU stats
-    memset(&cache->prev_cpu_info, 0, sizeof(cache->prev_cpu_info));
-    memset(&cache->curr_cpu_info, 0, sizeof(cache->curr_cpu_info));
+    // Only system ticks go through here, so the process tick unit is unused
+    cache->cpu_accounting = cpu_accounting_new(1, cache->cpu_count);
     
     return 0;
 }
 
-// Fast CPU usage calculation using Mach system calls
+#ifdef __APPLE__
+// Feed the per-core Mach tick counters to the accounting engine
+static int sample_processor_ticks(SystemCache *cache) {
+    natural_t processor_count = 0;
+    processor_info_array_t info = NULL;
+    mach_msg_type_number_t info_count = 0;
+    if (host_processor_info(mach_host_self(), PROCESSOR_CPU_LOAD_INFO, &processor_count,
+                            &info, &info_count) != KERN_SUCCESS) {
+        return -1;
+    }
+    
+    processor_cpu_load_info_t load = (processor_cpu_load_info_t)info;
+    CpuTicks cores[MAX_SAMPLED_CORES];
+    CpuTicks total = {0};
+    int core_count = (int)MIN(processor_count, (natural_t)MAX_SAMPLED_CORES);
+    
+    for (int i = 0; i < core_count; i++) {
+        memset(&cores[i], 0, sizeof(cores[i]));
+        cores[i].user = load[i].cpu_ticks[CPU_STATE_USER];
+        cores[i].nice = load[i].cpu_ticks[CPU_STATE_NICE];
+        cores[i].system = load[i].cpu_ticks[CPU_STATE_SYSTEM];
+        cores[i].idle = load[i].cpu_ticks[CPU_STATE_IDLE];
+        
+        total.user += cores[i].user;
+        total.nice += cores[i].nice;
+        total.system += cores[i].system;
+        total.idle += cores[i].idle;
+    }
+    vm_deallocate(mach_task_self(), (vm_address_t)info, info_count * sizeof(integer_t));
+    
+    cpu_accounting_update_system(cache->cpu_accounting, &total, cores, core_count);
+    return 0;
+}
+#endif
+
+// Fast CPU usage calculation using Mach system calls. Never blocks: the
+// first call reports the average since boot, later calls the delta since
+// the previous one.
 int update_cpu_stats_fast(SystemCache *cache) {
     if (!cache) return -1;
+#ifndef __APPLE__
+    return -1;
+#else
     
     time_t now = time(NULL);
-    if (now - cache->last_cpu_update < CPU_CACHE_DURATION) {
+    if (cache->last_cpu_update > 0 && now - cache->last_cpu_update < CPU_CACHE_DURATION) {
         return 0; // Use cached value
     }
     
-    // Move current stats to previous
-    cache->prev_cpu_info = cache->curr_cpu_info;
-    
-    // Get current CPU statistics
-    mach_msg_type_number_t count = HOST_CPU_LOAD_INFO_COUNT;
-    host_statistics(mach_host_self(), HOST_CPU_LOAD_INFO,
-                   (host_info_t)&cache->curr_cpu_info, &count);
-    
-    // Calculate CPU usage if we have previous data
-    if (cache->last_cpu_update > 0) {
-        unsigned int user_diff = cache->curr_cpu_info.cpu_ticks[CPU_STATE_USER] - 
-                               cache->prev_cpu_info.cpu_ticks[CPU_STATE_USER];
-        unsigned int system_diff = cache->curr_cpu_info.cpu_ticks[CPU_STATE_SYSTEM] - 
-                                 cache->prev_cpu_info.cpu_ticks[CPU_STATE_SYSTEM];
-        unsigned int idle_diff = cache->curr_cpu_info.cpu_ticks[CPU_STATE_IDLE] - 
-                               cache->prev_cpu_info.cpu_ticks[CPU_STATE_IDLE];
-        unsigned int nice_diff = cache->curr_cpu_info.cpu_ticks[CPU_STATE_NICE] - 
-                               cache->prev_cpu_info.cpu_ticks[CPU_STATE_NICE];
-        
-        unsigned int total_diff = user_diff + system_diff + idle_diff + nice_diff;
-        
-        if (total_diff > 0) {
-            cache->cpu_usage = ((double)(user_diff + system_diff + nice_diff) / total_diff) * 100.0;
-        }
-    }
+    if (sample_processor_ticks(cache) != 0) return -1;
     
+    cache->cpu_usage = cpu_accounting_system(cache->cpu_accounting)->busy;
     cache->last_cpu_update = now;
     return 0;
+#endif
 }
 
 // Fast memory usage calculation using direct VM calls
 int update_memory_stats_fast(SystemCache *cache) {
     if (!cache) return -1;
+#ifndef __APPLE__
+    return -1;
+#else
     
     time_t now = time(NULL);
     if (now - cache->last_memory_update < MEMORY_CACHE_DURATION) {
@@ -121,22 +146,13 @@ int update_memory_stats_fast(SystemCache *cache) {
     
     cache->last_memory_update = now;
     return 0;
+#endif
 }
 
 // Get cached CPU percentage (fast)
 double calculate_cpu_percentage_fast(const SystemCache *cache) {
     if (!cache || cache->last_cpu_update == 0) {
-        // Fallback to quick calculation if cache is empty
-        FILE *fp = popen("top -l 1 -n 0 | awk '/CPU usage:/ {print 100-$(NF-1)}'", "r");
-        if (fp) {
-            char buffer[32];
-            if (fgets(buffer, sizeof(buffer), fp)) {
-                pclose(fp);
-                return atof(buffer);
-            }
-            pclose(fp);
-        }
-        return 0.0;
+        return -1.0;  // Not sampled (no Mach statistics); caller falls back
     }
     
     return cache->cpu_usage;
@@ -248,7 +264,7 @@ int get_process_list_fast(SystemCache *cache) {
     cache->buffer_used = 0;
     
     // Use single top command for all process data
-    FILE *fp = popen("top -l 1 -o cpu -stats pid,command,cpu,mem,time", "r");
+    FILE *fp = tracked_popen("top -l 1 -o cpu -stats pid,command,cpu,mem,time", "r");
     if (!fp) return -1;
     
     char line[1024];
@@ -265,7 +281,7 @@ int get_process_list_fast(SystemCache *cache) {
 }
 
 // Fast process line parsing (optimized for speed)
-int parse_process_line_fast(const char *line, Process *proc) {
+int parse_process_line_fast(const char *line, ProcessSample *proc) {
     if (!line || !proc) return -1;
     
     // Fast parsing using pointer arithmetic instead of strtok
@@ -277,7 +293,7 @@ int parse_process_line_fast(const char *line, Process *proc) {
     // Parse PID (first field)
     long pid;
     if (fast_string_to_long(ptr, &pid) != 0) return -1;
-    snprintf(proc->pid, sizeof(proc->pid), "%ld", pid);
+    proc->pid = (pid_t)pid;
     
     // Move to next field
     while (*ptr && *ptr != ' ' && *ptr != '\t') ptr++;
@@ -286,16 +302,13 @@ int parse_process_line_fast(const char *line, Process *proc) {
     // Parse command name (second field)
     const char *cmd_start = ptr;
     while (*ptr && *ptr != ' ' && *ptr != '\t') ptr++;
-    size_t cmd_len = ptr - cmd_start;
-    if (cmd_len >= sizeof(proc->name)) cmd_len = sizeof(proc->name) - 1;
-    memcpy(proc->name, cmd_start, cmd_len);
-    proc->name[cmd_len] = '\0';
+    process_set_name(proc, cmd_start, ptr - cmd_start);
     
     // Parse CPU percentage (third field)
     while (*ptr == ' ' || *ptr == '\t') ptr++;
     double cpu_val;
     if (fast_string_to_double(ptr, &cpu_val) == 0) {
-        snprintf(proc->cpu, sizeof(proc->cpu), "%.1f%%", cpu_val);
+        proc->cpu = (float)cpu_val;
     }
     
     return 0;
@@ -325,7 +338,7 @@ int update_process_stats_batch(GList **processes, SystemCache *cache) {
     while ((line_end = strchr(line_start, '\n')) != NULL && process_count < MAX_PROCESSES) {
         *line_end = '\0'; // Temporarily null-terminate
         
-        Process *proc = get_process_from_pool_fast();
+        ProcessSample *proc = get_process_from_pool_fast();
         if (proc && parse_process_line_fast(line_start, proc) == 0) {
             *processes = g_list_prepend(*processes, proc);
             process_count++;
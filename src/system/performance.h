@@ -4,14 +4,17 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <sys/sysctl.h>
 #include <sys/types.h>
+#ifdef __APPLE__
+#include <sys/sysctl.h>
 #include <mach/mach.h>
 #include <mach/processor_info.h>
 #include <mach/mach_host.h>
 #include <mach/vm_map.h>
+#endif
 #include <glib.h>
 #include "../common/types.h"
+#include "cpu_accounting.h"
 
 // Performance-optimized system data collection
 typedef struct {
@@ -26,15 +29,18 @@ typedef struct {
     time_t last_cpu_update;
     time_t last_memory_update;
     
+    // Previous per-core tick counters; usage is the delta between samples
+    CpuAccounting *cpu_accounting;
+    
     // High-performance buffers
     char *process_buffer;
     size_t buffer_size;
     size_t buffer_used;
     
-    // System statistics cache
-    host_cpu_load_info_data_t prev_cpu_info;
-    host_cpu_load_info_data_t curr_cpu_info;
+#ifdef __APPLE__
+    // System statistics cache (Mach host statistics)
     vm_statistics64_data_t vm_stats;
+#endif
     
 } SystemCache;
 
@@ -45,8 +51,8 @@ int update_memory_stats_fast(SystemCache *cache);
 int get_process_list_fast(SystemCache *cache);
 
 // Optimized parsing functions
-int parse_process_line_fast(const char *line, Process *proc);
-double calculate_cpu_percentage_fast(const SystemCache *cache);
+int parse_process_line_fast(const char *line, ProcessSample *proc);
+double calculate_cpu_percentage_fast(const SystemCache *cache);  // -1 before the first sample
 double calculate_memory_percentage_fast(const SystemCache *cache);
 
 // Memory-efficient string operations
@@ -59,7 +65,7 @@ int collect_all_system_stats(SystemCache *cache);
 int update_process_stats_batch(GList **processes, SystemCache *cache);
 
 // Public fast interface functions
-double get_system_cpu_usage_fast(void);
+double get_system_cpu_usage_fast(void);     // -1 if unavailable on this platform
 double get_system_memory_usage_fast(void);
 
 #endif // PERFORMANCE_H
@@ -0,0 +1,508 @@
+#define _GNU_SOURCE
+#include "proc_reader.h"
+
+#ifdef __linux__
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+
+// io_uring is driven through the raw syscalls so there is no liburing
+// dependency; without the kernel header only the pread path is built
+#if defined(__has_include)
+#if __has_include(<linux/io_uring.h>) && defined(__NR_io_uring_setup)
+#include <linux/io_uring.h>
+#define PROC_READER_HAVE_URING 1
+#endif
+#endif
+
+#define PROC_FD_RESERVE 256             // Descriptors left for everything else
+#define PROC_FD_LIMIT 65536             // Most descriptors planned for, whatever the limit
+
+struct ProcFileCache {
+    int proc_fd;
+    GHashTable *files;                  // pid -> ProcPidFiles*
+    guint generation;
+    gint cached;                        // Entries holding open fds between cycles
+    gint budget;                        // Maximum for cached (from the soft RLIMIT_NOFILE)
+    guint64 syscalls;
+};
+
+#ifdef PROC_READER_HAVE_URING
+typedef struct {
+    int fd;
+    unsigned *sq_tail;
+    unsigned *sq_mask;
+    unsigned *sq_array;
+    unsigned *cq_head;
+    unsigned *cq_tail;
+    unsigned *cq_mask;
+    struct io_uring_sqe *sqes;
+    struct io_uring_cqe *cqes;
+    void *sq_map;
+    size_t sq_map_size;
+    void *cq_map;                       // Same mapping as sq_map with IORING_FEAT_SINGLE_MMAP
+    size_t cq_map_size;
+    size_t sqes_size;
+} ProcRing;
+#endif
+
+struct ProcReader {
+    ProcFileCache *cache;
+    ProcIoMode mode;
+    guint64 syscalls;
+
+    // Results of the last proc_reader_read(); NULL entries failed
+    const char *stat[PROC_READER_BATCH];
+    const char *statm[PROC_READER_BATCH];
+    char (*stat_buf)[PROC_READER_STAT_SIZE];
+    char (*statm_buf)[PROC_READER_STATM_SIZE];
+    gboolean transient[PROC_READER_BATCH];  // Opened for this read only (over budget)
+
+#ifdef PROC_READER_HAVE_URING
+    ProcRing ring;
+    gpointer ring_stat_buf;             // Buffers of reads the failed ring never
+    gpointer ring_statm_buf;            // completed; freed after the ring is closed
+#endif
+};
+
+// ============================================================================
+// FILE CACHE
+// ============================================================================
+
+static void close_files(ProcPidFiles *files) {
+    if (files->stat_fd >= 0) close(files->stat_fd);
+    if (files->statm_fd >= 0) close(files->statm_fd);
+    files->stat_fd = -1;
+    files->statm_fd = -1;
+}
+
+// Descriptors we may keep open within the current soft limit, less a reserve.
+// The limit is left alone: it is per process and inherited by every child
+// command_runner spawns. Processes over the budget are opened per read.
+static gint compute_fd_budget(void) {
+    struct rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) != 0) return 0;
+
+    rlim_t usable = limit.rlim_cur == RLIM_INFINITY ? PROC_FD_LIMIT : MIN(limit.rlim_cur, (rlim_t)PROC_FD_LIMIT);
+    if (usable <= PROC_FD_RESERVE) return 0;
+    return (gint)((usable - PROC_FD_RESERVE) / 2);  // Two files per process
+}
+
+ProcFileCache* proc_file_cache_new(int proc_fd) {
+    ProcFileCache *cache = g_new0(ProcFileCache, 1);
+    cache->proc_fd = proc_fd;
+    cache->files = g_hash_table_new_full(g_direct_hash, g_direct_equal, NULL, g_free);
+    cache->budget = compute_fd_budget();
+    return cache;
+}
+
+void proc_file_cache_free(ProcFileCache *cache) {
+    if (!cache) return;
+
+    GHashTableIter iter;
+    gpointer value;
+    g_hash_table_iter_init(&iter, cache->files);
+    while (g_hash_table_iter_next(&iter, NULL, &value)) {
+        close_files(value);
+    }
+    g_hash_table_destroy(cache->files);
+    g_free(cache);
+}
+
+void proc_file_cache_begin(ProcFileCache *cache) {
+    cache->generation++;
+}
+
+ProcPidFiles* proc_file_cache_get(ProcFileCache *cache, int pid) {
+    ProcPidFiles *files = g_hash_table_lookup(cache->files, GINT_TO_POINTER(pid));
+    if (!files) {
+        files = g_new0(ProcPidFiles, 1);
+        files->pid = pid;
+        files->stat_fd = -1;
+        files->statm_fd = -1;
+        files->uid = -1;
+        g_hash_table_insert(cache->files, GINT_TO_POINTER(pid), files);
+    }
+    files->generation = cache->generation;
+    return files;
+}
+
+static gboolean sweep_entry(gpointer key, gpointer value, gpointer user_data) {
+    (void)key;
+    ProcFileCache *cache = user_data;
+    ProcPidFiles *files = value;
+    if (files->generation == cache->generation) return FALSE;
+
+    if (files->stat_fd >= 0) cache->syscalls += 2;
+    if (files->cached) g_atomic_int_add(&cache->cached, -1);
+    close_files(files);
+    return TRUE;
+}
+
+guint proc_file_cache_sweep(ProcFileCache *cache) {
+    return g_hash_table_foreach_remove(cache->files, sweep_entry, cache);
+}
+
+guint proc_file_cache_size(const ProcFileCache *cache) {
+    return g_hash_table_size(cache->files);
+}
+
+guint64 proc_file_cache_take_syscalls(ProcFileCache *cache) {
+    guint64 syscalls = cache->syscalls;
+    cache->syscalls = 0;
+    return syscalls;
+}
+
+// ============================================================================
+// IO_URING
+// ============================================================================
+
+#ifdef PROC_READER_HAVE_URING
+
+static void ring_close(ProcRing *ring) {
+    if (ring->sqes) munmap(ring->sqes, ring->sqes_size);
+    if (ring->cq_map && ring->cq_map != ring->sq_map) munmap(ring->cq_map, ring->cq_map_size);
+    if (ring->sq_map) munmap(ring->sq_map, ring->sq_map_size);
+    if (ring->fd >= 0) close(ring->fd);
+    memset(ring, 0, sizeof(*ring));
+    ring->fd = -1;
+}
+
+// IORING_OP_READ needs Linux 5.6; the probe interface arrived in the same release
+static gboolean ring_supports_read(int fd) {
+    size_t size = sizeof(struct io_uring_probe) + 256 * sizeof(struct io_uring_probe_op);
+    struct io_uring_probe *probe = g_malloc0(size);
+    gboolean ok = syscall(__NR_io_uring_register, fd, IORING_REGISTER_PROBE, probe, 256) == 0 &&
+                  probe->last_op >= IORING_OP_READ &&
+                  (probe->ops[IORING_OP_READ].flags & IO_URING_OP_SUPPORTED);
+    g_free(probe);
+    return ok;
+}
+
+static gboolean ring_open(ProcRing *ring, unsigned entries) {
+    memset(ring, 0, sizeof(*ring));
+    ring->fd = -1;
+
+    struct io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    int fd = (int)syscall(__NR_io_uring_setup, entries, &params);
+    if (fd < 0) return FALSE;  // ENOSYS, or EPERM under seccomp / io_uring_disabled
+    ring->fd = fd;
+
+    if (!ring_supports_read(fd)) {
+        ring_close(ring);
+        return FALSE;
+    }
+
+    ring->sq_map_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    ring->cq_map_size = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        ring->sq_map_size = ring->cq_map_size = MAX(ring->sq_map_size, ring->cq_map_size);
+    }
+
+    ring->sq_map = mmap(NULL, ring->sq_map_size, PROT_READ | PROT_WRITE,
+                        MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+    if (ring->sq_map == MAP_FAILED) {
+        ring->sq_map = NULL;
+        ring_close(ring);
+        return FALSE;
+    }
+
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        ring->cq_map = ring->sq_map;
+    } else {
+        ring->cq_map = mmap(NULL, ring->cq_map_size, PROT_READ | PROT_WRITE,
+                            MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+        if (ring->cq_map == MAP_FAILED) {
+            ring->cq_map = NULL;
+            ring_close(ring);
+            return FALSE;
+        }
+    }
+
+    ring->sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+    ring->sqes = mmap(NULL, ring->sqes_size, PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+    if (ring->sqes == MAP_FAILED) {
+        ring->sqes = NULL;
+        ring_close(ring);
+        return FALSE;
+    }
+
+    char *sq = ring->sq_map;
+    char *cq = ring->cq_map;
+    ring->sq_tail = (unsigned*)(sq + params.sq_off.tail);
+    ring->sq_mask = (unsigned*)(sq + params.sq_off.ring_mask);
+    ring->sq_array = (unsigned*)(sq + params.sq_off.array);
+    ring->cq_head = (unsigned*)(cq + params.cq_off.head);
+    ring->cq_tail = (unsigned*)(cq + params.cq_off.tail);
+    ring->cq_mask = (unsigned*)(cq + params.cq_off.ring_mask);
+    ring->cqes = (struct io_uring_cqe*)(cq + params.cq_off.cqes);
+    return TRUE;
+}
+
+static void ring_queue_read(ProcRing *ring, unsigned *tail, int fd, char *buf, size_t size, guint64 tag) {
+    unsigned index = *tail & *ring->sq_mask;
+    struct io_uring_sqe *sqe = &ring->sqes[index];
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = IORING_OP_READ;
+    sqe->fd = fd;
+    sqe->addr = (guint64)(uintptr_t)buf;
+    sqe->len = (unsigned)(size - 1);
+    sqe->off = 0;
+    sqe->user_data = tag;
+    ring->sq_array[index] = index;
+    (*tail)++;
+}
+
+// Wait for the reads the kernel has taken but not completed. FALSE if they
+// cannot be accounted for; their buffers may then still be written.
+static gboolean ring_reap(ProcReader *reader, guint in_flight) {
+    ProcRing *ring = &reader->ring;
+    while (in_flight > 0) {
+        long ret = syscall(__NR_io_uring_enter, ring->fd, 0, in_flight, IORING_ENTER_GETEVENTS, NULL, 0);
+        reader->syscalls++;
+        if (ret < 0 && errno != EINTR) return FALSE;
+
+        unsigned head = *ring->cq_head;
+        unsigned cq_tail = __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE);
+        in_flight -= MIN(in_flight, cq_tail - head);
+        __atomic_store_n(ring->cq_head, cq_tail, __ATOMIC_RELEASE);
+    }
+    return TRUE;
+}
+
+// Give up on the ring. Reads still in flight complete into the old buffers,
+// which stay allocated until the ring is closed; pread() gets fresh ones.
+static void ring_abandon(ProcReader *reader, guint in_flight) {
+    reader->mode = PROC_IO_PREAD;
+    if (ring_reap(reader, in_flight)) return;
+
+    reader->ring_stat_buf = reader->stat_buf;
+    reader->ring_statm_buf = reader->statm_buf;
+    reader->stat_buf = g_malloc(PROC_READER_BATCH * PROC_READER_STAT_SIZE);
+    reader->statm_buf = g_malloc(PROC_READER_BATCH * PROC_READER_STATM_SIZE);
+}
+
+// Read every open file of the batch with one submission. FALSE if the ring
+// failed and was abandoned; the caller then redoes the batch with pread().
+static gboolean uring_read_batch(ProcReader *reader, ProcPidFiles **files, guint count) {
+    ProcRing *ring = &reader->ring;
+    unsigned tail = *ring->sq_tail;  // Only this thread produces
+    guint queued = 0;
+
+    for (guint i = 0; i < count; i++) {
+        if (files[i]->stat_fd < 0) continue;
+        ring_queue_read(ring, &tail, files[i]->stat_fd, reader->stat_buf[i],
+                        PROC_READER_STAT_SIZE, (guint64)i * 2);
+        ring_queue_read(ring, &tail, files[i]->statm_fd, reader->statm_buf[i],
+                        PROC_READER_STATM_SIZE, (guint64)i * 2 + 1);
+        queued += 2;
+    }
+    if (queued == 0) return TRUE;
+    __atomic_store_n(ring->sq_tail, tail, __ATOMIC_RELEASE);
+
+    guint submitted = 0, completed = 0;
+    while (completed < queued) {
+        long ret = syscall(__NR_io_uring_enter, ring->fd, queued - submitted, queued - completed,
+                           IORING_ENTER_GETEVENTS, NULL, 0);
+        reader->syscalls++;
+        if (ret < 0) {
+            if (errno == EINTR) continue;
+            ring_abandon(reader, submitted - completed);
+            return FALSE;
+        }
+        submitted += (guint)ret;
+
+        unsigned head = *ring->cq_head;
+        unsigned cq_tail = __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE);
+        for (; head != cq_tail; head++) {
+            const struct io_uring_cqe *cqe = &ring->cqes[head & *ring->cq_mask];
+            guint i = (guint)(cqe->user_data / 2);
+            gboolean is_statm = cqe->user_data & 1;
+            char *buf = is_statm ? reader->statm_buf[i] : reader->stat_buf[i];
+            const char **result = is_statm ? &reader->statm[i] : &reader->stat[i];
+
+            // -ESRCH / 0 bytes: the process exited since the files were opened
+            if (cqe->res > 0) {
+                buf[cqe->res] = '\0';
+                *result = buf;
+            }
+            completed++;
+        }
+        __atomic_store_n(ring->cq_head, head, __ATOMIC_RELEASE);
+    }
+    return TRUE;
+}
+
+#endif // PROC_READER_HAVE_URING
+
+gboolean proc_io_uring_available(void) {
+#ifdef PROC_READER_HAVE_URING
+    static gint available = -1;  // Probed once per process
+    if (g_atomic_int_get(&available) < 0) {
+        ProcRing ring;
+        gboolean ok = ring_open(&ring, 2);
+        if (ok) ring_close(&ring);
+        g_atomic_int_set(&available, ok ? 1 : 0);
+    }
+    return g_atomic_int_get(&available) == 1;
+#else
+    return FALSE;
+#endif
+}
+
+const char* proc_io_mode_name(ProcIoMode mode) {
+    return mode == PROC_IO_URING ? "io_uring" : "pread";
+}
+
+// ============================================================================
+// READER
+// ============================================================================
+
+ProcReader* proc_reader_new(ProcFileCache *cache, ProcIoMode mode) {
+    ProcReader *reader = g_new0(ProcReader, 1);
+    reader->cache = cache;
+    reader->mode = PROC_IO_PREAD;
+    reader->stat_buf = g_malloc(PROC_READER_BATCH * PROC_READER_STAT_SIZE);
+    reader->statm_buf = g_malloc(PROC_READER_BATCH * PROC_READER_STATM_SIZE);
+
+#ifdef PROC_READER_HAVE_URING
+    reader->ring.fd = -1;
+    if (mode == PROC_IO_URING && ring_open(&reader->ring, PROC_READER_BATCH * 2)) {
+        reader->mode = PROC_IO_URING;
+    }
+#else
+    (void)mode;
+#endif
+    return reader;
+}
+
+void proc_reader_free(ProcReader *reader) {
+    if (!reader) return;
+#ifdef PROC_READER_HAVE_URING
+    if (reader->ring.fd >= 0) ring_close(&reader->ring);
+    g_free(reader->ring_stat_buf);
+    g_free(reader->ring_statm_buf);
+#endif
+    g_free(reader->stat_buf);
+    g_free(reader->statm_buf);
+    g_free(reader);
+}
+
+ProcIoMode proc_reader_mode(const ProcReader *reader) {
+    return reader->mode;
+}
+
+// First read of a process: open both files and note their owner (the
+// process's effective UID). Over the fd budget they are closed again after
+// this read.
+static gboolean open_files(ProcReader *reader, ProcPidFiles *files, guint index) {
+    ProcFileCache *cache = reader->cache;
+    char path[32];
+
+    snprintf(path, sizeof(path), "%d/stat", files->pid);
+    files->stat_fd = openat(cache->proc_fd, path, O_RDONLY | O_CLOEXEC);
+    snprintf(path, sizeof(path), "%d/statm", files->pid);
+    files->statm_fd = openat(cache->proc_fd, path, O_RDONLY | O_CLOEXEC);
+    reader->syscalls += 2;
+
+    struct stat st;
+    gboolean ok = files->stat_fd >= 0 && files->statm_fd >= 0;
+    if (ok) {
+        ok = fstat(files->stat_fd, &st) == 0;
+        reader->syscalls++;
+    }
+    if (!ok) {
+        reader->syscalls += (files->stat_fd >= 0) + (files->statm_fd >= 0);
+        close_files(files);
+        return FALSE;  // Process exited between listing and open
+    }
+    files->uid = (int)st.st_uid;
+
+    if (g_atomic_int_add(&cache->cached, 1) < cache->budget) {
+        files->cached = TRUE;
+    } else {
+        g_atomic_int_add(&cache->cached, -1);
+        reader->transient[index] = TRUE;
+    }
+    return TRUE;
+}
+
+static void release_files(ProcReader *reader, ProcPidFiles *files) {
+    if (files->stat_fd < 0) return;
+    reader->syscalls += 2;
+    if (files->cached) g_atomic_int_add(&reader->cache->cached, -1);
+    files->cached = FALSE;
+    close_files(files);
+}
+
+static void pread_batch(ProcReader *reader, ProcPidFiles **files, guint count) {
+    for (guint i = 0; i < count; i++) {
+        if (files[i]->stat_fd < 0) continue;
+
+        ssize_t n = pread(files[i]->stat_fd, reader->stat_buf[i], PROC_READER_STAT_SIZE - 1, 0);
+        reader->syscalls++;
+        if (n <= 0) continue;  // ESRCH: exited
+        reader->stat_buf[i][n] = '\0';
+        reader->stat[i] = reader->stat_buf[i];
+
+        n = pread(files[i]->statm_fd, reader->statm_buf[i], PROC_READER_STATM_SIZE - 1, 0);
+        reader->syscalls++;
+        if (n <= 0) continue;
+        reader->statm_buf[i][n] = '\0';
+        reader->statm[i] = reader->statm_buf[i];
+    }
+}
+
+void proc_reader_read(ProcReader *reader, ProcPidFiles **files, guint count) {
+    count = MIN(count, PROC_READER_BATCH);
+    for (guint i = 0; i < count; i++) {
+        reader->stat[i] = NULL;
+        reader->statm[i] = NULL;
+        reader->transient[i] = FALSE;
+        if (files[i]->stat_fd < 0) open_files(reader, files[i], i);
+    }
+
+#ifdef PROC_READER_HAVE_URING
+    if (reader->mode == PROC_IO_URING && !uring_read_batch(reader, files, count)) {
+        // Keep the ring mapped until the reader is freed so that late
+        // completions cannot land in unmapped memory
+        for (guint i = 0; i < count; i++) reader->stat[i] = reader->statm[i] = NULL;
+    }
+#endif
+    if (reader->mode == PROC_IO_PREAD) {
+        pread_batch(reader, files, count);
+    }
+
+    // A PID whose files stopped reading has exited (or been reused); the
+    // next cycle opens the new process's files if it is listed again
+    for (guint i = 0; i < count; i++) {
+        if (reader->transient[i] || (files[i]->stat_fd >= 0 && (!reader->stat[i] || !reader->statm[i]))) {
+            release_files(reader, files[i]);
+        }
+    }
+}
+
+const char* proc_reader_stat(const ProcReader *reader, guint index) {
+    return index < PROC_READER_BATCH ? reader->stat[index] : NULL;
+}
+
+const char* proc_reader_statm(const ProcReader *reader, guint index) {
+    return index < PROC_READER_BATCH ? reader->statm[index] : NULL;
+}
+
+guint64 proc_reader_take_syscalls(ProcReader *reader) {
+    guint64 syscalls = reader->syscalls;
+    reader->syscalls = 0;
+    return syscalls;
+}
+
+#endif // __linux__
@@ -0,0 +1,73 @@
+#ifndef PROC_READER_H
+#define PROC_READER_H
+
+#include <glib.h>
+
+// Batched reader for /proc/[pid]/stat and /proc/[pid]/statm (Linux only).
+//
+// The files of every listed PID stay open from one cycle to the next and
+// are re-read at offset 0, so a steady-state cycle costs no openat()/close()
+// at all. The reads themselves go either through io_uring - one
+// io_uring_enter() per PROC_READER_BATCH processes - or through one pread()
+// per file when io_uring is unavailable (old kernel, seccomp, headers).
+//
+// A ProcFileCache is shared by all scan threads and owns the open files; each
+// thread reads through its own ProcReader (ring and buffers).
+
+#define PROC_READER_BATCH 128           // Processes per io_uring submission
+#define PROC_READER_STAT_SIZE 1024      // /proc/[pid]/stat is at most ~700 bytes
+#define PROC_READER_STATM_SIZE 256
+
+typedef enum {
+    PROC_IO_PREAD,                      // One pread() per file
+    PROC_IO_URING                       // Batched IORING_OP_READ
+} ProcIoMode;
+
+// Open files of one process. Owned by the cache; a scan thread has exclusive
+// use of the entries it was handed for the cycle.
+typedef struct {
+    int pid;
+    int stat_fd;                        // -1 until opened
+    int statm_fd;
+    int uid;                            // Owner of the files, read when they are opened
+    gboolean cached;                    // Kept open between cycles (within the fd budget)
+    guint generation;                   // Last cycle the PID was listed
+} ProcPidFiles;
+
+typedef struct ProcFileCache ProcFileCache;
+
+// proc_fd is borrowed and must outlive the cache
+ProcFileCache* proc_file_cache_new(int proc_fd);
+void proc_file_cache_free(ProcFileCache *cache);
+
+// Start a listing cycle; then look up every listed PID and sweep the rest
+void proc_file_cache_begin(ProcFileCache *cache);
+ProcPidFiles* proc_file_cache_get(ProcFileCache *cache, int pid);
+guint proc_file_cache_sweep(ProcFileCache *cache);     // Closes exited PIDs; returns how many
+guint proc_file_cache_size(const ProcFileCache *cache);
+
+// Syscalls made by the cache (closes) since the last call
+guint64 proc_file_cache_take_syscalls(ProcFileCache *cache);
+
+typedef struct ProcReader ProcReader;
+
+// PROC_IO_URING degrades to PROC_IO_PREAD if no ring can be set up
+ProcReader* proc_reader_new(ProcFileCache *cache, ProcIoMode mode);
+void proc_reader_free(ProcReader *reader);
+ProcIoMode proc_reader_mode(const ProcReader *reader);
+
+// Read stat and statm of up to PROC_READER_BATCH processes. Files are opened
+// on first use; processes that exited in the meantime are closed and read
+// back as NULL.
+void proc_reader_read(ProcReader *reader, ProcPidFiles **files, guint count);
+const char* proc_reader_stat(const ProcReader *reader, guint index);
+const char* proc_reader_statm(const ProcReader *reader, guint index);
+
+// Syscalls made by this reader since the last call
+guint64 proc_reader_take_syscalls(ProcReader *reader);
+
+// TRUE if this kernel accepts io_uring reads
+gboolean proc_io_uring_available(void);
+const char* proc_io_mode_name(ProcIoMode mode);
+
+#endif // PROC_READER_H
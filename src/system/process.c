@@ -1,5 +1,6 @@
 #include "system.h" 
 #include "performance.h"
+#include "process_meta.h"
 #include "../ui/ui.h"
 #include "../utils/utils.h"
 #include "../common/config.h"
@@ -27,27 +28,27 @@ gpointer update_thread_func(gpointer data) {
         consecutive_failures = 0;  // Reset after backoff
     }
     
-    char* output = get_top_output();
-    
-    // Split all lines at once to avoid strtok conflicts with other functions
-    char **lines = malloc(2000 * sizeof(char*));  // Should be enough for all lines
-    int total_lines = 0;
-    char *line = strtok(output, "\n");
-    while (line && total_lines < 1999) {
-        lines[total_lines] = strdup(line);
-        total_lines++;
-        line = strtok(NULL, "\n");
+    // Stream top output; lines are parsed in place as they arrive (reentrant,
+    // no per-line copies)
+    TopReader top;
+    if (!top_reader_open(&top)) {
+        consecutive_failures++;
+        update_thread_running = FALSE;
+        return NULL;
     }
+    process_meta_refresh();  // Batched start time / UID for all PIDs
 
-    double current_time = (double)g_get_real_time() / 1000000.0;
+    gint64 now_us = g_get_real_time();
 
-    GList *processes = NULL;
+    ProcessTable *processes = process_table_acquire();
     char summary_buffer[1024] = "";
     gboolean found_header = FALSE;
     int process_count = 0;  // SECURITY: Track process count
+    guint max_processes = get_max_processes_per_update();
     
-    for (int line_num = 0; line_num < total_lines; line_num++) {
-        line = lines[line_num];
+    StrView view;
+    while (top_reader_next(&top, &view)) {
+        const char *line = view.ptr;  // NUL-terminated in the read buffer
         
         // Collect and simplify system summary lines (Networks:, VM:, Disks:)
         if (strstr(line, "Networks:") || strstr(line, "VM:") || strstr(line, "Disks:")) {
@@ -57,10 +58,10 @@ gpointer update_thread_func(gpointer data) {
             char simplified_line[256];
             if (strstr(line, "Networks:")) {
                 // Parse network info - format: "Networks: packets: 21060567/26G in, 7375591/1598M out."
-                char *net_info = line + 9; // Skip "Networks:"
+                const char *net_info = line + 9; // Skip "Networks:"
                 
                 // Look for the data amounts after the packet counts
-                char *in_pos = strstr(net_info, "/");
+                const char *in_pos = strstr(net_info, "/");
                 
                 char in_amount[32] = "";
                 char out_amount[32] = "";
@@ -68,7 +69,7 @@ gpointer update_thread_func(gpointer data) {
                 
                 if (in_pos) {
                     // Extract "in" amount - get everything between "/" and " in"
-                    char *in_end = strstr(in_pos, " in");
+                    const char *in_end = strstr(in_pos, " in");
                     if (in_end) {
                         int len = in_end - in_pos - 1; // Skip the "/"
                         if (len > 0 && len < 31) {
@@ -78,12 +79,12 @@ gpointer update_thread_func(gpointer data) {
                         }
                         
                         // Look for the "out" amount after "in,"
-                        char *out_start = strstr(in_end, ", ");
+                        const char *out_start = strstr(in_end, ", ");
                         if (out_start) {
                             out_start += 2; // Skip ", "
-                            char *out_slash = strstr(out_start, "/");
+                            const char *out_slash = strstr(out_start, "/");
                             if (out_slash) {
-                                char *out_end = strstr(out_slash, " out");
+                                const char *out_end = strstr(out_slash, " out");
                                 if (out_end) {
                                     int out_len = out_end - out_slash - 1;
                                     if (out_len > 0 && out_len < 31) {
@@ -135,15 +136,15 @@ gpointer update_thread_func(gpointer data) {
                 }
             } else if (strstr(line, "VM:")) {
                 // Parse and simplify virtual memory info for regular users
-                char *vm_info = line + 3; // Skip "VM:"
+                const char *vm_info = line + 3; // Skip "VM:"
                 
                 // Look for vsize (total virtual memory allocated by all processes)
-                char *vsize_pos = strstr(vm_info, " vsize");
+                const char *vsize_pos = strstr(vm_info, " vsize");
                 char total_allocated[32] = "";
                 
                 if (vsize_pos) {
                     // Work backwards to find the size before " vsize"
-                    char *size_start = vsize_pos;
+                    const char *size_start = vsize_pos;
                     while (size_start > vm_info && *(size_start-1) != ' ') {
                         size_start--;
                     }
@@ -157,12 +158,12 @@ gpointer update_thread_func(gpointer data) {
                 }
                 
                 // Look for framework vsize (memory used by system frameworks)
-                char *framework_pos = strstr(vm_info, " framework vsize");
+                const char *framework_pos = strstr(vm_info, " framework vsize");
                 char framework_mem[32] = "";
                 
                 if (framework_pos) {
                     // Work backwards to find the size before " framework vsize"
-                    char *size_start = framework_pos;
+                    const char *size_start = framework_pos;
                     while (size_start > vm_info && *(size_start-1) != ' ') {
                         size_start--;
                     }
@@ -176,14 +177,14 @@ gpointer update_thread_func(gpointer data) {
                 }
                 
                 // Parse swap numbers more accurately
-                char *swapins_str = strstr(vm_info, " swapins");
-                char *swapouts_str = strstr(vm_info, " swapouts");
+                const char *swapins_str = strstr(vm_info, " swapins");
+                const char *swapouts_str = strstr(vm_info, " swapouts");
                 long long actual_swapins = 0, actual_swapouts = 0;
                 
                 if (swapins_str) {
                     // Look for the number before " swapins"
-                    char *num_end = swapins_str;
-                    char *num_start = num_end - 1;
+                    const char *num_end = swapins_str;
+                    const char *num_start = num_end - 1;
                     while (num_start > vm_info && isdigit(*num_start)) {
                         num_start--;
                     }
@@ -194,8 +195,8 @@ gpointer update_thread_func(gpointer data) {
                 
                 if (swapouts_str) {
                     // Look for the number before " swapouts"
-                    char *num_end = swapouts_str;
-                    char *num_start = num_end - 1;
+                    const char *num_end = swapouts_str;
+                    const char *num_start = num_end - 1;
                     while (num_start > vm_info && isdigit(*num_start)) {
                         num_start--;
                     }
@@ -224,18 +225,18 @@ gpointer update_thread_func(gpointer data) {
                 }
             } else if (strstr(line, "Disks:")) {
                 // Parse disk activity - format: "Disks: 32434568/892G read, 14229951/334G written."
-                char *disk_info = line + 6; // Skip "Disks:"
+                const char *disk_info = line + 6; // Skip "Disks:"
                 
                 // Look for read amount - format: "number/sizeG read"
-                char *read_slash = strstr(disk_info, "/");
-                char *write_pos = strstr(disk_info, "written");
+                const char *read_slash = strstr(disk_info, "/");
+                const char *write_pos = strstr(disk_info, "written");
                 
                 char read_amount[32] = "";
                 char write_amount[32] = "";
                 
                 if (read_slash) {
                     // Extract read amount - get everything between "/" and " read"
-                    char *read_end = strstr(read_slash, " read");
+                    const char *read_end = strstr(read_slash, " read");
                     if (read_end) {
                         int len = read_end - read_slash - 1; // Skip the "/"
                         if (len > 0 && len < 31) {
@@ -247,7 +248,7 @@ gpointer update_thread_func(gpointer data) {
                 
                 if (write_pos) {
                     // Look backwards from "written" to find the slash
-                    char *write_search = write_pos;
+                    const char *write_search = write_pos;
                     while (write_search > disk_info && *write_search != '/') {
                         write_search--;
                     }
@@ -288,160 +289,63 @@ gpointer update_thread_func(gpointer data) {
         }
         
         // Only parse process lines after we've found the header
-        if (found_header && line && *line != '\0') {
+        if (found_header && view.len > 0) {
             // SECURITY: Check timeout and resource limits
             time_t now = time(NULL);
             if ((now - update_start_time) > (MAX_UPDATE_TIME_MS / 1000)) {
                 break;  // Timeout protection
             }
             
-            if (process_count >= MAX_PROCESSES_PER_UPDATE) {
+            if (process_count >= (int)max_processes) {
                 break;  // Process count limit
             }
             
             // Only parse lines that start with a digit (actual PIDs)
             if (isdigit(line[0])) {
                 process_count++;  // SECURITY: Increment counter
-                Process *proc = alloc_process();  // OPTIMIZATION: Use memory pool
-                
-                // Split line into tokens and parse from the end
-                char *tokens[20];  // Should be enough for any reasonable line
-                int token_count = 0;
-                char *line_copy = strdup(line);
-                char *token = strtok(line_copy, " \t");
+                ProcessSample sample;  // OPTIMIZATION: Copied into the contiguous table
+                ProcessSample *proc = &sample;
                 
-                while (token && token_count < 20) {
-                    tokens[token_count++] = strdup(token);
-                    token = strtok(NULL, " \t");
-                }
-                
-                if (token_count >= 5) {  // Need at least PID, NAME, CPU, MEM, TIME
-                    // SECURITY: Safe PID copying with bounds checking
-                    safe_strncpy(proc->pid, tokens[0], sizeof(proc->pid));
-                    
-                    // SECURITY: Validate CPU value before processing
-                    if (tokens[token_count - 3]) {
-                        float raw_cpu = atof(tokens[token_count - 3]);
-                        // SECURITY: Clamp CPU values to reasonable range
-                        if (raw_cpu < 0) raw_cpu = 0;
-                        if (raw_cpu > 999.9) raw_cpu = 999.9;
-                        
-                        float normalized_cpu = raw_cpu / (cpu_cores > 0 ? cpu_cores : 1);
-                        snprintf(proc->cpu, sizeof(proc->cpu), "%.1f", normalized_cpu);
-                    } else {
-                        safe_strncpy(proc->cpu, "0.0", sizeof(proc->cpu));
-                    }
-                    
-                    // SECURITY: Safe memory format conversion
-                    if (tokens[token_count - 2]) {
-                        char *formatted_mem = format_memory_human_readable(tokens[token_count - 2]);
-                        if (formatted_mem) {
-                            safe_strncpy(proc->mem, formatted_mem, sizeof(proc->mem));
-                            free(formatted_mem);
-                        } else {
-                            safe_strncpy(proc->mem, "0 B", sizeof(proc->mem));
-                        }
-                    } else {
-                        safe_strncpy(proc->mem, "0 B", sizeof(proc->mem));
-                    }
-                    
-                    // SECURITY: Safe runtime copying
-                    if (tokens[token_count - 1]) {
-                        safe_strncpy(proc->runtime, tokens[token_count - 1], sizeof(proc->runtime));
-                    } else {
-                        safe_strncpy(proc->runtime, "0:00", sizeof(proc->runtime));
-                    }
-
-                    // SECURITY: Safe command name construction with bounds checking
-                    proc->name[0] = '\0';
-                    for (int i = 1; i < token_count - 3 && i < 10; i++) {  // Limit iterations
-                        if (tokens[i]) {
-                            if (i > 1) safe_strncat(proc->name, " ", sizeof(proc->name));
-                            safe_strncat(proc->name, tokens[i], sizeof(proc->name));
-                        }
-                    }
-                    
-                    // Clean up tokens
-                    for (int i = 0; i < token_count; i++) {
-                        free(tokens[i]);
-                    }
-                } else {
-                    // Clean up tokens on error
-                    for (int i = 0; i < token_count; i++) {
-                        free(tokens[i]);
-                    }
-                    free(line_copy);
-                    free_process(proc);
+                // Need at least PID, NAME, CPU, MEM, TIME
+                if (!parse_top_process_fields(view, proc)) {
                     continue;
                 }
                 
-                free(line_copy);
-                
-                // Override runtime with elapsed time
-                char *runtime = get_run_time(proc->pid);
-                safe_strncpy(proc->runtime, runtime, sizeof(proc->runtime));
-                free(runtime);
-
-                // GPU: N/A (per-process not easily available)
-                safe_strncpy(proc->gpu, "N/A", sizeof(proc->gpu));
-                
-                // Determine process type (system vs user)
-                determine_process_type(proc);
+                // Start time, UID and process type (system vs user) from the
+                // batched metadata pass; GPU: per-process not easily available
+                fill_process_metadata(proc);
 
                 // Network rate (simplified for now)
                 long long current_bytes = get_net_bytes(proc->pid);
-                char *pid_key = g_strdup(proc->pid);
                 double rate = 0.0;
 
                 g_mutex_lock(&hash_mutex);
-                if (g_hash_table_contains(prev_net_bytes, pid_key)) {
-                    long long *prev_b_ptr = (long long *)g_hash_table_lookup(prev_net_bytes, pid_key);
-                    double *prev_t_ptr = (double *)g_hash_table_lookup(prev_times, pid_key);
-                    if (prev_b_ptr && prev_t_ptr) {
-                        double delta_time = current_time - *prev_t_ptr;
-                        if (delta_time > 0.3) {  // Need at least 0.3 seconds for meaningful rate
-                            long long bytes_diff = current_bytes - *prev_b_ptr;
-                            if (bytes_diff > 0) {  // Only show positive rates
-                                rate = (double)bytes_diff / delta_time / 1024.0;  // KB/s
-                            }
-                        }
-                    }
+                guint64 start_time = (proc->flags & PROCESS_FLAG_HAS_START) ? (guint64)proc->start_time : 0;
+                RateDelta delta;
+                if (rate_store_update(net_counters, proc->pid, start_time, RATE_COUNTER_NET_BYTES,
+                                      (guint64)MAX(current_bytes, 0), now_us, &delta) &&
+                    delta.seconds > 0.3) {  // Need at least 0.3 seconds for meaningful rate
+                    rate = (double)delta.increase / delta.seconds / 1024.0;  // KB/s
                 }
-                
-                // Update prev values
-                long long *new_bytes = malloc(sizeof(long long));
-                *new_bytes = current_bytes;
-                g_hash_table_insert(prev_net_bytes, g_strdup(pid_key), new_bytes);
-
-                double *new_time = malloc(sizeof(double));
-                *new_time = current_time;
-                g_hash_table_insert(prev_times, g_strdup(pid_key), new_time);
                 g_mutex_unlock(&hash_mutex);
 
-                if (rate > 0.1) {  // Only show rates above 0.1 KB/s
-                    sprintf(proc->net, "%.1f KB/s", rate);
-                } else {
-                    sprintf(proc->net, "0.0 KB/s");
-                }
-
-                g_free(pid_key);
+                proc->net_bps = rate > 0.1 ? (guint64)(rate * 1024.0) : 0;  // Only rates above 0.1 KB/s
 
-                // Add to list
-                processes = g_list_append(processes, proc);
+                // Add to table
+                process_table_add(processes, proc);
             }
         }
     }
     
-    // Free the lines array
-    for (int i = 0; i < total_lines; i++) {
-        free(lines[i]);
-    }
-    free(lines);
+    top_reader_close(&top);
 
-    free(output);
+    // Exited processes drop out of the network counters within a few updates
+    g_mutex_lock(&hash_mutex);
+    rate_store_advance(net_counters);
+    g_mutex_unlock(&hash_mutex);
 
     // SECURITY: Update success/failure tracking
-    int final_process_count = g_list_length(processes);
+    int final_process_count = (int)processes->count;
     if (final_process_count > 0) {
         consecutive_failures = 0;  // Reset on success
     } else {
@@ -454,7 +358,7 @@ gpointer update_thread_func(gpointer data) {
     UpdateData *update_data = malloc(sizeof(UpdateData));
     if (!update_data) {
         // Cleanup on allocation failure
-        g_list_free_full(processes, (GDestroyNotify)free_process);
+        process_table_release(processes);
         if (gpu_usage) free(gpu_usage);
         update_thread_running = FALSE;
         return NULL;
@@ -463,6 +367,7 @@ gpointer update_thread_func(gpointer data) {
     update_data->processes = processes;
     update_data->gpu_usage = gpu_usage ? gpu_usage : strdup("N/A");
     update_data->system_summary = strdup(summary_buffer);
+    update_data->arena = NULL;  // Heap-owned strings
     
     // Use optimized system usage collection (with fallback)
     update_data->system_cpu_usage = get_system_cpu_usage();
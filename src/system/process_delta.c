@@ -0,0 +1,62 @@
+#include "process_delta.h"
+#include "../utils/utils.h"
+#include <string.h>
+
+guint32 process_sample_diff(const ProcessSample *old_proc, const ProcessSample *new_proc) {
+    guint32 fields = 0;
+
+    // OPTIMIZATION: Interned names - equal text means equal IDs
+    if (old_proc->name_id != new_proc->name_id) fields |= PROCESS_FIELD_NAME;
+    if (old_proc->cpu != new_proc->cpu) fields |= PROCESS_FIELD_CPU;
+    if (old_proc->gpu != new_proc->gpu ||
+        ((old_proc->flags ^ new_proc->flags) & PROCESS_FLAG_HAS_GPU)) fields |= PROCESS_FIELD_GPU;
+    if (old_proc->rss_bytes != new_proc->rss_bytes) fields |= PROCESS_FIELD_MEM;
+    if (old_proc->net_bps != new_proc->net_bps) fields |= PROCESS_FIELD_NET;
+    if (old_proc->start_time != new_proc->start_time ||
+        ((old_proc->flags ^ new_proc->flags) & PROCESS_FLAG_HAS_START)) fields |= PROCESS_FIELD_START;
+    if ((old_proc->flags ^ new_proc->flags) & PROCESS_FLAG_SYSTEM) fields |= PROCESS_FIELD_TYPE;
+
+    return fields;
+}
+
+ProcessDelta* process_delta_compute(const ProcessTable *old_table, const ProcessTable *new_table) {
+    ProcessDelta *delta = g_new0(ProcessDelta, 1);
+    delta->added = g_array_new(FALSE, FALSE, sizeof(guint32));
+    delta->removed = g_array_new(FALSE, FALSE, sizeof(pid_t));
+    delta->changed = g_array_new(FALSE, FALSE, sizeof(ProcessChange));
+
+    guint new_count = new_table ? new_table->count : 0;
+    for (guint32 i = 0; i < new_count; i++) {
+        const ProcessSample *curr = &new_table->items[i];
+        const ProcessSample *prev = process_table_lookup(old_table, curr->pid);
+
+        if (!prev) {
+            g_array_append_val(delta->added, i);
+            continue;
+        }
+
+        guint32 fields = process_sample_diff(prev, curr);
+        if (fields) {
+            ProcessChange change = { curr->pid, i, fields };
+            g_array_append_val(delta->changed, change);
+        }
+    }
+
+    guint old_count = old_table ? old_table->count : 0;
+    for (guint i = 0; i < old_count; i++) {
+        pid_t pid = old_table->items[i].pid;
+        if (!process_table_lookup(new_table, pid)) {
+            g_array_append_val(delta->removed, pid);
+        }
+    }
+
+    return delta;
+}
+
+void process_delta_free(ProcessDelta *delta) {
+    if (!delta) return;
+    g_array_free(delta->added, TRUE);
+    g_array_free(delta->removed, TRUE);
+    g_array_free(delta->changed, TRUE);
+    g_free(delta);
+}
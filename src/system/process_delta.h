@@ -0,0 +1,38 @@
+#ifndef PROCESS_DELTA_H
+#define PROCESS_DELTA_H
+
+#include <glib.h>
+#include "../common/types.h"
+
+// Per-field change bits, one per displayed column
+#define PROCESS_FIELD_NAME   (1u << 0)
+#define PROCESS_FIELD_CPU    (1u << 1)
+#define PROCESS_FIELD_GPU    (1u << 2)
+#define PROCESS_FIELD_MEM    (1u << 3)
+#define PROCESS_FIELD_NET    (1u << 4)
+#define PROCESS_FIELD_START  (1u << 5)
+#define PROCESS_FIELD_TYPE   (1u << 6)
+#define PROCESS_FIELD_ALL    0x7fu
+
+typedef struct {
+    pid_t pid;
+    guint32 index;              // Row in the new table
+    guint32 fields;             // PROCESS_FIELD_* that differ from the old row
+} ProcessChange;
+
+// Difference between two consecutive process tables. Rows that are equal in
+// both tables do not appear at all.
+typedef struct {
+    GArray *added;              // guint32 row indices into the new table
+    GArray *removed;            // pid_t of rows only in the old table
+    GArray *changed;            // ProcessChange for rows present in both
+} ProcessDelta;
+
+// Fields that differ between two samples of the same PID
+guint32 process_sample_diff(const ProcessSample *old_proc, const ProcessSample *new_proc);
+
+// Delta from old_table to new_table; a NULL old_table makes every row "added"
+ProcessDelta* process_delta_compute(const ProcessTable *old_table, const ProcessTable *new_table);
+void process_delta_free(ProcessDelta *delta);
+
+#endif // PROCESS_DELTA_H
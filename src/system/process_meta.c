@@ -0,0 +1,248 @@
+#define _GNU_SOURCE
+#include "process_meta.h"
+#include "../utils/utils.h"
+#include <ctype.h>
+#include <unistd.h>
+
+#ifdef __APPLE__
+#include <sys/sysctl.h>
+#elif defined(__linux__)
+#include <dirent.h>
+#include <fcntl.h>
+#endif
+
+// Cache: pid -> ProcessMeta*, protected by meta_mutex
+static PidMap *meta_cache = NULL;              // PID -> ProcessMeta, stored inline
+static GMutex meta_mutex;
+static guint meta_generation = 0;
+static ProcessMetaStats meta_stats = {0};
+
+// Record one process seen during enumeration. uid_lookup is only called when
+// the (pid, start_time) pair is not cached yet.
+typedef int (*UidLookupFunc)(int pid, void *ctx);
+
+static void meta_observe(int pid, time_t start_time, UidLookupFunc uid_lookup, void *ctx) {
+    ProcessMeta *meta = pid_map_lookup(meta_cache, pid);
+
+    meta_stats.live++;
+    if (meta && meta->start_time == start_time) {
+        meta->generation = meta_generation;
+        meta_stats.reused++;
+        return;
+    }
+
+    // New process, or the PID was reused by a different process
+    if (!meta) meta = pid_map_insert(meta_cache, pid);
+    meta->pid = pid;
+    meta->start_time = start_time;
+    meta->uid = uid_lookup(pid, ctx);
+    meta->generation = meta_generation;
+    meta_stats.inserted++;
+}
+
+static gboolean meta_is_stale(pid_t pid, gpointer value, gpointer user_data) {
+    (void)pid;
+    (void)user_data;
+    return ((ProcessMeta*)value)->generation != meta_generation;
+}
+
+#ifdef __APPLE__
+
+// macOS: kinfo_proc already carries the UID, nothing extra to read
+static int kinfo_uid_lookup(int pid, void *ctx) {
+    (void)pid;
+    return *(int*)ctx;
+}
+
+// One sysctl(KERN_PROC_ALL) returns start time and UID for every process
+static int enumerate_processes(void) {
+    int mib[4] = { CTL_KERN, KERN_PROC, KERN_PROC_ALL, 0 };
+    size_t size = 0;
+    if (sysctl(mib, 4, NULL, &size, NULL, 0) != 0) return -1;
+
+    // Leave headroom for processes started between the two calls
+    size += size / 8;
+    struct kinfo_proc *procs = malloc(size);
+    if (!procs) return -1;
+
+    if (sysctl(mib, 4, procs, &size, NULL, 0) != 0) {
+        free(procs);
+        return -1;
+    }
+
+    int count = (int)(size / sizeof(struct kinfo_proc));
+    for (int i = 0; i < count; i++) {
+        int uid = (int)procs[i].kp_eproc.e_ucred.cr_uid;
+        meta_observe(procs[i].kp_proc.p_pid,
+                     procs[i].kp_proc.p_starttime.tv_sec,
+                     kinfo_uid_lookup, &uid);
+    }
+
+    free(procs);
+    return count;
+}
+
+#elif defined(__linux__)
+
+static time_t boot_time = 0;
+static long clock_ticks = 0;
+
+// Boot time in seconds since the epoch ("btime" line of /proc/stat)
+static time_t read_boot_time(void) {
+    FILE *fp = fopen("/proc/stat", "r");
+    if (!fp) return 0;
+
+    char line[256];
+    long long btime = 0;
+    while (fgets(line, sizeof(line), fp)) {
+        if (sscanf(line, "btime %lld", &btime) == 1) break;
+    }
+    fclose(fp);
+    return (time_t)btime;
+}
+
+static ssize_t read_small_file(int dir_fd, const char *path, char *buf, size_t size) {
+    int fd = openat(dir_fd, path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return -1;
+
+    ssize_t n = read(fd, buf, size - 1);
+    close(fd);
+    if (n < 0) return -1;
+    buf[n] = '\0';
+    return n;
+}
+
+// Effective UID from the "Uid:" line of /proc/[pid]/status (real, effective, saved, fs)
+static int status_uid_lookup(int pid, void *ctx) {
+    int proc_fd = *(int*)ctx;
+    char path[32];
+    char buf[2048];
+    snprintf(path, sizeof(path), "%d/status", pid);
+    if (read_small_file(proc_fd, path, buf, sizeof(buf)) <= 0) return -1;
+
+    const char *uid_line = strstr(buf, "\nUid:");
+    int real_uid = -1, effective_uid = -1;
+    if (!uid_line || sscanf(uid_line + 5, "%d %d", &real_uid, &effective_uid) != 2) {
+        return -1;
+    }
+    return effective_uid;
+}
+
+// starttime (field 22, clock ticks since boot) from /proc/[pid]/stat
+static gboolean parse_start_ticks(const char *stat, unsigned long long *ticks) {
+    const char *pos = strrchr(stat, ')');  // comm may contain spaces or ')'
+    if (!pos) return FALSE;
+    pos++;
+
+    // Fields after comm start at 3 (state); skip to field 22
+    for (int field = 3; field < 22; field++) {
+        while (*pos == ' ') pos++;
+        while (*pos && *pos != ' ') pos++;
+        if (!*pos) return FALSE;
+    }
+
+    char *end;
+    *ticks = strtoull(pos, &end, 10);
+    return end != pos;
+}
+
+// One readdir pass over /proc; status is only read for processes not yet cached
+static int enumerate_processes(void) {
+    if (boot_time == 0) boot_time = read_boot_time();
+    if (clock_ticks <= 0) clock_ticks = sysconf(_SC_CLK_TCK);
+    if (clock_ticks <= 0) clock_ticks = 100;
+
+    int proc_fd = open("/proc", O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (proc_fd < 0) return -1;
+
+    int dir_fd = dup(proc_fd);
+    DIR *dir = dir_fd >= 0 ? fdopendir(dir_fd) : NULL;
+    if (!dir) {
+        if (dir_fd >= 0) close(dir_fd);
+        close(proc_fd);
+        return -1;
+    }
+
+    int count = 0;
+    char path[sizeof(((struct dirent*)0)->d_name) + 8];
+    char buf[1024];
+    struct dirent *entry;
+    while ((entry = readdir(dir)) != NULL) {
+        if (!isdigit((unsigned char)entry->d_name[0])) continue;
+
+        snprintf(path, sizeof(path), "%s/stat", entry->d_name);
+        if (read_small_file(proc_fd, path, buf, sizeof(buf)) <= 0) continue;
+
+        unsigned long long start_ticks = 0;
+        if (!parse_start_ticks(buf, &start_ticks)) continue;
+
+        time_t start_time = boot_time + (time_t)(start_ticks / clock_ticks);
+        meta_observe(atoi(entry->d_name), start_time, status_uid_lookup, &proc_fd);
+        count++;
+    }
+
+    closedir(dir);
+    close(proc_fd);
+    return count;
+}
+
+#else
+
+static int enumerate_processes(void) {
+    return -1;  // No batched enumeration on this platform
+}
+
+#endif
+
+int process_meta_refresh(void) {
+    g_mutex_lock(&meta_mutex);
+
+    if (!meta_cache) {
+        meta_cache = pid_map_new(sizeof(ProcessMeta), 0);
+    }
+
+    meta_generation++;
+    memset(&meta_stats, 0, sizeof(meta_stats));
+
+    int count = enumerate_processes();
+    if (count >= 0) {
+        // Drop processes that were not seen in this pass
+        meta_stats.removed = pid_map_remove_if(meta_cache, meta_is_stale, NULL);
+    }
+
+    g_mutex_unlock(&meta_mutex);
+    return count;
+}
+
+gboolean process_meta_lookup(int pid, ProcessMeta *out) {
+    gboolean found = FALSE;
+
+    g_mutex_lock(&meta_mutex);
+    if (meta_cache) {
+        ProcessMeta *meta = pid_map_lookup(meta_cache, pid);
+        if (meta) {
+            if (out) *out = *meta;
+            found = TRUE;
+        }
+    }
+    g_mutex_unlock(&meta_mutex);
+
+    return found;
+}
+
+void process_meta_get_stats(ProcessMetaStats *stats) {
+    if (!stats) return;
+
+    g_mutex_lock(&meta_mutex);
+    *stats = meta_stats;
+    g_mutex_unlock(&meta_mutex);
+}
+
+void process_meta_cleanup(void) {
+    g_mutex_lock(&meta_mutex);
+    if (meta_cache) {
+        pid_map_free(meta_cache);
+        meta_cache = NULL;
+    }
+    g_mutex_unlock(&meta_mutex);
+}
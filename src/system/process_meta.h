@@ -0,0 +1,37 @@
+#ifndef PROCESS_META_H
+#define PROCESS_META_H
+
+#include <glib.h>
+#include <time.h>
+#include "../common/types.h"
+
+// Per-process metadata that never changes over a process lifetime.
+// Filled for every PID by one enumeration pass and cached by (pid, start_time),
+// so the per-row `ps -p PID -o etime=` / `ps -p PID -o uid=` calls go away.
+typedef struct {
+    int pid;
+    time_t start_time;          // Process start, seconds since the epoch
+    int uid;                    // Effective UID
+    guint generation;           // Last refresh that saw this process
+} ProcessMeta;
+
+// Enumerate all processes once and update the cache. Call at the start of
+// each collection cycle; entries for exited processes are dropped.
+// Returns the number of live processes, or -1 if enumeration failed.
+int process_meta_refresh(void);
+
+// Copy the cached entry for pid into out; FALSE if the PID was not seen
+gboolean process_meta_lookup(int pid, ProcessMeta *out);
+
+// Cache statistics for the last refresh
+typedef struct {
+    guint live;                 // Processes seen in the last pass
+    guint reused;               // Served from cache (same pid + start_time)
+    guint inserted;             // New or PID-reused processes
+    guint removed;              // Exited processes dropped
+} ProcessMetaStats;
+
+void process_meta_get_stats(ProcessMetaStats *stats);
+void process_meta_cleanup(void);
+
+#endif // PROCESS_META_H
@@ -0,0 +1,289 @@
+#include "sample_scheduler.h"
+#include "../common/config.h"
+
+// Hashed timer wheel: a source due at tick t sits in slot t % SLOTS. Each
+// wakeup expires the slots of the ticks elapsed since the previous one, and
+// the next wakeup is the earliest deadline found scanning one revolution
+// ahead. Deadlines further out than a revolution stay in their slot until
+// their tick comes round.
+#define SCHEDULER_WHEEL_SLOTS 64
+
+struct SampleScheduler {
+    GMutex mutex;
+    GCond cond;
+    SampleSource *wheel[SCHEDULER_WHEEL_SLOTS];
+    gint64 tick_us;
+    gint64 last_tick;           // Ticks up to here have been expired
+    gboolean stop;
+    guint64 wakeups;
+    WorkerPool *pool;           // NULL: sources run on the scheduler thread
+    WorkerBatch batch;          // Pooled runs in flight
+};
+
+static gint64 tick_of(const SampleScheduler *scheduler, gint64 time_us) {
+    return time_us / scheduler->tick_us;
+}
+
+static void wheel_link(SampleScheduler *scheduler, SampleSource *source) {
+    SampleSource **slot = &scheduler->wheel[tick_of(scheduler, source->due_us) % SCHEDULER_WHEEL_SLOTS];
+    source->next = *slot;
+    *slot = source;
+    source->queued = TRUE;
+}
+
+static void wheel_unlink(SampleScheduler *scheduler, SampleSource *source) {
+    SampleSource **link = &scheduler->wheel[tick_of(scheduler, source->due_us) % SCHEDULER_WHEEL_SLOTS];
+    while (*link && *link != source) link = &(*link)->next;
+    if (*link) *link = source->next;
+    source->next = NULL;
+    source->queued = FALSE;
+}
+
+// Next multiple of the period after now_us
+static gint64 aligned_deadline(gint64 now_us, guint period_ms) {
+    gint64 period_us = (gint64)period_ms * 1000;
+    return (now_us / period_us + 1) * period_us;
+}
+
+SampleScheduler* sample_scheduler_new(void) {
+    SampleScheduler *scheduler = g_new0(SampleScheduler, 1);
+    g_mutex_init(&scheduler->mutex);
+    g_cond_init(&scheduler->cond);
+    scheduler->tick_us = (gint64)SAMPLE_SCHEDULER_TICK_MS * 1000;
+    scheduler->last_tick = tick_of(scheduler, g_get_monotonic_time()) - 1;
+    worker_batch_init(&scheduler->batch);
+    return scheduler;
+}
+
+void sample_scheduler_free(SampleScheduler *scheduler) {
+    if (!scheduler) return;
+    worker_batch_clear(&scheduler->batch);
+    g_mutex_clear(&scheduler->mutex);
+    g_cond_clear(&scheduler->cond);
+    g_free(scheduler);
+}
+
+void sample_scheduler_add(SampleScheduler *scheduler, SampleSource *source) {
+    g_mutex_lock(&scheduler->mutex);
+    source->due_us = g_get_monotonic_time();
+    source->next = NULL;
+    source->scheduler = scheduler;
+    wheel_link(scheduler, source);
+    g_cond_signal(&scheduler->cond);
+    g_mutex_unlock(&scheduler->mutex);
+}
+
+// Unlink every source whose deadline has passed, cheapest first. Called with
+// the mutex held.
+static SampleSource* expire_due(SampleScheduler *scheduler, gint64 now_us) {
+    SampleSource *due = NULL;
+    gint64 now_tick = tick_of(scheduler, now_us);
+    gint64 first = MAX(scheduler->last_tick + 1, now_tick - SCHEDULER_WHEEL_SLOTS + 1);
+
+    for (gint64 tick = first; tick <= now_tick; tick++) {
+        SampleSource **link = &scheduler->wheel[tick % SCHEDULER_WHEEL_SLOTS];
+        while (*link) {
+            SampleSource *source = *link;
+            if (source->due_us > now_us) {
+                link = &source->next;
+                continue;
+            }
+            *link = source->next;
+            source->queued = FALSE;
+
+            SampleSource **pos = &due;
+            while (*pos && (*pos)->cost_ms <= source->cost_ms) pos = &(*pos)->next;
+            source->next = *pos;
+            *pos = source;
+        }
+    }
+    // The current tick may still hold later deadlines; look at it again next time
+    scheduler->last_tick = now_tick - 1;
+    return due;
+}
+
+// Earliest deadline within one revolution, or the end of the revolution
+static gint64 next_wakeup(SampleScheduler *scheduler, gint64 now_us) {
+    gint64 now_tick = tick_of(scheduler, now_us);
+    for (gint64 tick = now_tick; tick < now_tick + SCHEDULER_WHEEL_SLOTS; tick++) {
+        gint64 earliest = G_MAXINT64;
+        for (SampleSource *source = scheduler->wheel[tick % SCHEDULER_WHEEL_SLOTS]; source; source = source->next) {
+            if (tick_of(scheduler, source->due_us) <= tick) earliest = MIN(earliest, source->due_us);
+        }
+        if (earliest != G_MAXINT64) return earliest;
+    }
+    return (now_tick + SCHEDULER_WHEEL_SLOTS) * scheduler->tick_us;
+}
+
+// Next deadline after a run; missed periods are skipped, not replayed
+static void reschedule(SampleScheduler *scheduler, SampleSource *source, gint64 now_us) {
+    if (source->period_ms == 0) {
+        source->due_us = G_MAXINT64;  // Parked until triggered
+        return;
+    }
+
+    gint64 period_us = (gint64)source->period_ms * 1000;
+    gint64 next = aligned_deadline(source->due_us, source->period_ms);
+    if (next <= now_us) {
+        source->skipped += (guint)((now_us - next) / period_us + 1);
+        next = aligned_deadline(now_us, source->period_ms);
+    }
+    source->due_us = next;
+    wheel_link(scheduler, source);
+}
+
+static void run_source(SampleSource *source) {
+    gint64 start = g_get_monotonic_time();
+    source->last_lateness_us = MAX(start - source->due_us, 0);
+    source->func(source->data);
+    source->last_us = g_get_monotonic_time() - start;
+    source->max_us = MAX(source->max_us, source->last_us);
+    source->runs++;
+}
+
+// Back on the wheel after a run. Called with the mutex held.
+static void finish_source(SampleScheduler *scheduler, SampleSource *source, gint64 now_us) {
+    source->next = NULL;
+    source->running = FALSE;
+    if (source->triggered) {
+        source->triggered = FALSE;
+        source->due_us = now_us;
+        wheel_link(scheduler, source);
+    } else {
+        reschedule(scheduler, source, now_us);
+    }
+}
+
+static void run_pooled_source(gpointer data) {
+    SampleSource *source = data;
+    if (!sample_scheduler_stopping(source->scheduler)) run_source(source);
+}
+
+// Worker pool done hook: the task can be resubmitted from here on
+static void finish_pooled_source(gpointer data) {
+    SampleSource *source = data;
+    SampleScheduler *scheduler = source->scheduler;
+
+    g_mutex_lock(&scheduler->mutex);
+    finish_source(scheduler, source, g_get_monotonic_time());
+    g_cond_signal(&scheduler->cond);  // The new deadline may be the earliest
+    g_mutex_unlock(&scheduler->mutex);
+}
+
+// Hand the due sources to the pool. Called with the mutex held.
+static void submit_due(SampleScheduler *scheduler, SampleSource *due) {
+    while (due) {
+        SampleSource *source = due;
+        due = source->next;
+        source->next = NULL;
+
+        source->task.name = source->name;
+        source->task.func = run_pooled_source;
+        source->task.done = finish_pooled_source;
+        source->task.data = source;
+        source->task.budget_ms = source->cost_ms;
+        if (!worker_pool_submit(scheduler->pool, &scheduler->batch, &source->task)) {
+            finish_source(scheduler, source, g_get_monotonic_time());  // Pool shutting down
+        }
+    }
+}
+
+void sample_scheduler_set_pool(SampleScheduler *scheduler, WorkerPool *pool) {
+    g_mutex_lock(&scheduler->mutex);
+    scheduler->pool = pool;
+    g_mutex_unlock(&scheduler->mutex);
+}
+
+void sample_scheduler_run(SampleScheduler *scheduler) {
+    g_mutex_lock(&scheduler->mutex);
+    while (!scheduler->stop) {
+        gint64 now = g_get_monotonic_time();
+        SampleSource *due = expire_due(scheduler, now);
+
+        if (due) {
+            for (SampleSource *source = due; source; source = source->next) {
+                source->running = TRUE;
+            }
+            // OPTIMIZATION: Due sources run side by side; a 3 s system_profiler
+            // or a slow powermetrics no longer holds back the process sample
+            if (scheduler->pool) {
+                submit_due(scheduler, due);
+                continue;
+            }
+
+            g_mutex_unlock(&scheduler->mutex);
+            for (SampleSource *source = due; source; source = source->next) {
+                if (sample_scheduler_stopping(scheduler)) break;
+                run_source(source);
+            }
+            g_mutex_lock(&scheduler->mutex);
+
+            now = g_get_monotonic_time();
+            while (due) {
+                SampleSource *source = due;
+                due = source->next;
+                finish_source(scheduler, source, now);
+            }
+            continue;
+        }
+
+        // Signalled by stop(), trigger(), a period change or a pooled run ending
+        g_cond_wait_until(&scheduler->cond, &scheduler->mutex, next_wakeup(scheduler, now));
+        scheduler->wakeups++;
+    }
+    g_mutex_unlock(&scheduler->mutex);
+
+    // Pooled runs still reference the scheduler
+    worker_batch_wait(&scheduler->batch);
+}
+
+void sample_scheduler_stop(SampleScheduler *scheduler) {
+    if (!scheduler) return;
+    g_mutex_lock(&scheduler->mutex);
+    scheduler->stop = TRUE;
+    g_cond_broadcast(&scheduler->cond);
+    g_mutex_unlock(&scheduler->mutex);
+}
+
+gboolean sample_scheduler_stopping(SampleScheduler *scheduler) {
+    g_mutex_lock(&scheduler->mutex);
+    gboolean stop = scheduler->stop;
+    g_mutex_unlock(&scheduler->mutex);
+    return stop;
+}
+
+void sample_scheduler_trigger(SampleScheduler *scheduler, SampleSource *source) {
+    g_mutex_lock(&scheduler->mutex);
+    if (source->running) {
+        source->triggered = TRUE;  // Runs again as soon as the current run ends
+    } else {
+        if (source->queued) wheel_unlink(scheduler, source);
+        source->due_us = g_get_monotonic_time();
+        wheel_link(scheduler, source);
+        g_cond_signal(&scheduler->cond);
+    }
+    g_mutex_unlock(&scheduler->mutex);
+}
+
+void sample_scheduler_set_period(SampleScheduler *scheduler, SampleSource *source, guint period_ms) {
+    g_mutex_lock(&scheduler->mutex);
+    source->period_ms = period_ms;
+    if (!source->running) {
+        if (source->queued) wheel_unlink(scheduler, source);
+        if (period_ms > 0) {
+            source->due_us = aligned_deadline(g_get_monotonic_time(), period_ms);
+            wheel_link(scheduler, source);
+        } else {
+            source->due_us = G_MAXINT64;
+        }
+        g_cond_signal(&scheduler->cond);
+    }
+    g_mutex_unlock(&scheduler->mutex);
+}
+
+guint64 sample_scheduler_wakeups(SampleScheduler *scheduler) {
+    g_mutex_lock(&scheduler->mutex);
+    guint64 wakeups = scheduler->wakeups;
+    g_mutex_unlock(&scheduler->mutex);
+    return wakeups;
+}
@@ -0,0 +1,82 @@
+#ifndef SAMPLE_SCHEDULER_H
+#define SAMPLE_SCHEDULER_H
+
+#include <glib.h>
+#include "../utils/worker_pool.h"
+
+// Deadline-driven sampling for the continuous collector. Every metric source
+// declares how often it wants to run and what a run costs; the scheduler
+// thread sleeps until the earliest deadline on a timer wheel and runs
+// whatever is due.
+//
+// Deadlines are aligned to multiples of the period on the monotonic clock,
+// so sources with related periods (500 ms, 1 s, 2 s) come due together and
+// share a wakeup. A run that overruns skips the periods it missed instead of
+// queueing catch-up runs. Waits are interruptible: sample_scheduler_stop()
+// returns the scheduler thread at once rather than after its sleep.
+//
+// Sources run on the scheduler thread one after another, or on a worker
+// pool (sample_scheduler_set_pool), where each source is rescheduled as soon
+// as its own run ends and a slow one never delays the others. A source
+// never runs concurrently with itself.
+
+typedef void (*SampleFunc)(gpointer data);
+
+typedef struct SampleScheduler SampleScheduler;
+
+// A metric source. The caller owns the struct; it must stay alive while the
+// scheduler runs.
+typedef struct SampleSource {
+    const char *name;
+    guint period_ms;            // 0 = run once, as soon as the scheduler starts
+    guint cost_ms;              // Expected run time; without a pool cheaper sources run first
+                                // when several are due, on a pool costlier ones start first
+    SampleFunc func;
+    gpointer data;
+
+    // Updated by the thread running the source
+    guint runs;
+    guint skipped;              // Deadlines missed because an earlier run overran
+    gint64 last_us;             // Duration of the last run
+    gint64 max_us;
+    gint64 last_lateness_us;    // How far past its deadline the last run started
+
+    // Private
+    gint64 due_us;              // Next deadline (monotonic), G_MAXINT64 when finished
+    gboolean queued;            // Linked into the wheel
+    gboolean running;
+    gboolean triggered;         // trigger() during a run: due again right after it
+    struct SampleSource *next;
+    SampleScheduler *scheduler;
+    WorkerTask task;            // Pooled run
+} SampleSource;
+
+SampleScheduler* sample_scheduler_new(void);
+void sample_scheduler_free(SampleScheduler *scheduler);   // Only after run() has returned
+
+// Register a source before run(); the first run is due immediately
+void sample_scheduler_add(SampleScheduler *scheduler, SampleSource *source);
+
+// Run due sources on pool instead of the scheduler thread. Call before
+// run(); the pool must outlive it.
+void sample_scheduler_set_pool(SampleScheduler *scheduler, WorkerPool *pool);
+
+// Run due sources until sample_scheduler_stop()
+void sample_scheduler_run(SampleScheduler *scheduler);
+
+// Thread-safe. stop() wakes the scheduler and makes run() return once the
+// sources currently running (if any) have finished.
+void sample_scheduler_stop(SampleScheduler *scheduler);
+gboolean sample_scheduler_stopping(SampleScheduler *scheduler);
+
+// Thread-safe: run the source at the next wakeup instead of at its deadline
+void sample_scheduler_trigger(SampleScheduler *scheduler, SampleSource *source);
+
+// Change a source's period (thread-safe). The next deadline is re-aligned to
+// the new period; 0 stops the source until it is triggered.
+void sample_scheduler_set_period(SampleScheduler *scheduler, SampleSource *source, guint period_ms);
+
+// Number of times the scheduler thread woke up
+guint64 sample_scheduler_wakeups(SampleScheduler *scheduler);
+
+#endif // SAMPLE_SCHEDULER_H
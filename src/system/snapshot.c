@@ -0,0 +1,102 @@
+#include "snapshot.h"
+#include "../utils/utils.h"
+
+Snapshot* snapshot_new(UpdateData *data) {
+    // Arena-backed data carries the snapshot along with it
+    Snapshot *snapshot = data && data->arena
+        ? sample_arena_alloc(data->arena, sizeof(Snapshot))
+        : g_new0(Snapshot, 1);
+    snapshot->data = data;
+    snapshot->ref_count = 1;
+    return snapshot;
+}
+
+Snapshot* snapshot_ref(Snapshot *snapshot) {
+    if (snapshot) g_atomic_int_inc(&snapshot->ref_count);
+    return snapshot;
+}
+
+void snapshot_unref(Snapshot *snapshot) {
+    if (!snapshot) return;
+
+    if (g_atomic_int_dec_and_test(&snapshot->ref_count)) {
+        gboolean in_arena = snapshot->data && snapshot->data->arena;
+        process_delta_free(snapshot->delta);
+        if (snapshot->data) free_update_data(snapshot->data);
+        if (!in_arena) g_free(snapshot);
+    }
+}
+
+void snapshot_slot_init(SnapshotSlot *slot) {
+    g_atomic_pointer_set(&slot->current, NULL);
+    g_atomic_int_set(&slot->active_readers, 0);
+    slot->next_sequence = 1;
+    g_atomic_pointer_set(&slot->notify, NULL);
+    slot->notify_data = NULL;
+    g_atomic_int_set(&slot->notifying, 0);
+}
+
+// Wait until no reader is between loading slot->current and taking its ref.
+// Readers that arrive after the swap see the new pointer, so this is bounded
+// by the few instructions of snapshot_slot_acquire().
+static void wait_for_readers(SnapshotSlot *slot) {
+    int spins = 0;
+    while (g_atomic_int_get(&slot->active_readers) != 0) {
+        if (++spins > 64) {
+            g_thread_yield();
+            spins = 0;
+        }
+    }
+}
+
+void snapshot_slot_clear(SnapshotSlot *slot) {
+    Snapshot *old = g_atomic_pointer_get(&slot->current);
+    g_atomic_pointer_set(&slot->current, NULL);
+    wait_for_readers(slot);
+    snapshot_unref(old);
+}
+
+guint64 snapshot_slot_publish(SnapshotSlot *slot, UpdateData *data) {
+    Snapshot *snapshot = snapshot_new(data);
+    snapshot->sequence = slot->next_sequence++;
+
+    // The slot's reference moves from the old snapshot to the new one.
+    // Single writer, so a plain load + store is an exchange.
+    Snapshot *old = g_atomic_pointer_get(&slot->current);
+    if (old && old->data && data) {
+        snapshot->delta = process_delta_compute(old->data->processes, data->processes);
+    }
+    g_atomic_pointer_set(&slot->current, snapshot);
+    if (old) {
+        wait_for_readers(slot);
+        snapshot_unref(old);
+    }
+
+    guint64 sequence = snapshot->sequence;
+    g_atomic_int_inc(&slot->notifying);
+    SnapshotNotifyFunc notify = (SnapshotNotifyFunc)g_atomic_pointer_get(&slot->notify);
+    if (notify) notify(sequence, g_atomic_pointer_get(&slot->notify_data));
+    g_atomic_int_dec_and_test(&slot->notifying);
+    return sequence;
+}
+
+void snapshot_slot_set_notify(SnapshotSlot *slot, SnapshotNotifyFunc func, gpointer user_data) {
+    // Data first: a writer that sees the new function also sees its data
+    g_atomic_pointer_set(&slot->notify, NULL);
+    g_atomic_pointer_set(&slot->notify_data, user_data);
+    g_atomic_pointer_set(&slot->notify, (gpointer)func);
+
+    // A writer that loaded the old function may still be calling it
+    if (!func) {
+        while (g_atomic_int_get(&slot->notifying) != 0) g_thread_yield();
+    }
+}
+
+Snapshot* snapshot_slot_acquire(SnapshotSlot *slot) {
+    // The slot keeps its reference until every reader that may have loaded
+    // the old pointer has left this window, so the ref below is always safe
+    g_atomic_int_inc(&slot->active_readers);
+    Snapshot *snapshot = snapshot_ref(g_atomic_pointer_get(&slot->current));
+    g_atomic_int_add(&slot->active_readers, -1);
+    return snapshot;
+}
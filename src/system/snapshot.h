@@ -0,0 +1,59 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <glib.h>
+#include "../common/types.h"
+#include "process_delta.h"
+
+// Immutable, reference-counted view of one complete collection cycle.
+// The collector publishes a new snapshot per cycle; readers take a reference
+// instead of deep-copying the process list and must treat data as read-only.
+typedef struct {
+    UpdateData *data;           // Owned; freed with the last reference
+    guint64 sequence;           // Publication number, increases by one per publish
+    ProcessDelta *delta;        // Changes since snapshot sequence - 1 (NULL for the first)
+    gint ref_count;
+} Snapshot;
+
+// Wrap data (ownership transfers to the snapshot) with one reference
+Snapshot* snapshot_new(UpdateData *data);
+Snapshot* snapshot_ref(Snapshot *snapshot);
+void snapshot_unref(Snapshot *snapshot);
+
+// Called on the writer's thread right after a publish, with the new sequence.
+// Must not block: hand the work to another thread (e.g. wake a main loop).
+typedef void (*SnapshotNotifyFunc)(guint64 sequence, gpointer user_data);
+
+// Single-writer publication point. Readers never take a lock: acquire is a
+// few atomic operations and never waits for the writer. The writer swaps the
+// pointer and only waits for readers still inside acquire (a handful of
+// instructions) before dropping its reference to the old snapshot.
+typedef struct {
+    Snapshot *current;          // Accessed atomically
+    gint active_readers;        // Readers between pointer load and ref
+    guint64 next_sequence;      // Writer-only
+    SnapshotNotifyFunc notify;  // Accessed atomically
+    gpointer notify_data;
+    gint notifying;             // Writer inside the notify call
+} SnapshotSlot;
+
+void snapshot_slot_init(SnapshotSlot *slot);
+void snapshot_slot_clear(SnapshotSlot *slot);
+
+// Publish data as the latest snapshot (takes ownership); returns its sequence.
+// The process delta against the previous snapshot is computed here, once,
+// for every reader.
+guint64 snapshot_slot_publish(SnapshotSlot *slot, UpdateData *data);
+
+// Install the publish notification (NULL removes it). May be installed while
+// the writer runs - a publish racing with the call may go unnotified, so
+// check the slot once afterwards - but only swapped for another function
+// while it is stopped. Removing it waits for a notification in progress,
+// so user_data can be freed once this returns.
+void snapshot_slot_set_notify(SnapshotSlot *slot, SnapshotNotifyFunc func, gpointer user_data);
+
+// Reference to the latest snapshot, or NULL before the first publish.
+// Release with snapshot_unref().
+Snapshot* snapshot_slot_acquire(SnapshotSlot *slot);
+
+#endif // SNAPSHOT_H
@@ -0,0 +1,228 @@
+#include "collector_backend.h"
+#include "stream_source.h"
+#include "threaded_collector.h"
+#include "system.h"
+#include "../utils/utils.h"
+#include "../common/config.h"
+#include <string.h>
+
+// Streaming backend: one `top -l 0` and one `nettop -L 0` run for the whole
+// session and every collection parses the newest frame they have written.
+// Compared to the top backend this drops a fork/exec per cycle and the
+// one-second stall of `top -l 2 -s 1` (the CPU delta comes from top's own
+// running sample instead).
+//
+// TASKMINI_TOP_STREAM and TASKMINI_NETTOP_STREAM replace the commands (e.g.
+// a script replaying a recorded capture); an empty TASKMINI_NETTOP_STREAM
+// disables network rates.
+
+#define STREAM_INTERVAL G_STRINGIFY(STREAM_SAMPLE_INTERVAL_S)
+
+// Longest wait for a top frame: a relaunch plus the skipped startup sample
+#define STREAM_FRAME_TIMEOUT_MS (STREAM_RESTART_DELAY_MS + 3 * STREAM_SAMPLE_INTERVAL_S * 1000)
+
+typedef struct {
+    StreamSource *top;
+    StreamSource *nettop;           // NULL when disabled
+    guint64 top_sequence;           // Last frame consumed from each source
+    guint64 nettop_sequence;
+
+    LineScanner frame_lines;        // Private copy of a top frame, split in place
+    LineScanner net_lines;          // Same for nettop; refresh_network() runs beside collect()
+    PidMap *net_bytes;              // PID -> guint64 cumulative bytes in the last nettop frame
+    PidMap *net_bytes_next;         // Filled from the new frame, then swapped with net_bytes
+    PidMap *net_rates_next;         // Filled from the new frame, then swapped with net_rates
+    gint64 net_frame_us;            // When the last nettop frame was read
+    gboolean background;            // Both tools paused between collections
+
+    GMutex rates_mutex;             // Protects net_rates
+    PidMap *net_rates;              // PID -> guint64 bytes/s between the last two frames
+} StreamBackendState;
+
+// Lines starting a sample: macOS top, procps `top -b`
+static const char *const top_markers[] = { "Processes:", "top - ", NULL };
+// nettop -x repeats its CSV header before every sample
+static const char *const nettop_markers[] = { "time,", NULL };
+
+// Command from the environment, or the default. NULL if disabled.
+static char** stream_command(const char *env_name, const char *const *default_argv) {
+    const char *override = g_getenv(env_name);
+    if (!override) return g_strdupv((char **)default_argv);
+
+    char **argv = NULL;
+    if (*override == '\0' || !g_shell_parse_argv(override, NULL, &argv, NULL)) return NULL;
+    return argv;
+}
+
+static StreamSource* start_source(const char *env_name, const char *const *default_argv,
+                                  const char *const *markers, guint skip_frames) {
+    char **argv = stream_command(env_name, default_argv);
+    if (!argv) return NULL;
+    StreamSource *source = stream_source_start(argv, markers, skip_frames);
+    g_strfreev(argv);
+    return source;
+}
+
+static gboolean stream_backend_open(CollectorBackend *backend) {
+    static const char *const top_argv[] = {
+        "top", "-l", "0", "-s", STREAM_INTERVAL, "-o", "cpu", "-stats", "pid,command,cpu,mem,time", NULL
+    };
+    static const char *const nettop_argv[] = {
+        "nettop", "-P", "-x", "-L", "0", "-s", STREAM_INTERVAL, NULL
+    };
+
+    StreamBackendState *state = g_new0(StreamBackendState, 1);
+
+    // top's first sample has no CPU deltas yet
+    state->top = start_source("TASKMINI_TOP_STREAM", top_argv, top_markers, 1);
+    if (!state->top) {
+        g_free(state);
+        return FALSE;
+    }
+    state->nettop = start_source("TASKMINI_NETTOP_STREAM", nettop_argv, nettop_markers, 0);
+
+    line_scanner_init(&state->frame_lines, 256 * 1024);
+    line_scanner_init(&state->net_lines, 0);
+    state->net_bytes = pid_map_new(sizeof(guint64), 0);
+    state->net_bytes_next = pid_map_new(sizeof(guint64), 0);
+    state->net_rates = pid_map_new(sizeof(guint64), 0);
+    state->net_rates_next = pid_map_new(sizeof(guint64), 0);
+    g_mutex_init(&state->rates_mutex);
+    backend->state = state;
+    return TRUE;
+}
+
+// Load a frame into a private scanner; lines come back NUL-terminated
+static void load_frame(LineScanner *lines, GBytes *frame) {
+    gsize size;
+    const char *data = g_bytes_get_data(frame, &size);
+    line_scanner_reset(lines);
+    line_scanner_feed(lines, data, size);
+    line_scanner_finish(lines);
+}
+
+// nettop reports cumulative bytes; rates are the change between frames
+static void update_network_rates(StreamBackendState *state, GBytes *frame) {
+    gint64 now_us = g_get_monotonic_time();
+    double interval = state->net_frame_us > 0 ? (now_us - state->net_frame_us) / 1e6 : 0.0;
+    PidMap *bytes_now = state->net_bytes_next;
+    PidMap *rates_now = state->net_rates_next;
+
+    pid_map_clear(bytes_now);
+    pid_map_clear(rates_now);
+    load_frame(&state->net_lines, frame);
+
+    StrView line;
+    while (line_scanner_next(&state->net_lines, &line)) {
+        pid_t pid;
+        guint64 total;
+        if (!parse_nettop_line(line, &pid, &total) || total == 0) continue;
+
+        *(guint64*)pid_map_insert(bytes_now, pid) = total;
+
+        const guint64 *prev = pid_map_lookup(state->net_bytes, pid);
+        if (prev && interval > 0.3 && total > *prev) {  // Need at least 0.3 seconds
+            *(guint64*)pid_map_insert(rates_now, pid) = (guint64)((total - *prev) / interval);
+        }
+    }
+
+    // OPTIMIZATION: Both map pairs trade places; nothing is allocated per
+    // frame and collect() only waits for the swap
+    state->net_bytes_next = state->net_bytes;
+    state->net_bytes = bytes_now;
+    state->net_frame_us = now_us;
+    g_mutex_lock(&state->rates_mutex);
+    state->net_rates_next = state->net_rates;
+    state->net_rates = rates_now;
+    g_mutex_unlock(&state->rates_mutex);
+}
+
+static UpdateData* stream_backend_collect(CollectorBackend *backend) {
+    StreamBackendState *state = backend->state;
+
+    // OPTIMIZATION: In the background top only runs for the frame asked
+    // for. Otherwise returns at once when top already wrote a newer sample.
+    GBytes *frame = state->background
+        ? stream_source_wait_resumed_frame(state->top, &state->top_sequence, STREAM_FRAME_TIMEOUT_MS)
+        : stream_source_wait_frame(state->top, &state->top_sequence, STREAM_FRAME_TIMEOUT_MS);
+    if (!frame) return NULL;
+
+    TopFrameParser parser;
+    top_frame_parser_init(&parser);
+    load_frame(&state->frame_lines, frame);
+    g_bytes_unref(frame);
+
+    StrView line;
+    while (line_scanner_next(&state->frame_lines, &line) && top_frame_parser_feed(&parser, line)) {}
+    UpdateData *data = top_frame_parser_finish(&parser);
+
+    // Rates come from the last refresh_network() on the network period
+    if (state->nettop) {
+        ProcessTable *processes = data->processes;
+        g_mutex_lock(&state->rates_mutex);
+        for (guint i = 0; i < processes->count; i++) {
+            const guint64 *rate = pid_map_lookup(state->net_rates, processes->items[i].pid);
+            processes->items[i].net_bps = rate ? *rate : 0;
+        }
+        g_mutex_unlock(&state->rates_mutex);
+    }
+    return data;
+}
+
+// Take the newest nettop frame, if one arrived since the last refresh
+static void stream_backend_refresh_network(CollectorBackend *backend) {
+    StreamBackendState *state = backend->state;
+    if (!state->nettop) return;
+
+    GBytes *net_frame = stream_source_wait_frame(state->nettop, &state->nettop_sequence, 0);
+    if (net_frame) {
+        update_network_rates(state, net_frame);
+        g_bytes_unref(net_frame);
+    }
+}
+
+// OPTIMIZATION: Hidden window - top and nettop stay stopped instead of
+// sampling every interval for nobody; network rates are not sampled
+static void stream_backend_set_background(CollectorBackend *backend, gboolean background) {
+    StreamBackendState *state = backend->state;
+    state->background = background;
+    stream_source_set_paused(state->top, background);
+    stream_source_set_paused(state->nettop, background);
+    if (background) {
+        g_mutex_lock(&state->rates_mutex);
+        pid_map_clear(state->net_rates);  // Would go stale
+        g_mutex_unlock(&state->rates_mutex);
+    }
+}
+
+static void stream_backend_close(CollectorBackend *backend) {
+    StreamBackendState *state = backend->state;
+    if (!state) return;
+
+    stream_source_stop(state->top);
+    stream_source_stop(state->nettop);
+    line_scanner_clear(&state->frame_lines);
+    line_scanner_clear(&state->net_lines);
+    pid_map_free(state->net_bytes);
+    pid_map_free(state->net_bytes_next);
+    pid_map_free(state->net_rates);
+    pid_map_free(state->net_rates_next);
+    g_mutex_clear(&state->rates_mutex);
+    g_free(state);
+    backend->state = NULL;
+}
+
+static const CollectorBackendOps stream_backend_ops = {
+    .name = "stream",
+    .open = stream_backend_open,
+    .collect = stream_backend_collect,
+    .close = stream_backend_close,
+    .refresh_network = stream_backend_refresh_network,
+    .sample_gpu = collector_backend_sample_system_gpu,
+    .min_period_ms = STREAM_SAMPLE_INTERVAL_S * 1000,  // top writes one frame per interval
+    .set_background = stream_backend_set_background,
+};
+
+const CollectorBackendOps* collector_backend_stream_ops(void) {
+    return &stream_backend_ops;
+}
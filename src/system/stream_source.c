@@ -0,0 +1,254 @@
+#define _GNU_SOURCE
+#include "stream_source.h"
+#include "../utils/utils.h"
+#include "../utils/scanner.h"
+#include "../common/config.h"
+#include <errno.h>
+#include <poll.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#define STREAM_INITIAL_BUFFER (64 * 1024)
+#define STREAM_KILL_GRACE_MS 500        // SIGTERM to SIGKILL
+
+struct StreamSource {
+    char **argv;
+    char **markers;
+    guint skip_frames;
+    GThread *thread;
+
+    GMutex mutex;                   // Protects everything below
+    GCond cond;                     // New frame or stop
+    gboolean stop;
+    gboolean paused;                // Child kept stopped (SIGSTOP)
+    GBytes *frame;                  // Latest complete frame
+    guint64 sequence;               // Bumped per published frame
+    StreamSourceStats stats;
+};
+
+static gboolean stop_requested(StreamSource *source) {
+    g_mutex_lock(&source->mutex);
+    gboolean stop = source->stop;
+    g_mutex_unlock(&source->mutex);
+    return stop;
+}
+
+static gboolean is_frame_marker(StreamSource *source, StrView line) {
+    for (char **marker = source->markers; *marker; marker++) {
+        if (str_view_has_prefix(line, *marker)) return TRUE;
+    }
+    return FALSE;
+}
+
+// Per-launch parsing state
+typedef struct {
+    GString *frame;         // Lines of the frame being assembled
+    gboolean in_frame;      // A marker was seen; lines belong to a frame
+    guint skip;             // Startup frames still to drop
+} FrameBuilder;
+
+static void complete_frame(StreamSource *source, FrameBuilder *builder) {
+    if (builder->in_frame && builder->frame->len > 0) {
+        g_mutex_lock(&source->mutex);
+        if (builder->skip > 0) {
+            builder->skip--;
+            source->stats.skipped++;
+        } else {
+            // OPTIMIZATION: Readers take a reference; nothing is copied per reader
+            if (source->frame) g_bytes_unref(source->frame);
+            source->frame = g_bytes_new(builder->frame->str, builder->frame->len);
+            source->sequence++;
+            source->stats.frames++;
+            g_cond_broadcast(&source->cond);
+        }
+        g_mutex_unlock(&source->mutex);
+    }
+    g_string_truncate(builder->frame, 0);
+    builder->in_frame = FALSE;
+}
+
+static void add_line(StreamSource *source, FrameBuilder *builder, StrView line) {
+    if (is_frame_marker(source, line)) {
+        complete_frame(source, builder);
+        builder->in_frame = TRUE;
+    }
+    if (!builder->in_frame) return;  // Output before the first marker
+
+    // SECURITY: A runaway frame is dropped rather than buffered without bound
+    if (builder->frame->len + line.len + 1 > MAX_STREAM_FRAME_SIZE) {
+        g_string_truncate(builder->frame, 0);
+        builder->in_frame = FALSE;
+        return;
+    }
+    g_string_append_len(builder->frame, line.ptr, (gssize)line.len);
+    g_string_append_c(builder->frame, '\n');
+}
+
+// Read frames from one launch of the child until it exits or we stop
+static void read_frames(StreamSource *source, int fd) {
+    LineScanner scanner;
+    line_scanner_init(&scanner, STREAM_INITIAL_BUFFER);
+    FrameBuilder builder = { g_string_sized_new(STREAM_INITIAL_BUFFER), FALSE, source->skip_frames };
+    struct pollfd pfd = { .fd = fd, .events = POLLIN };
+    StrView line;
+
+    while (!stop_requested(source)) {
+        int ready = poll(&pfd, 1, STREAM_STOP_CHECK_MS);
+        if (ready < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        if (ready == 0) continue;
+
+        if (!line_scanner_fill_fd(&scanner, fd)) {
+            // EOF ends the last frame like a marker would
+            while (line_scanner_next(&scanner, &line)) add_line(source, &builder, line);
+            complete_frame(source, &builder);
+            break;
+        }
+        while (line_scanner_next(&scanner, &line)) add_line(source, &builder, line);
+    }
+
+    // A frame cut off by a stop is incomplete; drop it
+    g_string_free(builder.frame, TRUE);
+    line_scanner_clear(&scanner);
+}
+
+// The child is not reaped until here, so its pid cannot have been reused
+static void reap_child(GPid pid) {
+    kill(pid, SIGTERM);
+    kill(pid, SIGCONT);  // A paused child only acts on SIGTERM once continued
+
+    for (int waited = 0; waitpid(pid, NULL, WNOHANG) == 0; waited += 10) {
+        if (waited >= STREAM_KILL_GRACE_MS) {
+            kill(pid, SIGKILL);
+            waitpid(pid, NULL, 0);
+            break;
+        }
+        g_usleep(10000);
+    }
+    g_spawn_close_pid(pid);
+}
+
+// Sleep for the restart delay unless stopped first
+static void wait_before_restart(StreamSource *source) {
+    gint64 deadline = g_get_monotonic_time() + STREAM_RESTART_DELAY_MS * G_TIME_SPAN_MILLISECOND;
+    g_mutex_lock(&source->mutex);
+    while (!source->stop && g_cond_wait_until(&source->cond, &source->mutex, deadline)) {}
+    g_mutex_unlock(&source->mutex);
+}
+
+static gpointer stream_reader_thread(gpointer data) {
+    StreamSource *source = data;
+    gboolean launched = FALSE;
+
+    while (!stop_requested(source)) {
+        GPid pid;
+        int fd;
+        if (tracked_spawn_reader(source->argv, &pid, &fd)) {
+            g_mutex_lock(&source->mutex);
+            if (launched) source->stats.restarts++;
+            source->stats.pid = pid;
+            if (source->paused) kill(pid, SIGSTOP);
+            g_mutex_unlock(&source->mutex);
+            launched = TRUE;
+
+            read_frames(source, fd);
+            close(fd);
+
+            // Cleared before reaping: set_paused() never signals a reused pid
+            g_mutex_lock(&source->mutex);
+            source->stats.pid = 0;
+            g_mutex_unlock(&source->mutex);
+            reap_child(pid);
+        }
+        wait_before_restart(source);
+    }
+    return NULL;
+}
+
+StreamSource* stream_source_start(char **argv, const char *const *frame_markers, guint skip_frames) {
+    if (!argv || !argv[0] || !frame_markers || !frame_markers[0]) return NULL;
+
+    StreamSource *source = g_new0(StreamSource, 1);
+    source->argv = g_strdupv(argv);
+    source->markers = g_strdupv((char **)frame_markers);
+    source->skip_frames = skip_frames;
+    g_mutex_init(&source->mutex);
+    g_cond_init(&source->cond);
+    source->thread = g_thread_new("stream_source", stream_reader_thread, source);
+    return source;
+}
+
+void stream_source_stop(StreamSource *source) {
+    if (!source) return;
+
+    g_mutex_lock(&source->mutex);
+    source->stop = TRUE;
+    g_cond_broadcast(&source->cond);
+    g_mutex_unlock(&source->mutex);
+    g_thread_join(source->thread);
+
+    if (source->frame) g_bytes_unref(source->frame);
+    g_strfreev(source->argv);
+    g_strfreev(source->markers);
+    g_cond_clear(&source->cond);
+    g_mutex_clear(&source->mutex);
+    g_free(source);
+}
+
+void stream_source_set_paused(StreamSource *source, gboolean paused) {
+    if (!source) return;
+
+    g_mutex_lock(&source->mutex);
+    if (source->paused != paused) {
+        source->paused = paused;
+        if (source->stats.pid > 0) kill(source->stats.pid, paused ? SIGSTOP : SIGCONT);
+    }
+    g_mutex_unlock(&source->mutex);
+}
+
+GBytes* stream_source_wait_frame(StreamSource *source, guint64 *sequence, guint timeout_ms) {
+    if (!source || !sequence) return NULL;
+
+    gint64 deadline = g_get_monotonic_time() + (gint64)timeout_ms * G_TIME_SPAN_MILLISECOND;
+    GBytes *frame = NULL;
+
+    g_mutex_lock(&source->mutex);
+    while (source->sequence == *sequence && !source->stop &&
+           g_cond_wait_until(&source->cond, &source->mutex, deadline)) {}
+    if (source->sequence != *sequence && source->frame) {
+        frame = g_bytes_ref(source->frame);
+        *sequence = source->sequence;
+    }
+    g_mutex_unlock(&source->mutex);
+    return frame;
+}
+
+GBytes* stream_source_wait_resumed_frame(StreamSource *source, guint64 *sequence, guint timeout_ms) {
+    if (!source || !sequence) return NULL;
+
+    gint64 deadline = g_get_monotonic_time() + (gint64)timeout_ms * G_TIME_SPAN_MILLISECOND;
+    GBytes *stale = stream_source_wait_frame(source, sequence, 0);  // Published while paused
+    if (stale) g_bytes_unref(stale);
+
+    // The first frame after the resume was written before the pause
+    stream_source_set_paused(source, FALSE);
+    GBytes *frame = NULL;
+    for (int wanted = 0; wanted < 2; wanted++) {
+        if (frame) g_bytes_unref(frame);
+        gint64 left_ms = (deadline - g_get_monotonic_time()) / G_TIME_SPAN_MILLISECOND;
+        frame = stream_source_wait_frame(source, sequence, (guint)MAX(left_ms, 0));
+        if (!frame) break;
+    }
+    stream_source_set_paused(source, TRUE);
+    return frame;
+}
+
+void stream_source_get_stats(StreamSource *source, StreamSourceStats *stats) {
+    if (!source || !stats) return;
+    g_mutex_lock(&source->mutex);
+    *stats = source->stats;
+    g_mutex_unlock(&source->mutex);
+}
@@ -0,0 +1,51 @@
+#ifndef STREAM_SOURCE_H
+#define STREAM_SOURCE_H
+
+#include <glib.h>
+
+// Long-lived child process whose output is an endless series of frames
+// (`top -l 0`, `nettop -L 0`). A reader thread splits the output into
+// frames as it streams in and keeps the latest complete one; when the child
+// exits it is relaunched. One launch serves a whole session instead of one
+// launch (and one startup sample) per collection cycle.
+//
+// A frame starts at a line beginning with one of the markers and ends at
+// the next marker or when the child's output ends.
+typedef struct StreamSource StreamSource;
+
+typedef struct {
+    guint64 frames;         // Frames published
+    guint64 skipped;        // Startup frames discarded (see skip_frames)
+    guint64 restarts;       // Relaunches after the child exited
+    GPid pid;               // Current child, 0 while not running
+} StreamSourceStats;
+
+// argv is exec'd without a shell and copied; frame_markers is a
+// NULL-terminated list of line prefixes. The first skip_frames frames after
+// every launch are dropped (top's first sample has no CPU deltas).
+StreamSource* stream_source_start(char **argv, const char *const *frame_markers, guint skip_frames);
+
+// Terminates the child and joins the reader thread
+void stream_source_stop(StreamSource *source);
+
+// Stop the child with SIGSTOP (relaunches start stopped too) or let it run
+// again. A paused tool costs no CPU; once resumed it finishes the interval
+// it was sleeping through and writes a sample covering the whole pause.
+// A frame is only complete when the next one starts, so the first frame
+// published after the resume is the one written before the pause.
+void stream_source_set_paused(StreamSource *source, gboolean paused);
+
+// Wait up to timeout_ms for a frame newer than *sequence. Returns the frame
+// text (lines terminated by '\n') and advances *sequence, or NULL on
+// timeout. Start with *sequence = 0. Release with g_bytes_unref().
+GBytes* stream_source_wait_frame(StreamSource *source, guint64 *sequence, guint timeout_ms);
+
+// For a paused source: resume the child, drop the frame it wrote before
+// the pause and wait up to timeout_ms for the next one, sampled after the
+// resume (about one interval later); then pause it again. Returns NULL on
+// timeout, like stream_source_wait_frame().
+GBytes* stream_source_wait_resumed_frame(StreamSource *source, guint64 *sequence, guint timeout_ms);
+
+void stream_source_get_stats(StreamSource *source, StreamSourceStats *stats);
+
+#endif // STREAM_SOURCE_H
@@ -3,19 +3,41 @@
 
 #include <glib.h>
 #include "../common/types.h"
+#include "../utils/pid_map.h"
+#include "../utils/scanner.h"
 
 // System information functions
 char* get_static_specs(void);
 
+// Streaming reader for `top -l 2` output. Only lines of the second sample
+// are returned (the first has no CPU deltas yet); each line is a view into
+// the read buffer, NUL-terminated, valid until the next call.
+#define TOP_SAMPLE_COUNT 2
+#define TOP_MAX_FIELDS 20
+typedef struct {
+    FILE *fp;
+    LineScanner scanner;
+    guint sample;           // "Processes:" headers seen so far
+} TopReader;
+
+gboolean top_reader_open(TopReader *reader);
+gboolean top_reader_next(TopReader *reader, StrView *line);
+void top_reader_close(TopReader *reader);
+
 // Process monitoring functions
-char* get_top_output(void);
 gpointer update_thread_func(gpointer data);
 gboolean is_system_process(const char *name, const char *pid);
-void determine_process_type(Process *proc);
+gboolean classify_system_process(const char *name, int pid, int uid);
+void apply_process_type(ProcessSample *proc, gboolean is_system);
+void determine_process_type(ProcessSample *proc);
+void fill_process_metadata(ProcessSample *proc);
+gboolean parse_top_process_fields(StrView line, ProcessSample *proc);
+gboolean parse_top_process_line(const char *line, ProcessSample *proc);
 char* get_run_time(const char *pid);
 
 // GPU monitoring functions
 char* get_gpu_usage(void);
+char* sample_gpu_usage(void);
 char* get_gpu_usage_fallback(void);
 
 // System-wide usage functions
@@ -23,7 +45,8 @@ float get_system_cpu_usage(void);
 float get_system_memory_usage(void);
 
 // Network monitoring functions
-long long get_net_bytes(const char *pid);
+long long get_net_bytes(pid_t pid);
+gboolean parse_nettop_line(StrView line, pid_t *pid, guint64 *total_bytes);
 void collect_all_network_data(void);
 
 // Global variables (declared in system/process.c)
@@ -35,7 +58,7 @@ extern int gpu_check_interval;
 
 // Network cache globals
 extern time_t last_net_collection;
-extern GHashTable *net_cache;
+extern PidMap *net_cache;
 
 // System-wide network tracking
 extern long long prev_system_bytes_in;
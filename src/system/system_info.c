@@ -1,11 +1,15 @@
+#define _GNU_SOURCE
 #include "system.h"
 #include "performance.h"
+#include "process_meta.h"
 #include "../utils/utils.h"
 #include "../common/config.h"
 #include <unistd.h>
 #include <ctype.h>
+#ifdef __APPLE__
 #include <sys/sysctl.h>
 #include <mach/mach.h>
+#endif
 
 // Global variable for CPU core count
 int cpu_cores = 0;
@@ -40,7 +44,7 @@ char* get_static_specs(void) {
     
     // Get CPU core count for percentage normalization
     char *cores_str = run_command("sysctl -n hw.ncpu");
-    cpu_cores = atoi(cores_str);
+    g_atomic_int_set(&cpu_cores, atoi(cores_str));  // Read by the process source meanwhile
     free(cores_str);
 
     // Simplify CPU name (remove technical details)
@@ -96,61 +100,51 @@ char* get_static_specs(void) {
     return specs;
 }
 
-// Get elapsed run time for a PID using ps -o etime=
+// Get elapsed run time for a PID (metadata cache, ps -o etime= as fallback)
 char* get_run_time(const char *pid) {
+    // OPTIMIZATION: Start time comes from the batched metadata pass - no fork
+    ProcessMeta meta;
+    if (process_meta_lookup(atoi(pid), &meta)) {
+        char buf[32];
+        format_elapsed_time((long long)(time(NULL) - meta.start_time), buf, sizeof(buf));
+        return strdup(buf);
+    }
+    
     char cmd[50];
     sprintf(cmd, "ps -p %s -o etime=", pid);
     return run_command(cmd);
 }
 
-// Function to get top output with better CPU sampling
-char* get_top_output(void) {
-    FILE *fp;
-    char *buffer = malloc(65536);  // Much larger buffer for all processes
-    size_t buffer_size = 65536;
-    size_t total_len = 0;
-    size_t bytes_read = 0;
-    char chunk[1024];
-    
-    buffer[0] = '\0';
-
-    // Take 2 samples 1 second apart for better CPU calculation
-    // Remove -n limit to show ALL processes like a real task manager
-    fp = popen("top -l 2 -s 1 -o cpu -stats pid,command,cpu,mem,time", "r");
-    if (fp == NULL) {
+// Start `top` with better CPU sampling: 2 samples 1 second apart, all processes
+gboolean top_reader_open(TopReader *reader) {
+    memset(reader, 0, sizeof(*reader));
+    reader->fp = tracked_popen("top -l 2 -s 1 -o cpu -stats pid,command,cpu,mem,time", "r");
+    if (!reader->fp) {
         perror("popen failed");
-        exit(1);
+        return FALSE;
     }
+    line_scanner_init(&reader->scanner, 64 * 1024);
+    return TRUE;
+}
 
-    while ((bytes_read = fread(chunk, 1, sizeof(chunk), fp)) > 0) {
-        if (total_len + bytes_read + 1 > buffer_size) {
-            buffer_size *= 2;
-            buffer = realloc(buffer, buffer_size);
-        }
-        memcpy(buffer + total_len, chunk, bytes_read);
-        total_len += bytes_read;
-        buffer[total_len] = '\0';
+// OPTIMIZATION: Lines are parsed as top writes them; the first sample is
+// skipped line by line instead of being buffered and searched afterwards
+gboolean top_reader_next(TopReader *reader, StrView *line) {
+    while (line_scanner_read_line(&reader->scanner, reader->fp, line)) {
+        if (str_view_has_prefix(*line, "Processes:")) reader->sample++;
+        if (reader->sample >= TOP_SAMPLE_COUNT) return TRUE;
     }
+    return FALSE;
+}
 
-    pclose(fp);
-    
-    // Find the second sample by looking for the second occurrence of "Processes:"
-    char *first_processes = strstr(buffer, "Processes:");
-    if (first_processes) {
-        char *second_processes = strstr(first_processes + 1, "Processes:");
-        if (second_processes) {
-            // Return from the second sample which has better CPU data
-            return strdup(second_processes);
-        }
-    }
-    
-    // If we can't find second sample, return the whole output
-    return buffer;
+void top_reader_close(TopReader *reader) {
+    if (reader->fp) pclose(reader->fp);
+    line_scanner_clear(&reader->scanner);
+    reader->fp = NULL;
 }
 
-// Determine if a process is a critical system process
-gboolean is_system_process(const char *name, const char *pid) {
-    // Critical system processes that should not be killed
+// Critical system processes that should not be killed
+static gboolean is_known_system_name(const char *name) {
     const char *system_processes[] = {
         "kernel_task", "launchd", "SystemUIServer", "Dock", "Finder", 
         "WindowServer", "loginwindow", "cfprefsd", "systemstats",
@@ -165,16 +159,50 @@ gboolean is_system_process(const char *name, const char *pid) {
         NULL
     };
     
-    // Check against known system process names
     for (int i = 0; system_processes[i] != NULL; i++) {
         if (strstr(name, system_processes[i]) != NULL) {
             return TRUE;
         }
     }
+    return FALSE;
+}
+
+// Classify a process from attributes the caller already has (uid -1 = unknown).
+// Never spawns a subprocess, so native backends can call it for every row.
+gboolean classify_system_process(const char *name, int pid, int uid) {
+    if (!name) return FALSE;
+    
+    // Check against known system process names
+    if (is_known_system_name(name)) {
+        return TRUE;
+    }
     
     // Check if PID is very low (typically system processes)
+    if (pid <= 10 && pid > 0) {
+        return TRUE;
+    }
+    
+    // Root process - likely system, but check if it's a user-launched root process
+    if (uid == 0) {
+        if (strstr(name, "sudo") != NULL || 
+            strstr(name, "Terminal") != NULL ||
+            strstr(name, "iTerm") != NULL) {
+            return FALSE; // User-launched root process
+        }
+        return TRUE;
+    }
+    
+    return FALSE;
+}
+
+// Determine if a process is a critical system process
+gboolean is_system_process(const char *name, const char *pid) {
+    if (!name || !pid) return FALSE;  // SECURITY: Null pointer check
+    
     int pid_num = atoi(pid);
-    if (pid_num <= 10 && pid_num > 0) {
+    
+    // Cheap checks first - avoids spawning ps for most system processes
+    if (classify_system_process(name, pid_num, -1)) {
         return TRUE;
     }
     
@@ -183,6 +211,7 @@ gboolean is_system_process(const char *name, const char *pid) {
     sprintf(cmd, "ps -p %s -o uid= 2>/dev/null", pid);
     char *uid_str = run_command(cmd);
     
+    int uid = -1;
     // Only process UID if we got valid output from ps command
     if (uid_str && strlen(uid_str) > 0 && strstr(uid_str, "N/A") == NULL) {
         // Strip whitespace and verify we have numeric content
@@ -191,51 +220,116 @@ gboolean is_system_process(const char *name, const char *pid) {
         
         // Check if the result is actually a number
         if (*trimmed >= '0' && *trimmed <= '9') {
-            int uid = atoi(trimmed);
-            if (uid == 0) {
-                // Root process - likely system, but check if it's a user-launched root process
-                if (strstr(name, "sudo") != NULL || 
-                    strstr(name, "Terminal") != NULL ||
-                    strstr(name, "iTerm") != NULL) {
-                    free(uid_str);
-                    return FALSE; // User-launched root process
-                }
-                free(uid_str);
-                return TRUE;
-            } else {
-                free(uid_str);
-                return FALSE;
-            }
+            uid = atoi(trimmed);
         }
     }
     if (uid_str) free(uid_str);
     
-    return FALSE;
+    return classify_system_process(name, pid_num, uid);
+}
+
+// Set the system flag from a system/user decision
+void apply_process_type(ProcessSample *proc, gboolean is_system) {
+    if (!proc) return;  // SECURITY: Null pointer check
+    
+    if (is_system) {
+        proc->flags |= PROCESS_FLAG_SYSTEM;
+    } else {
+        proc->flags &= ~PROCESS_FLAG_SYSTEM;
+    }
 }
 
 // Determine and set the process type - SECURED with bounds checking
-void determine_process_type(Process *proc) {
+void determine_process_type(ProcessSample *proc) {
     if (!proc) return;  // SECURITY: Null pointer check
     
-    if (is_system_process(proc->name, proc->pid)) {
-        safe_strncpy(proc->type, "🛡️ System", sizeof(proc->type));
-        proc->is_system = TRUE;
+    // OPTIMIZATION: UID comes from the batched metadata pass - no ps per row
+    if (proc->uid != PROCESS_UID_UNKNOWN) {
+        apply_process_type(proc, classify_system_process(process_name(proc), proc->pid, proc->uid));
+        return;
+    }
+    
+    char pid_str[16];
+    snprintf(pid_str, sizeof(pid_str), "%d", (int)proc->pid);
+    apply_process_type(proc, is_system_process(process_name(proc), pid_str));
+}
+
+// Fill start time, UID and type from the metadata cache (see process_meta_refresh)
+void fill_process_metadata(ProcessSample *proc) {
+    if (!proc) return;
+    
+    ProcessMeta meta;
+    if (process_meta_lookup(proc->pid, &meta)) {
+        proc->uid = meta.uid;
+        proc->start_time = meta.start_time;
+        proc->flags |= PROCESS_FLAG_HAS_START;
     } else {
-        safe_strncpy(proc->type, "User", sizeof(proc->type));
-        proc->is_system = FALSE;
+        proc->uid = PROCESS_UID_UNKNOWN;
     }
+    
+    determine_process_type(proc);
+}
+
+// Parse one process line of `top -stats pid,command,cpu,mem,time` output.
+// Fields are taken from the end because the command name may contain spaces.
+gboolean parse_top_process_fields(StrView line, ProcessSample *proc) {
+    if (!proc || line.len == 0 || !isdigit((unsigned char)line.ptr[0])) return FALSE;
+    
+    // OPTIMIZATION: Views into the line - no copy, no strtok, no atof
+    StrView fields[TOP_MAX_FIELDS];
+    guint count = str_view_split_fields(line, fields, TOP_MAX_FIELDS);
+    if (count < 5) return FALSE;  // Need at least PID, NAME, CPU, MEM, TIME
+    
+    gint64 pid;
+    if (!str_view_to_int64(fields[0], &pid) || pid < 0 || pid > G_MAXINT32) return FALSE;
+    
+    memset(proc, 0, sizeof(*proc));
+    proc->pid = (pid_t)pid;
+    
+    // SECURITY: Clamp CPU values to reasonable range, then normalize per core
+    double cpu_value = 0.0;
+    str_view_to_double(fields[count - 3], &cpu_value);
+    float raw_cpu = (float)cpu_value;
+    if (raw_cpu < 0) raw_cpu = 0;
+    if (raw_cpu > 999.9) raw_cpu = 999.9;
+    int cores = g_atomic_int_get(&cpu_cores);
+    proc->cpu = raw_cpu / (cores > 0 ? cores : 1);
+    
+    // Memory like "1024M", "512K", "2.5G" (top may append '+'/'-')
+    guint64 mem_bytes = 0;
+    str_view_to_size(fields[count - 2], &mem_bytes);
+    proc->rss_bytes = mem_bytes;
+    
+    // SECURITY: Bounded command name, words joined by single spaces
+    char name[STRING_INTERN_MAX];
+    gsize name_len = 0;
+    for (guint i = 1; i + 3 < count && i < 10; i++) {
+        if (i > 1 && name_len + 1 < sizeof(name)) name[name_len++] = ' ';
+        gsize copy = MIN(fields[i].len, sizeof(name) - 1 - name_len);
+        memcpy(name + name_len, fields[i].ptr, copy);
+        name_len += copy;
+    }
+    process_set_name(proc, name, (gssize)name_len);
+    
+    proc->uid = PROCESS_UID_UNKNOWN;
+    return TRUE;
+}
+
+gboolean parse_top_process_line(const char *line, ProcessSample *proc) {
+    return line && parse_top_process_fields(str_view_from_cstr(line), proc);
 }
 
 // Get system-wide CPU usage percentage (optimized)
 float get_system_cpu_usage(void) {
-    // Use optimized version first
+    // Use optimized version first. 0% is a valid reading; only a negative
+    // value means the tick counters are unavailable
     double cpu_fast = get_system_cpu_usage_fast();
-    if (cpu_fast > 0.0) {
+    if (cpu_fast >= 0.0) {
         return (float)cpu_fast;
     }
     
     // Fallback to traditional method if needed
-    FILE *fp = popen("top -l 1 -n 0 | grep 'CPU usage:'", "r");
+    FILE *fp = tracked_popen("top -l 1 -n 0 | grep 'CPU usage:'", "r");
     if (!fp) return 0.0;
     
     char line[256];
@@ -276,7 +370,7 @@ float get_system_memory_usage(void) {
     if (total_bytes == 0) return 0.0;
     
     // Get used pages using Activity Monitor's method: sum of active, inactive, speculative, wired, and compressed
-    FILE *fp = popen("vm_stat | awk 'BEGIN{total=0} /Pages active|Pages inactive|Pages speculative|Pages wired down|Pages occupied by compressor/ {gsub(/[^0-9]/, \"\", $NF); total+=$NF} END{print total}'", "r");
+    FILE *fp = tracked_popen("vm_stat | awk 'BEGIN{total=0} /Pages active|Pages inactive|Pages speculative|Pages wired down|Pages occupied by compressor/ {gsub(/[^0-9]/, \"\", $NF); total+=$NF} END{print total}'", "r");
     if (!fp) return 0.0;
     
     char buffer[64];
@@ -293,7 +387,7 @@ float get_system_memory_usage(void) {
     long used_pages = atol(buffer);
     
     // Get actual page size from vm_stat header
-    FILE *fp2 = popen("vm_stat | head -1 | grep -o '[0-9]*' | tail -1", "r");
+    FILE *fp2 = tracked_popen("vm_stat | head -1 | grep -o '[0-9]*' | tail -1", "r");
     if (!fp2) return 0.0;
     
     char page_size_str[32];
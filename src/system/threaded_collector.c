@@ -1,6 +1,7 @@
 #include "threaded_collector.h"
 #include "system.h"
 #include "performance.h"
+#include "process_meta.h"
 #include "../utils/utils.h"
 #include "../common/config.h"
 #include <time.h>
@@ -12,36 +13,48 @@
 // Global collector instance
 static ThreadedCollector *g_collector = NULL;
 
-// Helper function to parse process line for basic info only (fast)
-Process* parse_process_line_basic(const char *line) {
-    if (!line || strlen(line) < 10) return NULL;
-    
-    // Parse the top output line - similar to original but only extract basics
-    char pid_str[20] = "";
-    char name[100] = "";
+// Collection tasks and their expected cost per cycle
+static const struct {
+    const char *name;
+    WorkerTaskFunc func;
+    guint budget_ms;
+} collector_task_defs[COLLECTOR_TASK_COUNT] = {
+    [COLLECTOR_TASK_PROCESS] = { "process", collect_process_list_task, 1500 },  // top -l 2 -s 1
+    [COLLECTOR_TASK_CPU]     = { "cpu",     collect_cpu_data_task,     200 },
+    [COLLECTOR_TASK_MEMORY]  = { "memory",  collect_memory_data_task,  200 },
+    [COLLECTOR_TASK_GPU]     = { "gpu",     collect_gpu_data_task,     500 },
+    [COLLECTOR_TASK_NETWORK] = { "network", collect_network_data_task, 1000 },
+};
+
+// Metric sources of the continuous collector: period and expected cost
+static void sample_processes_source(gpointer data);
+static void sample_network_source(gpointer data);
+static void sample_gpu_source(gpointer data);
+static void sample_specs_source(gpointer data);
+
+static const struct {
+    const char *name;
+    SampleFunc func;
+    guint period_ms;
+    guint cost_ms;
+} collector_source_defs[COLLECTOR_SOURCE_COUNT] = {
+    [COLLECTOR_SOURCE_PROCESSES] = { "processes", sample_processes_source, SAMPLE_PERIOD_PROCESSES_MS, 50 },
+    [COLLECTOR_SOURCE_NETWORK]   = { "network",   sample_network_source,   SAMPLE_PERIOD_NETWORK_MS,   5 },     // Frame already read
+    [COLLECTOR_SOURCE_GPU]       = { "gpu",       sample_gpu_source,       SAMPLE_PERIOD_GPU_MS,       200 },   // powermetrics -i100
+    [COLLECTOR_SOURCE_SPECS]     = { "specs",     sample_specs_source,     0,                          3000 },  // system_profiler
+};
+
+// Helper function to parse a top process line into a sample (fast)
+gboolean parse_process_line_basic(StrView line, ProcessSample *proc) {
+    if (line.len < 10) return FALSE;
     
-    // Top format: PID COMMAND %CPU TIME #TH #WQ #PORT MEM PURG CMPRS PGRP PPID STATE BOOSTS %CPU_ME %CPU_OTHERS UID FAULTS COW MSGSENT MSGRECV SYSBSD SYSMACH CSW PAGEINS USER #MREGS RPRVT VPRVT VSIZE KPRVT KSHRD
-    if (sscanf(line, "%19s %99s", pid_str, name) >= 2) {
-        Process *proc = alloc_process();
-        if (proc) {
-            safe_strncpy(proc->pid, pid_str, sizeof(proc->pid));
-            safe_strncpy(proc->name, name, sizeof(proc->name));
-            
-            // Determine process type
-            determine_process_type(proc);
-            
-            // Set default placeholder values
-            safe_strncpy(proc->cpu, "...", sizeof(proc->cpu));
-            safe_strncpy(proc->mem, "...", sizeof(proc->mem));
-            safe_strncpy(proc->gpu, "...", sizeof(proc->gpu));
-            safe_strncpy(proc->net, "...", sizeof(proc->net));
-            safe_strncpy(proc->runtime, get_run_time(proc->pid), sizeof(proc->runtime));
-            
-            return proc;
-        }
+    if (!parse_top_process_fields(line, proc)) {
+        return FALSE;
     }
     
-    return NULL;
+    // Start time, UID and type from the batched metadata pass
+    fill_process_metadata(proc);
+    return TRUE;
 }
 
 // Create a new threaded collector
@@ -64,12 +77,12 @@ ThreadedCollector* threaded_collector_create(void) {
     g_mutex_init(&collector->network_data->mutex);
     g_mutex_init(&collector->coordinator_mutex);
     
-    // Initialize hash tables
-    collector->cpu_data->process_cpu = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_free);
-    collector->memory_data->process_memory = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_free);
-    collector->network_data->process_network = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_free);
-    collector->network_data->prev_net_bytes = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_free);
-    collector->network_data->prev_times = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_free);
+    // OPTIMIZATION: Per-PID maps with inline values instead of hash tables
+    // keyed by PID strings (no allocation per process per cycle)
+    collector->cpu_data->process_cpu = pid_map_new(sizeof(float), 0);
+    collector->memory_data->process_memory = pid_map_new(sizeof(long long), 0);
+    collector->network_data->process_network = pid_map_new(sizeof(double), 0);
+    collector->network_data->net_counters = rate_store_new(0);
     
     // Set all states to idle
     collector->process_list->state = THREAD_STATE_IDLE;
@@ -78,12 +91,23 @@ ThreadedCollector* threaded_collector_create(void) {
     collector->gpu_data->state = THREAD_STATE_IDLE;
     collector->network_data->state = THREAD_STATE_IDLE;
     
+    // Tasks for the worker pool; the pool itself starts with the first cycle
+    worker_batch_init(&collector->batch);
+    for (int i = 0; i < COLLECTOR_TASK_COUNT; i++) {
+        collector->tasks[i].name = collector_task_defs[i].name;
+        collector->tasks[i].func = collector_task_defs[i].func;
+        collector->tasks[i].data = collector;
+        collector->tasks[i].budget_ms = collector_task_defs[i].budget_ms;
+    }
+    
     // Initialize collector/bin system
-    collector->data_bin = NULL;
-    g_mutex_init(&collector->bin_mutex);
+    snapshot_slot_init(&collector->data_bin);
     collector->collector_thread = NULL;
     collector->continuous_mode = FALSE;
     
+    // OPTIMIZATION: Pick the native backend where available (no fork/exec per sample)
+    collector->backend = collector_backend_create_default();
+    
     collector->shutdown_requested = FALSE;
     
     return collector;
@@ -93,32 +117,32 @@ ThreadedCollector* threaded_collector_create(void) {
 void threaded_collector_destroy(ThreadedCollector *collector) {
     if (!collector) return;
     
-    // Signal shutdown
+    // Signal shutdown; the scheduler wakes at once instead of finishing its sleep
     g_mutex_lock(&collector->coordinator_mutex);
     collector->shutdown_requested = TRUE;
     g_mutex_unlock(&collector->coordinator_mutex);
+    sample_scheduler_stop(collector->scheduler);
     
-    // Wait for threads to complete (with timeout)
-    if (collector->process_thread) {
-        g_thread_join(collector->process_thread);
-    }
-    if (collector->cpu_thread) {
-        g_thread_join(collector->cpu_thread);
-    }
-    if (collector->memory_thread) {
-        g_thread_join(collector->memory_thread);
-    }
-    if (collector->gpu_thread) {
-        g_thread_join(collector->gpu_thread);
-    }
-    if (collector->network_thread) {
-        g_thread_join(collector->network_thread);
-    }
-    
-    // Wait for continuous collector thread
+    // Wait for continuous collector thread; it returns once the sources
+    // running on the pool are done
     if (collector->collector_thread) {
         g_thread_join(collector->collector_thread);
     }
+    sample_scheduler_free(collector->scheduler);
+    collector->scheduler = NULL;
+    
+    // Let the running cycle finish (tasks stop early on shutdown), then
+    // stop the workers
+    worker_batch_wait(&collector->batch);
+    worker_pool_free(collector->pool);
+    collector->pool = NULL;
+    worker_batch_clear(&collector->batch);
+    g_free(collector->gpu_usage);
+    g_free(collector->static_specs);
+    
+    // Backend is only used by the collector thread, safe to release now
+    collector_backend_destroy(collector->backend);
+    collector->backend = NULL;
     
     // Cleanup result data
     cleanup_process_list_result(collector->process_list);
@@ -127,41 +151,50 @@ void threaded_collector_destroy(ThreadedCollector *collector) {
     cleanup_gpu_data_result(collector->gpu_data);
     cleanup_network_data_result(collector->network_data);
     
-    // Cleanup data bin
-    g_mutex_lock(&collector->bin_mutex);
-    if (collector->data_bin) {
-        free_update_data(collector->data_bin);
-        collector->data_bin = NULL;
-    }
-    g_mutex_unlock(&collector->bin_mutex);
+    // Drop the published snapshot; readers holding references keep it alive
+    snapshot_slot_clear(&collector->data_bin);
     
     // Cleanup mutexes
     g_mutex_clear(&collector->coordinator_mutex);
-    g_mutex_clear(&collector->bin_mutex);
     
     g_free(collector);
 }
 
-// Start data collection in all threads
+// Workers shared by the collection tasks, the continuous collector's
+// sources and the backend's parallel scans
+static WorkerPool* collector_pool(ThreadedCollector *collector) {
+    if (!collector->pool) {
+        // Every task or source can run at once (they mostly wait on child
+        // processes), and the /proc scan still gets a worker per other core
+        guint sources = MAX((guint)COLLECTOR_TASK_COUNT, (guint)COLLECTOR_SOURCE_COUNT);
+        collector->pool = worker_pool_new(g_get_num_processors() + sources - 1);
+        if (collector->backend) collector->backend->pool = collector->pool;
+    }
+    return collector->pool;
+}
+
+// Queue one collection cycle on the worker pool
 void threaded_collector_start_collection(ThreadedCollector *collector) {
     if (!collector) return;
     
+    // One cycle at a time; results of the running one are still being written
+    if (!worker_batch_done(&collector->batch)) return;
+    
     g_mutex_lock(&collector->coordinator_mutex);
     collector->collection_start_time = time(NULL);
     collector->shutdown_requested = FALSE;
     g_mutex_unlock(&collector->coordinator_mutex);
     
-    // Start threads with different priorities
-    // Highest priority: Process list (fast, needed immediately)
-    collector->process_thread = g_thread_new("process_collector", collect_process_list_thread, collector);
-    
-    // High priority: CPU and Memory (relatively fast)
-    collector->cpu_thread = g_thread_new("cpu_collector", collect_cpu_data_thread, collector);
-    collector->memory_thread = g_thread_new("memory_collector", collect_memory_data_thread, collector);
-    
-    // Lower priority: GPU and Network (slower operations)
-    collector->gpu_thread = g_thread_new("gpu_collector", collect_gpu_data_thread, collector);
-    collector->network_thread = g_thread_new("network_collector", collect_network_data_thread, collector);
+    // Queued costliest first (process list and network before CPU/memory)
+    WorkerPool *pool = collector_pool(collector);
+    for (int i = 0; i < COLLECTOR_TASK_COUNT; i++) {
+        worker_pool_submit(pool, &collector->batch, &collector->tasks[i]);
+    }
+}
+
+// Completion barrier: returns once every task of the current cycle has finished
+void threaded_collector_wait_collection(ThreadedCollector *collector) {
+    if (collector) worker_batch_wait(&collector->batch);
 }
 
 // Check if basic data (process list) is available
@@ -196,8 +229,7 @@ UpdateData* threaded_collector_get_available_data(ThreadedCollector *collector)
     // Get process list and system summary if available
     g_mutex_lock(&collector->process_list->mutex);
     if (collector->process_list->state == THREAD_STATE_COMPLETED && collector->process_list->processes) {
-        data->processes = g_list_copy_deep(collector->process_list->processes, 
-                                          (GCopyFunc)copy_process, NULL);
+        data->processes = process_table_copy(collector->process_list->processes);
         if (collector->process_list->system_summary) {
             data->system_summary = g_strdup(collector->process_list->system_summary);
         }
@@ -233,7 +265,7 @@ UpdateData* threaded_collector_get_available_data(ThreadedCollector *collector)
 }
 
 // Fast process list collection (just PID, name, type)
-gpointer collect_process_list_thread(gpointer data) {
+void collect_process_list_task(gpointer data) {
     ThreadedCollector *collector = (ThreadedCollector*)data;
     ProcessListResult *result = collector->process_list;
     
@@ -242,31 +274,22 @@ gpointer collect_process_list_thread(gpointer data) {
     result->timestamp = time(NULL);
     g_mutex_unlock(&result->mutex);
     
-    // Use the same top output parsing as the original for compatibility
-    char* output = get_top_output();
-    if (!output) {
+    // Stream top output; lines are parsed in place as they arrive
+    TopReader top;
+    if (!top_reader_open(&top)) {
         g_mutex_lock(&result->mutex);
         result->state = THREAD_STATE_FAILED;
         g_mutex_unlock(&result->mutex);
-        return NULL;
-    }
-    
-    // Split all lines
-    char **lines = malloc(2000 * sizeof(char*));
-    int total_lines = 0;
-    char *line = strtok(output, "\n");
-    while (line && total_lines < 1999) {
-        lines[total_lines] = strdup(line);
-        total_lines++;
-        line = strtok(NULL, "\n");
+        return;
     }
 
-    GList *processes = NULL;
+    ProcessTable *processes = process_table_acquire();
     gboolean found_header = FALSE;
     char system_summary[1024] = "";
+    StrView view;
     
-    for (int line_num = 0; line_num < total_lines; line_num++) {
-        line = lines[line_num];
+    while (top_reader_next(&top, &view)) {
+        const char *line = view.ptr;  // NUL-terminated in the read buffer
         
         // Check for shutdown request
         g_mutex_lock(&collector->coordinator_mutex);
@@ -281,7 +304,7 @@ gpointer collect_process_list_thread(gpointer data) {
             // Simplify the display text similar to original
             if (strstr(line, "Networks:")) {
                 // Extract key network info
-                char *net_info = line + 9; // Skip "Networks:"
+                const char *net_info = line + 9; // Skip "Networks:"
                 char simplified_line[256];
                 snprintf(simplified_line, sizeof(simplified_line), "Networks:%s", net_info);
                 strcat(system_summary, simplified_line);
@@ -297,46 +320,39 @@ gpointer collect_process_list_thread(gpointer data) {
         
         // Look for process header line
         if (strstr(line, "PID") && strstr(line, "COMMAND")) {
+            // Start time and UID for every PID in one pass (used by type/runtime
+            // lookups), taken while top writes the sample being parsed
+            process_meta_refresh();
             found_header = TRUE;
             continue;
         }
         
         // Process data lines (after header)
-        if (found_header && line && strlen(line) > 10) {
-            Process *proc = parse_process_line_basic(line);
-            if (proc) {
-                    
-                processes = g_list_prepend(processes, proc);
+        if (found_header) {
+            ProcessSample sample;
+            if (parse_process_line_basic(view, &sample)) {
+                process_table_add(processes, &sample);
             }
         }
     }
     
-    // Cleanup
-    for (int i = 0; i < total_lines; i++) {
-        free(lines[i]);
-    }
-    free(lines);
-    free(output);
+    top_reader_close(&top);
     
     // Update result
     g_mutex_lock(&result->mutex);
-    if (result->processes) {
-        g_list_free_full(result->processes, (GDestroyNotify)free_process);
-    }
+    process_table_release(result->processes);
     if (result->system_summary) {
         g_free(result->system_summary);
     }
-    result->processes = g_list_reverse(processes); // Restore original order
+    result->processes = processes;
     result->system_summary = g_strdup(system_summary);
     result->state = THREAD_STATE_COMPLETED;
     result->timestamp = time(NULL);
     g_mutex_unlock(&result->mutex);
-    
-    return NULL;
 }
 
 // CPU data collection
-gpointer collect_cpu_data_thread(gpointer data) {
+void collect_cpu_data_task(gpointer data) {
     ThreadedCollector *collector = (ThreadedCollector*)data;
     CPUDataResult *result = collector->cpu_data;
     
@@ -349,30 +365,32 @@ gpointer collect_cpu_data_thread(gpointer data) {
     float system_cpu = get_system_cpu_usage();
     
     // Get per-process CPU usage
-    g_hash_table_remove_all(result->process_cpu);
+    pid_map_clear(result->process_cpu);
     
-    FILE *fp = popen("ps -eo pid,pcpu", "r");
+    FILE *fp = tracked_popen("ps -eo pid,pcpu", "r");
     if (fp) {
-        char line[256];
+        // OPTIMIZATION: Fields parsed in place from the read buffer (no sscanf)
+        LineScanner scanner;
+        line_scanner_init(&scanner, 0);
+        StrView line, fields[2];
         // Skip header
-        if (fgets(line, sizeof(line), fp)) {
-            while (fgets(line, sizeof(line), fp)) {
+        if (line_scanner_read_line(&scanner, fp, &line)) {
+            while (line_scanner_read_line(&scanner, fp, &line)) {
                 // Check for shutdown
                 g_mutex_lock(&collector->coordinator_mutex);
                 gboolean shutdown = collector->shutdown_requested;
                 g_mutex_unlock(&collector->coordinator_mutex);
                 if (shutdown) break;
                 
-                int pid;
-                float cpu;
-                if (sscanf(line, "%d %f", &pid, &cpu) == 2) {
-                    char *pid_str = g_strdup_printf("%d", pid);
-                    float *cpu_val = g_malloc(sizeof(float));
-                    *cpu_val = cpu;
-                    g_hash_table_insert(result->process_cpu, pid_str, cpu_val);
+                gint64 pid;
+                double cpu;
+                if (str_view_split_fields(line, fields, 2) == 2 &&
+                    str_view_to_int64(fields[0], &pid) && str_view_to_double(fields[1], &cpu)) {
+                    *(float*)pid_map_insert(result->process_cpu, (pid_t)pid) = (float)cpu;
                 }
             }
         }
+        line_scanner_clear(&scanner);
         pclose(fp);
     }
     
@@ -381,12 +399,10 @@ gpointer collect_cpu_data_thread(gpointer data) {
     result->state = THREAD_STATE_COMPLETED;
     result->timestamp = time(NULL);
     g_mutex_unlock(&result->mutex);
-    
-    return NULL;
 }
 
 // Memory data collection
-gpointer collect_memory_data_thread(gpointer data) {
+void collect_memory_data_task(gpointer data) {
     ThreadedCollector *collector = (ThreadedCollector*)data;
     MemoryDataResult *result = collector->memory_data;
     
@@ -398,30 +414,32 @@ gpointer collect_memory_data_thread(gpointer data) {
     float system_memory = get_system_memory_usage();
     
     // Get per-process memory usage
-    g_hash_table_remove_all(result->process_memory);
+    pid_map_clear(result->process_memory);
     
-    FILE *fp = popen("ps -eo pid,rss", "r");
+    FILE *fp = tracked_popen("ps -eo pid,rss", "r");
     if (fp) {
-        char line[256];
+        LineScanner scanner;
+        line_scanner_init(&scanner, 0);
+        StrView line, fields[2];
         // Skip header
-        if (fgets(line, sizeof(line), fp)) {
-            while (fgets(line, sizeof(line), fp)) {
+        if (line_scanner_read_line(&scanner, fp, &line)) {
+            while (line_scanner_read_line(&scanner, fp, &line)) {
                 // Check for shutdown
                 g_mutex_lock(&collector->coordinator_mutex);
                 gboolean shutdown = collector->shutdown_requested;
                 g_mutex_unlock(&collector->coordinator_mutex);
                 if (shutdown) break;
                 
-                int pid;
-                long rss; // RSS in KB
-                if (sscanf(line, "%d %ld", &pid, &rss) == 2) {
-                    char *pid_str = g_strdup_printf("%d", pid);
-                    long long *bytes = g_malloc(sizeof(long long));
-                    *bytes = rss * 1024; // Convert KB to bytes
-                    g_hash_table_insert(result->process_memory, pid_str, bytes);
+                gint64 pid;
+                gint64 rss; // RSS in KB
+                if (str_view_split_fields(line, fields, 2) == 2 &&
+                    str_view_to_int64(fields[0], &pid) && str_view_to_int64(fields[1], &rss)) {
+                    // Convert KB to bytes
+                    *(long long*)pid_map_insert(result->process_memory, (pid_t)pid) = rss * 1024;
                 }
             }
         }
+        line_scanner_clear(&scanner);
         pclose(fp);
     }
     
@@ -430,12 +448,10 @@ gpointer collect_memory_data_thread(gpointer data) {
     result->state = THREAD_STATE_COMPLETED;
     result->timestamp = time(NULL);
     g_mutex_unlock(&result->mutex);
-    
-    return NULL;
 }
 
 // GPU data collection (slowest operation)
-gpointer collect_gpu_data_thread(gpointer data) {
+void collect_gpu_data_task(gpointer data) {
     ThreadedCollector *collector = (ThreadedCollector*)data;
     GPUDataResult *result = collector->gpu_data;
     
@@ -468,12 +484,10 @@ gpointer collect_gpu_data_thread(gpointer data) {
     result->state = THREAD_STATE_COMPLETED;
     result->timestamp = time(NULL);
     g_mutex_unlock(&result->mutex);
-    
-    return NULL;
 }
 
 // Network data collection (slow operation)
-gpointer collect_network_data_thread(gpointer data) {
+void collect_network_data_task(gpointer data) {
     ThreadedCollector *collector = (ThreadedCollector*)data;
     NetworkDataResult *result = collector->network_data;
     
@@ -482,124 +496,73 @@ gpointer collect_network_data_thread(gpointer data) {
     g_mutex_unlock(&result->mutex);
     
     // Clear previous data
-    g_hash_table_remove_all(result->process_network);
+    pid_map_clear(result->process_network);
     
     // Collect network data directly using nettop
-    FILE *fp = popen("nettop -P -L1 -x", "r");  // Use -x for better parsing
+    FILE *fp = tracked_popen("nettop -P -L1 -x", "r");  // Use -x for better parsing
     if (fp) {
-        char line[1024];
-        double current_time = (double)g_get_real_time() / 1000000.0;
-        
-        // Skip header lines
-        int skip_lines = 0;
-        while (fgets(line, sizeof(line), fp) && skip_lines < 2) {
-            skip_lines++;
-        }
+        LineScanner scanner;
+        line_scanner_init(&scanner, 0);
+        StrView line;
+        gint64 now_us = g_get_real_time();
         
-        // Process each line
-        while (fgets(line, sizeof(line), fp)) {
+        // Process each line; the header fails parse_nettop_line()
+        while (line_scanner_read_line(&scanner, fp, &line)) {
             // Check for shutdown
             g_mutex_lock(&collector->coordinator_mutex);
             gboolean shutdown = collector->shutdown_requested;
             g_mutex_unlock(&collector->coordinator_mutex);
             if (shutdown) break;
             
-            // Parse nettop CSV: time,processname.pid,interface,state,bytes_in,bytes_out,...
-            // Split by commas
-            char *fields[8];
-            int field_count = 0;
-            char *pos = line;
-            
-            while (*pos && field_count < 8) {
-                fields[field_count] = pos;
-                while (*pos && *pos != ',') pos++;
-                if (*pos) {
-                    *pos = '\0';
-                    pos++;
-                }
-                field_count++;
-            }
+            pid_t pid;
+            guint64 bytes;
+            if (!parse_nettop_line(line, &pid, &bytes)) continue;
+            long long total_bytes = (long long)bytes;
             
-            if (field_count < 6) continue;
-            
-            // Extract PID from "processname.pid" format (field 1)
-            char *process_pid = fields[1];
-            char *dot = strrchr(process_pid, '.');  // Find last dot
-            if (!dot) continue;
-            
-            char *pid_str = dot + 1;  // PID is after the dot
-            char *bytes_in_str = fields[4];
-            char *bytes_out_str = fields[5];
-            long long bytes_in = atoll(bytes_in_str);
-            long long bytes_out = atoll(bytes_out_str);
-            long long total_bytes = bytes_in + bytes_out;
-            
-            if (total_bytes > 0 && strlen(pid_str) > 0) {
-                // Calculate rate if we have previous data
+            if (total_bytes > 0) {
+                // Rate against the previous sample of the same process (start
+                // times from the metadata cache the process list task refreshes)
+                ProcessMeta meta;
+                guint64 start_time = process_meta_lookup(pid, &meta) ? (guint64)meta.start_time : 0;
+                RateDelta delta;
                 double rate = 0.0;
-                if (g_hash_table_contains(result->prev_net_bytes, pid_str)) {
-                    long long *prev_bytes_ptr = g_hash_table_lookup(result->prev_net_bytes, pid_str);
-                    double *prev_time_ptr = g_hash_table_lookup(result->prev_times, pid_str);
-                    
-                    if (prev_bytes_ptr && prev_time_ptr) {
-                        double time_diff = current_time - *prev_time_ptr;
-                        if (time_diff > 0.3) {  // Need at least 0.3 seconds
-                            long long bytes_diff = total_bytes - *prev_bytes_ptr;
-                            if (bytes_diff > 0) {
-                                rate = (double)bytes_diff / time_diff / 1024.0;  // KB/s
-                            }
-                        }
-                    }
-                }
-                
-                // Update previous values
-                long long *new_bytes = g_malloc(sizeof(long long));
-                *new_bytes = total_bytes;
-                g_hash_table_insert(result->prev_net_bytes, g_strdup(pid_str), new_bytes);
-                
-                double *new_time = g_malloc(sizeof(double));
-                *new_time = current_time;
-                g_hash_table_insert(result->prev_times, g_strdup(pid_str), new_time);
-                
-                // Store rate for this process
-                char rate_str[32];
-                if (rate > 0.1) {
-                    snprintf(rate_str, sizeof(rate_str), "%.1f KB/s", rate);
-                } else {
-                    snprintf(rate_str, sizeof(rate_str), "0.0 KB/s");
+                if (rate_store_update(result->net_counters, pid, start_time, RATE_COUNTER_NET_BYTES,
+                                      (guint64)total_bytes, now_us, &delta) &&
+                    delta.seconds > 0.3) {  // Need at least 0.3 seconds
+                    rate = (double)delta.increase / delta.seconds / 1024.0;  // KB/s
                 }
                 
-                g_hash_table_insert(result->process_network, 
-                                   g_strdup(pid_str), 
-                                   g_strdup(rate_str));
+                // Store rate for this process (bytes per second)
+                *(double*)pid_map_insert(result->process_network, pid) = rate > 0.1 ? rate * 1024.0 : 0.0;
             }
         }
+        line_scanner_clear(&scanner);
         pclose(fp);
     }
     
+    // Exited processes drop out of the counters within a few runs
+    rate_store_advance(result->net_counters);
+    
     g_mutex_lock(&result->mutex);
     result->state = THREAD_STATE_COMPLETED;
     result->timestamp = time(NULL);
     g_mutex_unlock(&result->mutex);
-    
-    return NULL;
 }
 
 // Merge collected data into process structures
-void merge_process_data(GList *processes, CPUDataResult *cpu, MemoryDataResult *memory, 
+void merge_process_data(ProcessTable *processes, CPUDataResult *cpu, MemoryDataResult *memory, 
                        GPUDataResult *gpu, NetworkDataResult *network) {
     if (!processes) return;
     
-    for (GList *l = processes; l != NULL; l = l->next) {
-        Process *proc = (Process*)l->data;
-        if (!proc) continue;
+    for (guint i = 0; i < processes->count; i++) {
+        ProcessSample *proc = &processes->items[i];
         
         // Update CPU data
         if (cpu && cpu->state == THREAD_STATE_COMPLETED) {
             g_mutex_lock(&cpu->mutex);
-            float *cpu_val = g_hash_table_lookup(cpu->process_cpu, proc->pid);
+            float *cpu_val = pid_map_lookup(cpu->process_cpu, proc->pid);
             if (cpu_val) {
-                snprintf(proc->cpu, sizeof(proc->cpu), "%.1f", *cpu_val);
+                proc->cpu = *cpu_val;
             }
             g_mutex_unlock(&cpu->mutex);
         }
@@ -607,11 +570,9 @@ void merge_process_data(GList *processes, CPUDataResult *cpu, MemoryDataResult *
         // Update Memory data
         if (memory && memory->state == THREAD_STATE_COMPLETED) {
             g_mutex_lock(&memory->mutex);
-            long long *mem_bytes = g_hash_table_lookup(memory->process_memory, proc->pid);
-            if (mem_bytes) {
-                char *mem_str = format_bytes_human_readable(*mem_bytes);
-                safe_strncpy(proc->mem, mem_str, sizeof(proc->mem));
-                g_free(mem_str);
+            long long *mem_bytes = pid_map_lookup(memory->process_memory, proc->pid);
+            if (mem_bytes && *mem_bytes > 0) {
+                proc->rss_bytes = (guint64)*mem_bytes;
             }
             g_mutex_unlock(&memory->mutex);
         }
@@ -619,20 +580,17 @@ void merge_process_data(GList *processes, CPUDataResult *cpu, MemoryDataResult *
         // Update GPU data (system-wide, same for all processes)
         if (gpu && gpu->state == THREAD_STATE_COMPLETED) {
             g_mutex_lock(&gpu->mutex);
-            safe_strncpy(proc->gpu, gpu->gpu_status, sizeof(proc->gpu));
+            proc->gpu = gpu->gpu_percentage;
+            proc->flags |= PROCESS_FLAG_HAS_GPU;
             g_mutex_unlock(&gpu->mutex);
         }
         
         // Network data (when available)
         if (network && network->state == THREAD_STATE_COMPLETED) {
             g_mutex_lock(&network->mutex);
-            char *net_rate = g_hash_table_lookup(network->process_network, proc->pid);
-            if (net_rate) {
-                safe_strncpy(proc->net, net_rate, sizeof(proc->net));
-            } else {
-                // Set default network rate for processes without specific data
-                safe_strncpy(proc->net, "0.0 KB/s", sizeof(proc->net));
-            }
+            double *net_rate = pid_map_lookup(network->process_network, proc->pid);
+            // Processes without specific data have no traffic
+            proc->net_bps = net_rate ? (guint64)*net_rate : 0;
             g_mutex_unlock(&network->mutex);
         }
     }
@@ -642,10 +600,8 @@ void merge_process_data(GList *processes, CPUDataResult *cpu, MemoryDataResult *
 void cleanup_process_list_result(ProcessListResult *result) {
     if (!result) return;
     g_mutex_lock(&result->mutex);
-    if (result->processes) {
-        g_list_free_full(result->processes, (GDestroyNotify)free_process);
-        result->processes = NULL;
-    }
+    process_table_release(result->processes);
+    result->processes = NULL;
     if (result->system_summary) {
         g_free(result->system_summary);
         result->system_summary = NULL;
@@ -658,10 +614,8 @@ void cleanup_process_list_result(ProcessListResult *result) {
 void cleanup_cpu_data_result(CPUDataResult *result) {
     if (!result) return;
     g_mutex_lock(&result->mutex);
-    if (result->process_cpu) {
-        g_hash_table_destroy(result->process_cpu);
-        result->process_cpu = NULL;
-    }
+    pid_map_free(result->process_cpu);
+    result->process_cpu = NULL;
     g_mutex_unlock(&result->mutex);
     g_mutex_clear(&result->mutex);
     g_free(result);
@@ -670,10 +624,8 @@ void cleanup_cpu_data_result(CPUDataResult *result) {
 void cleanup_memory_data_result(MemoryDataResult *result) {
     if (!result) return;
     g_mutex_lock(&result->mutex);
-    if (result->process_memory) {
-        g_hash_table_destroy(result->process_memory);
-        result->process_memory = NULL;
-    }
+    pid_map_free(result->process_memory);
+    result->process_memory = NULL;
     g_mutex_unlock(&result->mutex);
     g_mutex_clear(&result->mutex);
     g_free(result);
@@ -688,18 +640,10 @@ void cleanup_gpu_data_result(GPUDataResult *result) {
 void cleanup_network_data_result(NetworkDataResult *result) {
     if (!result) return;
     g_mutex_lock(&result->mutex);
-    if (result->process_network) {
-        g_hash_table_destroy(result->process_network);
-        result->process_network = NULL;
-    }
-    if (result->prev_net_bytes) {
-        g_hash_table_destroy(result->prev_net_bytes);
-        result->prev_net_bytes = NULL;
-    }
-    if (result->prev_times) {
-        g_hash_table_destroy(result->prev_times);
-        result->prev_times = NULL;
-    }
+    pid_map_free(result->process_network);
+    result->process_network = NULL;
+    rate_store_free(result->net_counters);
+    result->net_counters = NULL;
     g_mutex_unlock(&result->mutex);
     g_mutex_clear(&result->mutex);
     g_free(result);
@@ -709,265 +653,251 @@ void cleanup_network_data_result(NetworkDataResult *result) {
 // COLLECTOR/BIN SYSTEM - Efficient background data collection
 // ============================================================================
 
-// Background collector thread that continuously updates the data bin
-// Synchronous data collection function (based on update_thread_func but without GUI)
-UpdateData* collect_complete_data_sync(void) {
-    // SECURITY: Track timing for timeout protection  
-    time_t update_start_time = time(NULL);
-    
-    // Get process data using the same logic as update_thread_func
-    char* output = get_top_output();
-    if (!output) {
-        return NULL;
-    }
-
-    // Split all lines
-    char **lines = NULL;
-    int total_lines = 0;
-    char *token = strtok(output, "\n");
-    while (token != NULL) {
-        lines = realloc(lines, sizeof(char*) * (total_lines + 1));
-        lines[total_lines] = strdup(token);
-        total_lines++;
-        token = strtok(NULL, "\n");
-    }
-
-    GList *processes = NULL;
-    char summary_buffer[2048] = "";
-    gboolean found_header = FALSE;
-    int process_count = 0;
-    
-    // Use limits from config.h
+// One top sample, fed line by line from a pipe (TopReader) or a streamed
+// frame (stream backend)
+void top_frame_parser_init(TopFrameParser *parser) {
+    memset(parser, 0, sizeof(*parser));
+    // OPTIMIZATION: Rows go into a recycled contiguous table (no per-row allocation)
+    parser->processes = process_table_acquire();
+    // SECURITY: Track timing for timeout protection
+    parser->start_time = time(NULL);
+    parser->max_processes = get_max_processes_per_update();
+}
 
-    // Process lines using the same logic as update_thread_func
-    for (int i = 0; i < total_lines; i++) {
-        char *line = lines[i];
+gboolean top_frame_parser_feed(TopFrameParser *parser, StrView view) {
+    const char *line = view.ptr;  // NUL-terminated in the read buffer
+    int i = parser->line_index++;
+    
+    // Build summary buffer from initial system info lines
+    if (i < 15 && (strstr(line, "Processes:") || strstr(line, "Load Avg:") || 
+                   strstr(line, "CPU usage:") || strstr(line, "PhysMem:") ||
+                   strstr(line, "Networks:") || strstr(line, "VM:") || 
+                   strstr(line, "Disks:"))) {
         
-        // Build summary buffer from initial system info lines
-        if (i < 15 && (strstr(line, "Processes:") || strstr(line, "Load Avg:") || 
-                       strstr(line, "CPU usage:") || strstr(line, "PhysMem:") ||
-                       strstr(line, "Networks:") || strstr(line, "VM:") || 
-                       strstr(line, "Disks:"))) {
+        // System-friendly simplification (same as original)
+        char simplified_line[256];
+        if (strstr(line, "Networks:")) {
+            // Parse network info
+            const char *net_info = line + 9; // Skip "Networks:"
+            const char *read_pos = strstr(net_info, "packets:");
+            const char *write_pos = strstr(net_info, "data received");
             
-            // System-friendly simplification (same as original)
-            char simplified_line[256];
-            if (strstr(line, "Networks:")) {
-                // Parse network info
-                char *net_info = line + 9; // Skip "Networks:"
-                char *read_pos = strstr(net_info, "packets:");
-                char *write_pos = strstr(net_info, "data received");
-                
-                char in_amount[32] = "";
-                
-                if (read_pos && write_pos) {
-                    // Extract amounts using similar logic as original
-                    char *slash_pos = strstr(write_pos, "/");
-                    if (slash_pos) {
-                        char *space_pos = strstr(slash_pos, " ");
-                        if (space_pos) {
-                            int len = space_pos - slash_pos - 1;
-                            if (len > 0 && len < 31) {
-                                strncpy(in_amount, slash_pos + 1, len);
-                                in_amount[len] = '\0';
-                            }
+            char in_amount[32] = "";
+            
+            if (read_pos && write_pos) {
+                // Extract amounts using similar logic as original
+                const char *slash_pos = strstr(write_pos, "/");
+                if (slash_pos) {
+                    const char *space_pos = strstr(slash_pos, " ");
+                    if (space_pos) {
+                        int len = space_pos - slash_pos - 1;
+                        if (len > 0 && len < 31) {
+                            strncpy(in_amount, slash_pos + 1, len);
+                            in_amount[len] = '\0';
                         }
                     }
                 }
-                
-                if (strlen(in_amount) > 0) {
-                    snprintf(simplified_line, sizeof(simplified_line), "Network: %s received", in_amount);
-                } else {
-                    sprintf(simplified_line, "Network: Active");
-                }
-            } else if (strstr(line, "VM:")) {
-                // Simplified VM info
-                sprintf(simplified_line, "Virtual Memory: Active");
-            } else if (strstr(line, "Disks:")) {
-                // Simplified disk info
-                sprintf(simplified_line, "Disk Activity: Active");
-            } else {
-                // Use line as-is for other system info
-                strncpy(simplified_line, line, 255);
-                simplified_line[255] = '\0';
             }
             
-            strncat(summary_buffer, simplified_line, sizeof(summary_buffer) - strlen(summary_buffer) - 2);
-            if (strlen(summary_buffer) < sizeof(summary_buffer) - 1) {
-                strcat(summary_buffer, "\n");
+            if (strlen(in_amount) > 0) {
+                snprintf(simplified_line, sizeof(simplified_line), "Network: %s received", in_amount);
+            } else {
+                sprintf(simplified_line, "Network: Active");
             }
+        } else if (strstr(line, "VM:")) {
+            // Simplified VM info
+            sprintf(simplified_line, "Virtual Memory: Active");
+        } else if (strstr(line, "Disks:")) {
+            // Simplified disk info
+            sprintf(simplified_line, "Disk Activity: Active");
+        } else {
+            // Use line as-is for other system info
+            strncpy(simplified_line, line, 255);
+            simplified_line[255] = '\0';
         }
         
-        // Look for the PID COMMAND header to know when process lines start
-        if (strstr(line, "PID") && strstr(line, "COMMAND")) {
-            found_header = TRUE;
-            continue;
+        strncat(parser->summary, simplified_line, sizeof(parser->summary) - strlen(parser->summary) - 2);
+        if (strlen(parser->summary) < sizeof(parser->summary) - 1) {
+            strcat(parser->summary, "\n");
+        }
+    }
+    
+    // Look for the PID COMMAND header to know when process lines start
+    if (strstr(line, "PID") && strstr(line, "COMMAND")) {
+        // OPTIMIZATION: One enumeration pass replaces a ps fork per process for
+        // runtime and UID (get_run_time / determine_process_type read the cache)
+        process_meta_refresh();
+        parser->found_header = TRUE;
+        return TRUE;
+    }
+    
+    // Only parse process lines after we've found the header
+    if (parser->found_header && view.len > 0) {
+        // SECURITY: Check timeout and resource limits (same as original)
+        time_t now = time(NULL);
+        if ((now - parser->start_time) > (MAX_UPDATE_TIME_MS / 1000)) {
+            return FALSE;  // Timeout protection
         }
         
-        // Only parse process lines after we've found the header
-        if (found_header && line && *line != '\0') {
-            // SECURITY: Check timeout and resource limits (same as original)
-            time_t now = time(NULL);
-            if ((now - update_start_time) > (MAX_UPDATE_TIME_MS / 1000)) {
-                break;  // Timeout protection
-            }
+        if (parser->process_count >= (int)parser->max_processes) {
+            return FALSE;  // Process count limit
+        }
+        
+        // Only parse lines that start with a digit (actual PIDs)
+        if (isdigit(line[0])) {
+            parser->process_count++;
+            ProcessSample sample;
             
-            if (process_count >= MAX_PROCESSES_PER_UPDATE) {
-                break;  // Process count limit
-            }
-            
-            // Only parse lines that start with a digit (actual PIDs)
-            if (isdigit(line[0])) {
-                process_count++;
-                Process *proc = alloc_process();
-                
-                // Use the same parsing logic as original
-                char *tokens[20];
-                int token_count = 0;
-                char *line_copy = strdup(line);
-                char *token_ptr = strtok(line_copy, " \t");
-                
-                while (token_ptr && token_count < 20) {
-                    tokens[token_count++] = strdup(token_ptr);
-                    token_ptr = strtok(NULL, " \t");
-                }
-                
-                if (token_count >= 5) {
-                    // Parse PID
-                    safe_strncpy(proc->pid, tokens[0], sizeof(proc->pid));
-                    
-                    // Parse CPU (same normalization as original)
-                    if (tokens[token_count - 3]) {
-                        float raw_cpu = atof(tokens[token_count - 3]);
-                        if (raw_cpu < 0) raw_cpu = 0;
-                        if (raw_cpu > 999.9) raw_cpu = 999.9;
-                        
-                        extern int cpu_cores; // From system.h
-                        float normalized_cpu = raw_cpu / (cpu_cores > 0 ? cpu_cores : 1);
-                        snprintf(proc->cpu, sizeof(proc->cpu), "%.1f", normalized_cpu);
-                    } else {
-                        safe_strncpy(proc->cpu, "0.0", sizeof(proc->cpu));
-                    }
-                    
-                    // Parse memory
-                    if (tokens[token_count - 2]) {
-                        char *formatted_mem = format_memory_human_readable(tokens[token_count - 2]);
-                        if (formatted_mem) {
-                            safe_strncpy(proc->mem, formatted_mem, sizeof(proc->mem));
-                            free(formatted_mem);
-                        } else {
-                            safe_strncpy(proc->mem, "0 B", sizeof(proc->mem));
-                        }
-                    } else {
-                        safe_strncpy(proc->mem, "0 B", sizeof(proc->mem));
-                    }
-                    
-                    // Parse runtime
-                    if (tokens[token_count - 1]) {
-                        safe_strncpy(proc->runtime, tokens[token_count - 1], sizeof(proc->runtime));
-                    } else {
-                        safe_strncpy(proc->runtime, "0:00", sizeof(proc->runtime));
-                    }
-                    
-                    // Build command name
-                    proc->name[0] = '\0';
-                    for (int j = 1; j < token_count - 3 && j < 10; j++) {
-                        if (tokens[j]) {
-                            if (j > 1) safe_strncat(proc->name, " ", sizeof(proc->name));
-                            safe_strncat(proc->name, tokens[j], sizeof(proc->name));
-                        }
-                    }
-                    
-                    // Clean up tokens
-                    for (int j = 0; j < token_count; j++) {
-                        free(tokens[j]);
-                    }
-                    
-                    // Get runtime
-                    char *runtime = get_run_time(proc->pid);
-                    safe_strncpy(proc->runtime, runtime, sizeof(proc->runtime));
-                    free(runtime);
-                    
-                    // Set defaults for GPU and network (will be filled later if needed)
-                    safe_strncpy(proc->gpu, "N/A", sizeof(proc->gpu));
-                    safe_strncpy(proc->net, "0.0 KB/s", sizeof(proc->net));
-                    
-                    // Determine process type
-                    determine_process_type(proc);
-                    
-                    processes = g_list_append(processes, proc);
-                } else {
-                    // Clean up on parsing error
-                    for (int j = 0; j < token_count; j++) {
-                        free(tokens[j]);
-                    }
-                    free_process(proc);
-                }
-                
-                free(line_copy);
+            if (parse_top_process_fields(view, &sample)) {
+                // Start time, UID and type from the metadata cache;
+                // GPU and network stay zero (filled later if needed)
+                fill_process_metadata(&sample);
+                process_table_add(parser->processes, &sample);
             }
         }
     }
+    return TRUE;
+}
+
+UpdateData* top_frame_parser_finish(TopFrameParser *parser) {
+    // Create UpdateData structure; GPU usage is sampled on its own period
+    UpdateData *update_data = update_data_new();
+    update_data->processes = parser->processes;
+    update_data->gpu_usage = update_data_strndup(update_data, "N/A", -1);
+    update_data->system_summary = update_data_strndup(update_data, parser->summary, -1);
+    parser->processes = NULL;
     
-    // Free the lines array
-    for (int i = 0; i < total_lines; i++) {
-        free(lines[i]);
+    // Use system usage collection
+    update_data->system_cpu_usage = get_system_cpu_usage();
+    update_data->system_memory_usage = get_system_memory_usage();
+
+    return update_data;
+}
+
+// Synchronous data collection function (based on update_thread_func but without GUI)
+UpdateData* collect_complete_data_sync(void) {
+    // Stream top output; lines are parsed in place as they arrive
+    // OPTIMIZATION: No line array, no strdup per line or per token
+    TopReader top;
+    if (!top_reader_open(&top)) {
+        return NULL;
     }
-    free(lines);
-    free(output);
 
-    // Get additional data
+    TopFrameParser parser;
+    top_frame_parser_init(&parser);
+    StrView view;
+    while (top_reader_next(&top, &view) && top_frame_parser_feed(&parser, view)) {}
+    top_reader_close(&top);
+
+    UpdateData *data = top_frame_parser_finish(&parser);
     char *gpu_usage = get_gpu_usage();
+    if (gpu_usage) {
+        update_data_set_text(data, &data->gpu_usage, gpu_usage);
+        free(gpu_usage);
+    }
+    return data;
+}
 
-    // Create UpdateData structure
-    UpdateData *update_data = g_malloc0(sizeof(UpdateData));
-    if (!update_data) {
-        g_list_free_full(processes, (GDestroyNotify)free_process);
-        if (gpu_usage) free(gpu_usage);
-        return NULL;
+// Process list, CPU and memory: one backend sample, published as a snapshot
+static void sample_processes_source(gpointer data) {
+    ThreadedCollector *collector = (ThreadedCollector*)data;
+    
+    g_mutex_lock(&collector->coordinator_mutex);
+    gboolean background = collector->background;
+    g_mutex_unlock(&collector->coordinator_mutex);
+    if (background != collector->backend_background) {
+        collector_backend_set_background(collector->backend, background);
+        collector->backend_background = background;
     }
     
-    update_data->processes = processes;
-    update_data->gpu_usage = gpu_usage ? gpu_usage : g_strdup("N/A");
-    update_data->system_summary = g_strdup(summary_buffer);
+    UpdateData *new_data = collector->backend
+        ? collector_backend_collect(collector->backend)
+        : collect_complete_data_sync();
+    if (!new_data) return;
     
-    // Use system usage collection
-    update_data->system_cpu_usage = get_system_cpu_usage();
-    update_data->system_memory_usage = get_system_memory_usage();
+    // Latest GPU sample from its own source
+    g_mutex_lock(&collector->coordinator_mutex);
+    if (collector->gpu_usage) {
+        update_data_set_text(new_data, &new_data->gpu_usage, collector->gpu_usage);
+    }
+    gboolean shutdown = collector->shutdown_requested;
+    g_mutex_unlock(&collector->coordinator_mutex);
+    
+    if (shutdown) {
+        free_update_data(new_data);
+        return;
+    }
+    // Publish the new complete dataset; the previous snapshot is freed once
+    // the last reader releases it
+    snapshot_slot_publish(&collector->data_bin, new_data);
+    string_intern_advance();
+}
 
-    return update_data;
+// Per-process network rates, merged by the next process sample
+static void sample_network_source(gpointer data) {
+    ThreadedCollector *collector = (ThreadedCollector*)data;
+    collector_backend_refresh_network(collector->backend);
 }
 
-gpointer continuous_collector_thread(gpointer data) {
+static void sample_gpu_source(gpointer data) {
     ThreadedCollector *collector = (ThreadedCollector*)data;
+    char *gpu_usage = collector_backend_sample_gpu(collector->backend);
+    if (!gpu_usage) return;
     
-    while (!collector->shutdown_requested) {
-        // Collect all data using our new synchronous function
-        UpdateData *new_data = collect_complete_data_sync();
-        
-        if (new_data && !collector->shutdown_requested) {
-            // Update the data bin (thread-safe)
-            g_mutex_lock(&collector->bin_mutex);
-            
-            // Free old data if it exists
-            if (collector->data_bin) {
-                free_update_data(collector->data_bin);
-            }
-            
-            // Store the new complete dataset
-            collector->data_bin = new_data;
-            
-            g_mutex_unlock(&collector->bin_mutex);
-        }
-        
-        // Sleep before next collection cycle
-        if (!collector->shutdown_requested) {
-            g_usleep(1500000); // 1.5 seconds between collections
-        }
-    }
+    g_mutex_lock(&collector->coordinator_mutex);
+    g_free(collector->gpu_usage);
+    collector->gpu_usage = g_strdup(gpu_usage);
+    g_mutex_unlock(&collector->coordinator_mutex);
+    free(gpu_usage);
+}
+
+// Hardware description; runs once
+static void sample_specs_source(gpointer data) {
+    ThreadedCollector *collector = (ThreadedCollector*)data;
+    char *specs = get_static_specs();
     
+    g_mutex_lock(&collector->coordinator_mutex);
+    g_free(collector->static_specs);
+    collector->static_specs = g_strdup(specs);
+    g_mutex_unlock(&collector->coordinator_mutex);
+    free(specs);
+}
+
+// Background collector thread: runs the metric sources until shutdown
+gpointer continuous_collector_thread(gpointer data) {
+    ThreadedCollector *collector = (ThreadedCollector*)data;
+    sample_scheduler_run(collector->scheduler);
     return NULL;
 }
 
+// Sources the backend can feed; the others are never scheduled
+static gboolean source_enabled(ThreadedCollector *collector, int id) {
+    switch (id) {
+        case COLLECTOR_SOURCE_NETWORK: return collector_backend_has_network(collector->backend);
+        case COLLECTOR_SOURCE_GPU:     return collector_backend_has_gpu(collector->backend);
+        default:                       return TRUE;
+    }
+}
+
+// Period of a source in the foreground or with the window hidden
+static guint source_period(ThreadedCollector *collector, int id, gboolean background) {
+    guint min_period = collector->backend ? collector->backend->ops->min_period_ms : 0;
+    
+    switch (id) {
+        case COLLECTOR_SOURCE_PROCESSES:
+            if (background) {
+                return collector->background_period_ms > 0
+                    ? MAX(collector->background_period_ms, min_period) : 0;
+            }
+            return MAX(collector_source_defs[id].period_ms, min_period);
+        case COLLECTOR_SOURCE_NETWORK:
+        case COLLECTOR_SOURCE_GPU:
+            return background ? 0 : collector_source_defs[id].period_ms;
+        default:
+            return collector_source_defs[id].period_ms;
+    }
+}
+
 // Start continuous background data collection
 void threaded_collector_start_continuous_collection(ThreadedCollector *collector) {
     if (!collector || collector->continuous_mode) return;
@@ -975,44 +905,105 @@ void threaded_collector_start_continuous_collection(ThreadedCollector *collector
     collector->continuous_mode = TRUE;
     collector->shutdown_requested = FALSE;
     
+    // The specs source sets the real core count later; until then the top
+    // path normalizes by the processors this process can see
+    if (cpu_cores <= 0) cpu_cores = (int)g_get_num_processors();
+    
+    // OPTIMIZATION: Each metric source at its own period instead of one
+    // full collection every 1.5 seconds, on the worker pool so sources
+    // that come due together run side by side
+    collector->scheduler = sample_scheduler_new();
+    sample_scheduler_set_pool(collector->scheduler, collector_pool(collector));
+    const char *background_override = g_getenv("TASKMINI_BACKGROUND_PERIOD_MS");
+    collector->background_period_ms = background_override
+        ? (guint)g_ascii_strtoull(background_override, NULL, 10) : SAMPLE_PERIOD_BACKGROUND_MS;
+    
+    g_mutex_lock(&collector->coordinator_mutex);
+    gboolean background = collector->background;
+    g_mutex_unlock(&collector->coordinator_mutex);
+    
+    for (int i = 0; i < COLLECTOR_SOURCE_COUNT; i++) {
+        SampleSource *source = &collector->sources[i];
+        source->name = collector_source_defs[i].name;
+        source->func = collector_source_defs[i].func;
+        source->data = collector;
+        source->period_ms = source_period(collector, i, background);
+        source->cost_ms = collector_source_defs[i].cost_ms;
+        // Always one first run: processes and specs fill the window, the
+        // others prime their rates
+        if (source_enabled(collector, i)) sample_scheduler_add(collector->scheduler, source);
+    }
+    
     // Start the background collector thread
     collector->collector_thread = g_thread_new("continuous_collector", 
                                                continuous_collector_thread, 
                                                collector);
 }
 
-// Get the latest complete data from the bin (fast operation)
-UpdateData* threaded_collector_get_latest_complete_data(ThreadedCollector *collector) {
+// Hardware description from the specs source, NULL until it has run
+char* threaded_collector_dup_static_specs(ThreadedCollector *collector) {
     if (!collector) return NULL;
+    g_mutex_lock(&collector->coordinator_mutex);
+    char *specs = g_strdup(collector->static_specs);
+    g_mutex_unlock(&collector->coordinator_mutex);
+    return specs;
+}
+
+// Get a reference to the latest complete data (fast operation, no copy)
+Snapshot* threaded_collector_acquire_snapshot(ThreadedCollector *collector) {
+    if (!collector) return NULL;
+    return snapshot_slot_acquire(&collector->data_bin);
+}
+
+void threaded_collector_set_background(ThreadedCollector *collector, gboolean background) {
+    if (!collector) return;
     
-    UpdateData *data_copy = NULL;
-    
-    g_mutex_lock(&collector->bin_mutex);
-    
-    if (collector->data_bin) {
-        // Create a deep copy of the current data
-        data_copy = g_malloc0(sizeof(UpdateData));
-        
-        // Copy system-wide values
-        data_copy->system_cpu_usage = collector->data_bin->system_cpu_usage;
-        data_copy->system_memory_usage = collector->data_bin->system_memory_usage;
-        
-        // Deep copy process list
-        if (collector->data_bin->processes) {
-            data_copy->processes = g_list_copy_deep(collector->data_bin->processes, 
-                                                   (GCopyFunc)copy_process, NULL);
-        }
-        
-        // Copy string data
-        if (collector->data_bin->system_summary) {
-            data_copy->system_summary = g_strdup(collector->data_bin->system_summary);
-        }
-        if (collector->data_bin->gpu_usage) {
-            data_copy->gpu_usage = g_strdup(collector->data_bin->gpu_usage);
+    g_mutex_lock(&collector->coordinator_mutex);
+    gboolean changed = collector->background != background;
+    collector->background = background;
+    g_mutex_unlock(&collector->coordinator_mutex);
+    if (!changed || !collector->scheduler) return;  // start() reads the flag
+    
+    for (int i = 0; i < COLLECTOR_SOURCE_COUNT; i++) {
+        if (i == COLLECTOR_SOURCE_SPECS || !source_enabled(collector, i)) continue;
+        SampleSource *source = &collector->sources[i];
+        sample_scheduler_set_period(collector->scheduler, source, source_period(collector, i, background));
+        // Showing: fresh data right away. Hiding: the process source runs
+        // once more to put the backend in background mode.
+        if (!background || i == COLLECTOR_SOURCE_PROCESSES) {
+            sample_scheduler_trigger(collector->scheduler, source);
         }
     }
+}
+
+void threaded_collector_set_publish_notify(ThreadedCollector *collector, SnapshotNotifyFunc func, gpointer user_data) {
+    if (!collector) return;
+    snapshot_slot_set_notify(&collector->data_bin, func, user_data);
+}
+
+// Get a private deep copy of the latest complete data
+UpdateData* threaded_collector_get_latest_complete_data(ThreadedCollector *collector) {
+    Snapshot *snapshot = threaded_collector_acquire_snapshot(collector);
+    if (!snapshot) return NULL;
+    
+    const UpdateData *latest = snapshot->data;
+    UpdateData *data_copy = g_malloc0(sizeof(UpdateData));
+    
+    // Copy system-wide values
+    data_copy->system_cpu_usage = latest->system_cpu_usage;
+    data_copy->system_memory_usage = latest->system_memory_usage;
     
-    g_mutex_unlock(&collector->bin_mutex);
+    // Copy process table
+    data_copy->processes = process_table_copy(latest->processes);
+    
+    // Copy string data
+    if (latest->system_summary) {
+        data_copy->system_summary = g_strdup(latest->system_summary);
+    }
+    if (latest->gpu_usage) {
+        data_copy->gpu_usage = g_strdup(latest->gpu_usage);
+    }
     
+    snapshot_unref(snapshot);
     return data_copy;
 }
@@ -4,6 +4,13 @@
 #include <glib.h>
 #include <time.h>
 #include "../common/types.h"
+#include "collector_backend.h"
+#include "snapshot.h"
+#include "sample_scheduler.h"
+#include "../utils/pid_map.h"
+#include "../utils/rate_store.h"
+#include "../utils/scanner.h"
+#include "../utils/worker_pool.h"
 
 // Threading states
 typedef enum {
@@ -15,7 +22,7 @@ typedef enum {
 
 // Data collection results for different components
 typedef struct {
-    GList *processes;           // Basic process list (PID, name, type)
+    ProcessTable *processes;    // Basic process table (PID, name, type)
     char *system_summary;       // System summary info (Networks, VM, Disks)
     ThreadState state;
     time_t timestamp;
@@ -24,7 +31,7 @@ typedef struct {
 
 typedef struct {
     float cpu_usage;            // System-wide CPU usage
-    GHashTable *process_cpu;    // Per-process CPU usage (PID -> CPU%)
+    PidMap *process_cpu;        // Per-process CPU usage (PID -> float CPU%)
     ThreadState state;
     time_t timestamp;
     GMutex mutex;
@@ -32,7 +39,7 @@ typedef struct {
 
 typedef struct {
     float memory_usage;         // System-wide memory usage
-    GHashTable *process_memory; // Per-process memory usage (PID -> bytes)
+    PidMap *process_memory;     // Per-process memory usage (PID -> long long bytes)
     ThreadState state;
     time_t timestamp;
     GMutex mutex;
@@ -47,14 +54,32 @@ typedef struct {
 } GPUDataResult;
 
 typedef struct {
-    GHashTable *process_network; // Per-process network rates (PID -> KB/s)
-    GHashTable *prev_net_bytes;  // Previous network bytes per process
-    GHashTable *prev_times;      // Previous collection times per process
+    PidMap *process_network;    // Per-process network rates (PID -> double bytes/s)
+    RateStore *net_counters;    // Previous network bytes per (PID, start time)
     ThreadState state;
     time_t timestamp;
     GMutex mutex;
 } NetworkDataResult;
 
+// Collection tasks run on the worker pool each cycle
+typedef enum {
+    COLLECTOR_TASK_PROCESS,
+    COLLECTOR_TASK_CPU,
+    COLLECTOR_TASK_MEMORY,
+    COLLECTOR_TASK_GPU,
+    COLLECTOR_TASK_NETWORK,
+    COLLECTOR_TASK_COUNT
+} CollectorTaskId;
+
+// Metric sources of the continuous collector, each on its own period
+typedef enum {
+    COLLECTOR_SOURCE_PROCESSES,     // Backend sample: process list, CPU, memory
+    COLLECTOR_SOURCE_NETWORK,       // Backend network rates (if supported)
+    COLLECTOR_SOURCE_GPU,           // Backend GPU usage (if supported)
+    COLLECTOR_SOURCE_SPECS,         // Static hardware description, once
+    COLLECTOR_SOURCE_COUNT
+} CollectorSourceId;
+
 // Main collector structure
 typedef struct {
     ProcessListResult *process_list;
@@ -63,12 +88,11 @@ typedef struct {
     GPUDataResult *gpu_data;
     NetworkDataResult *network_data;
     
-    // Thread handles
-    GThread *process_thread;
-    GThread *cpu_thread;
-    GThread *memory_thread;
-    GThread *gpu_thread;
-    GThread *network_thread;
+    // OPTIMIZATION: Persistent worker threads - every cycle queues the
+    // same tasks instead of creating and destroying five threads
+    WorkerPool *pool;               // Created on first use; also runs the sources and backend scans
+    WorkerBatch batch;              // Completion barrier of the current cycle
+    WorkerTask tasks[COLLECTOR_TASK_COUNT];
     
     // Coordination
     gboolean shutdown_requested;
@@ -76,10 +100,24 @@ typedef struct {
     time_t collection_start_time;
     
     // Collector/Bin system - pre-built complete data ready for fast UI access
-    UpdateData *data_bin;           // Latest complete dataset
-    GMutex bin_mutex;              // Protects the data bin
+    // OPTIMIZATION: Published as an immutable snapshot - readers take a
+    // reference without locking or copying
+    SnapshotSlot data_bin;          // Latest complete dataset
     GThread *collector_thread;     // Single background collector thread
     gboolean continuous_mode;      // Whether collector runs continuously
+    CollectorBackend *backend;     // Data source used by the collector thread
+    
+    // OPTIMIZATION: Multi-rate sampling; the collector thread schedules,
+    // the worker pool runs the sources
+    SampleScheduler *scheduler;
+    SampleSource sources[COLLECTOR_SOURCE_COUNT];
+    char *gpu_usage;               // Latest GPU sample (coordinator_mutex)
+    char *static_specs;            // Hardware description (coordinator_mutex)
+    
+    // OPTIMIZATION: Slow sampling while nobody is looking
+    gboolean background;           // Window hidden (coordinator_mutex)
+    gboolean backend_background;   // Mode last applied to the backend (collector thread)
+    guint background_period_ms;    // Process period while hidden, 0 = paused
     
 } ThreadedCollector;
 
@@ -88,24 +126,53 @@ ThreadedCollector* threaded_collector_create(void);
 void threaded_collector_destroy(ThreadedCollector *collector);
 
 // Original threading functions (kept for compatibility)
-void threaded_collector_start_collection(ThreadedCollector *collector);
+void threaded_collector_start_collection(ThreadedCollector *collector);   // No-op while a cycle is running
+void threaded_collector_wait_collection(ThreadedCollector *collector);
 gboolean threaded_collector_has_basic_data(ThreadedCollector *collector);
 gboolean threaded_collector_has_complete_data(ThreadedCollector *collector);
 UpdateData* threaded_collector_get_available_data(ThreadedCollector *collector);
 
 // New collector/bin functions (efficient approach)
 void threaded_collector_start_continuous_collection(ThreadedCollector *collector);
+Snapshot* threaded_collector_acquire_snapshot(ThreadedCollector *collector);  // Release with snapshot_unref()
+// Window hidden: sample the process list at the background period only.
+// Back in the foreground a fresh sample is taken at once.
+void threaded_collector_set_background(ThreadedCollector *collector, gboolean background);
+// Called on the collector thread after every publish (see snapshot_slot_set_notify)
+void threaded_collector_set_publish_notify(ThreadedCollector *collector, SnapshotNotifyFunc func, gpointer user_data);
+char* threaded_collector_dup_static_specs(ThreadedCollector *collector);       // NULL until sampled
+
+// Deep copy of the latest snapshot for callers that need to own or modify it
 UpdateData* threaded_collector_get_latest_complete_data(ThreadedCollector *collector);
 
-// Individual collection threads
-gpointer collect_process_list_thread(gpointer data);
-gpointer collect_cpu_data_thread(gpointer data);
-gpointer collect_memory_data_thread(gpointer data);
-gpointer collect_gpu_data_thread(gpointer data);
-gpointer collect_network_data_thread(gpointer data);
+// One full sample through the top/ps pipeline (used by the "top" backend)
+UpdateData* collect_complete_data_sync(void);
+
+// Parser for one top sample (lines from "Processes:" on), shared by the
+// one-shot top pipeline and the streaming backend
+typedef struct {
+    ProcessTable *processes;
+    char summary[2048];
+    gboolean found_header;      // PID/COMMAND header seen
+    int process_count;
+    guint max_processes;        // get_max_processes_per_update() at init
+    int line_index;
+    time_t start_time;
+} TopFrameParser;
+
+void top_frame_parser_init(TopFrameParser *parser);
+gboolean top_frame_parser_feed(TopFrameParser *parser, StrView line);  // FALSE once a limit is hit
+UpdateData* top_frame_parser_finish(TopFrameParser *parser);           // Adds system usage; GPU is "N/A"
+
+// Individual collection tasks (data is the ThreadedCollector)
+void collect_process_list_task(gpointer data);
+void collect_cpu_data_task(gpointer data);
+void collect_memory_data_task(gpointer data);
+void collect_gpu_data_task(gpointer data);
+void collect_network_data_task(gpointer data);
 
 // Helper functions
-void merge_process_data(GList *processes, CPUDataResult *cpu, MemoryDataResult *memory, 
+void merge_process_data(ProcessTable *processes, CPUDataResult *cpu, MemoryDataResult *memory, 
                        GPUDataResult *gpu, NetworkDataResult *network);
 void cleanup_process_list_result(ProcessListResult *result);
 void cleanup_cpu_data_result(CPUDataResult *result);
@@ -14,26 +14,28 @@ void show_context_menu(GtkWidget *widget, GdkEventButton *event, gpointer user_d
     }
     
     // Get process info
-    gchar *pid = NULL, *name = NULL, *type = NULL;
+    gint pid_value = 0;
+    gchar *name = NULL;
+    gboolean is_system = FALSE;
     gtk_tree_model_get(model, &iter, 
-                       COL_PID, &pid, 
+                       COL_PID, &pid_value, 
                        COL_NAME, &name, 
-                       COL_TYPE, &type, 
+                       COL_TYPE, &is_system, 
                        -1);
     
     // Don't show context menu for system processes
-    if (type && strstr(type, "🛡️") != NULL) {
-        g_free(pid);
+    if (is_system) {
         g_free(name);
-        g_free(type);
         return;
     }
     
+    gchar *pid = g_strdup_printf("%d", pid_value);
+    
     // Create context menu
     GtkWidget *menu = gtk_menu_new();
     
     // Kill process menu item
-    gchar *menu_text = g_strdup_printf("Terminate Process %s (%s)", name ? name : "Unknown", pid ? pid : "0");
+    gchar *menu_text = g_strdup_printf("Terminate Process %s (%s)", name ? name : "Unknown", pid);
     GtkWidget *kill_item = gtk_menu_item_new_with_label(menu_text);
     g_free(menu_text);
     
@@ -49,7 +51,6 @@ void show_context_menu(GtkWidget *widget, GdkEventButton *event, gpointer user_d
     
     g_free(pid);
     g_free(name);
-    g_free(type);
 }
 
 // Right-click event handler
@@ -0,0 +1,623 @@
+#include "filter.h"
+#include "../utils/utils.h"
+#include <ctype.h>
+#include <math.h>
+#include <string.h>
+#include <strings.h>
+
+#define FILTER_NAME_MEMO_BITS 8
+#define FILTER_NAME_MEMO (1u << FILTER_NAME_MEMO_BITS)  // Distinct names remembered per select pass
+
+// ============================================================================
+// FILTER TEXT PARSING
+// ============================================================================
+
+// Helper function to convert memory string to bytes for comparison
+long long memory_to_bytes(const char *mem_str) {
+    if (!mem_str || strlen(mem_str) == 0) return -1;
+    
+    char temp[50];
+    strncpy(temp, mem_str, sizeof(temp) - 1);
+    temp[sizeof(temp) - 1] = '\0';
+    
+    // Convert to uppercase for consistent comparison
+    for (int i = 0; temp[i]; i++) {
+        temp[i] = toupper(temp[i]);
+    }
+    
+    char *endptr;
+    double value = strtod(temp, &endptr);
+    if (value < 0) return -1;
+    
+    // Skip whitespace
+    while (*endptr && isspace(*endptr)) endptr++;
+    
+    // Check suffix (case-insensitive)
+    if (strstr(endptr, "TB")) {
+        return (long long)(value * 1024LL * 1024LL * 1024LL * 1024LL);
+    } else if (strstr(endptr, "GB")) {
+        return (long long)(value * 1024LL * 1024LL * 1024LL);
+    } else if (strstr(endptr, "MB")) {
+        return (long long)(value * 1024LL * 1024LL);
+    } else if (strstr(endptr, "KB")) {
+        return (long long)(value * 1024LL);
+    } else if (strstr(endptr, "B") || strlen(endptr) == 0) {
+        return (long long)value; // Bytes or no suffix
+    } else {
+        return -1; // Invalid suffix
+    }
+}
+
+// Helper function to extract numeric value and operator from filter string
+gboolean parse_numeric_filter(const char *filter, double *value, char *op, const char *suffix) {
+    if (!filter || strlen(filter) == 0) return FALSE;
+    
+    char temp[50];
+    strncpy(temp, filter, sizeof(temp) - 1);
+    temp[sizeof(temp) - 1] = '\0';
+    
+    int len = strlen(temp);
+    if (len == 0) return FALSE;
+    
+    // Check for operators at the end
+    if (temp[len - 1] == '+') {
+        *op = '+';
+        temp[len - 1] = '\0';
+        len--;
+    } else if (temp[len - 1] == '-') {
+        *op = '-';
+        temp[len - 1] = '\0';
+        len--;
+    } else {
+        *op = '='; // Exact match
+    }
+    
+    // Remove suffix if provided (like % for percentages)
+    if (suffix && strlen(suffix) > 0) {
+        char *pos = strstr(temp, suffix);
+        if (pos) {
+            *pos = '\0';
+            len = strlen(temp);
+        }
+    }
+    
+    if (len == 0) return FALSE;
+    
+    char *endptr;
+    *value = strtod(temp, &endptr);
+    return (endptr != temp && *value >= 0); // Valid if we parsed something and it's non-negative
+}
+
+// Helper function to parse memory filter with operators
+gboolean parse_memory_filter(const char *filter, long long *bytes, char *op) {
+    if (!filter || strlen(filter) == 0) return FALSE;
+    
+    char temp[50];
+    strncpy(temp, filter, sizeof(temp) - 1);
+    temp[sizeof(temp) - 1] = '\0';
+    
+    int len = strlen(temp);
+    if (len == 0) return FALSE;
+    
+    // Check for operators at the end
+    if (temp[len - 1] == '+') {
+        *op = '+';
+        temp[len - 1] = '\0';
+    } else if (temp[len - 1] == '-') {
+        *op = '-';
+        temp[len - 1] = '\0';
+    } else {
+        *op = '='; // Exact match
+    }
+    
+    *bytes = memory_to_bytes(temp);
+    return (*bytes >= 0);
+}
+
+// Helper function to convert network rate string to bytes per second
+long long network_to_bps(const char *net_str) {
+    if (!net_str || strlen(net_str) == 0) return -1;
+    
+    char temp[50];
+    strncpy(temp, net_str, sizeof(temp) - 1);
+    temp[sizeof(temp) - 1] = '\0';
+    
+    // Convert to uppercase for consistent comparison
+    for (int i = 0; temp[i]; i++) {
+        temp[i] = toupper(temp[i]);
+    }
+    
+    char *endptr;
+    double value = strtod(temp, &endptr);
+    if (value < 0) return -1;
+    
+    // Skip whitespace
+    while (*endptr && isspace(*endptr)) endptr++;
+    
+    // Check for /S suffix
+    char *per_sec = strstr(endptr, "/S");
+    if (!per_sec) return -1; // Must have /s or /S
+    
+    // Check prefix before /S
+    if (strstr(endptr, "GB/S")) {
+        return (long long)(value * 1024LL * 1024LL * 1024LL);
+    } else if (strstr(endptr, "MB/S")) {
+        return (long long)(value * 1024LL * 1024LL);
+    } else if (strstr(endptr, "KB/S")) {
+        return (long long)(value * 1024LL);
+    } else if (strstr(endptr, "B/S")) {
+        return (long long)value;
+    } else {
+        return -1; // Invalid format
+    }
+}
+
+// Helper function to parse network filter with operators
+gboolean parse_network_filter(const char *filter, long long *bps, char *op) {
+    if (!filter || strlen(filter) == 0) return FALSE;
+    
+    char temp[50];
+    strncpy(temp, filter, sizeof(temp) - 1);
+    temp[sizeof(temp) - 1] = '\0';
+    
+    int len = strlen(temp);
+    if (len == 0) return FALSE;
+    
+    // Check for operators at the end
+    if (temp[len - 1] == '+') {
+        *op = '+';
+        temp[len - 1] = '\0';
+    } else if (temp[len - 1] == '-') {
+        *op = '-';
+        temp[len - 1] = '\0';
+    } else {
+        *op = '='; // Exact match
+    }
+    
+    *bps = network_to_bps(temp);
+    return (*bps >= 0);
+}
+
+// Parse range filter like "[100,200]" or "[1.5,5.0]"
+gboolean parse_range_filter(const char *filter, double *min_val, double *max_val) {
+    if (!filter || strlen(filter) < 5) return FALSE;
+    
+    // Check if it's a range format [min,max]
+    if (filter[0] != '[') return FALSE;
+    
+    const char *end = strchr(filter, ']');
+    if (!end) return FALSE;
+    
+    // Find comma separator
+    const char *comma = strchr(filter + 1, ',');
+    if (!comma || comma >= end) return FALSE;
+    
+    // Parse min value
+    char min_str[32];
+    int min_len = comma - (filter + 1);
+    if (min_len >= sizeof(min_str)) return FALSE;
+    strncpy(min_str, filter + 1, min_len);
+    min_str[min_len] = '\0';
+    
+    // Parse max value  
+    char max_str[32];
+    int max_len = end - (comma + 1);
+    if (max_len >= sizeof(max_str)) return FALSE;
+    strncpy(max_str, comma + 1, max_len);
+    max_str[max_len] = '\0';
+    
+    // Convert to numbers
+    char *endptr;
+    *min_val = strtod(min_str, &endptr);
+    if (*endptr != '\0') return FALSE;
+    
+    *max_val = strtod(max_str, &endptr);
+    if (*endptr != '\0') return FALSE;
+    
+    return *min_val <= *max_val; // Validate range
+}
+
+// Parse range filter for memory/network like "[100MB,1GB]" 
+gboolean parse_memory_range_filter(const char *filter, long long *min_bytes, long long *max_bytes) {
+    if (!filter || strlen(filter) < 5) return FALSE;
+    
+    // Check if it's a range format [min,max]
+    if (filter[0] != '[') return FALSE;
+    
+    const char *end = strchr(filter, ']');
+    if (!end) return FALSE;
+    
+    // Find comma separator
+    const char *comma = strchr(filter + 1, ',');
+    if (!comma || comma >= end) return FALSE;
+    
+    // Parse min value
+    char min_str[32];
+    int min_len = comma - (filter + 1);
+    if (min_len >= sizeof(min_str)) return FALSE;
+    strncpy(min_str, filter + 1, min_len);
+    min_str[min_len] = '\0';
+    
+    // Parse max value  
+    char max_str[32];
+    int max_len = end - (comma + 1);
+    if (max_len >= sizeof(max_str)) return FALSE;
+    strncpy(max_str, comma + 1, max_len);
+    max_str[max_len] = '\0';
+    
+    // Convert to bytes using existing parse_bytes function
+    *min_bytes = parse_bytes(min_str);
+    *max_bytes = parse_bytes(max_str);
+    
+    return (*min_bytes >= 0 && *max_bytes >= 0 && *min_bytes <= *max_bytes);
+}
+
+// Parse range filter for network like "[1MB/s,10MB/s]"
+gboolean parse_network_range_filter(const char *filter, long long *min_bps, long long *max_bps) {
+    if (!filter || strlen(filter) < 5) return FALSE;
+    
+    // Check if it's a range format [min,max]
+    if (filter[0] != '[') return FALSE;
+    
+    const char *end = strchr(filter, ']');
+    if (!end) return FALSE;
+    
+    // Find comma separator
+    const char *comma = strchr(filter + 1, ',');
+    if (!comma || comma >= end) return FALSE;
+    
+    // Parse min value
+    char min_str[32];
+    int min_len = comma - (filter + 1);
+    if (min_len >= sizeof(min_str)) return FALSE;
+    strncpy(min_str, filter + 1, min_len);
+    min_str[min_len] = '\0';
+    
+    // Parse max value  
+    char max_str[32];
+    int max_len = end - (comma + 1);
+    if (max_len >= sizeof(max_str)) return FALSE;
+    strncpy(max_str, comma + 1, max_len);
+    max_str[max_len] = '\0';
+    
+    // Convert to bytes per second using existing network_to_bps function
+    *min_bps = network_to_bps(min_str);
+    *max_bps = network_to_bps(max_str);
+    
+    return (*min_bps >= 0 && *max_bps >= 0 && *min_bps <= *max_bps);
+}
+
+
+// ============================================================================
+// COMPILER
+// ============================================================================
+
+static gint64 double_to_int64(double value) {
+    if (value <= (double)G_MININT64) return G_MININT64;
+    if (value >= (double)G_MAXINT64) return G_MAXINT64;
+    return (gint64)value;
+}
+
+// Smallest float >= value and largest float <= value, so float compares
+// give the same answer as the double compares they replace
+static float float_at_least(double value) {
+    float f = (float)value;
+    if ((double)f < value) f = nextafterf(f, INFINITY);
+    return f;
+}
+
+static float float_at_most(double value) {
+    float f = (float)value;
+    if ((double)f > value) f = nextafterf(f, -INFINITY);
+    return f;
+}
+
+// "[min,max]", "N+", "N-" or "N" (N +/- 0.1) on a percentage column
+static gboolean compile_percent(const char *text, float *min_out, float *max_out) {
+    double min_val, max_val, value;
+    char op;
+
+    if (parse_range_filter(text, &min_val, &max_val)) {
+        *min_out = float_at_least(min_val);
+        *max_out = float_at_most(max_val);
+        return TRUE;
+    }
+    if (!parse_numeric_filter(text, &value, &op, "%")) return FALSE;
+
+    switch (op) {
+        case '+':
+            *min_out = float_at_least(value);
+            *max_out = INFINITY;
+            break;
+        case '-':
+            *min_out = -INFINITY;
+            *max_out = float_at_most(value);
+            break;
+        default:
+            *min_out = float_at_least(value - 0.1);
+            *max_out = float_at_most(value + 0.1);
+            break;
+    }
+    return TRUE;
+}
+
+// Byte count with operator: "=" means within 10% of the value
+static gboolean compile_byte_op(long long value, char op, guint64 *min_out, guint64 *max_out) {
+    switch (op) {
+        case '+':
+            *min_out = (guint64)value;
+            *max_out = G_MAXUINT64;
+            return TRUE;
+        case '-':
+            *min_out = 0;
+            *max_out = (guint64)value;
+            return TRUE;
+        default: {
+            if (value <= 0) return FALSE;  // No tolerance around 0, not filtered
+            guint64 tolerance = (guint64)floor(value * 0.1);
+            *min_out = (guint64)value > tolerance ? (guint64)value - tolerance : 0;
+            *max_out = (guint64)value + tolerance;
+            return TRUE;
+        }
+    }
+}
+
+void filter_program_compile(FilterProgram *program, const FilterCriteria *criteria) {
+    memset(program, 0, sizeof(*program));
+    if (!criteria || !criteria->active) return;
+
+    // PID
+    if (criteria->pid_filter[0]) {
+        double min_val, max_val, value;
+        char op;
+        if (parse_range_filter(criteria->pid_filter, &min_val, &max_val)) {
+            program->pid_min = double_to_int64(trunc(min_val));
+            program->pid_max = double_to_int64(trunc(max_val));
+            program->checks |= FILTER_CHECK_PID;
+        } else if (parse_numeric_filter(criteria->pid_filter, &value, &op, NULL)) {
+            program->pid_min = op == '-' ? G_MININT64 : double_to_int64(op == '+' ? ceil(value) : trunc(value));
+            program->pid_max = op == '+' ? G_MAXINT64 : double_to_int64(op == '-' ? floor(value) : trunc(value));
+            program->checks |= FILTER_CHECK_PID;
+        }
+    }
+
+    // Name: case-insensitive substring
+    if (criteria->name_filter[0]) {
+        gsize len = MIN(strlen(criteria->name_filter), sizeof(program->name) - 1);
+        for (gsize i = 0; i < len; i++) {
+            program->name[i] = (char)tolower((unsigned char)criteria->name_filter[i]);
+        }
+        program->name[len] = '\0';
+        program->name_len = len;
+        program->checks |= FILTER_CHECK_NAME;
+    }
+
+    if (criteria->cpu_filter[0] &&
+        compile_percent(criteria->cpu_filter, &program->cpu_min, &program->cpu_max)) {
+        program->checks |= FILTER_CHECK_CPU;
+    }
+    if (criteria->gpu_filter[0] &&
+        compile_percent(criteria->gpu_filter, &program->gpu_min, &program->gpu_max)) {
+        program->checks |= FILTER_CHECK_GPU;
+    }
+
+    // Memory
+    if (criteria->memory_filter[0]) {
+        long long min_bytes, max_bytes, value;
+        char op;
+        if (parse_memory_range_filter(criteria->memory_filter, &min_bytes, &max_bytes)) {
+            program->mem_min = (guint64)min_bytes;
+            program->mem_max = (guint64)max_bytes;
+            program->checks |= FILTER_CHECK_MEM;
+        } else if (parse_memory_filter(criteria->memory_filter, &value, &op) &&
+                   compile_byte_op(value, op, &program->mem_min, &program->mem_max)) {
+            program->checks |= FILTER_CHECK_MEM;
+        }
+    }
+
+    // Network
+    if (criteria->network_filter[0]) {
+        long long min_bps, max_bps, value;
+        char op;
+        if (parse_network_range_filter(criteria->network_filter, &min_bps, &max_bps)) {
+            program->net_min = (guint64)min_bps;
+            program->net_max = (guint64)max_bps;
+            program->checks |= FILTER_CHECK_NET;
+        } else if (parse_network_filter(criteria->network_filter, &value, &op) &&
+                   compile_byte_op(value, op, &program->net_min, &program->net_max)) {
+            program->checks |= FILTER_CHECK_NET;
+        }
+    }
+
+    // Type: "All" (or empty) does not filter
+    if (criteria->type_filter[0] && strcmp(criteria->type_filter, "All") != 0) {
+        const char *type = criteria->type_filter;
+        if (strcasecmp(type, "System") == 0) {
+            program->type_mask = FILTER_TYPE_SYSTEM;
+        } else if (strcasecmp(type, "User") == 0) {
+            program->type_mask = FILTER_TYPE_USER;
+        } else {
+            if (strcasecmp(type, process_type_label(FALSE)) == 0) program->type_mask |= FILTER_TYPE_USER;
+            if (strcasecmp(type, process_type_label(TRUE)) == 0) program->type_mask |= FILTER_TYPE_SYSTEM;
+        }
+        program->checks |= FILTER_CHECK_TYPE;
+    }
+}
+
+// ============================================================================
+// EVALUATION
+// ============================================================================
+
+// Case-insensitive substring search; needle is already lowercased
+static gboolean name_contains(const char *haystack, const char *needle, gsize needle_len) {
+    for (const char *start = haystack; *start; start++) {
+        gsize i = 0;
+        while (i < needle_len && start[i] &&
+               (char)tolower((unsigned char)start[i]) == needle[i]) {
+            i++;
+        }
+        if (i == needle_len) return TRUE;
+        if (!start[i]) return FALSE;  // Rest of haystack is shorter than needle
+    }
+    return needle_len == 0;
+}
+
+static guint8 sample_type_bit(const ProcessSample *proc) {
+    return (proc->flags & PROCESS_FLAG_SYSTEM) ? FILTER_TYPE_SYSTEM : FILTER_TYPE_USER;
+}
+
+gboolean filter_program_matches(const FilterProgram *program, const ProcessSample *proc) {
+    guint32 checks = program->checks;
+    if (checks == 0) return TRUE;
+
+    // Numeric checks first, the name search last
+    if ((checks & FILTER_CHECK_PID) &&
+        ((gint64)proc->pid < program->pid_min || (gint64)proc->pid > program->pid_max)) {
+        return FALSE;
+    }
+    if ((checks & FILTER_CHECK_CPU) && !(proc->cpu >= program->cpu_min && proc->cpu <= program->cpu_max)) {
+        return FALSE;
+    }
+    if (checks & FILTER_CHECK_GPU) {
+        float gpu = (proc->flags & PROCESS_FLAG_HAS_GPU) ? proc->gpu : 0.0f;
+        if (!(gpu >= program->gpu_min && gpu <= program->gpu_max)) return FALSE;
+    }
+    if ((checks & FILTER_CHECK_MEM) &&
+        (proc->rss_bytes < program->mem_min || proc->rss_bytes > program->mem_max)) {
+        return FALSE;
+    }
+    if ((checks & FILTER_CHECK_NET) &&
+        (proc->net_bps < program->net_min || proc->net_bps > program->net_max)) {
+        return FALSE;
+    }
+    if ((checks & FILTER_CHECK_TYPE) && !(sample_type_bit(proc) & program->type_mask)) {
+        return FALSE;
+    }
+    if ((checks & FILTER_CHECK_NAME) && !name_contains(process_name(proc), program->name, program->name_len)) {
+        return FALSE;
+    }
+    return TRUE;
+}
+
+void filter_columns_load(FilterColumns *cols, const ProcessTable *table, guint32 checks) {
+    guint count = table ? table->count : 0;
+
+    if (count > cols->capacity) {
+        guint capacity = MAX(count, cols->capacity * 2);
+        cols->pid = g_renew(gint32, cols->pid, capacity);
+        cols->cpu = g_renew(float, cols->cpu, capacity);
+        cols->gpu = g_renew(float, cols->gpu, capacity);
+        cols->mem = g_renew(guint64, cols->mem, capacity);
+        cols->net = g_renew(guint64, cols->net, capacity);
+        cols->type = g_renew(guint8, cols->type, capacity);
+        cols->name_id = g_renew(guint32, cols->name_id, capacity);
+        cols->capacity = capacity;
+    }
+
+    // Only the columns the program reads
+    const ProcessSample *items = table ? table->items : NULL;
+    if (checks & FILTER_CHECK_PID) {
+        for (guint i = 0; i < count; i++) cols->pid[i] = (gint32)items[i].pid;
+    }
+    if (checks & FILTER_CHECK_CPU) {
+        for (guint i = 0; i < count; i++) cols->cpu[i] = items[i].cpu;
+    }
+    if (checks & FILTER_CHECK_GPU) {
+        for (guint i = 0; i < count; i++) {
+            cols->gpu[i] = (items[i].flags & PROCESS_FLAG_HAS_GPU) ? items[i].gpu : 0.0f;
+        }
+    }
+    if (checks & FILTER_CHECK_MEM) {
+        for (guint i = 0; i < count; i++) cols->mem[i] = items[i].rss_bytes;
+    }
+    if (checks & FILTER_CHECK_NET) {
+        for (guint i = 0; i < count; i++) cols->net[i] = items[i].net_bps;
+    }
+    if (checks & FILTER_CHECK_TYPE) {
+        for (guint i = 0; i < count; i++) cols->type[i] = sample_type_bit(&items[i]);
+    }
+    if (checks & FILTER_CHECK_NAME) {
+        for (guint i = 0; i < count; i++) cols->name_id[i] = items[i].name_id;
+    }
+    cols->count = count;
+}
+
+void filter_columns_clear(FilterColumns *cols) {
+    g_free(cols->pid);
+    g_free(cols->cpu);
+    g_free(cols->gpu);
+    g_free(cols->mem);
+    g_free(cols->net);
+    g_free(cols->type);
+    g_free(cols->name_id);
+    memset(cols, 0, sizeof(*cols));
+}
+
+// OPTIMIZATION: One pass per predicate over a single column. The loop
+// bodies have no branches, so they compile to SIMD compares and ANDs.
+static void select_float(guint8 *mask, const float *column, guint count, float min, float max) {
+    for (guint i = 0; i < count; i++) {
+        mask[i] &= (column[i] >= min) & (column[i] <= max);
+    }
+}
+
+static void select_u64(guint8 *mask, const guint64 *column, guint count, guint64 min, guint64 max) {
+    for (guint i = 0; i < count; i++) {
+        mask[i] &= (column[i] >= min) & (column[i] <= max);
+    }
+}
+
+guint filter_program_select(const FilterProgram *program, const FilterColumns *cols, guint8 *mask) {
+    guint count = cols->count;
+    guint32 checks = program->checks;
+
+    memset(mask, 1, count);
+    if (checks == 0) return count;
+
+    if (checks & FILTER_CHECK_PID) {
+        if (program->pid_min > G_MAXINT32 || program->pid_max < G_MININT32) {
+            memset(mask, 0, count);
+            return 0;
+        }
+        gint32 min = (gint32)MAX(program->pid_min, (gint64)G_MININT32);
+        gint32 max = (gint32)MIN(program->pid_max, (gint64)G_MAXINT32);
+        for (guint i = 0; i < count; i++) {
+            mask[i] &= (cols->pid[i] >= min) & (cols->pid[i] <= max);
+        }
+    }
+    if (checks & FILTER_CHECK_CPU) select_float(mask, cols->cpu, count, program->cpu_min, program->cpu_max);
+    if (checks & FILTER_CHECK_GPU) select_float(mask, cols->gpu, count, program->gpu_min, program->gpu_max);
+    if (checks & FILTER_CHECK_MEM) select_u64(mask, cols->mem, count, program->mem_min, program->mem_max);
+    if (checks & FILTER_CHECK_NET) select_u64(mask, cols->net, count, program->net_min, program->net_max);
+    if (checks & FILTER_CHECK_TYPE) {
+        guint8 type_mask = program->type_mask;
+        for (guint i = 0; i < count; i++) {
+            mask[i] &= (cols->type[i] & type_mask) != 0;
+        }
+    }
+
+    // Name search only for rows the numeric passes kept
+    // OPTIMIZATION: Rows share interned names (every "chrome" is one ID), so
+    // each distinct name is searched once and then looked up by ID
+    if (checks & FILTER_CHECK_NAME) {
+        guint32 memo_id[FILTER_NAME_MEMO];
+        guint8 memo_match[FILTER_NAME_MEMO];
+        memset(memo_id, 0xff, sizeof(memo_id));  // No valid ID is all ones
+        for (guint i = 0; i < count; i++) {
+            if (!mask[i]) continue;
+            guint32 id = cols->name_id[i];
+            guint slot = (id * 2654435761u) >> (32 - FILTER_NAME_MEMO_BITS);
+            if (memo_id[slot] != id) {
+                memo_id[slot] = id;
+                memo_match[slot] = name_contains(string_intern_text(id), program->name, program->name_len);
+            }
+            mask[i] = memo_match[slot];
+        }
+    }
+
+    guint selected = 0;
+    for (guint i = 0; i < count; i++) {
+        selected += mask[i];
+    }
+    return selected;
+}
@@ -0,0 +1,76 @@
+#ifndef FILTER_H
+#define FILTER_H
+
+#include <glib.h>
+#include "../common/types.h"
+
+// Filter text parsing (shared by input validation and the compiler)
+long long memory_to_bytes(const char *mem_str);
+gboolean parse_numeric_filter(const char *filter, double *value, char *op, const char *suffix);
+gboolean parse_memory_filter(const char *filter, long long *bytes, char *op);
+long long network_to_bps(const char *net_str);
+gboolean parse_network_filter(const char *filter, long long *bps, char *op);
+gboolean parse_range_filter(const char *filter, double *min_val, double *max_val);
+gboolean parse_memory_range_filter(const char *filter, long long *min_bytes, long long *max_bytes);
+gboolean parse_network_range_filter(const char *filter, long long *min_bps, long long *max_bps);
+
+// Predicates present in a compiled program
+#define FILTER_CHECK_PID   (1u << 0)
+#define FILTER_CHECK_NAME  (1u << 1)
+#define FILTER_CHECK_CPU   (1u << 2)
+#define FILTER_CHECK_GPU   (1u << 3)
+#define FILTER_CHECK_MEM   (1u << 4)
+#define FILTER_CHECK_NET   (1u << 5)
+#define FILTER_CHECK_TYPE  (1u << 6)
+
+// Allowed process types for FILTER_CHECK_TYPE
+#define FILTER_TYPE_USER   (1u << 0)
+#define FILTER_TYPE_SYSTEM (1u << 1)
+
+// FilterCriteria compiled once into inclusive bounds on the raw sample
+// fields. Operators ("100+", "5%-", "=" tolerances) and ranges
+// ("[100MB,1GB]") all become a [min, max] pair, so matching a row is a
+// handful of numeric compares and at most one case-folded substring search.
+typedef struct {
+    guint32 checks;             // FILTER_CHECK_* bits, 0 matches everything
+    gint64 pid_min, pid_max;
+    float cpu_min, cpu_max;
+    float gpu_min, gpu_max;     // Processes without GPU data count as 0%
+    guint64 mem_min, mem_max;
+    guint64 net_min, net_max;
+    guint8 type_mask;           // FILTER_TYPE_* bits
+    char name[100];             // Lowercased name substring
+    gsize name_len;
+} FilterProgram;
+
+void filter_program_compile(FilterProgram *program, const FilterCriteria *criteria);
+gboolean filter_program_matches(const FilterProgram *program, const ProcessSample *proc);
+
+// Struct-of-arrays copy of the filterable fields of a ProcessTable. Each
+// predicate runs as one branch-free pass over a single column, which the
+// compiler can vectorize; names are only searched for rows still selected,
+// once per distinct interned name.
+typedef struct {
+    guint count;
+    guint capacity;
+    gint32 *pid;
+    float *cpu;
+    float *gpu;
+    guint64 *mem;
+    guint64 *net;
+    guint8 *type;               // FILTER_TYPE_* bit of each row
+    guint32 *name_id;           // Interned names of the source table's rows
+} FilterColumns;
+
+// Load the columns named by checks (FILTER_CHECK_* bits, normally
+// program->checks) from table, reusing cols' storage. Names are held as
+// borrowed IDs, so table must stay alive while cols is in use.
+void filter_columns_load(FilterColumns *cols, const ProcessTable *table, guint32 checks);
+void filter_columns_clear(FilterColumns *cols);
+
+// Set mask[i] to 1 for each selected row of cols, 0 otherwise. cols must
+// have been loaded with at least program->checks.
+// Returns the number of selected rows.
+guint filter_program_select(const FilterProgram *program, const FilterColumns *cols, guint8 *mask);
+
+#endif // FILTER_H
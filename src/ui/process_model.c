@@ -0,0 +1,588 @@
+#include "process_model.h"
+#include "ui.h"
+#include "sort_order.h"
+#include "../utils/utils.h"
+#include <string.h>
+
+// Per-table-row bookkeeping during an update
+#define ROW_VISIBLE_OLD  (1u << 0)  // Row was shown before the update
+#define ROW_VISIBLE_NEW  (1u << 1)  // Row is shown after the update
+#define ROW_CHANGED      (1u << 2)  // Data differs from the previous snapshot
+#define ROW_ADDED        (1u << 3)  // PID not in the previous snapshot
+#define ROW_KEY_CHANGED  (1u << 4)  // Sort column value changed
+
+#define ROW_GONE G_MAXUINT32
+
+struct _ProcessModel {
+    GObject parent_instance;
+
+    gint stamp;                     // Invalidates iters from before an update
+    Snapshot *snapshot;             // Rows index into snapshot->data->processes
+    GArray *rows;                   // guint32 table index per visible position
+
+    gint sort_column;               // COL_* or GTK_TREE_SORTABLE_*_SORT_COLUMN_ID
+    GtkSortType sort_order;
+
+    ProcessModelFilterFunc filter;
+    ProcessModelSelectFunc select;
+    gpointer filter_data;
+
+    ProcessModelStats stats;
+
+    // Scratch buffers reused between updates
+    GArray *row_state;              // guint8 ROW_* per table row
+    GArray *mapped;                 // guint32 new table index per old position
+    GArray *pending;                // guint32 table indices to insert
+    GArray *selected;               // guint8 select() result per table row
+    GArray *keys;                   // guint64 sort key per table row
+};
+
+static void process_model_tree_model_init(GtkTreeModelIface *iface);
+static void process_model_sortable_init(GtkTreeSortableIface *iface);
+
+G_DEFINE_TYPE_WITH_CODE(ProcessModel, process_model, G_TYPE_OBJECT,
+                        G_IMPLEMENT_INTERFACE(GTK_TYPE_TREE_MODEL, process_model_tree_model_init)
+                        G_IMPLEMENT_INTERFACE(GTK_TYPE_TREE_SORTABLE, process_model_sortable_init))
+
+// ============================================================================
+// HELPERS
+// ============================================================================
+
+static const ProcessTable* model_table(ProcessModel *model) {
+    return (model->snapshot && model->snapshot->data) ? model->snapshot->data->processes : NULL;
+}
+
+static const ProcessSample* row_sample(ProcessModel *model, guint position) {
+    const ProcessTable *table = model_table(model);
+    return &table->items[g_array_index(model->rows, guint32, position)];
+}
+
+static gboolean model_is_sorted(ProcessModel *model) {
+    return model->sort_column >= 0;
+}
+
+static void fill_iter(ProcessModel *model, GtkTreeIter *iter, guint position) {
+    iter->stamp = model->stamp;
+    iter->user_data = GUINT_TO_POINTER(position);
+    iter->user_data2 = NULL;
+    iter->user_data3 = NULL;
+}
+
+static gboolean iter_position(ProcessModel *model, GtkTreeIter *iter, guint *position) {
+    if (!iter || iter->stamp != model->stamp) return FALSE;
+    guint pos = GPOINTER_TO_UINT(iter->user_data);
+    if (pos >= model->rows->len) return FALSE;
+    *position = pos;
+    return TRUE;
+}
+
+// Sort keys of the current table for the sort column
+static void update_sort_keys(ProcessModel *model) {
+    const ProcessTable *table = model_table(model);
+    guint count = table ? table->count : 0;
+
+    g_array_set_size(model->keys, count);
+    if (count > 0 && model_is_sorted(model)) {
+        sort_order_compute_keys(table->items, count, model->sort_column, (guint64*)model->keys->data);
+    }
+}
+
+static void get_sort_order(ProcessModel *model, SortOrder *order) {
+    const ProcessTable *table = model_table(model);
+    order->items = table ? table->items : NULL;
+    order->keys = (const guint64*)model->keys->data;
+    order->column = model->sort_column;
+    order->descending = model->sort_order == GTK_SORT_DESCENDING;
+}
+
+static gint compare_pending(gconstpointer a, gconstpointer b, gpointer user_data) {
+    return sort_order_compare(user_data, *(const guint32*)a, *(const guint32*)b);
+}
+
+static void emit_row_inserted(ProcessModel *model, guint position) {
+    GtkTreeIter iter;
+    fill_iter(model, &iter, position);
+    GtkTreePath *path = gtk_tree_path_new_from_indices((gint)position, -1);
+    gtk_tree_model_row_inserted(GTK_TREE_MODEL(model), path, &iter);
+    gtk_tree_path_free(path);
+    model->stats.rows_inserted++;
+}
+
+static void emit_row_deleted(ProcessModel *model, guint position) {
+    GtkTreePath *path = gtk_tree_path_new_from_indices((gint)position, -1);
+    gtk_tree_model_row_deleted(GTK_TREE_MODEL(model), path);
+    gtk_tree_path_free(path);
+    model->stats.rows_deleted++;
+}
+
+static void emit_row_changed(ProcessModel *model, guint position) {
+    GtkTreeIter iter;
+    fill_iter(model, &iter, position);
+    GtkTreePath *path = gtk_tree_path_new_from_indices((gint)position, -1);
+    gtk_tree_model_row_changed(GTK_TREE_MODEL(model), path, &iter);
+    gtk_tree_path_free(path);
+    model->stats.rows_changed++;
+}
+
+static void emit_rows_reordered(ProcessModel *model, gint *new_order) {
+    model->stamp++;
+    GtkTreePath *path = gtk_tree_path_new();
+    gtk_tree_model_rows_reordered(GTK_TREE_MODEL(model), path, NULL, new_order);
+    gtk_tree_path_free(path);
+    model->stats.reorders++;
+}
+
+// Put the visible rows in order. With moved_flag 0 everything is sorted
+// from scratch (new sort column); otherwise only rows with moved_flag set
+// in state are re-placed. Emits one rows-reordered, only if a row moved.
+static void reorder_rows(ProcessModel *model, const guint8 *state, guint8 moved_flag) {
+    guint count = model->rows->len;
+    if (!model_is_sorted(model) || count < 2) return;
+
+    SortOrder order;
+    get_sort_order(model, &order);
+    guint32 *rows = (guint32*)model->rows->data;
+    gint *new_order = g_new(gint, count);
+
+    gboolean moved = moved_flag
+        ? sort_order_repair(&order, rows, count, state, moved_flag, new_order)
+        : sort_order_sort(&order, rows, count, new_order);
+    if (moved) emit_rows_reordered(model, new_order);
+
+    g_free(new_order);
+}
+
+// ============================================================================
+// UPDATE
+// ============================================================================
+
+// Move the model from its current snapshot to new_snapshot (or re-evaluate
+// the current one when new_snapshot is NULL). delta marks the rows whose
+// data changed; with recheck_all every row is run through the filter again.
+static void apply_update(ProcessModel *model, Snapshot *new_snapshot,
+                         const ProcessDelta *delta, gboolean recheck_all) {
+    const ProcessTable *old_table = model_table(model);
+    const ProcessTable *new_table = new_snapshot && new_snapshot->data
+        ? new_snapshot->data->processes : (new_snapshot ? NULL : old_table);
+    guint new_count = new_table ? new_table->count : 0;
+    guint64 touched_before = model->stats.rows_inserted + model->stats.rows_deleted + model->stats.rows_changed;
+
+    g_array_set_size(model->row_state, new_count);
+    if (new_count > 0) memset(model->row_state->data, 0, new_count);
+    guint8 *state = (guint8*)model->row_state->data;
+
+    if (delta) {
+        for (guint i = 0; i < delta->added->len; i++) {
+            state[g_array_index(delta->added, guint32, i)] |= ROW_ADDED;
+        }
+        guint32 key_field = model_is_sorted(model) ? sort_order_column_field(model->sort_column) : 0;
+        for (guint i = 0; i < delta->changed->len; i++) {
+            const ProcessChange *change = &g_array_index(delta->changed, ProcessChange, i);
+            state[change->index] |= ROW_CHANGED;
+            if (change->fields & key_field) state[change->index] |= ROW_KEY_CHANGED;
+        }
+    }
+
+    // Where each visible row lives in the new table
+    guint old_visible = model->rows->len;
+    g_array_set_size(model->mapped, old_visible);
+    for (guint pos = 0; pos < old_visible; pos++) {
+        guint32 old_index = g_array_index(model->rows, guint32, pos);
+        guint32 new_index = ROW_GONE;
+
+        if (old_table == new_table) {
+            new_index = old_index;
+        } else if (new_table) {
+            const ProcessSample *sample = process_table_lookup(new_table, old_table->items[old_index].pid);
+            if (sample) new_index = (guint32)(sample - new_table->items);
+        }
+
+        g_array_index(model->mapped, guint32, pos) = new_index;
+        if (new_index != ROW_GONE) state[new_index] |= ROW_VISIBLE_OLD;
+    }
+
+    // OPTIMIZATION: Only rows whose data changed are run through the filter;
+    // full re-evaluations use the bulk select when there is one
+    const guint8 *selected = NULL;
+    if (recheck_all && model->filter && model->select && new_count > 0) {
+        g_array_set_size(model->selected, new_count);
+        model->select(new_table, (guint8*)model->selected->data, model->filter_data);
+        selected = (const guint8*)model->selected->data;
+    }
+
+    for (guint i = 0; i < new_count; i++) {
+        gboolean visible;
+        if (selected) {
+            visible = selected[i] != 0;
+        } else if (recheck_all || (state[i] & (ROW_CHANGED | ROW_ADDED))) {
+            visible = !model->filter || model->filter(&new_table->items[i], model->filter_data);
+        } else {
+            visible = (state[i] & ROW_VISIBLE_OLD) != 0;
+        }
+        if (visible) state[i] |= ROW_VISIBLE_NEW;
+    }
+
+    // Deletions, last row first, while rows still index the old table
+    for (guint pos = old_visible; pos-- > 0; ) {
+        guint32 new_index = g_array_index(model->mapped, guint32, pos);
+        if (new_index != ROW_GONE && (state[new_index] & ROW_VISIBLE_NEW)) continue;
+
+        g_array_remove_index(model->rows, pos);
+        model->stamp++;
+        emit_row_deleted(model, pos);
+    }
+
+    // Switch to the new table; survivors keep their positions
+    if (new_snapshot && new_snapshot != model->snapshot) {
+        guint kept = 0;
+        for (guint pos = 0; pos < old_visible; pos++) {
+            guint32 new_index = g_array_index(model->mapped, guint32, pos);
+            if (new_index != ROW_GONE && (state[new_index] & ROW_VISIBLE_NEW)) {
+                g_array_index(model->rows, guint32, kept++) = new_index;
+            }
+        }
+
+        Snapshot *old_snapshot = model->snapshot;
+        model->snapshot = snapshot_ref(new_snapshot);
+        snapshot_unref(old_snapshot);
+    }
+    model->stamp++;
+
+    // OPTIMIZATION: The order is kept across updates; only survivors whose
+    // sort value changed are re-placed (O(n + k log k)), nothing is re-sorted
+    update_sort_keys(model);
+    reorder_rows(model, state, ROW_KEY_CHANGED);
+
+    // Insertions at their sorted positions
+    g_array_set_size(model->pending, 0);
+    for (guint32 i = 0; i < new_count; i++) {
+        if ((state[i] & ROW_VISIBLE_NEW) && !(state[i] & ROW_VISIBLE_OLD)) {
+            g_array_append_val(model->pending, i);
+        }
+    }
+    SortOrder order;
+    get_sort_order(model, &order);
+    if (model_is_sorted(model) && model->pending->len > 1) {
+        g_array_sort_with_data(model->pending, compare_pending, &order);
+    }
+    for (guint i = 0; i < model->pending->len; i++) {
+        guint32 index = g_array_index(model->pending, guint32, i);
+        guint position = model_is_sorted(model)
+            ? sort_order_position(&order, (const guint32*)model->rows->data, model->rows->len, index)
+            : model->rows->len;
+
+        g_array_insert_val(model->rows, position, index);
+        model->stamp++;
+        emit_row_inserted(model, position);
+    }
+
+    // Value changes for rows that stayed visible
+    for (guint pos = 0; pos < model->rows->len; pos++) {
+        guint32 index = g_array_index(model->rows, guint32, pos);
+        if ((state[index] & ROW_CHANGED) && (state[index] & ROW_VISIBLE_OLD)) {
+            emit_row_changed(model, pos);
+        }
+    }
+
+    guint64 touched_after = model->stats.rows_inserted + model->stats.rows_deleted + model->stats.rows_changed;
+    model->stats.rows_touched_last = (guint)(touched_after - touched_before);
+}
+
+ProcessModel* process_model_new(void) {
+    return g_object_new(PROCESS_TYPE_MODEL, NULL);
+}
+
+void process_model_set_snapshot(ProcessModel *model, Snapshot *snapshot) {
+    g_return_if_fail(PROCESS_IS_MODEL(model));
+
+    model->stats.updates++;
+    if (!snapshot || snapshot == model->snapshot) {
+        model->stats.rows_touched_last = 0;
+        return;
+    }
+
+    if (!model->snapshot) {
+        // First snapshot: everything is new
+        apply_update(model, snapshot, NULL, TRUE);
+    } else if (snapshot->delta && model->snapshot->sequence != 0 &&
+               snapshot->sequence == model->snapshot->sequence + 1) {
+        // Collector already diffed against what we show
+        apply_update(model, snapshot, snapshot->delta, FALSE);
+    } else {
+        // Skipped or unpublished snapshots: diff locally
+        const ProcessTable *new_table = snapshot->data ? snapshot->data->processes : NULL;
+        ProcessDelta *delta = process_delta_compute(model_table(model), new_table);
+        apply_update(model, snapshot, delta, FALSE);
+        process_delta_free(delta);
+    }
+}
+
+void process_model_set_filter(ProcessModel *model, ProcessModelFilterFunc filter,
+                              ProcessModelSelectFunc select, gpointer user_data) {
+    g_return_if_fail(PROCESS_IS_MODEL(model));
+    model->filter = filter;
+    model->select = select;
+    model->filter_data = user_data;
+    process_model_refilter(model);
+}
+
+void process_model_refilter(ProcessModel *model) {
+    g_return_if_fail(PROCESS_IS_MODEL(model));
+    if (!model->snapshot) return;
+    apply_update(model, NULL, NULL, TRUE);
+}
+
+const ProcessSample* process_model_get_sample(ProcessModel *model, GtkTreeIter *iter) {
+    guint position;
+    if (!PROCESS_IS_MODEL(model) || !iter_position(model, iter, &position)) return NULL;
+    return row_sample(model, position);
+}
+
+void process_model_get_stats(ProcessModel *model, ProcessModelStats *stats) {
+    if (!stats) return;
+    if (!PROCESS_IS_MODEL(model)) {
+        memset(stats, 0, sizeof(*stats));
+        return;
+    }
+    *stats = model->stats;
+}
+
+// ============================================================================
+// GtkTreeModel
+// ============================================================================
+
+static GtkTreeModelFlags process_model_get_flags(GtkTreeModel *tree_model) {
+    (void)tree_model;
+    return GTK_TREE_MODEL_LIST_ONLY;
+}
+
+static gint process_model_get_n_columns(GtkTreeModel *tree_model) {
+    (void)tree_model;
+    return NUM_COLS;
+}
+
+static GType process_model_get_column_type(GtkTreeModel *tree_model, gint column) {
+    (void)tree_model;
+    switch (column) {
+        case COL_PID:     return G_TYPE_INT;
+        case COL_NAME:    return G_TYPE_STRING;
+        case COL_CPU:     return G_TYPE_FLOAT;
+        case COL_GPU:     return G_TYPE_FLOAT;
+        case COL_MEM:     return G_TYPE_UINT64;
+        case COL_NET:     return G_TYPE_UINT64;
+        case COL_RUNTIME: return G_TYPE_INT64;
+        case COL_TYPE:    return G_TYPE_BOOLEAN;
+        default:          return G_TYPE_INVALID;
+    }
+}
+
+static gboolean process_model_get_iter(GtkTreeModel *tree_model, GtkTreeIter *iter, GtkTreePath *path) {
+    ProcessModel *model = PROCESS_MODEL(tree_model);
+    if (gtk_tree_path_get_depth(path) != 1) return FALSE;
+
+    gint position = gtk_tree_path_get_indices(path)[0];
+    if (position < 0 || (guint)position >= model->rows->len) return FALSE;
+
+    fill_iter(model, iter, (guint)position);
+    return TRUE;
+}
+
+static GtkTreePath* process_model_get_path(GtkTreeModel *tree_model, GtkTreeIter *iter) {
+    ProcessModel *model = PROCESS_MODEL(tree_model);
+    guint position;
+    g_return_val_if_fail(iter_position(model, iter, &position), NULL);
+    return gtk_tree_path_new_from_indices((gint)position, -1);
+}
+
+static void process_model_get_value(GtkTreeModel *tree_model, GtkTreeIter *iter, gint column, GValue *value) {
+    ProcessModel *model = PROCESS_MODEL(tree_model);
+    guint position;
+
+    g_value_init(value, process_model_get_column_type(tree_model, column));
+    if (!iter_position(model, iter, &position)) return;
+
+    const ProcessSample *proc = row_sample(model, position);
+    switch (column) {
+        case COL_PID:
+            g_value_set_int(value, (gint)proc->pid);
+            break;
+        case COL_NAME:
+            g_value_set_string(value, process_name(proc));
+            break;
+        case COL_CPU:
+            g_value_set_float(value, proc->cpu);
+            break;
+        case COL_GPU:
+            g_value_set_float(value, (proc->flags & PROCESS_FLAG_HAS_GPU) ? proc->gpu : -1.0f);
+            break;
+        case COL_MEM:
+            g_value_set_uint64(value, proc->rss_bytes);
+            break;
+        case COL_NET:
+            g_value_set_uint64(value, proc->net_bps);
+            break;
+        case COL_RUNTIME:
+            g_value_set_int64(value, (proc->flags & PROCESS_FLAG_HAS_START) ? proc->start_time : 0);
+            break;
+        case COL_TYPE:
+            g_value_set_boolean(value, (proc->flags & PROCESS_FLAG_SYSTEM) != 0);
+            break;
+    }
+}
+
+static gboolean process_model_iter_next(GtkTreeModel *tree_model, GtkTreeIter *iter) {
+    ProcessModel *model = PROCESS_MODEL(tree_model);
+    guint position;
+
+    if (!iter_position(model, iter, &position) || position + 1 >= model->rows->len) {
+        iter->stamp = 0;
+        return FALSE;
+    }
+    fill_iter(model, iter, position + 1);
+    return TRUE;
+}
+
+static gboolean process_model_iter_previous(GtkTreeModel *tree_model, GtkTreeIter *iter) {
+    ProcessModel *model = PROCESS_MODEL(tree_model);
+    guint position;
+
+    if (!iter_position(model, iter, &position) || position == 0) {
+        iter->stamp = 0;
+        return FALSE;
+    }
+    fill_iter(model, iter, position - 1);
+    return TRUE;
+}
+
+static gboolean process_model_iter_nth_child(GtkTreeModel *tree_model, GtkTreeIter *iter,
+                                             GtkTreeIter *parent, gint n) {
+    ProcessModel *model = PROCESS_MODEL(tree_model);
+    if (parent || n < 0 || (guint)n >= model->rows->len) return FALSE;
+
+    fill_iter(model, iter, (guint)n);
+    return TRUE;
+}
+
+static gboolean process_model_iter_children(GtkTreeModel *tree_model, GtkTreeIter *iter, GtkTreeIter *parent) {
+    return process_model_iter_nth_child(tree_model, iter, parent, 0);
+}
+
+static gboolean process_model_iter_has_child(GtkTreeModel *tree_model, GtkTreeIter *iter) {
+    (void)tree_model;
+    (void)iter;
+    return FALSE;
+}
+
+static gint process_model_iter_n_children(GtkTreeModel *tree_model, GtkTreeIter *iter) {
+    ProcessModel *model = PROCESS_MODEL(tree_model);
+    return iter ? 0 : (gint)model->rows->len;
+}
+
+static gboolean process_model_iter_parent(GtkTreeModel *tree_model, GtkTreeIter *iter, GtkTreeIter *child) {
+    (void)tree_model;
+    (void)iter;
+    (void)child;
+    return FALSE;
+}
+
+static void process_model_tree_model_init(GtkTreeModelIface *iface) {
+    iface->get_flags = process_model_get_flags;
+    iface->get_n_columns = process_model_get_n_columns;
+    iface->get_column_type = process_model_get_column_type;
+    iface->get_iter = process_model_get_iter;
+    iface->get_path = process_model_get_path;
+    iface->get_value = process_model_get_value;
+    iface->iter_next = process_model_iter_next;
+    iface->iter_previous = process_model_iter_previous;
+    iface->iter_children = process_model_iter_children;
+    iface->iter_has_child = process_model_iter_has_child;
+    iface->iter_n_children = process_model_iter_n_children;
+    iface->iter_nth_child = process_model_iter_nth_child;
+    iface->iter_parent = process_model_iter_parent;
+}
+
+// ============================================================================
+// GtkTreeSortable - sorting is built in, custom sort funcs are not used
+// ============================================================================
+
+static gboolean process_model_get_sort_column_id(GtkTreeSortable *sortable, gint *sort_column_id,
+                                                 GtkSortType *order) {
+    ProcessModel *model = PROCESS_MODEL(sortable);
+    if (sort_column_id) *sort_column_id = model->sort_column;
+    if (order) *order = model->sort_order;
+    return model_is_sorted(model);
+}
+
+static void process_model_set_sort_column_id(GtkTreeSortable *sortable, gint sort_column_id, GtkSortType order) {
+    ProcessModel *model = PROCESS_MODEL(sortable);
+    if (model->sort_column == sort_column_id && model->sort_order == order) return;
+
+    model->sort_column = sort_column_id;
+    model->sort_order = order;
+    gtk_tree_sortable_sort_column_changed(sortable);
+    update_sort_keys(model);
+    reorder_rows(model, NULL, 0);
+}
+
+static void process_model_set_sort_func(GtkTreeSortable *sortable, gint sort_column_id,
+                                        GtkTreeIterCompareFunc sort_func, gpointer user_data,
+                                        GDestroyNotify destroy) {
+    (void)sortable;
+    (void)sort_column_id;
+    (void)sort_func;
+    if (destroy) destroy(user_data);
+}
+
+static void process_model_set_default_sort_func(GtkTreeSortable *sortable, GtkTreeIterCompareFunc sort_func,
+                                                gpointer user_data, GDestroyNotify destroy) {
+    (void)sortable;
+    (void)sort_func;
+    if (destroy) destroy(user_data);
+}
+
+static gboolean process_model_has_default_sort_func(GtkTreeSortable *sortable) {
+    (void)sortable;
+    return FALSE;
+}
+
+static void process_model_sortable_init(GtkTreeSortableIface *iface) {
+    iface->get_sort_column_id = process_model_get_sort_column_id;
+    iface->set_sort_column_id = process_model_set_sort_column_id;
+    iface->set_sort_func = process_model_set_sort_func;
+    iface->set_default_sort_func = process_model_set_default_sort_func;
+    iface->has_default_sort_func = process_model_has_default_sort_func;
+}
+
+// ============================================================================
+// GObject
+// ============================================================================
+
+static void process_model_finalize(GObject *object) {
+    ProcessModel *model = PROCESS_MODEL(object);
+
+    snapshot_unref(model->snapshot);
+    g_array_free(model->rows, TRUE);
+    g_array_free(model->row_state, TRUE);
+    g_array_free(model->mapped, TRUE);
+    g_array_free(model->pending, TRUE);
+    g_array_free(model->selected, TRUE);
+    g_array_free(model->keys, TRUE);
+
+    G_OBJECT_CLASS(process_model_parent_class)->finalize(object);
+}
+
+static void process_model_class_init(ProcessModelClass *klass) {
+    G_OBJECT_CLASS(klass)->finalize = process_model_finalize;
+}
+
+static void process_model_init(ProcessModel *model) {
+    model->stamp = g_random_int();
+    model->rows = g_array_new(FALSE, FALSE, sizeof(guint32));
+    model->row_state = g_array_new(FALSE, FALSE, sizeof(guint8));
+    model->mapped = g_array_new(FALSE, FALSE, sizeof(guint32));
+    model->pending = g_array_new(FALSE, FALSE, sizeof(guint32));
+    model->selected = g_array_new(FALSE, FALSE, sizeof(guint8));
+    model->keys = g_array_new(FALSE, FALSE, sizeof(guint64));
+    model->sort_column = GTK_TREE_SORTABLE_UNSORTED_SORT_COLUMN_ID;
+    model->sort_order = GTK_SORT_ASCENDING;
+}
@@ -0,0 +1,53 @@
+#ifndef PROCESS_MODEL_H
+#define PROCESS_MODEL_H
+
+#include <gtk/gtk.h>
+#include "../common/types.h"
+#include "../system/snapshot.h"
+
+// Virtualized GtkTreeModel over a collector snapshot. Rows are not copied:
+// the model keeps a reference to the snapshot and a permutation of table
+// indices (filtered, in display order). Columns are the COL_* enum with
+// the same raw types the list store used (int PID, float CPU/GPU with -1
+// for no GPU data, guint64 bytes, gint64 start time, gboolean system).
+//
+// Also implements GtkTreeSortable; sorting compares samples directly.
+
+#define PROCESS_TYPE_MODEL (process_model_get_type())
+G_DECLARE_FINAL_TYPE(ProcessModel, process_model, PROCESS, MODEL, GObject)
+
+typedef gboolean (*ProcessModelFilterFunc)(const ProcessSample *proc, gpointer user_data);
+
+// Optional bulk form of the filter: set mask[i] for every row of table that
+// passes. Used when all rows are re-evaluated. Returns the number passing.
+typedef guint (*ProcessModelSelectFunc)(const ProcessTable *table, guint8 *mask, gpointer user_data);
+
+// Signals emitted by the model, per update and in total
+typedef struct {
+    guint64 updates;                // process_model_set_snapshot() calls
+    guint64 rows_inserted;
+    guint64 rows_deleted;
+    guint64 rows_changed;
+    guint64 reorders;               // rows-reordered emissions
+    guint rows_touched_last;        // Inserted + deleted + changed in the last update
+} ProcessModelStats;
+
+ProcessModel* process_model_new(void);
+
+// Show snapshot (takes its own reference). Only rows that were added,
+// removed, changed or moved produce signals. Uses snapshot->delta when it
+// follows the current snapshot, otherwise diffs the two tables.
+void process_model_set_snapshot(ProcessModel *model, Snapshot *snapshot);
+
+// Visible rows must pass filter (select, if given, must agree with it); call
+// process_model_refilter() when the criteria behind it change
+void process_model_set_filter(ProcessModel *model, ProcessModelFilterFunc filter,
+                              ProcessModelSelectFunc select, gpointer user_data);
+void process_model_refilter(ProcessModel *model);
+
+// Sample behind a valid iter (no GValue boxing), NULL if invalid
+const ProcessSample* process_model_get_sample(ProcessModel *model, GtkTreeIter *iter);
+
+void process_model_get_stats(ProcessModel *model, ProcessModelStats *stats);
+
+#endif // PROCESS_MODEL_H
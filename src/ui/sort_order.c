@@ -0,0 +1,197 @@
+#include "sort_order.h"
+#include "../system/process_delta.h"
+#include "../utils/process_table.h"
+#include <string.h>
+
+// Float bits mapped so unsigned integer order matches numeric order
+static guint64 float_key(float value) {
+    if (value == 0.0f) value = 0.0f;  // -0 and +0 compare equal
+    guint32 bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return (bits & 0x80000000u) ? (guint64)~bits : (guint64)(bits | 0x80000000u);
+}
+
+// First 8 bytes of the name, big-endian: same order as strcmp on the prefix
+static guint64 name_key(const char *name) {
+    guint64 key = 0;
+    gsize i = 0;
+    for (; i < 8 && name[i]; i++) {
+        key = (key << 8) | (unsigned char)name[i];
+    }
+    return i < 8 ? key << (8 * (8 - i)) : key;  // "" is key 0; a shift by 64 is undefined
+}
+
+guint64 sort_order_key(const ProcessSample *proc, gint column) {
+    switch (column) {
+        case COL_PID:
+            return (guint64)(gint64)proc->pid ^ ((guint64)1 << 63);
+        case COL_NAME:
+            return name_key(process_name(proc));
+        case COL_CPU:
+            return float_key(proc->cpu);
+        case COL_GPU:
+            return float_key((proc->flags & PROCESS_FLAG_HAS_GPU) ? proc->gpu : -1.0f);
+        case COL_MEM:
+            return proc->rss_bytes;
+        case COL_NET:
+            return proc->net_bps;
+        case COL_RUNTIME:
+            // Later start = shorter runtime; unknown start sorts as zero runtime
+            if (!(proc->flags & PROCESS_FLAG_HAS_START) || proc->start_time <= 0) return 0;
+            return (guint64)(G_MAXINT64 - proc->start_time) + 1;
+        case COL_TYPE:
+            return (proc->flags & PROCESS_FLAG_SYSTEM) ? 1 : 0;
+        default:
+            return 0;
+    }
+}
+
+guint32 sort_order_column_field(gint column) {
+    switch (column) {
+        case COL_NAME:    return PROCESS_FIELD_NAME;
+        case COL_CPU:     return PROCESS_FIELD_CPU;
+        case COL_GPU:     return PROCESS_FIELD_GPU;
+        case COL_MEM:     return PROCESS_FIELD_MEM;
+        case COL_NET:     return PROCESS_FIELD_NET;
+        case COL_RUNTIME: return PROCESS_FIELD_START;
+        case COL_TYPE:    return PROCESS_FIELD_TYPE;
+        default:          return 0;  // PIDs never change
+    }
+}
+
+void sort_order_compute_keys(const ProcessSample *items, guint count, gint column, guint64 *keys) {
+    for (guint i = 0; i < count; i++) {
+        keys[i] = sort_order_key(&items[i], column);
+    }
+}
+
+static gint compare_keyed(const SortOrder *order, guint64 key_a, guint32 a, guint64 key_b, guint32 b) {
+    gint ret = (key_a > key_b) - (key_a < key_b);
+    if (ret == 0 && order->column == COL_NAME) {
+        const ProcessSample *pa = &order->items[a], *pb = &order->items[b];
+        if (pa->name_id != pb->name_id) ret = strcmp(process_name(pa), process_name(pb));
+    }
+    if (order->descending) ret = -ret;
+    if (ret == 0) {
+        pid_t pa = order->items[a].pid, pb = order->items[b].pid;
+        ret = (pa > pb) - (pa < pb);
+    }
+    return ret;
+}
+
+gint sort_order_compare(const SortOrder *order, guint32 a, guint32 b) {
+    return compare_keyed(order, order->keys[a], a, order->keys[b], b);
+}
+
+guint sort_order_position(const SortOrder *order, const guint32 *rows, guint count, guint32 index) {
+    guint64 key = order->keys[index];
+    guint low = 0, high = count;
+
+    while (low < high) {
+        guint mid = low + (high - low) / 2;
+        guint32 row = rows[mid];
+        if (compare_keyed(order, order->keys[row], row, key, index) < 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+// Key copied next to the row so sorting does not chase the keys array
+typedef struct {
+    guint64 key;
+    guint32 index;
+    guint32 position;               // Position before sorting
+} SortEntry;
+
+static gint compare_entries(gconstpointer a, gconstpointer b, gpointer user_data) {
+    const SortEntry *ea = a, *eb = b;
+    if (ea->key != eb->key) {
+        gint ret = ea->key > eb->key ? 1 : -1;
+        return ((const SortOrder*)user_data)->descending ? -ret : ret;
+    }
+    return compare_keyed(user_data, ea->key, ea->index, eb->key, eb->index);
+}
+
+// Apply old-position permutation order to rows; TRUE if it is not the identity
+static gboolean apply_order(guint32 *rows, guint count, const gint *order, gint *new_order) {
+    gboolean moved = FALSE;
+    for (guint i = 0; i < count && !moved; i++) {
+        moved = order[i] != (gint)i;
+    }
+    if (!moved) return FALSE;
+
+    guint32 *previous = g_new(guint32, count);
+    memcpy(previous, rows, count * sizeof(guint32));
+    for (guint i = 0; i < count; i++) {
+        rows[i] = previous[order[i]];
+    }
+    g_free(previous);
+
+    if (new_order) memcpy(new_order, order, count * sizeof(gint));
+    return TRUE;
+}
+
+gboolean sort_order_sort(const SortOrder *order, guint32 *rows, guint count, gint *new_order) {
+    if (count < 2) return FALSE;
+
+    SortEntry *entries = g_new(SortEntry, count);
+    for (guint i = 0; i < count; i++) {
+        entries[i].key = order->keys[rows[i]];
+        entries[i].index = rows[i];
+        entries[i].position = i;
+    }
+    g_qsort_with_data(entries, (gint)count, sizeof(SortEntry), compare_entries, (gpointer)order);
+
+    gint *positions = g_new(gint, count);
+    for (guint i = 0; i < count; i++) {
+        positions[i] = (gint)entries[i].position;
+    }
+    gboolean moved = apply_order(rows, count, positions, new_order);
+
+    g_free(positions);
+    g_free(entries);
+    return moved;
+}
+
+gboolean sort_order_repair(const SortOrder *order, guint32 *rows, guint count,
+                           const guint8 *flags, guint8 moved_flag, gint *new_order) {
+    // Split into rows that kept their key (still sorted) and rows that may move
+    SortEntry *moving = NULL;
+    guint32 *staying = NULL;
+    guint n_moving = 0, n_staying = 0;
+
+    for (guint i = 0; i < count; i++) {
+        if (!(flags[rows[i]] & moved_flag)) continue;
+        if (!moving) moving = g_new(SortEntry, count);
+        moving[n_moving].key = order->keys[rows[i]];
+        moving[n_moving].index = rows[i];
+        moving[n_moving].position = i;
+        n_moving++;
+    }
+    if (n_moving == 0) return FALSE;
+
+    staying = g_new(guint32, count - n_moving + 1);
+    for (guint i = 0; i < count; i++) {
+        if (!(flags[rows[i]] & moved_flag)) staying[n_staying++] = i;
+    }
+
+    // OPTIMIZATION: Sort only the k changed rows, then merge them back
+    g_qsort_with_data(moving, (gint)n_moving, sizeof(SortEntry), compare_entries, (gpointer)order);
+
+    gint *positions = g_new(gint, count);
+    guint s = 0, m = 0;
+    for (guint out = 0; out < count; out++) {
+        gboolean take_staying = m == n_moving ||
+            (s < n_staying && sort_order_compare(order, rows[staying[s]], moving[m].index) < 0);
+        positions[out] = take_staying ? (gint)staying[s++] : (gint)moving[m++].position;
+    }
+    gboolean moved = apply_order(rows, count, positions, new_order);
+
+    g_free(positions);
+    g_free(staying);
+    g_free(moving);
+    return moved;
+}
@@ -0,0 +1,49 @@
+#ifndef SORT_ORDER_H
+#define SORT_ORDER_H
+
+#include <glib.h>
+#include "../common/types.h"
+
+// Display order of process rows, kept as a permutation of table indices
+// (guint32) and repaired between refreshes instead of re-sorted.
+//
+// Each row gets a precomputed 64-bit key for the sort column; comparing two
+// rows is one integer compare, falling back to the full name for COL_NAME
+// prefixes that tie and to the PID for equal keys. The order matches
+// process_sample_compare().
+
+// Key of proc for column: ascending keys give ascending column order
+guint64 sort_order_key(const ProcessSample *proc, gint column);
+
+// PROCESS_FIELD_* bit whose change can move a row in column, 0 for none
+guint32 sort_order_column_field(gint column);
+
+typedef struct {
+    const ProcessSample *items;     // Table rows
+    const guint64 *keys;            // sort_order_key() of each table row
+    gint column;                    // COL_*
+    gboolean descending;
+} SortOrder;
+
+// Fill keys[i] for the count rows of items
+void sort_order_compute_keys(const ProcessSample *items, guint count, gint column, guint64 *keys);
+
+// <0, 0 or >0 as table row a sorts before, with or after table row b
+gint sort_order_compare(const SortOrder *order, guint32 a, guint32 b);
+
+// Position at which table row index belongs in the sorted rows
+guint sort_order_position(const SortOrder *order, const guint32 *rows, guint count, guint32 index);
+
+// Sort rows from scratch. new_order (may be NULL) receives the old position
+// of each row's new position. Returns TRUE if any row moved.
+gboolean sort_order_sort(const SortOrder *order, guint32 *rows, guint count, gint *new_order);
+
+// Repair rows after the keys of some rows changed. Table rows with
+// moved_flag set in flags[index] may have a new key; the other rows must
+// still be in order relative to each other. Costs O(n + k log k) for k
+// moved rows. new_order is as for sort_order_sort(). Returns TRUE if any
+// row moved.
+gboolean sort_order_repair(const SortOrder *order, guint32 *rows, guint count,
+                           const guint8 *flags, guint8 moved_flag, gint *new_order);
+
+#endif // SORT_ORDER_H
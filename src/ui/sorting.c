@@ -1,62 +1,38 @@
 #include "../ui/ui.h"
 #include "../utils/utils.h"
-#include <math.h>
+#include <string.h>
 
-// Custom compare function for sorting columns. Handles different types: int for PID, 
-// string for Name, float for CPU/Net/GPU, bytes for Mem, seconds for Runtime.
-gint process_compare_func(GtkTreeModel *model, GtkTreeIter *a, GtkTreeIter *b, gpointer user_data) {
-    int col = GPOINTER_TO_INT(user_data);
-    gchar *va = NULL, *vb = NULL;
-    gtk_tree_model_get(model, a, col, &va, -1);
-    gtk_tree_model_get(model, b, col, &vb, -1);
+#define COMPARE_VALUES(a, b) (((a) > (b)) ? 1 : ((a) < (b)) ? -1 : 0)
 
-    if (va == NULL || vb == NULL) {
-        gint ret = (va == NULL) - (vb == NULL);
-        g_free(va);
-        g_free(vb);
-        return ret;
-    }
-
-    gint ret = 0;
-    switch (col) {
-        case COL_PID: {
-            int ia = atoi(va), ib = atoi(vb);
-            ret = ia - ib;
-            break;
-        }
-        case COL_NAME: {
-            ret = g_strcmp0(va, vb);
-            break;
-        }
+// Column ordering for the process model, read straight from the samples.
+// Floats compare exactly so the order stays transitive for the model sort.
+gint process_sample_compare(const ProcessSample *a, const ProcessSample *b, gint column) {
+    switch (column) {
+        case COL_PID:
+            return COMPARE_VALUES(a->pid, b->pid);
+        case COL_NAME:
+            // Same ID, same text
+            return a->name_id == b->name_id ? 0 : strcmp(process_name(a), process_name(b));
         case COL_CPU:
-        case COL_GPU:
-        case COL_NET: {  // Treat N/A or KB/s as float (strip non-numeric if needed, but simple atof works)
-            float fa = atof(va), fb = atof(vb);
-            
-            // More robust float comparison to avoid precision issues
-            if (fabs(fa - fb) < 0.001) {
-                ret = 0;
-            } else {
-                ret = (fa > fb) ? 1 : (fa < fb) ? -1 : 0;
-            }
-            break;
-        }
-        case COL_MEM: {
-            long long la = parse_bytes(va), lb = parse_bytes(vb);
-            ret = (la > lb) ? 1 : (la < lb) ? -1 : 0;
-            break;
+            return COMPARE_VALUES(a->cpu, b->cpu);
+        case COL_GPU: {
+            float ga = (a->flags & PROCESS_FLAG_HAS_GPU) ? a->gpu : -1.0f;
+            float gb = (b->flags & PROCESS_FLAG_HAS_GPU) ? b->gpu : -1.0f;
+            return COMPARE_VALUES(ga, gb);
         }
+        case COL_MEM:
+            return COMPARE_VALUES(a->rss_bytes, b->rss_bytes);
+        case COL_NET:
+            return COMPARE_VALUES(a->net_bps, b->net_bps);
         case COL_RUNTIME: {
-            long long la = parse_runtime_to_seconds(va), lb = parse_runtime_to_seconds(vb);
-            ret = (la > lb) ? 1 : (la < lb) ? -1 : 0;
-            break;
-        }
-        case COL_TYPE: {
-            ret = g_strcmp0(va, vb);
-            break;
+            gboolean ka = (a->flags & PROCESS_FLAG_HAS_START) && a->start_time > 0;
+            gboolean kb = (b->flags & PROCESS_FLAG_HAS_START) && b->start_time > 0;
+            if (!ka || !kb) return ka - kb;
+            return COMPARE_VALUES(b->start_time, a->start_time);
         }
+        case COL_TYPE:
+            return ((a->flags & PROCESS_FLAG_SYSTEM) != 0) - ((b->flags & PROCESS_FLAG_SYSTEM) != 0);
+        default:
+            return 0;
     }
-    g_free(va);
-    g_free(vb);
-    return ret;
 }
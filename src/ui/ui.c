@@ -2,6 +2,7 @@
 #include "../system/system.h"
 #include "../utils/utils.h"
 #include "../common/config.h"
+#include "filter.h"
 #include <time.h>
 #include <ctype.h>
 #include <math.h>
@@ -9,30 +10,32 @@
 
 // Global UI variables
 GtkApplication *app = NULL;
-GtkListStore *liststore = NULL;
+ProcessModel *process_model = NULL;
 GtkLabel *specs_label = NULL;
 GtkLabel *summary_label = NULL;
 char *static_specs = NULL;
 gboolean updating = FALSE;
 GMutex hash_mutex;
 
-// Threaded data collection
+// Threaded data collection: a local collector, or a client of a headless one
 ThreadedCollector *g_collector = NULL;
+CollectorClient *g_collector_client = NULL;
+static gboolean attach_requested = FALSE;
+static gchar *attach_socket_path = NULL;      // NULL for the default socket
 
 // Global widgets
 GtkTreeView *global_treeview = NULL;
 GtkScrolledWindow *global_scrolled_window = NULL;
 
-// Hash tables for network tracking
-GHashTable *prev_net_bytes = NULL;
-GHashTable *prev_times = NULL;
+// Previous network bytes per (PID, start time), under hash_mutex
+RateStore *net_counters = NULL;
 
-// Process cache for incremental updates (key: PID, value: ProcessCacheEntry*)
-GHashTable *process_cache = NULL;
-GMutex cache_mutex;
-
-// Filter system
+// Filter system: current_filter is compiled into current_program on every change
 FilterCriteria current_filter = {0};
+static FilterProgram current_program = {0};
+static FilterColumns filter_columns = {0};
+static const ProcessTable *filter_columns_table = NULL;  // Table the columns hold, NULL if stale
+static guint32 filter_columns_checks = 0;               // Columns loaded (FILTER_CHECK_* bits)
 GtkWidget *filter_entries[7] = {0}; // PID, Name, CPU, GPU, Memory, Network, Type
 
 // Dynamic column headers
@@ -47,178 +50,130 @@ float current_memory_usage = 0.0;
 time_t last_update_time = 0;
 int consecutive_failures = 0;
 
-// Helper function to compare two processes for changes
-gboolean process_data_changed(Process *old_proc, Process *new_proc) {
-    if (!old_proc || !new_proc) return TRUE;
-    
-    return strcmp(old_proc->name, new_proc->name) != 0 ||
-           strcmp(old_proc->cpu, new_proc->cpu) != 0 ||
-           strcmp(old_proc->mem, new_proc->mem) != 0 ||
-           strcmp(old_proc->gpu, new_proc->gpu) != 0 ||
-           strcmp(old_proc->net, new_proc->net) != 0 ||
-           strcmp(old_proc->runtime, new_proc->runtime) != 0 ||
-           strcmp(old_proc->type, new_proc->type) != 0;
-}
-
-// Helper function to update a single row in the TreeView using row reference
-void update_tree_row_by_ref(GtkTreeRowReference *row_ref, Process *proc) {
-    if (!row_ref || !gtk_tree_row_reference_valid(row_ref)) return;
-    
-    GtkTreePath *path = gtk_tree_row_reference_get_path(row_ref);
-    if (!path) return;
-    
-    GtkTreeIter iter;
-    if (gtk_tree_model_get_iter(GTK_TREE_MODEL(liststore), &iter, path)) {
-        gtk_list_store_set(liststore, &iter,
-                           COL_PID, proc->pid,
-                           COL_NAME, proc->name,
-                           COL_CPU, proc->cpu,
-                           COL_GPU, proc->gpu,
-                           COL_MEM, proc->mem,
-                           COL_NET, proc->net,
-                           COL_RUNTIME, proc->runtime,
-                           COL_TYPE, proc->type,
-                           -1);
+// Format one model column as text - called by GTK for visible cells only.
+// OPTIMIZATION: Reads the snapshot sample behind the row, no GValue round trip
+static void render_process_cell(GtkTreeViewColumn *column, GtkCellRenderer *renderer,
+                                GtkTreeModel *model, GtkTreeIter *iter, gpointer user_data) {
+    (void)column;
+    int col = GPOINTER_TO_INT(user_data);
+    const ProcessSample *proc = process_model_get_sample(PROCESS_MODEL(model), iter);
+    char text[32];
+    
+    if (!proc) {
+        g_object_set(renderer, "text", "", NULL);
+        return;
+    }
+    
+    switch (col) {
+        case COL_PID:
+            snprintf(text, sizeof(text), "%d", (int)proc->pid);
+            break;
+        case COL_CPU:
+            snprintf(text, sizeof(text), "%.1f", proc->cpu);
+            break;
+        case COL_GPU:
+            if (proc->flags & PROCESS_FLAG_HAS_GPU) {
+                snprintf(text, sizeof(text), "%.1f%%", proc->gpu);
+            } else {
+                snprintf(text, sizeof(text), "N/A");
+            }
+            break;
+        case COL_MEM:
+            format_memory_bytes_buf((long long)proc->rss_bytes, text, sizeof(text));
+            break;
+        case COL_NET:
+            format_network_rate(proc->net_bps, text, sizeof(text));
+            break;
+        case COL_RUNTIME:
+            format_process_runtime((proc->flags & PROCESS_FLAG_HAS_START) ? proc->start_time : 0,
+                                   text, sizeof(text));
+            break;
+        case COL_TYPE:
+            snprintf(text, sizeof(text), "%s", process_type_label((proc->flags & PROCESS_FLAG_SYSTEM) != 0));
+            break;
+        default:
+            text[0] = '\0';
+            break;
     }
     
-    gtk_tree_path_free(path);
-}
-
-// Helper function to free ProcessCacheEntry
-void free_cache_entry(ProcessCacheEntry *entry) {
-    if (entry) {
-        if (entry->process) {
-            free_process(entry->process);
-        }
-        if (entry->row_ref) {
-            gtk_tree_row_reference_free(entry->row_ref);
-        }
-        g_free(entry);
-    }
+    g_object_set(renderer, "text", text, NULL);
 }
 
 // Forward declarations
-void cleanup_stale_cache_entries(void);
-gboolean process_matches_filter(Process *proc);
+gboolean process_matches_filter(const ProcessSample *proc);
 void on_filter_changed(GtkWidget *widget, gpointer user_data);
-gboolean parse_memory_filter(const char *filter, long long *bytes, char *op);
-gboolean parse_network_filter(const char *filter, long long *bps, char *op);
-long long network_to_bps(const char *net_str);
 gboolean validate_filter_input(const char *text, int filter_type);
 void apply_filters_to_display(void);
 void update_column_headers_old(float cpu_percent, float gpu_percent, float memory_percent);
 
-// Incremental UI update function that preserves scroll position naturally
-gboolean update_ui_func(gpointer user_data) {
-    UpdateData *data = (UpdateData *)user_data;
-    
-    if (!liststore) {
-        return G_SOURCE_REMOVE;
-    }
-    
-    // Use incremental updates instead of clearing the entire model
-    // This naturally preserves scroll position without any restoration needed
-    
-    GtkTreeSortable *sortable = GTK_TREE_SORTABLE(liststore);
-    gint sort_column_id;
-    GtkSortType sort_order;
-    gboolean was_sorted = gtk_tree_sortable_get_sort_column_id(sortable, &sort_column_id, &sort_order);
-    
-    // Temporarily disable sorting during updates to prevent flickering
-    gtk_tree_sortable_set_sort_column_id(sortable, GTK_TREE_SORTABLE_UNSORTED_SORT_COLUMN_ID, GTK_SORT_ASCENDING);
-    
-    // Build a hash table of current processes for quick lookup
-    GHashTable *new_processes = g_hash_table_new_full(g_str_hash, g_str_equal, NULL, NULL);
-    GList *l;
-    for (l = data->processes; l != NULL; l = l->next) {
-        Process *new_proc = (Process *)l->data;
-        if (process_matches_filter(new_proc)) {
-            g_hash_table_insert(new_processes, new_proc->pid, new_proc);
-        }
-    }
-    
-    // Update existing rows and mark rows to remove
-    GtkTreeIter iter;
-    gboolean valid = gtk_tree_model_get_iter_first(GTK_TREE_MODEL(liststore), &iter);
-    GList *rows_to_remove = NULL;
-    
-    while (valid) {
-        gchar *pid_str;
-        gtk_tree_model_get(GTK_TREE_MODEL(liststore), &iter, COL_PID, &pid_str, -1);
-        
-        Process *new_proc = g_hash_table_lookup(new_processes, pid_str);
-        if (new_proc) {
-            // Update existing row with new data
-            gtk_list_store_set(liststore, &iter,
-                               COL_PID, new_proc->pid,
-                               COL_NAME, new_proc->name,
-                               COL_CPU, new_proc->cpu,
-                               COL_GPU, new_proc->gpu,
-                               COL_MEM, new_proc->mem,
-                               COL_NET, new_proc->net,
-                               COL_RUNTIME, new_proc->runtime,
-                               COL_TYPE, new_proc->type,
-                               -1);
-            // Remove from new_processes so we don't add it again
-            g_hash_table_remove(new_processes, pid_str);
-        } else {
-            // Mark this row for removal (process no longer exists or filtered out)
-            GtkTreePath *path = gtk_tree_model_get_path(GTK_TREE_MODEL(liststore), &iter);
-            GtkTreeRowReference *row_ref = gtk_tree_row_reference_new(GTK_TREE_MODEL(liststore), path);
-            rows_to_remove = g_list_prepend(rows_to_remove, row_ref);
-            gtk_tree_path_free(path);
-        }
-        
-        g_free(pid_str);
-        valid = gtk_tree_model_iter_next(GTK_TREE_MODEL(liststore), &iter);
-    }
+// Model filter: the visible rows are the ones matching current_filter
+static gboolean filter_process_sample(const ProcessSample *proc, gpointer user_data) {
+    (void)user_data;
+    return process_matches_filter(proc);
+}
+
+// Bulk form of the model filter for full re-evaluations (new filters or
+// first fill): runs the compiled program over a column copy of the table.
+// OPTIMIZATION: The copy is kept until the next snapshot, so refiltering
+// while the user types only pays for the column passes
+static guint select_process_rows(const ProcessTable *table, guint8 *mask, gpointer user_data) {
+    (void)user_data;
+    guint32 checks = current_program.checks;
+    
+    if (table != filter_columns_table || (checks & ~filter_columns_checks) != 0) {
+        if (table != filter_columns_table) filter_columns_checks = 0;
+        filter_columns_checks |= checks;
+        filter_columns_load(&filter_columns, table, filter_columns_checks);
+        filter_columns_table = table;
+    }
+    return filter_program_select(&current_program, &filter_columns, mask);
+}
+
+// Main loop side of fetch_static_specs_thread()
+static gboolean store_static_specs(gpointer data) {
+    char *specs = data;
+    if (!static_specs) static_specs = g_strdup(specs);
+    free(specs);
+    return G_SOURCE_REMOVE;
+}
+
+// system_profiler takes seconds; never on the UI thread
+static gpointer fetch_static_specs_thread(gpointer data) {
+    (void)data;
+    char *specs = get_static_specs();
+    if (specs) g_main_context_invoke(NULL, store_static_specs, specs);
+    return NULL;
+}
+
+// Hardware description: sampled once by the collector's specs source off the
+// UI thread; a viewer attached to a headless collector gathers it once on a
+// thread of its own
+static const char* current_static_specs(void) {
+    static gboolean specs_fetch_started = FALSE;
     
-    // Remove rows that no longer exist
-    for (GList *rem = rows_to_remove; rem != NULL; rem = rem->next) {
-        GtkTreeRowReference *row_ref = (GtkTreeRowReference *)rem->data;
-        if (gtk_tree_row_reference_valid(row_ref)) {
-            GtkTreePath *path = gtk_tree_row_reference_get_path(row_ref);
-            if (gtk_tree_model_get_iter(GTK_TREE_MODEL(liststore), &iter, path)) {
-                gtk_list_store_remove(liststore, &iter);
-            }
-            gtk_tree_path_free(path);
+    if (!static_specs) {
+        if (g_collector) {
+            static_specs = threaded_collector_dup_static_specs(g_collector);
+        } else if (g_collector_client && !specs_fetch_started) {
+            specs_fetch_started = TRUE;
+            g_thread_unref(g_thread_new("static_specs", fetch_static_specs_thread, NULL));
         }
-        gtk_tree_row_reference_free(row_ref);
     }
-    g_list_free(rows_to_remove);
-    
-    // Add new processes that weren't in the existing model
-    GHashTableIter hash_iter;
-    gpointer key, value;
-    g_hash_table_iter_init(&hash_iter, new_processes);
-    while (g_hash_table_iter_next(&hash_iter, &key, &value)) {
-        Process *new_proc = (Process *)value;
-        gtk_list_store_append(liststore, &iter);
-        gtk_list_store_set(liststore, &iter,
-                           COL_PID, new_proc->pid,
-                           COL_NAME, new_proc->name,
-                           COL_CPU, new_proc->cpu,
-                           COL_GPU, new_proc->gpu,
-                           COL_MEM, new_proc->mem,
-                           COL_NET, new_proc->net,
-                           COL_RUNTIME, new_proc->runtime,
-                           COL_TYPE, new_proc->type,
-                           -1);
-    }
-    
-    // Restore sort state
-    if (was_sorted) {
-        gtk_tree_sortable_set_sort_column_id(sortable, sort_column_id, sort_order);
+    return static_specs ? static_specs : "Loading system specs...";
+}
+
+// Incremental UI update that preserves scroll position naturally.
+// The model references the snapshot and only signals rows that were added,
+// removed, changed or moved; it sorts and filters the rows itself.
+void render_snapshot(Snapshot *snapshot) {
+    if (!process_model || !snapshot || !snapshot->data) {
+        return;
     }
+    const UpdateData *data = snapshot->data;
     
-    // Clean up
-    g_hash_table_destroy(new_processes);
-    
-    // Free process data
-    for (l = data->processes; l != NULL; l = l->next) {
-        free_process((Process *)l->data);
-    }
-    g_list_free(data->processes);
+    // Tables are recycled, so cached filter columns never outlive a snapshot
+    filter_columns_table = NULL;
+    process_model_set_snapshot(process_model, snapshot);
     
     // No scroll restoration needed - incremental updates preserve position naturally!
     
@@ -251,62 +206,152 @@ gboolean update_ui_func(gpointer user_data) {
         strcpy(gpu_status, "Graphics: Maximum use");
     }
     
-    sprintf(full_specs, "%s\n%s (%.0f%%)", static_specs, gpu_status, gpu_percent);
+    snprintf(full_specs, sizeof(full_specs), "%s\n%s (%.0f%%)", current_static_specs(), gpu_status, gpu_percent);
     gtk_label_set_text(specs_label, full_specs);
     
     // Update system summary label
     if (data->system_summary) {
         gtk_label_set_text(summary_label, data->system_summary);
-        free(data->system_summary);
     }
+}
+
+void ui_get_update_stats(ProcessModelStats *stats) {
+    process_model_get_stats(process_model, stats);
+}
+
+// Idle callback for owned UpdateData (legacy update thread path)
+gboolean update_ui_func(gpointer user_data) {
+    UpdateData *data = (UpdateData *)user_data;
     
-    if (data->gpu_usage) free(data->gpu_usage);
-    free(data);
+    // Unpublished data (sequence 0): the model diffs it against the rows shown
+    Snapshot *snapshot = snapshot_new(data);
+    render_snapshot(snapshot);
+    snapshot_unref(snapshot);
+    updating = FALSE;
+
+    return G_SOURCE_REMOVE;
+}
 
+// OPTIMIZATION: Event-driven refresh - the collector wakes the main loop
+// when it publishes instead of the UI polling on a timer. Wakeups coalesce:
+// however many snapshots arrive before the main loop runs, one render of
+// the latest is queued, and nothing runs while no new data is published.
+static gint render_pending = 0;
+static guint64 rendered_sequence = 0;
+static gboolean window_mapped = FALSE;
+static gboolean window_iconified = FALSE;
+
+// Render the latest published snapshot; FALSE if there is nothing new
+static gboolean render_latest_snapshot(void) {
+    if ((!g_collector && !g_collector_client) || updating) return FALSE;
+    
+    // OPTIMIZATION: No lock and no copy of the process list
+    Snapshot *snapshot = g_collector_client
+        ? collector_client_acquire_snapshot(g_collector_client)
+        : threaded_collector_acquire_snapshot(g_collector);
+    if (!snapshot) return FALSE;
+    if (snapshot->sequence == rendered_sequence) {
+        snapshot_unref(snapshot);
+        return FALSE;
+    }
+    
+    updating = TRUE;
+    render_snapshot(snapshot);
+    rendered_sequence = snapshot->sequence;
+    snapshot_unref(snapshot);
     updating = FALSE;
+    return TRUE;
+}
 
+static gboolean snapshot_ready_callback(gpointer data) {
+    (void)data;
+    
+    // Cleared before reading the slot: a publish from here on queues again
+    g_atomic_int_set(&render_pending, 0);
+    // A hidden window catches up when it is shown
+    if (window_mapped && !window_iconified) render_latest_snapshot();
     return G_SOURCE_REMOVE;
 }
 
-// Collector/Bin architecture: fast UI updates from pre-collected data
-gboolean timeout_callback(gpointer data) {
-    (void)data; // Suppress unused parameter warning
+// Runs on the collector (or client) thread after every publish
+static void on_snapshot_published(guint64 sequence, gpointer user_data) {
+    (void)sequence;
+    (void)user_data;
     
+    if (g_atomic_int_compare_and_exchange(&render_pending, 0, 1)) {
+        g_main_context_invoke(NULL, snapshot_ready_callback, NULL);
+    }
+}
+
+// Start the collector (or attach to a headless one) on first use
+static gboolean ensure_collector_started(void) {
     static gboolean collector_initialized = FALSE;
-    
-    // Initialize collector on first run
-    if (!collector_initialized) {
-        if (!g_collector) {
-            g_collector = threaded_collector_create();
-        }
-        
-        if (g_collector) {
-            // Start continuous background data collection
-            threaded_collector_start_continuous_collection(g_collector);
+    if (collector_initialized) return TRUE;
+    
+    // OPTIMIZATION: Attach to the host's headless collector when asked to,
+    // so this viewer adds no collection work of its own
+    if (attach_requested && !g_collector_client) {
+        g_collector_client = collector_client_connect(attach_socket_path);
+        if (g_collector_client) {
+            collector_client_set_publish_notify(g_collector_client, on_snapshot_published, NULL);
             collector_initialized = TRUE;
+            return TRUE;
         }
-        return TRUE; // Skip first update, let collector run
+        g_warning("No headless collector to attach to, collecting locally");
+        attach_requested = FALSE;
     }
     
-    // Fast UI update: just read from the pre-collected data bin
-    if (g_collector && !updating) {
-        UpdateData *latest_data = threaded_collector_get_latest_complete_data(g_collector);
-        if (latest_data) {
-            // Only update if we actually got new data
-            updating = TRUE;
-            update_ui_func(latest_data);
-            // Note: update_ui_func will free the data and set updating = FALSE
-        }
+    if (!g_collector) {
+        g_collector = threaded_collector_create();
     }
     
-    return TRUE;
+    if (g_collector) {
+        // Start continuous background data collection
+        threaded_collector_set_publish_notify(g_collector, on_snapshot_published, NULL);
+        threaded_collector_start_continuous_collection(g_collector);
+        collector_initialized = TRUE;
+    }
+    return collector_initialized;
+}
+
+// OPTIMIZATION: Collect at the background period while the window is
+// unmapped or minimized; showing it takes a fresh sample immediately.
+// Losing focus alone keeps the full rate - the window is still watched.
+static void update_window_visibility(void) {
+    gboolean hidden = !window_mapped || window_iconified;
+    if (g_collector) threaded_collector_set_background(g_collector, hidden);
+    if (!hidden) render_latest_snapshot();
+}
+
+static gboolean on_window_map_event(GtkWidget *widget, GdkEvent *event, gpointer user_data) {
+    (void)widget;
+    (void)user_data;
+    window_mapped = event->type == GDK_MAP;
+    update_window_visibility();
+    return FALSE;
+}
+
+static gboolean on_window_state_event(GtkWidget *widget, GdkEventWindowState *event, gpointer user_data) {
+    (void)widget;
+    (void)user_data;
+    if (event->changed_mask & GDK_WINDOW_STATE_ICONIFIED) {
+        window_iconified = (event->new_window_state & GDK_WINDOW_STATE_ICONIFIED) != 0;
+        update_window_visibility();
+    }
+    return FALSE;
+}
+
+void ui_attach_collector(const char *socket_path) {
+    attach_requested = TRUE;
+    g_free(attach_socket_path);
+    attach_socket_path = g_strdup(socket_path);
 }
 
 // Using model detachment technique for perfect scroll preservation
 
 // Activate callback: Set up vertical box for specs label + scrolled window. 
-// Init hashes and static specs. Added sorting setup: cast liststore to sortable, 
-// set custom sort func for each column, set sort column id on each tree view column 
+// Init hashes and static specs. Sorting setup: the process model implements
+// GtkTreeSortable, set sort column id on each tree view column 
 // to make them clickable for asc/desc sorting. Initial sort on CPU descending. 
 // Added g_mutex_init for hash_mutex. Initial update now launches thread instead of direct call.
 void activate(GtkApplication *app, gpointer user_data) {
@@ -388,20 +433,18 @@ void activate(GtkApplication *app, gpointer user_data) {
     
     gtk_box_pack_start(GTK_BOX(content_box), scrolled_window, TRUE, TRUE, 0);
 
-    // List store - added G_TYPE_STRING for the new TYPE column
-    liststore = gtk_list_store_new(NUM_COLS, G_TYPE_STRING, G_TYPE_STRING, G_TYPE_STRING, G_TYPE_STRING, G_TYPE_STRING, G_TYPE_STRING, G_TYPE_STRING, G_TYPE_STRING);
+    // Virtualized model over collector snapshots: raw values (PID, name,
+    // CPU %, GPU % or -1, RSS bytes, network bytes/s, start time, is-system),
+    // cells are formatted on draw
+    process_model = process_model_new();
+    process_model_set_filter(process_model, filter_process_sample, select_process_rows, NULL);
 
-    // Make sortable and set sort functions
-    GtkTreeSortable *sortable = GTK_TREE_SORTABLE(liststore);
-    for (int col = 0; col < NUM_COLS; col++) {
-        gtk_tree_sortable_set_sort_func(sortable, col, process_compare_func, GINT_TO_POINTER(col), NULL);
-    }
-
-    // Set initial sort: CPU descending (will be applied after data is loaded)
-    gtk_tree_sortable_set_sort_column_id(sortable, COL_CPU, GTK_SORT_DESCENDING);
+    // Initial sort: CPU descending. The model sorts samples itself, so no
+    // per-column sort functions are registered.
+    gtk_tree_sortable_set_sort_column_id(GTK_TREE_SORTABLE(process_model), COL_CPU, GTK_SORT_DESCENDING);
 
     // Tree view
-    GtkWidget *treeview = gtk_tree_view_new_with_model(GTK_TREE_MODEL(liststore));
+    GtkWidget *treeview = gtk_tree_view_new_with_model(GTK_TREE_MODEL(process_model));
     global_treeview = GTK_TREE_VIEW(treeview); // Set global reference for scroll preservation
     gtk_container_add(GTK_CONTAINER(scrolled_window), treeview);
     
@@ -412,7 +455,8 @@ void activate(GtkApplication *app, gpointer user_data) {
     GtkCellRenderer *renderer = gtk_cell_renderer_text_new();
     GtkTreeViewColumn *column;
 
-    column = gtk_tree_view_column_new_with_attributes("PID", renderer, "text", COL_PID, NULL);
+    column = gtk_tree_view_column_new_with_attributes("PID", renderer, NULL);
+    gtk_tree_view_column_set_cell_data_func(column, renderer, render_process_cell, GINT_TO_POINTER(COL_PID), NULL);
     gtk_tree_view_column_set_sort_column_id(column, COL_PID);
     gtk_tree_view_column_set_clickable(column, TRUE);
     gtk_tree_view_column_set_sort_indicator(column, TRUE);
@@ -424,170 +468,67 @@ void activate(GtkApplication *app, gpointer user_data) {
     gtk_tree_view_column_set_sort_indicator(column, TRUE);
     gtk_tree_view_append_column(GTK_TREE_VIEW(treeview), column);
 
-    cpu_column = gtk_tree_view_column_new_with_attributes("CPU", renderer, "text", COL_CPU, NULL);
+    cpu_column = gtk_tree_view_column_new_with_attributes("CPU", renderer, NULL);
+    gtk_tree_view_column_set_cell_data_func(cpu_column, renderer, render_process_cell, GINT_TO_POINTER(COL_CPU), NULL);
     gtk_tree_view_column_set_sort_column_id(cpu_column, COL_CPU);
     gtk_tree_view_column_set_clickable(cpu_column, TRUE);
     gtk_tree_view_column_set_sort_indicator(cpu_column, TRUE);
     gtk_tree_view_append_column(GTK_TREE_VIEW(treeview), cpu_column);
 
-    gpu_column = gtk_tree_view_column_new_with_attributes("GPU", renderer, "text", COL_GPU, NULL);
+    gpu_column = gtk_tree_view_column_new_with_attributes("GPU", renderer, NULL);
+    gtk_tree_view_column_set_cell_data_func(gpu_column, renderer, render_process_cell, GINT_TO_POINTER(COL_GPU), NULL);
     gtk_tree_view_column_set_sort_column_id(gpu_column, COL_GPU);
     gtk_tree_view_column_set_clickable(gpu_column, TRUE);
     gtk_tree_view_column_set_sort_indicator(gpu_column, TRUE);
     gtk_tree_view_append_column(GTK_TREE_VIEW(treeview), gpu_column);
 
-    memory_column = gtk_tree_view_column_new_with_attributes("Memory", renderer, "text", COL_MEM, NULL);
+    memory_column = gtk_tree_view_column_new_with_attributes("Memory", renderer, NULL);
+    gtk_tree_view_column_set_cell_data_func(memory_column, renderer, render_process_cell, GINT_TO_POINTER(COL_MEM), NULL);
     gtk_tree_view_column_set_sort_column_id(memory_column, COL_MEM);
     gtk_tree_view_column_set_clickable(memory_column, TRUE);
     gtk_tree_view_column_set_sort_indicator(memory_column, TRUE);
     gtk_tree_view_append_column(GTK_TREE_VIEW(treeview), memory_column);
 
-    column = gtk_tree_view_column_new_with_attributes("Network", renderer, "text", COL_NET, NULL);
+    column = gtk_tree_view_column_new_with_attributes("Network", renderer, NULL);
+    gtk_tree_view_column_set_cell_data_func(column, renderer, render_process_cell, GINT_TO_POINTER(COL_NET), NULL);
     gtk_tree_view_column_set_sort_column_id(column, COL_NET);
     gtk_tree_view_column_set_clickable(column, TRUE);
     gtk_tree_view_column_set_sort_indicator(column, TRUE);
     gtk_tree_view_append_column(GTK_TREE_VIEW(treeview), column);
 
-    column = gtk_tree_view_column_new_with_attributes("Run Time", renderer, "text", COL_RUNTIME, NULL);
+    column = gtk_tree_view_column_new_with_attributes("Run Time", renderer, NULL);
+    gtk_tree_view_column_set_cell_data_func(column, renderer, render_process_cell, GINT_TO_POINTER(COL_RUNTIME), NULL);
     gtk_tree_view_column_set_sort_column_id(column, COL_RUNTIME);
     gtk_tree_view_column_set_clickable(column, TRUE);
     gtk_tree_view_column_set_sort_indicator(column, TRUE);
     gtk_tree_view_append_column(GTK_TREE_VIEW(treeview), column);
 
-    column = gtk_tree_view_column_new_with_attributes("Type", renderer, "text", COL_TYPE, NULL);
+    column = gtk_tree_view_column_new_with_attributes("Type", renderer, NULL);
+    gtk_tree_view_column_set_cell_data_func(column, renderer, render_process_cell, GINT_TO_POINTER(COL_TYPE), NULL);
     gtk_tree_view_column_set_sort_column_id(column, COL_TYPE);
     gtk_tree_view_column_set_clickable(column, TRUE);
     gtk_tree_view_column_set_sort_indicator(column, TRUE);
     gtk_tree_view_append_column(GTK_TREE_VIEW(treeview), column);
 
-    // Init hashes
-    prev_net_bytes = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_free);
-    prev_times = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_free);
+    // Init network tracking
+    net_counters = rate_store_new(0);
     g_mutex_init(&hash_mutex);
-    
-    // Init process cache for incremental updates
-    process_cache = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, (GDestroyNotify)free_cache_entry);
-    g_mutex_init(&cache_mutex);
 
-    // Get static specs
-    static_specs = get_static_specs();
+    g_signal_connect(window, "map-event", G_CALLBACK(on_window_map_event), NULL);
+    g_signal_connect(window, "unmap-event", G_CALLBACK(on_window_map_event), NULL);
+    g_signal_connect(window, "window-state-event", G_CALLBACK(on_window_state_event), NULL);
 
     // Show window first to ensure UI is ready
     gtk_widget_show_all(window);
 
-    // Timer for UI updates - collector will be initialized on first callback
-    g_timeout_add(UI_UPDATE_INTERVAL_MS, timeout_callback, NULL);
+    // Collection starts right away and every publish wakes the main loop,
+    // so the first snapshot is painted as soon as it exists. A client may
+    // have received a frame before its notification was installed.
+    if (ensure_collector_started()) render_latest_snapshot();
 }
 
 // Removed old progressive update functions - now using collector/bin system
 
-// Update system summary information
-void update_system_summary(UpdateData *data) {
-    if (!data) return;
-    
-    // Update summary label with detailed system info (VM, Disks, Networks)
-    if (summary_label) {
-        if (data->system_summary && strlen(data->system_summary) > 0) {
-            // Use the detailed system summary from top output (Networks, VM, Disks)
-            gtk_label_set_text(summary_label, data->system_summary);
-        } else {
-            // Show loading message while data is being collected
-            gtk_label_set_text(summary_label, "Loading system information...");
-        }
-    }
-    
-    // Update specs label with GPU status
-    if (specs_label && static_specs) {
-        char full_specs[1024];
-        char gpu_status[100];
-        
-        if (data->gpu_usage && strlen(data->gpu_usage) > 0) {
-            float gpu_percent = 0.0;
-            if (sscanf(data->gpu_usage, "%f%%", &gpu_percent) == 1) {
-                if (gpu_percent < 10) {
-                    strcpy(gpu_status, "Graphics: Idle");
-                } else if (gpu_percent < 30) {
-                    strcpy(gpu_status, "Graphics: Light use");
-                } else if (gpu_percent < 60) {
-                    strcpy(gpu_status, "Graphics: Active");
-                } else if (gpu_percent < 90) {
-                    strcpy(gpu_status, "Graphics: Busy");
-                } else {
-                    strcpy(gpu_status, "Graphics: Maximum use");
-                }
-                
-                snprintf(full_specs, sizeof(full_specs), "%s\n%s (%.0f%%)", static_specs, gpu_status, gpu_percent);
-            } else {
-                snprintf(full_specs, sizeof(full_specs), "%s\nGraphics: %s", static_specs, data->gpu_usage);
-            }
-        } else {
-            snprintf(full_specs, sizeof(full_specs), "%s\nGraphics: N/A", static_specs);
-        }
-        
-        gtk_label_set_text(specs_label, full_specs);
-    }
-}
-
-// Update column headers with system usage data
-void update_column_headers(UpdateData *data) {
-    if (!data) return;
-    
-    if (cpu_column) {
-        char cpu_title[100];
-        snprintf(cpu_title, sizeof(cpu_title), "CPU (%.1f%% system)", data->system_cpu_usage);
-        gtk_tree_view_column_set_title(cpu_column, cpu_title);
-    }
-    
-    if (memory_column) {
-        char memory_title[100];
-        snprintf(memory_title, sizeof(memory_title), "Memory (%.1f%% system)", data->system_memory_usage);
-        gtk_tree_view_column_set_title(memory_column, memory_title);
-    }
-    
-    if (gpu_column && data->gpu_usage) {
-        char gpu_title[100];
-        snprintf(gpu_title, sizeof(gpu_title), "GPU (%s)", data->gpu_usage);
-        gtk_tree_view_column_set_title(gpu_column, gpu_title);
-    }
-}
-
-
-
-// Cache maintenance function to clean up stale entries
-void cleanup_stale_cache_entries(void) {
-    static time_t last_cleanup = 0;
-    time_t now = time(NULL);
-    
-    // Only cleanup every 30 seconds to avoid overhead
-    if (now - last_cleanup < 30) return;
-    last_cleanup = now;
-    
-    g_mutex_lock(&cache_mutex);
-    
-    GHashTableIter iter;
-    gpointer key, value;
-    GList *to_remove = NULL;
-    
-    g_hash_table_iter_init(&iter, process_cache);
-    while (g_hash_table_iter_next(&iter, &key, &value)) {
-        ProcessCacheEntry *entry = (ProcessCacheEntry *)value;
-        
-        // Check if row reference is still valid
-        if (!entry->row_ref || !gtk_tree_row_reference_valid(entry->row_ref)) {
-            to_remove = g_list_prepend(to_remove, g_strdup((char *)key));
-        }
-    }
-    
-    // Remove stale entries
-    for (GList *rem = to_remove; rem != NULL; rem = rem->next) {
-        g_hash_table_remove(process_cache, (char *)rem->data);
-        g_free(rem->data);
-    }
-    g_list_free(to_remove);
-    
-    g_mutex_unlock(&cache_mutex);
-}
-
 // Cleanup function for UI resources
 void cleanup_ui_resources(void) {
     // Cleanup threaded collector
@@ -595,485 +536,35 @@ void cleanup_ui_resources(void) {
         threaded_collector_destroy(g_collector);
         g_collector = NULL;
     }
-    
-    if (process_cache) {
-        g_hash_table_destroy(process_cache);
-        process_cache = NULL;
+    if (g_collector_client) {
+        collector_client_destroy(g_collector_client);
+        g_collector_client = NULL;
     }
+    g_free(attach_socket_path);
+    attach_socket_path = NULL;
     
-    if (prev_net_bytes) {
-        g_hash_table_destroy(prev_net_bytes);
-        prev_net_bytes = NULL;
-    }
+    // Drops the model's reference to the last snapshot
+    g_clear_object(&process_model);
     
-    if (prev_times) {
-        g_hash_table_destroy(prev_times);
-        prev_times = NULL;
-    }
+    rate_store_free(net_counters);
+    net_counters = NULL;
+    
+    filter_columns_clear(&filter_columns);
+    filter_columns_table = NULL;
     
-    g_mutex_clear(&cache_mutex);
     g_mutex_clear(&hash_mutex);
     
     if (static_specs) {
-        free(static_specs);
+        g_free(static_specs);
         static_specs = NULL;
     }
 }
 
-// Helper function to convert memory string to bytes for comparison
-long long memory_to_bytes(const char *mem_str) {
-    if (!mem_str || strlen(mem_str) == 0) return -1;
-    
-    char temp[50];
-    strncpy(temp, mem_str, sizeof(temp) - 1);
-    temp[sizeof(temp) - 1] = '\0';
-    
-    // Convert to uppercase for consistent comparison
-    for (int i = 0; temp[i]; i++) {
-        temp[i] = toupper(temp[i]);
-    }
-    
-    char *endptr;
-    double value = strtod(temp, &endptr);
-    if (value < 0) return -1;
-    
-    // Skip whitespace
-    while (*endptr && isspace(*endptr)) endptr++;
-    
-    // Check suffix (case-insensitive)
-    if (strstr(endptr, "TB")) {
-        return (long long)(value * 1024LL * 1024LL * 1024LL * 1024LL);
-    } else if (strstr(endptr, "GB")) {
-        return (long long)(value * 1024LL * 1024LL * 1024LL);
-    } else if (strstr(endptr, "MB")) {
-        return (long long)(value * 1024LL * 1024LL);
-    } else if (strstr(endptr, "KB")) {
-        return (long long)(value * 1024LL);
-    } else if (strstr(endptr, "B") || strlen(endptr) == 0) {
-        return (long long)value; // Bytes or no suffix
-    } else {
-        return -1; // Invalid suffix
-    }
-}
-
-// Helper function to extract numeric value and operator from filter string
-gboolean parse_numeric_filter(const char *filter, double *value, char *op, const char *suffix) {
-    if (!filter || strlen(filter) == 0) return FALSE;
-    
-    char temp[50];
-    strncpy(temp, filter, sizeof(temp) - 1);
-    temp[sizeof(temp) - 1] = '\0';
-    
-    int len = strlen(temp);
-    if (len == 0) return FALSE;
-    
-    // Check for operators at the end
-    if (temp[len - 1] == '+') {
-        *op = '+';
-        temp[len - 1] = '\0';
-        len--;
-    } else if (temp[len - 1] == '-') {
-        *op = '-';
-        temp[len - 1] = '\0';
-        len--;
-    } else {
-        *op = '='; // Exact match
-    }
-    
-    // Remove suffix if provided (like % for percentages)
-    if (suffix && strlen(suffix) > 0) {
-        char *pos = strstr(temp, suffix);
-        if (pos) {
-            *pos = '\0';
-            len = strlen(temp);
-        }
-    }
-    
-    if (len == 0) return FALSE;
-    
-    char *endptr;
-    *value = strtod(temp, &endptr);
-    return (endptr != temp && *value >= 0); // Valid if we parsed something and it's non-negative
-}
-
-// Helper function to parse memory filter with operators
-gboolean parse_memory_filter(const char *filter, long long *bytes, char *op) {
-    if (!filter || strlen(filter) == 0) return FALSE;
-    
-    char temp[50];
-    strncpy(temp, filter, sizeof(temp) - 1);
-    temp[sizeof(temp) - 1] = '\0';
-    
-    int len = strlen(temp);
-    if (len == 0) return FALSE;
-    
-    // Check for operators at the end
-    if (temp[len - 1] == '+') {
-        *op = '+';
-        temp[len - 1] = '\0';
-    } else if (temp[len - 1] == '-') {
-        *op = '-';
-        temp[len - 1] = '\0';
-    } else {
-        *op = '='; // Exact match
-    }
-    
-    *bytes = memory_to_bytes(temp);
-    return (*bytes >= 0);
-}
-
-// Helper function to convert network rate string to bytes per second
-long long network_to_bps(const char *net_str) {
-    if (!net_str || strlen(net_str) == 0) return -1;
-    
-    char temp[50];
-    strncpy(temp, net_str, sizeof(temp) - 1);
-    temp[sizeof(temp) - 1] = '\0';
-    
-    // Convert to uppercase for consistent comparison
-    for (int i = 0; temp[i]; i++) {
-        temp[i] = toupper(temp[i]);
-    }
-    
-    char *endptr;
-    double value = strtod(temp, &endptr);
-    if (value < 0) return -1;
-    
-    // Skip whitespace
-    while (*endptr && isspace(*endptr)) endptr++;
-    
-    // Check for /S suffix
-    char *per_sec = strstr(endptr, "/S");
-    if (!per_sec) return -1; // Must have /s or /S
-    
-    // Check prefix before /S
-    if (strstr(endptr, "GB/S")) {
-        return (long long)(value * 1024LL * 1024LL * 1024LL);
-    } else if (strstr(endptr, "MB/S")) {
-        return (long long)(value * 1024LL * 1024LL);
-    } else if (strstr(endptr, "KB/S")) {
-        return (long long)(value * 1024LL);
-    } else if (strstr(endptr, "B/S")) {
-        return (long long)value;
-    } else {
-        return -1; // Invalid format
-    }
-}
-
-// Helper function to parse network filter with operators
-gboolean parse_network_filter(const char *filter, long long *bps, char *op) {
-    if (!filter || strlen(filter) == 0) return FALSE;
-    
-    char temp[50];
-    strncpy(temp, filter, sizeof(temp) - 1);
-    temp[sizeof(temp) - 1] = '\0';
-    
-    int len = strlen(temp);
-    if (len == 0) return FALSE;
-    
-    // Check for operators at the end
-    if (temp[len - 1] == '+') {
-        *op = '+';
-        temp[len - 1] = '\0';
-    } else if (temp[len - 1] == '-') {
-        *op = '-';
-        temp[len - 1] = '\0';
-    } else {
-        *op = '='; // Exact match
-    }
-    
-    *bps = network_to_bps(temp);
-    return (*bps >= 0);
-}
-
-// Parse range filter like "[100,200]" or "[1.5,5.0]"
-gboolean parse_range_filter(const char *filter, double *min_val, double *max_val) {
-    if (!filter || strlen(filter) < 5) return FALSE;
-    
-    // Check if it's a range format [min,max]
-    if (filter[0] != '[') return FALSE;
-    
-    const char *end = strchr(filter, ']');
-    if (!end) return FALSE;
-    
-    // Find comma separator
-    const char *comma = strchr(filter + 1, ',');
-    if (!comma || comma >= end) return FALSE;
-    
-    // Parse min value
-    char min_str[32];
-    int min_len = comma - (filter + 1);
-    if (min_len >= sizeof(min_str)) return FALSE;
-    strncpy(min_str, filter + 1, min_len);
-    min_str[min_len] = '\0';
-    
-    // Parse max value  
-    char max_str[32];
-    int max_len = end - (comma + 1);
-    if (max_len >= sizeof(max_str)) return FALSE;
-    strncpy(max_str, comma + 1, max_len);
-    max_str[max_len] = '\0';
-    
-    // Convert to numbers
-    char *endptr;
-    *min_val = strtod(min_str, &endptr);
-    if (*endptr != '\0') return FALSE;
-    
-    *max_val = strtod(max_str, &endptr);
-    if (*endptr != '\0') return FALSE;
-    
-    return *min_val <= *max_val; // Validate range
-}
-
-// Parse range filter for memory/network like "[100MB,1GB]" 
-gboolean parse_memory_range_filter(const char *filter, long long *min_bytes, long long *max_bytes) {
-    if (!filter || strlen(filter) < 5) return FALSE;
-    
-    // Check if it's a range format [min,max]
-    if (filter[0] != '[') return FALSE;
-    
-    const char *end = strchr(filter, ']');
-    if (!end) return FALSE;
-    
-    // Find comma separator
-    const char *comma = strchr(filter + 1, ',');
-    if (!comma || comma >= end) return FALSE;
-    
-    // Parse min value
-    char min_str[32];
-    int min_len = comma - (filter + 1);
-    if (min_len >= sizeof(min_str)) return FALSE;
-    strncpy(min_str, filter + 1, min_len);
-    min_str[min_len] = '\0';
-    
-    // Parse max value  
-    char max_str[32];
-    int max_len = end - (comma + 1);
-    if (max_len >= sizeof(max_str)) return FALSE;
-    strncpy(max_str, comma + 1, max_len);
-    max_str[max_len] = '\0';
-    
-    // Convert to bytes using existing parse_bytes function
-    *min_bytes = parse_bytes(min_str);
-    *max_bytes = parse_bytes(max_str);
-    
-    return (*min_bytes >= 0 && *max_bytes >= 0 && *min_bytes <= *max_bytes);
-}
-
-// Parse range filter for network like "[1MB/s,10MB/s]"
-gboolean parse_network_range_filter(const char *filter, long long *min_bps, long long *max_bps) {
-    if (!filter || strlen(filter) < 5) return FALSE;
-    
-    // Check if it's a range format [min,max]
-    if (filter[0] != '[') return FALSE;
-    
-    const char *end = strchr(filter, ']');
-    if (!end) return FALSE;
-    
-    // Find comma separator
-    const char *comma = strchr(filter + 1, ',');
-    if (!comma || comma >= end) return FALSE;
-    
-    // Parse min value
-    char min_str[32];
-    int min_len = comma - (filter + 1);
-    if (min_len >= sizeof(min_str)) return FALSE;
-    strncpy(min_str, filter + 1, min_len);
-    min_str[min_len] = '\0';
-    
-    // Parse max value  
-    char max_str[32];
-    int max_len = end - (comma + 1);
-    if (max_len >= sizeof(max_str)) return FALSE;
-    strncpy(max_str, comma + 1, max_len);
-    max_str[max_len] = '\0';
-    
-    // Convert to bytes per second using existing network_to_bps function
-    *min_bps = network_to_bps(min_str);
-    *max_bps = network_to_bps(max_str);
-    
-    return (*min_bps >= 0 && *max_bps >= 0 && *min_bps <= *max_bps);
-}
-
-// Function to check if a process matches the current filter criteria
-gboolean process_matches_filter(Process *proc) {
-    if (!current_filter.active) return TRUE;
-    
-    // PID filter
-    if (strlen(current_filter.pid_filter) > 0) {
-        int proc_pid = atoi(proc->pid);
-        
-        // Check for range filter first [min,max]
-        double min_val, max_val;
-        if (parse_range_filter(current_filter.pid_filter, &min_val, &max_val)) {
-            if (proc_pid < (int)min_val || proc_pid > (int)max_val) return FALSE;
-        } else {
-            // Use existing numeric filter logic
-            double filter_pid;
-            char op;
-            if (parse_numeric_filter(current_filter.pid_filter, &filter_pid, &op, NULL)) {
-                switch (op) {
-                    case '+':
-                        if (proc_pid < filter_pid) return FALSE;
-                        break;
-                    case '-':
-                        if (proc_pid > filter_pid) return FALSE;
-                        break;
-                    case '=':
-                        if (proc_pid != (int)filter_pid) return FALSE;
-                        break;
-                }
-            }
-        }
-    }
-    
-    // Name filter (substring search, case-insensitive)
-    if (strlen(current_filter.name_filter) > 0) {
-        char proc_name_lower[100], filter_lower[100];
-        strncpy(proc_name_lower, proc->name, sizeof(proc_name_lower) - 1);
-        strncpy(filter_lower, current_filter.name_filter, sizeof(filter_lower) - 1);
-        
-        // Convert to lowercase for case-insensitive search
-        for (int i = 0; proc_name_lower[i]; i++) {
-            proc_name_lower[i] = tolower(proc_name_lower[i]);
-        }
-        for (int i = 0; filter_lower[i]; i++) {
-            filter_lower[i] = tolower(filter_lower[i]);
-        }
-        
-        if (!strstr(proc_name_lower, filter_lower)) return FALSE;
-    }
-    
-    // CPU filter
-    if (strlen(current_filter.cpu_filter) > 0) {
-        double proc_cpu = strtod(proc->cpu, NULL);
-        
-        // Check for range filter first [min,max]
-        double min_val, max_val;
-        if (parse_range_filter(current_filter.cpu_filter, &min_val, &max_val)) {
-            if (proc_cpu < min_val || proc_cpu > max_val) return FALSE;
-        } else {
-            // Use existing numeric filter logic
-            double filter_cpu;
-            char op;
-            if (parse_numeric_filter(current_filter.cpu_filter, &filter_cpu, &op, "%")) {
-                switch (op) {
-                    case '+':
-                        if (proc_cpu < filter_cpu) return FALSE;
-                        break;
-                    case '-':
-                        if (proc_cpu > filter_cpu) return FALSE;
-                        break;
-                    case '=':
-                        if (fabs(proc_cpu - filter_cpu) > 0.1) return FALSE;
-                        break;
-                }
-            }
-        }
-    }
-    
-    // GPU filter
-    if (strlen(current_filter.gpu_filter) > 0) {
-        double proc_gpu = strtod(proc->gpu, NULL);
-        
-        // Check for range filter first [min,max]
-        double min_val, max_val;
-        if (parse_range_filter(current_filter.gpu_filter, &min_val, &max_val)) {
-            if (proc_gpu < min_val || proc_gpu > max_val) return FALSE;
-        } else {
-            // Use existing numeric filter logic
-            double filter_gpu;
-            char op;
-            if (parse_numeric_filter(current_filter.gpu_filter, &filter_gpu, &op, "%")) {
-                switch (op) {
-                    case '+':
-                        if (proc_gpu < filter_gpu) return FALSE;
-                        break;
-                    case '-':
-                        if (proc_gpu > filter_gpu) return FALSE;
-                        break;
-                    case '=':
-                        if (fabs(proc_gpu - filter_gpu) > 0.1) return FALSE;
-                        break;
-                }
-            }
-        }
-    }
-    
-    // Memory filter
-    if (strlen(current_filter.memory_filter) > 0) {
-        long long proc_mem = memory_to_bytes(proc->mem);
-        if (proc_mem >= 0) {
-            // Check for range filter first [min,max]
-            long long min_bytes, max_bytes;
-            if (parse_memory_range_filter(current_filter.memory_filter, &min_bytes, &max_bytes)) {
-                if (proc_mem < min_bytes || proc_mem > max_bytes) return FALSE;
-            } else {
-                // Use existing memory filter logic
-                long long filter_mem;
-                char op;
-                if (parse_memory_filter(current_filter.memory_filter, &filter_mem, &op)) {
-                    switch (op) {
-                        case '+':
-                            if (proc_mem < filter_mem) return FALSE;
-                            break;
-                        case '-':
-                            if (proc_mem > filter_mem) return FALSE;
-                            break;
-                        case '=':
-                            // Exact match within 10% tolerance
-                            if (filter_mem > 0 && (llabs(proc_mem - filter_mem) > filter_mem * 0.1)) return FALSE;
-                            break;
-                    }
-                }
-            }
-        }
-    }
-    
-    // Network filter
-    if (strlen(current_filter.network_filter) > 0) {
-        long long proc_net = network_to_bps(proc->net);
-        if (proc_net >= 0) {
-            // Check for range filter first [min,max]
-            long long min_bps, max_bps;
-            if (parse_network_range_filter(current_filter.network_filter, &min_bps, &max_bps)) {
-                if (proc_net < min_bps || proc_net > max_bps) return FALSE;
-            } else {
-                // Use existing network filter logic
-                long long filter_net;
-                char op;
-                if (parse_network_filter(current_filter.network_filter, &filter_net, &op)) {
-                    switch (op) {
-                        case '+':
-                            if (proc_net < filter_net) return FALSE;
-                            break;
-                        case '-':
-                            if (proc_net > filter_net) return FALSE;
-                            break;
-                        case '=':
-                            // Exact match within 10% tolerance
-                            if (filter_net > 0 && (llabs(proc_net - filter_net) > filter_net * 0.1)) return FALSE;
-                            break;
-                    }
-                }
-            }
-        }
-    }
-    
-    // Type filter
-    if (strlen(current_filter.type_filter) > 0 && 
-        strcmp(current_filter.type_filter, "All") != 0) {
-        // Handle system processes which have "🛡️ System" format
-        if (strcasecmp(current_filter.type_filter, "System") == 0) {
-            if (strstr(proc->type, "System") == NULL) return FALSE;
-        } else if (strcasecmp(current_filter.type_filter, "User") == 0) {
-            if (strcasecmp(proc->type, "User") != 0) return FALSE;
-        } else {
-            if (strcasecmp(current_filter.type_filter, proc->type) != 0) return FALSE;
-        }
-    }
-    
-    return TRUE;
+// Function to check if a process matches the current filter criteria.
+// OPTIMIZATION: Evaluates the program compiled from current_filter, no
+// filter text is parsed per row
+gboolean process_matches_filter(const ProcessSample *proc) {
+    return filter_program_matches(&current_program, proc);
 }
 
 // Callback for filter entry changes
@@ -1149,6 +640,7 @@ void on_filter_changed(GtkWidget *widget, gpointer user_data) {
                                strlen(current_filter.network_filter) > 0 ||
                                (strlen(current_filter.type_filter) > 0 && 
                                 strcmp(current_filter.type_filter, "All") != 0));
+        filter_program_compile(&current_program, &current_filter);
         
         // Apply filters to current display immediately
         apply_filters_to_display();
@@ -1163,6 +655,7 @@ void on_clear_filters(GtkWidget *widget, gpointer user_data) {
     // Clear all filter criteria
     memset(&current_filter, 0, sizeof(FilterCriteria));
     current_filter.active = FALSE;
+    filter_program_compile(&current_program, &current_filter);
     
     // Clear all filter entry widgets
     for (int i = 0; i < 7; i++) {
@@ -1295,11 +788,11 @@ gboolean validate_filter_input(const char *text, int filter_type) {
 
 // Function to apply current filters to all visible processes
 void apply_filters_to_display(void) {
-    // Since we're using a simplified update approach that clears and repopulates
-    // the entire list, we don't need to do row-by-row filtering here.
-    // The filtering is now handled directly in update_ui_func().
-    // This function is kept for compatibility with filter change callbacks
-    // but doesn't need to do anything since the next UI update will apply filters.
+    // Deltas only cover rows whose data changed, so every row is re-checked
+    // against the new filters - right away, not on the next collection cycle
+    if (process_model) {
+        process_model_refilter(process_model);
+    }
 }
 
 // Function to update column headers with current usage percentages (compatible with new system)
@@ -5,19 +5,27 @@
 #include <glib.h>
 #include "../common/types.h"
 #include "../system/threaded_collector.h"
+#include "../system/collector_client.h"
+#include "process_model.h"
 
 // UI callback functions
 void activate(GtkApplication *app, gpointer user_data);
-gboolean timeout_callback(gpointer data);
 gboolean update_ui_func(gpointer user_data);
+void render_snapshot(Snapshot *snapshot);
 gboolean update_ui_progressive(gpointer user_data);
 gboolean restore_scroll_position(gpointer user_data);
 
+// Read snapshots from the headless collector at socket_path instead of
+// collecting in this process (call before the application runs; NULL for
+// the default socket)
+void ui_attach_collector(const char *socket_path);
+
+// Process list update statistics (signals emitted by the process model)
+void ui_get_update_stats(ProcessModelStats *stats);
+
 // Progressive update functions
 void update_process_list_basic(GList *processes);
 void update_process_list_complete(GList *processes);
-void update_system_summary(UpdateData *data);
-void update_column_headers(UpdateData *data);
 void save_scroll_position(void);
 // Scroll position preserved using model detachment + explicit adjustment restoration
 
@@ -27,11 +35,11 @@ gboolean on_treeview_button_press(GtkWidget *widget, GdkEventButton *event, gpoi
 void kill_process_callback(GtkWidget *menuitem, gpointer user_data);
 
 // Sorting functions
-gint process_compare_func(GtkTreeModel *model, GtkTreeIter *a, GtkTreeIter *b, gpointer user_data);
+gint process_sample_compare(const ProcessSample *a, const ProcessSample *b, gint column);
 
 // Global UI variables (declared in ui/ui.c)
 extern GtkApplication *app;
-extern GtkListStore *liststore;
+extern ProcessModel *process_model;
 extern GtkLabel *specs_label;
 extern GtkLabel *summary_label;
 extern char *static_specs;
@@ -43,9 +51,8 @@ extern GtkTreeView *global_treeview;
 extern GtkScrolledWindow *global_scrolled_window;
 extern GtkAdjustment *vertical_adjustment;
 
-// Hash tables for network tracking
-extern GHashTable *prev_net_bytes;
-extern GHashTable *prev_times;
+// Previous network bytes per (PID, start time), under hash_mutex
+extern RateStore *net_counters;
 
 // Security tracking
 extern time_t last_update_time;
@@ -0,0 +1,252 @@
+#define _GNU_SOURCE
+#include "command_runner.h"
+#include "utils.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <spawn.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+extern char **environ;
+
+#define COMMAND_MIN_OUTPUT 256
+#define COMMAND_MAX_ARGS 32
+#define COMMAND_REAP_MIN_US 20       // First wait for exit after EOF, doubled per retry
+#define COMMAND_REAP_MAX_US 10000
+
+// ---- Per-program statistics ----
+
+static GMutex stats_mutex;
+static CommandStats command_stats[COMMAND_STATS_MAX];
+static guint command_stats_count = 0;
+
+static void record_stats(const char *name, const CommandResult *result, gboolean ok) {
+    g_mutex_lock(&stats_mutex);
+    CommandStats *entry = NULL;
+    for (guint i = 0; i < command_stats_count; i++) {
+        if (strcmp(command_stats[i].name, name) == 0) {
+            entry = &command_stats[i];
+            break;
+        }
+    }
+    if (!entry && command_stats_count < COMMAND_STATS_MAX) {
+        entry = &command_stats[command_stats_count++];
+        memset(entry, 0, sizeof(*entry));
+        safe_strncpy(entry->name, name, sizeof(entry->name));
+    }
+    if (entry) {
+        entry->runs++;
+        entry->timeouts += result->timed_out ? 1 : 0;
+        entry->failures += ok || result->timed_out ? 0 : 1;
+        entry->total_us += result->elapsed_us;
+        entry->spawn_us += result->spawn_us;
+        if (result->elapsed_us > entry->max_us) entry->max_us = result->elapsed_us;
+    }
+    g_mutex_unlock(&stats_mutex);
+}
+
+guint command_runner_get_stats(CommandStats *stats, guint max_stats) {
+    g_mutex_lock(&stats_mutex);
+    guint count = MIN(max_stats, command_stats_count);
+    memcpy(stats, command_stats, count * sizeof(*stats));
+    g_mutex_unlock(&stats_mutex);
+    return count;
+}
+
+void command_runner_reset_stats(void) {
+    g_mutex_lock(&stats_mutex);
+    command_stats_count = 0;
+    g_mutex_unlock(&stats_mutex);
+}
+
+// ---- Output buffer ----
+
+static void output_reserve(CommandOutput *output, size_t needed) {
+    if (output->data && output->size >= needed) return;
+    size_t size = MAX(output->size, (size_t)COMMAND_MIN_OUTPUT);
+    while (size < needed) size *= 2;
+    output->data = realloc(output->data, size);
+    output->size = size;
+}
+
+void command_output_clear(CommandOutput *output) {
+    if (!output) return;
+    free(output->data);
+    memset(output, 0, sizeof(*output));
+}
+
+// ---- Running ----
+
+static gint64 remaining_ms(gint64 deadline) {
+    gint64 left = (deadline - g_get_monotonic_time() + 999) / 1000;
+    return left > 0 ? left : 0;
+}
+
+static int open_cloexec_pipe(int fds[2]) {
+#ifdef __linux__
+    return pipe2(fds, O_CLOEXEC);
+#else
+    // SECURITY: Mark both ends close-on-exec so children spawned by other
+    // threads never inherit our pipe (which would hold EOF back)
+    if (pipe(fds) != 0) return -1;
+    fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+    fcntl(fds[1], F_SETFD, FD_CLOEXEC);
+    return 0;
+#endif
+}
+
+// Wait for the child until the deadline, then kill its process group
+static int reap_child(pid_t pid, gint64 deadline, gboolean *timed_out) {
+    int status = 0;
+    // Usually the child exits right after closing stdout; back off quickly
+    // for the ones that keep running
+    for (gulong delay = COMMAND_REAP_MIN_US;; delay = MIN(delay * 2, COMMAND_REAP_MAX_US)) {
+        pid_t done = waitpid(pid, &status, WNOHANG);
+        if (done == pid) return status;
+        if (done < 0 && errno != EINTR) return -1;
+        if (g_get_monotonic_time() >= deadline) break;
+        g_usleep(delay);
+    }
+
+    *timed_out = TRUE;
+    kill(-pid, SIGKILL);
+    while (waitpid(pid, &status, 0) < 0 && errno == EINTR) {}
+    return status;
+}
+
+static gboolean run_spawned(const char *name, char *const argv[], guint timeout_ms, size_t max_output,
+                            CommandOutput *output, CommandResult *result) {
+    CommandResult local;
+    if (!result) result = &local;
+    memset(result, 0, sizeof(*result));
+    result->exit_status = -1;
+
+    output_reserve(output, MIN(max_output, (size_t)COMMAND_MIN_OUTPUT) + 1);
+    output->len = 0;
+    output->data[0] = '\0';
+
+    gint64 start = g_get_monotonic_time();
+    gint64 deadline = start + (gint64)timeout_ms * 1000;
+
+    int fds[2];
+    if (open_cloexec_pipe(fds) != 0) {
+        record_stats(name, result, FALSE);
+        return FALSE;
+    }
+
+    // stdout onto the pipe (dup2 clears close-on-exec on the target). The
+    // child leads its own process group so a timeout kills the whole
+    // pipeline, not just /bin/sh.
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_adddup2(&actions, fds[1], STDOUT_FILENO);
+    posix_spawnattr_t attr;
+    posix_spawnattr_init(&attr);
+    posix_spawnattr_setflags(&attr, POSIX_SPAWN_SETPGROUP);
+    posix_spawnattr_setpgroup(&attr, 0);
+
+    // OPTIMIZATION: posix_spawn uses vfork/clone(CLONE_VFORK) - no page
+    // table copy of our address space per command
+    pid_t pid;
+    int spawn_error = posix_spawnp(&pid, argv[0], &actions, &attr, argv, environ);
+    result->spawn_us = g_get_monotonic_time() - start;
+    posix_spawn_file_actions_destroy(&actions);
+    posix_spawnattr_destroy(&attr);
+    close(fds[1]);
+
+    if (spawn_error != 0) {
+        close(fds[0]);
+        result->elapsed_us = g_get_monotonic_time() - start;
+        record_stats(name, result, FALSE);
+        return FALSE;
+    }
+    track_spawned_child();
+
+    char drain[4096];
+    struct pollfd pfd = { .fd = fds[0], .events = POLLIN };
+    for (;;) {
+        gint64 wait_ms = remaining_ms(deadline);
+        int ready = wait_ms > 0 ? poll(&pfd, 1, (int)wait_ms) : 0;
+        if (ready < 0 && errno == EINTR) continue;
+        if (ready <= 0) {
+            result->timed_out = ready == 0;
+            break;
+        }
+
+        // Keep up to max_output bytes, drain the rest so the child can finish
+        char *target = drain;
+        size_t room = sizeof(drain);
+        if (output->len < max_output) {
+            output_reserve(output, MIN(max_output, output->len + sizeof(drain)) + 1);
+            target = output->data + output->len;
+            room = MIN(max_output, output->size - 1) - output->len;
+        }
+        ssize_t n = read(fds[0], target, room);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) break;
+        if (target == drain) {
+            result->truncated = TRUE;
+        } else {
+            output->len += (size_t)n;
+        }
+    }
+    output->data[output->len] = '\0';
+    close(fds[0]);
+
+    // A child that timed out while writing is killed at once
+    int status = reap_child(pid, result->timed_out ? 0 : deadline, &result->timed_out);
+    result->elapsed_us = g_get_monotonic_time() - start;
+    if (!result->timed_out && WIFEXITED(status)) result->exit_status = WEXITSTATUS(status);
+
+    gboolean ok = result->exit_status == 0;
+    record_stats(name, result, ok);
+    return ok;
+}
+
+gboolean command_run_argv(char *const argv[], guint timeout_ms, size_t max_output,
+                          CommandOutput *output, CommandResult *result) {
+    if (!argv || !argv[0] || !output) return FALSE;
+
+    const char *name = strrchr(argv[0], '/');
+    return run_spawned(name ? name + 1 : argv[0], argv, timeout_ms, max_output, output, result);
+}
+
+// Anything a shell would interpret
+static gboolean needs_shell(const char *cmd) {
+    return strpbrk(cmd, "|&;<>()$`\\\"'*?[]#~{}=%\n") != NULL;
+}
+
+gboolean command_run(const char *cmd, guint timeout_ms, size_t max_output,
+                     CommandOutput *output, CommandResult *result) {
+    if (!cmd || !output) return FALSE;
+
+    // Stats name: the first word
+    char name[32];
+    size_t name_len = strcspn(cmd, " \t");
+    safe_strncpy(name, cmd, MIN(name_len + 1, sizeof(name)));
+
+    if (needs_shell(cmd)) {
+        char *argv[] = { "/bin/sh", "-c", (char *)cmd, NULL };
+        return run_spawned(name, argv, timeout_ms, max_output, output, result);
+    }
+
+    // OPTIMIZATION: Plain commands skip the shell - one exec instead of two
+    char copy[1024];
+    if (strlen(cmd) >= sizeof(copy)) return FALSE;
+    safe_strncpy(copy, cmd, sizeof(copy));
+
+    char *argv[COMMAND_MAX_ARGS + 1];
+    int argc = 0;
+    char *save = NULL;
+    for (char *word = strtok_r(copy, " \t", &save); word && argc < COMMAND_MAX_ARGS;
+         word = strtok_r(NULL, " \t", &save)) {
+        argv[argc++] = word;
+    }
+    argv[argc] = NULL;
+    if (argc == 0) return FALSE;
+
+    return run_spawned(name, argv, timeout_ms, max_output, output, result);
+}
@@ -0,0 +1,58 @@
+#ifndef COMMAND_RUNNER_H
+#define COMMAND_RUNNER_H
+
+#include <stddef.h>
+#include <glib.h>
+
+// Runs short-lived commands with posix_spawn (vfork semantics, no /bin/sh
+// unless the command line needs one) and reads their output with poll()
+// against a deadline. A command that overruns is killed together with its
+// pipeline and reaped, so a hung tool can never stall a collector thread.
+
+// Output buffer reused across runs; grows as needed and is always
+// NUL-terminated. Start zeroed or with a malloc'd data/size pair.
+typedef struct {
+    char *data;
+    size_t size;            // Allocated bytes
+    size_t len;             // Output bytes kept
+} CommandOutput;
+
+typedef struct {
+    int exit_status;        // Exit code; -1 if killed, signalled or not started
+    gboolean timed_out;     // Deadline hit; output is what arrived before
+    gboolean truncated;     // More than max_output bytes were written
+    gint64 spawn_us;        // Time inside posix_spawn
+    gint64 elapsed_us;      // Spawn to reap
+} CommandResult;
+
+// Run argv (searched in PATH). Keeps at most max_output bytes of stdout;
+// the rest is drained and dropped. Returns TRUE if the command exited by
+// itself with status 0.
+gboolean command_run_argv(char *const argv[], guint timeout_ms, size_t max_output,
+                          CommandOutput *output, CommandResult *result);
+
+// Run a command line. Plain "tool arg arg" lines are split and exec'd
+// directly; lines using pipes, redirection, quotes or other shell syntax go
+// through /bin/sh -c.
+gboolean command_run(const char *cmd, guint timeout_ms, size_t max_output,
+                     CommandOutput *output, CommandResult *result);
+
+void command_output_clear(CommandOutput *output);
+
+// Per-program timing, keyed by the first word of the command line
+#define COMMAND_STATS_MAX 32
+typedef struct {
+    char name[32];
+    guint runs;
+    guint timeouts;
+    guint failures;         // Spawn errors and non-zero exits
+    gint64 total_us;
+    gint64 max_us;
+    gint64 spawn_us;        // Total time inside posix_spawn
+} CommandStats;
+
+// Copy up to max_stats entries; returns how many were copied
+guint command_runner_get_stats(CommandStats *stats, guint max_stats);
+void command_runner_reset_stats(void);
+
+#endif // COMMAND_RUNNER_H
@@ -1,26 +1,24 @@
 #include "utils.h"
 #include "memory_pool.h"
 #include "../ui/ui.h"
+#include "../system/process_meta.h"
 #include "../common/config.h"
 #include <time.h>
 
-// OPTIMIZATION: Memory pool for Process structs to reduce malloc/free overhead
-static Process *process_pool = NULL;
-static gboolean *pool_used = NULL;
-static int pool_initialized = 0;
-
-// OPTIMIZATION: String buffer cache to reduce malloc overhead for command outputs
+// OPTIMIZATION: String buffer cache to reduce malloc overhead for command outputs.
+// Collector sources run commands on several workers at once, hence the lock.
+static GMutex string_cache_mutex;
 static char *string_cache[STRING_CACHE_SIZE];
 static size_t cache_sizes[STRING_CACHE_SIZE];
 static int cache_initialized = 0;
 
-// OPTIMIZATION: Memory pool management for Process structs
+// OPTIMIZATION: ProcessSample structs come from the slab-backed pool
+// (memory_pool.h), which grows on demand
 void init_process_pool(void) {
-    if (!pool_initialized) {
-        process_pool = calloc(PROCESS_POOL_SIZE, sizeof(Process));
-        pool_used = calloc(PROCESS_POOL_SIZE, sizeof(gboolean));
-        pool_initialized = 1;
-        
+    init_memory_pools();
+    
+    g_mutex_lock(&string_cache_mutex);
+    if (!cache_initialized) {
         // Initialize string cache
         for (int i = 0; i < STRING_CACHE_SIZE; i++) {
             string_cache[i] = NULL;
@@ -28,43 +26,36 @@ void init_process_pool(void) {
         }
         cache_initialized = 1;
     }
+    g_mutex_unlock(&string_cache_mutex);
 }
 
-Process* alloc_process(void) {
+ProcessSample* alloc_process(void) {
     // Use the optimized memory pool
     return get_process_from_pool_fast();
 }
 
 // Compatibility wrapper for existing code
-Process* get_process_from_pool(void) {
+ProcessSample* get_process_from_pool(void) {
     return get_process_from_pool_fast();
 }
 
 // Compatibility wrapper for returning processes
-void return_process_to_pool(Process *proc) {
+void return_process_to_pool(ProcessSample *proc) {
     return_process_to_pool_fast(proc);
 }
 
-void free_process(Process *proc) {
+void free_process(ProcessSample *proc) {
     // Use the optimized pool return function
     return_process_to_pool_fast(proc);
 }
 
+// Releases the pool's slabs; every process from it must have been freed
 void cleanup_process_pool(void) {
-    if (pool_initialized) {
-        if (process_pool) {
-            free(process_pool);
-            process_pool = NULL;
-        }
-        if (pool_used) {
-            free(pool_used);
-            pool_used = NULL;
-        }
-        pool_initialized = 0;
-    }
+    cleanup_memory_pools();
 }
 
 char* get_cached_buffer(size_t min_size) {
+    g_mutex_lock(&string_cache_mutex);
     if (!cache_initialized) {
         for (int i = 0; i < STRING_CACHE_SIZE; i++) {
             string_cache[i] = NULL;
@@ -78,9 +69,11 @@ char* get_cached_buffer(size_t min_size) {
             char *buffer = string_cache[i];
             string_cache[i] = NULL;
             cache_sizes[i] = 0;
+            g_mutex_unlock(&string_cache_mutex);
             return buffer;
         }
     }
+    g_mutex_unlock(&string_cache_mutex);
     
     return malloc(min_size);
 }
@@ -88,25 +81,34 @@ char* get_cached_buffer(size_t min_size) {
 void return_cached_buffer(char *buffer, size_t size) {
     if (!buffer) return;
     
+    g_mutex_lock(&string_cache_mutex);
     for (int i = 0; i < STRING_CACHE_SIZE; i++) {
         if (!string_cache[i]) {
             string_cache[i] = buffer;
             cache_sizes[i] = size;
+            g_mutex_unlock(&string_cache_mutex);
             return;
         }
     }
+    g_mutex_unlock(&string_cache_mutex);
     
     // Cache full, just free it
     free(buffer);
 }
 
 void cleanup_resources(void) {
+    // Clean up UI resources (frees the processes it cached)
+    cleanup_ui_resources();
     cleanup_process_pool();
     
-    // Clean up UI resources
-    cleanup_ui_resources();
+    // Clean up process metadata cache
+    process_meta_cleanup();
+    process_table_recycler_cleanup();
+    sample_arena_recycler_cleanup();
+    string_intern_cleanup();
     
     // Clean up string cache
+    g_mutex_lock(&string_cache_mutex);
     if (cache_initialized) {
         for (int i = 0; i < STRING_CACHE_SIZE; i++) {
             if (string_cache[i]) {
@@ -116,42 +118,56 @@ void cleanup_resources(void) {
         }
         cache_initialized = 0;
     }
+    g_mutex_unlock(&string_cache_mutex);
 }
 
-Process* copy_process(const Process *proc) {
+ProcessSample* copy_process(const ProcessSample *proc) {
     if (!proc) return NULL;
     
-    Process *copy = alloc_process();
+    ProcessSample *copy = alloc_process();
     if (!copy) return NULL;
     
-    // Copy all fields
-    safe_strncpy(copy->pid, proc->pid, sizeof(copy->pid));
-    safe_strncpy(copy->name, proc->name, sizeof(copy->name));
-    safe_strncpy(copy->cpu, proc->cpu, sizeof(copy->cpu));
-    safe_strncpy(copy->gpu, proc->gpu, sizeof(copy->gpu));
-    safe_strncpy(copy->mem, proc->mem, sizeof(copy->mem));
-    safe_strncpy(copy->net, proc->net, sizeof(copy->net));
-    safe_strncpy(copy->runtime, proc->runtime, sizeof(copy->runtime));
-    safe_strncpy(copy->type, proc->type, sizeof(copy->type));
+    // OPTIMIZATION: Plain numeric record - a single struct copy
+    *copy = *proc;
     
     return copy;
 }
 
+UpdateData* update_data_new(void) {
+    SampleArena *arena = sample_arena_acquire();
+    UpdateData *data = sample_arena_alloc(arena, sizeof(UpdateData));
+    data->arena = arena;
+    return data;
+}
+
+char* update_data_strndup(UpdateData *data, const char *text, gssize len) {
+    if (!text) return NULL;
+    if (data->arena) return sample_arena_strndup(data->arena, text, len);
+    return len < 0 ? g_strdup(text) : g_strndup(text, (gsize)len);
+}
+
+void update_data_set_text(UpdateData *data, char **field, const char *text) {
+    // Arena strings are dropped with the arena; heap ones are freed now
+    if (!data->arena) g_free(*field);
+    *field = update_data_strndup(data, text, -1);
+}
+
 void free_update_data(UpdateData *data) {
     if (!data) return;
     
-    // Free process list
-    if (data->processes) {
-        GList *current = data->processes;
-        while (current) {
-            Process *proc = (Process*)current->data;
-            free_process(proc);
-            current = current->next;
-        }
-        g_list_free(data->processes);
+    // Hand the process table back for reuse by the next cycle
+    process_table_release(data->processes);
+    
+    // OPTIMIZATION: Arena-backed data (struct included) goes in one release
+    if (data->arena) {
+        sample_arena_release(data->arena);
+        return;
     }
     
-    // Free GPU usage string
+    // Free summary and GPU usage strings
+    if (data->system_summary) {
+        g_free(data->system_summary);
+    }
     if (data->gpu_usage) {
         g_free(data->gpu_usage);
     }
@@ -1,165 +1,66 @@
 #include "memory_pool.h"
+#include "../common/config.h"
+#include "sample_arena.h"
+#include "string_intern.h"
 #include <stdio.h>
 #include <string.h>
-#include <pthread.h>
 
-// Global memory pools
-static ProcessPool g_process_pool = {0};
-static StringPool g_string_pool = {0};
-static pthread_mutex_t pool_mutex = PTHREAD_MUTEX_INITIALIZER;
+// OPTIMIZATION: Slab caches with per-thread magazines instead of fixed
+// arrays behind one global mutex - no scan for a free slot, no lock per
+// call, and no malloc fallback when the arrays are exhausted
+static SlabCache g_process_cache;
+static SlabCache g_string_cache;
+
+static void ensure_memory_pools(void) {
+    static gsize initialized = 0;
+    if (g_once_init_enter(&initialized)) {
+        slab_cache_init(&g_process_cache, sizeof(ProcessSample), PROCESS_POOL_SIZE);
+        slab_cache_init(&g_string_cache, STRING_BUFFER_SIZE, STRING_POOL_SLAB);
+        g_once_init_leave(&initialized, 1);
+    }
+}
 
 // Initialize all memory pools
 int init_memory_pools(void) {
-    pthread_mutex_lock(&pool_mutex);
-    
-    // Initialize process pool
-    memset(&g_process_pool, 0, sizeof(g_process_pool));
-    g_process_pool.next_free = 0;
-    g_process_pool.total_allocated = 0;
-    
-    // Initialize string pool
-    memset(&g_string_pool, 0, sizeof(g_string_pool));
-    g_string_pool.next_free = 0;
-    
-    pthread_mutex_unlock(&pool_mutex);
+    ensure_memory_pools();
     return 0;
 }
 
 // Cleanup memory pools
 void cleanup_memory_pools(void) {
-    pthread_mutex_lock(&pool_mutex);
-    
-    // Clear process pool
-    memset(&g_process_pool, 0, sizeof(g_process_pool));
-    
-    // Clear string pool
-    memset(&g_string_pool, 0, sizeof(g_string_pool));
-    
-    pthread_mutex_unlock(&pool_mutex);
+    ensure_memory_pools();
+    slab_cache_clear(&g_process_cache);
+    slab_cache_clear(&g_string_cache);
 }
 
-// Get a process from the pool (fast, no malloc)
-Process* get_process_from_pool_fast(void) {
-    pthread_mutex_lock(&pool_mutex);
-    
-    // Find next available process
-    int start = g_process_pool.next_free;
-    for (int i = 0; i < POOL_SIZE; i++) {
-        int idx = (start + i) % POOL_SIZE;
-        if (!g_process_pool.used[idx]) {
-            g_process_pool.used[idx] = 1;
-            g_process_pool.next_free = (idx + 1) % POOL_SIZE;
-            g_process_pool.total_allocated++;
-            
-            // Clear the process structure
-            Process *proc = &g_process_pool.processes[idx];
-            memset(proc, 0, sizeof(Process));
-            
-            pthread_mutex_unlock(&pool_mutex);
-            return proc;
-        }
-    }
-    
-    pthread_mutex_unlock(&pool_mutex);
-    
-    // Pool is full, fallback to malloc
-    Process *proc = malloc(sizeof(Process));
-    if (proc) {
-        memset(proc, 0, sizeof(Process));
-    }
-    return proc;
+// Get a process from the pool (fast, no lock on the common path)
+ProcessSample* get_process_from_pool_fast(void) {
+    ensure_memory_pools();
+    return slab_alloc(&g_process_cache);
 }
 
 // Return a process to the pool
-void return_process_to_pool_fast(Process *proc) {
+void return_process_to_pool_fast(ProcessSample *proc) {
     if (!proc) return;
-    
-    pthread_mutex_lock(&pool_mutex);
-    
-    // Check if this process is from our pool
-    if (proc >= &g_process_pool.processes[0] && 
-        proc < &g_process_pool.processes[POOL_SIZE]) {
-        
-        int idx = proc - &g_process_pool.processes[0];
-        if (g_process_pool.used[idx]) {
-            g_process_pool.used[idx] = 0;
-            g_process_pool.total_allocated--;
-            
-            // Clear sensitive data
-            memset(proc, 0, sizeof(Process));
-        }
-    } else {
-        // This was a malloc'd process, free it
-        free(proc);
-    }
-    
-    pthread_mutex_unlock(&pool_mutex);
+    slab_free(&g_process_cache, proc);
 }
 
 // Reset the entire process pool
 void reset_process_pool(void) {
-    pthread_mutex_lock(&pool_mutex);
-    
-    memset(g_process_pool.used, 0, sizeof(g_process_pool.used));
-    g_process_pool.next_free = 0;
-    g_process_pool.total_allocated = 0;
-    
-    pthread_mutex_unlock(&pool_mutex);
+    ensure_memory_pools();
+    slab_cache_clear(&g_process_cache);
 }
 
 // Get a string buffer from the pool
 char* get_string_buffer_from_pool(void) {
-    pthread_mutex_lock(&pool_mutex);
-    
-    // Find next available buffer
-    int start = g_string_pool.next_free;
-    for (int i = 0; i < STRING_POOL_SIZE; i++) {
-        int idx = (start + i) % STRING_POOL_SIZE;
-        if (!g_string_pool.used[idx]) {
-            g_string_pool.used[idx] = 1;
-            g_string_pool.next_free = (idx + 1) % STRING_POOL_SIZE;
-            
-            // Clear the buffer
-            memset(g_string_pool.buffers[idx], 0, STRING_BUFFER_SIZE);
-            
-            pthread_mutex_unlock(&pool_mutex);
-            return g_string_pool.buffers[idx];
-        }
-    }
-    
-    pthread_mutex_unlock(&pool_mutex);
-    
-    // Pool is full, fallback to malloc
-    char *buffer = malloc(STRING_BUFFER_SIZE);
-    if (buffer) {
-        memset(buffer, 0, STRING_BUFFER_SIZE);
-    }
-    return buffer;
+    ensure_memory_pools();
+    return slab_alloc(&g_string_cache);
 }
 
 // Return a string buffer to the pool
 void return_string_buffer_to_pool(char *buffer) {
     if (!buffer) return;
-    
-    pthread_mutex_lock(&pool_mutex);
-    
-    // Check if this buffer is from our pool
-    for (int i = 0; i < STRING_POOL_SIZE; i++) {
-        if (buffer == g_string_pool.buffers[i]) {
-            if (g_string_pool.used[i]) {
-                g_string_pool.used[i] = 0;
-                // Clear the buffer for security
-                memset(buffer, 0, STRING_BUFFER_SIZE);
-            }
-            pthread_mutex_unlock(&pool_mutex);
-            return;
-        }
-    }
-    
-    // This was a malloc'd buffer, free it
-    free(buffer);
-    
-    pthread_mutex_unlock(&pool_mutex);
+    slab_free(&g_string_cache, buffer);
 }
 
 // Duplicate a string using the pool
@@ -167,7 +68,6 @@ char* duplicate_string_pooled(const char *src) {
     if (!src) return NULL;
     
     char *buffer = get_string_buffer_from_pool();
-    if (!buffer) return NULL;
     
     size_t len = strlen(src);
     if (len >= STRING_BUFFER_SIZE) {
@@ -180,33 +80,64 @@ char* duplicate_string_pooled(const char *src) {
     return buffer;
 }
 
-// Get memory pool usage statistics
+// Get memory pool usage statistics. "Used" is the slabs' outstanding count,
+// which includes free objects cached in thread magazines (up to
+// 2 * SLAB_MAGAZINE_SIZE per thread and pool): only the owning thread can
+// see those, so they cannot be subtracted here.
 int get_pool_usage_stats(int *process_used, int *string_used) {
-    pthread_mutex_lock(&pool_mutex);
+    SlabStats process_stats, string_stats;
+    get_memory_pool_stats(&process_stats, &string_stats);
     
     if (process_used) {
-        *process_used = g_process_pool.total_allocated;
+        *process_used = (int)process_stats.outstanding;
     }
-    
     if (string_used) {
-        int count = 0;
-        for (int i = 0; i < STRING_POOL_SIZE; i++) {
-            if (g_string_pool.used[i]) count++;
-        }
-        *string_used = count;
+        *string_used = (int)string_stats.outstanding;
     }
-    
-    pthread_mutex_unlock(&pool_mutex);
     return 0;
 }
 
+void get_memory_pool_stats(SlabStats *process_stats, SlabStats *string_stats) {
+    ensure_memory_pools();
+    slab_cache_get_stats(&g_process_cache, process_stats);
+    slab_cache_get_stats(&g_string_cache, string_stats);
+}
 
+static void print_slab_stats(const char *name, const SlabStats *stats) {
+    printf("%-8s %4llu slabs %7llu objects  %7llu held by threads  %7llu in depot  "
+           "%7llu exchanges (%llu contended)\n",
+           name, (unsigned long long)stats->slabs, (unsigned long long)stats->objects,
+           (unsigned long long)stats->outstanding, (unsigned long long)stats->depot_free,
+           (unsigned long long)stats->exchanges, (unsigned long long)stats->contended);
+}
+
+void print_memory_pool_stats(void) {
+    SlabStats process_stats, string_stats;
+    get_memory_pool_stats(&process_stats, &string_stats);
+    print_slab_stats("process", &process_stats);
+    print_slab_stats("string", &string_stats);
+
+    SampleArenaStats arena_stats;
+    sample_arena_get_stats(&arena_stats);
+    printf("%-8s %7llu samples  %5.1f%% reused  peak %zu bytes  last %zu bytes  %llu grown\n",
+           "arena", (unsigned long long)arena_stats.acquired,
+           arena_stats.acquired ? 100.0 * arena_stats.reused / arena_stats.acquired : 0.0,
+           arena_stats.peak_bytes, arena_stats.last_bytes,
+           (unsigned long long)arena_stats.grown);
+
+    StringInternStats intern_stats;
+    string_intern_get_stats(&intern_stats);
+    printf("%-8s %7u strings  %7u referenced  %5.1f%% hits  %llu evicted  %zu bytes\n",
+           "names", intern_stats.entries, intern_stats.referenced,
+           intern_stats.lookups ? 100.0 * intern_stats.hits / intern_stats.lookups : 0.0,
+           (unsigned long long)intern_stats.evicted, intern_stats.bytes);
+}
 
 // Bulk operations for efficiency
 void return_all_processes_to_pool(GList *process_list) {
     GList *current = process_list;
     while (current) {
-        Process *proc = (Process *)current->data;
+        ProcessSample *proc = (ProcessSample *)current->data;
         return_process_to_pool_fast(proc);
         current = current->next;
     }
@@ -216,13 +147,8 @@ void return_all_processes_to_pool(GList *process_list) {
 GList* allocate_process_list_from_pool(int count) {
     GList *list = NULL;
     
-    for (int i = 0; i < count && i < POOL_SIZE; i++) {
-        Process *proc = get_process_from_pool_fast();
-        if (proc) {
-            list = g_list_prepend(list, proc);
-        } else {
-            break; // Pool exhausted
-        }
+    for (int i = 0; i < count; i++) {
+        list = g_list_prepend(list, get_process_from_pool_fast());
     }
     
     return list;
@@ -2,45 +2,33 @@
 #define MEMORY_POOL_H
 
 #include "../common/types.h"
+#include "slab.h"
 #include <stdlib.h>
 #include <string.h>
 
-// Memory pool configuration
-#define POOL_SIZE 1024
-#define STRING_POOL_SIZE 4096
+// String buffer pool configuration
+#define STRING_POOL_SLAB 256        // Buffers per slab
 #define STRING_BUFFER_SIZE 256
 
-// Process memory pool
-typedef struct ProcessPool {
-    Process processes[POOL_SIZE];
-    int used[POOL_SIZE];
-    int next_free;
-    int total_allocated;
-} ProcessPool;
-
-// String buffer pool for temporary allocations
-typedef struct StringPool {
-    char buffers[STRING_POOL_SIZE][STRING_BUFFER_SIZE];
-    int used[STRING_POOL_SIZE];
-    int next_free;
-} StringPool;
-
-// Memory pool management functions
+// Memory pool management functions. The pools are slab caches (slab.h):
+// they grow as needed and are usable before init_memory_pools().
 int init_memory_pools(void);
-void cleanup_memory_pools(void);
+void cleanup_memory_pools(void);    // Releases all memory; outstanding objects become invalid
 
-// Process pool functions
-Process* get_process_from_pool_fast(void);
-void return_process_to_pool_fast(Process *proc);
-void reset_process_pool(void);
+// Process pool functions (zero-filled structs, never NULL)
+ProcessSample* get_process_from_pool_fast(void);
+void return_process_to_pool_fast(ProcessSample *proc);
+void reset_process_pool(void);      // Releases every process at once
 
 // String pool functions  
 char* get_string_buffer_from_pool(void);
 void return_string_buffer_to_pool(char *buffer);
 char* duplicate_string_pooled(const char *src);
 
-// Memory statistics
+// Memory statistics. "Used" counts objects held by threads, including the
+// free objects cached in their magazines.
 int get_pool_usage_stats(int *process_used, int *string_used);
+void get_memory_pool_stats(SlabStats *process_stats, SlabStats *string_stats);
 void print_memory_pool_stats(void);
 
 // Bulk operations
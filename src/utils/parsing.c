@@ -1,6 +1,7 @@
 #include "utils.h"
 #include <ctype.h>
 #include <math.h>
+#include <time.h>
 
 // Parse bytes string like "1234 B" or "5.6 MiB" to long long bytes
 long long parse_bytes(const char *str) {
@@ -21,14 +22,21 @@ long long parse_bytes(const char *str) {
 
 // Helper function to format bytes as human-readable strings (for rates)
 char* format_bytes_human_readable(long long bytes) {
+    char buf[32];
+    format_bytes_buf(bytes, buf, sizeof(buf));
+    return g_strdup(buf);
+}
+
+// Buffer variant of format_bytes_human_readable (no allocation)
+void format_bytes_buf(long long bytes, char *buf, size_t buf_size) {
     if (bytes < 1024) {
-        return g_strdup_printf("%lld B", bytes);
+        snprintf(buf, buf_size, "%lld B", bytes);
     } else if (bytes < 1024 * 1024) {
-        return g_strdup_printf("%.1f KB", bytes / 1024.0);
+        snprintf(buf, buf_size, "%.1f KB", bytes / 1024.0);
     } else if (bytes < 1024 * 1024 * 1024) {
-        return g_strdup_printf("%.1f MB", bytes / (1024.0 * 1024.0));
+        snprintf(buf, buf_size, "%.1f MB", bytes / (1024.0 * 1024.0));
     } else {
-        return g_strdup_printf("%.1f GB", bytes / (1024.0 * 1024.0 * 1024.0));
+        snprintf(buf, buf_size, "%.1f GB", bytes / (1024.0 * 1024.0 * 1024.0));
     }
 }
 
@@ -59,36 +67,45 @@ char* format_memory_human_readable(const char *mem_str) {
     if (!mem_str) return strdup("0 B");
     
     // Parse the memory value from top output (like "1024M", "512K", "2.5G")
-    long long bytes = parse_memory_string(mem_str);
-    
+    return format_memory_bytes_human_readable(parse_memory_string(mem_str));
+}
+
+// Format a byte count the same way as top-derived memory values
+char* format_memory_bytes_human_readable(long long bytes) {
     char *result = malloc(20);
+    if (!result) return NULL;
+    format_memory_bytes_buf(bytes, result, 20);
+    return result;
+}
+
+// Buffer variant used for lazy per-row formatting (no allocation)
+void format_memory_bytes_buf(long long bytes, char *result, size_t result_size) {
+    if (!result || result_size == 0) return;
     
     if (bytes >= 1024LL * 1024 * 1024) {
         // >= 1 GB: show as GB with 2 decimal places
         double gb = (double)bytes / (1024LL * 1024 * 1024);
         if (gb >= 10.0) {
-            sprintf(result, "%.1f GB", gb);  // 10.1 GB (1 decimal for large values)
+            snprintf(result, result_size, "%.1f GB", gb);  // 10.1 GB (1 decimal for large values)
         } else {
-            sprintf(result, "%.2f GB", gb);  // 1.25 GB (2 decimals for smaller GB values)
+            snprintf(result, result_size, "%.2f GB", gb);  // 1.25 GB (2 decimals for smaller GB values)
         }
     } else if (bytes >= 1024 * 1024) {
         // >= 1 MB: show as MB with 1 decimal place
         double mb = (double)bytes / (1024 * 1024);
         if (mb >= 100.0) {
-            sprintf(result, "%.0f MB", mb);  // 512 MB (no decimals for large MB values)
+            snprintf(result, result_size, "%.0f MB", mb);  // 512 MB (no decimals for large MB values)
         } else {
-            sprintf(result, "%.1f MB", mb);  // 64.5 MB (1 decimal for smaller MB values)
+            snprintf(result, result_size, "%.1f MB", mb);  // 64.5 MB (1 decimal for smaller MB values)
         }
     } else if (bytes >= 1024) {
         // >= 1 KB: show as KB with no decimals
         long kb = bytes / 1024;
-        sprintf(result, "%ld KB", kb);  // 512 KB
+        snprintf(result, result_size, "%ld KB", kb);  // 512 KB
     } else {
         // < 1 KB: show as bytes
-        sprintf(result, "%lld B", bytes);  // 256 B
+        snprintf(result, result_size, "%lld B", bytes);  // 256 B
     }
-    
-    return result;
 }
 
 // Parse run time string to seconds for sorting, e.g., "01:23:45" or "1-02:34:56"
@@ -112,3 +129,50 @@ long long parse_runtime_to_seconds(const char *str) {
     
     return (long long)days * 86400 + hours * 3600 + mins * 60 + secs;
 }
+
+// Format seconds in ps etime style ("[[dd-]hh:]mm:ss") so it round-trips
+// through parse_runtime_to_seconds
+void format_elapsed_time(long long seconds, char *buf, size_t buf_size) {
+    if (!buf || buf_size == 0) return;
+    if (seconds < 0) seconds = 0;
+
+    long long days = seconds / 86400;
+    int hours = (int)((seconds % 86400) / 3600);
+    int mins = (int)((seconds % 3600) / 60);
+    int secs = (int)(seconds % 60);
+
+    if (days > 0) {
+        snprintf(buf, buf_size, "%lld-%02d:%02d:%02d", days, hours, mins, secs);
+    } else if (hours > 0) {
+        snprintf(buf, buf_size, "%02d:%02d:%02d", hours, mins, secs);
+    } else {
+        snprintf(buf, buf_size, "%02d:%02d", mins, secs);
+    }
+}
+
+// Network throughput as shown in the Network column ("12.3 KB/s")
+void format_network_rate(guint64 bytes_per_sec, char *buf, size_t buf_size) {
+    if (!buf || buf_size == 0) return;
+    
+    double kbps = bytes_per_sec / 1024.0;
+    if (kbps > 0.1) {  // Only show rates above 0.1 KB/s
+        snprintf(buf, buf_size, "%.1f KB/s", kbps);
+    } else {
+        snprintf(buf, buf_size, "0.0 KB/s");
+    }
+}
+
+// Elapsed run time from a start timestamp ("N/A" when unknown)
+void format_process_runtime(gint64 start_time, char *buf, size_t buf_size) {
+    if (!buf || buf_size == 0) return;
+    
+    if (start_time <= 0) {
+        snprintf(buf, buf_size, "N/A");
+        return;
+    }
+    format_elapsed_time((long long)(time(NULL) - start_time), buf, buf_size);
+}
+
+const char* process_type_label(gboolean is_system) {
+    return is_system ? "🛡️ System" : "User";
+}
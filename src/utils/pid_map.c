@@ -0,0 +1,238 @@
+#include "pid_map.h"
+#include <string.h>
+
+#define PID_MAP_EMPTY ((gint32)-1)          // Never a real PID; kept in the spare slot
+#define PID_MAP_MIN_BITS 4
+
+struct PidMap {
+    gint32 *keys;                   // PID per slot, PID_MAP_EMPTY if free
+    guint8 *values;                 // value_size bytes per slot, plus the spare slot
+    gsize value_size;
+    guint mask;                     // Slot count - 1
+    guint shift;                    // 32 - log2(slot count)
+    guint count;                    // Entries in the slots
+    gboolean has_spare;             // Entry for PID_MAP_EMPTY stored after the slots
+};
+
+// Fibonacci hashing: the top bits of the product spread sequential PIDs
+static inline guint pid_home(const PidMap *map, gint32 pid) {
+    return (guint)(((guint32)pid * 2654435761u) >> map->shift);
+}
+
+static inline gpointer value_at(const PidMap *map, guint slot) {
+    return map->values + (gsize)slot * map->value_size;
+}
+
+static inline guint spare_slot(const PidMap *map) {
+    return map->mask + 1;
+}
+
+static void alloc_slots(PidMap *map, guint bits) {
+    guint slots = 1u << bits;
+    map->keys = g_new(gint32, slots);
+    memset(map->keys, 0xff, slots * sizeof(gint32));  // All PID_MAP_EMPTY
+    map->values = g_malloc0((gsize)(slots + 1) * map->value_size);
+    map->mask = slots - 1;
+    map->shift = 32 - bits;
+}
+
+// Slot holding pid, or the empty slot where it would be inserted
+static guint find_slot(const PidMap *map, gint32 pid) {
+    guint slot = pid_home(map, pid);
+    while (map->keys[slot] != PID_MAP_EMPTY && map->keys[slot] != pid) {
+        slot = (slot + 1) & map->mask;
+    }
+    return slot;
+}
+
+static void grow(PidMap *map) {
+    gint32 *old_keys = map->keys;
+    guint8 *old_values = map->values;
+    guint old_slots = map->mask + 1;
+    gsize size = map->value_size;
+
+    guint bits = 32 - map->shift + 1;
+    alloc_slots(map, bits);
+    for (guint i = 0; i < old_slots; i++) {
+        if (old_keys[i] == PID_MAP_EMPTY) continue;
+        guint slot = find_slot(map, old_keys[i]);
+        map->keys[slot] = old_keys[i];
+        memcpy(value_at(map, slot), old_values + (gsize)i * size, size);
+    }
+    memcpy(value_at(map, spare_slot(map)), old_values + (gsize)old_slots * size, size);
+    g_free(old_keys);
+    g_free(old_values);
+}
+
+PidMap* pid_map_new(gsize value_size, guint capacity_hint) {
+    PidMap *map = g_new0(PidMap, 1);
+    map->value_size = MAX(value_size, 1);
+
+    // Room for capacity_hint entries at half load
+    guint bits = PID_MAP_MIN_BITS;
+    while (bits < 30 && (1u << bits) < (guint64)capacity_hint * 2) bits++;
+    alloc_slots(map, bits);
+    return map;
+}
+
+void pid_map_free(PidMap *map) {
+    if (!map) return;
+    g_free(map->keys);
+    g_free(map->values);
+    g_free(map);
+}
+
+void pid_map_clear(PidMap *map) {
+    memset(map->keys, 0xff, (map->mask + 1) * sizeof(gint32));
+    map->count = 0;
+    map->has_spare = FALSE;
+}
+
+guint pid_map_size(const PidMap *map) {
+    return map->count + (map->has_spare ? 1 : 0);
+}
+
+gsize pid_map_bytes(const PidMap *map) {
+    gsize slots = map->mask + 1;
+    return slots * sizeof(gint32) + (slots + 1) * map->value_size;
+}
+
+guint pid_map_slots(const PidMap *map) {
+    return map->mask + 1;
+}
+
+gpointer pid_map_lookup(const PidMap *map, pid_t pid) {
+    if ((gint32)pid == PID_MAP_EMPTY) return map->has_spare ? value_at(map, spare_slot(map)) : NULL;
+
+    guint slot = find_slot(map, (gint32)pid);
+    return map->keys[slot] != PID_MAP_EMPTY ? value_at(map, slot) : NULL;
+}
+
+gpointer pid_map_insert(PidMap *map, pid_t pid) {
+    if ((gint32)pid == PID_MAP_EMPTY) {
+        gpointer value = value_at(map, spare_slot(map));
+        if (!map->has_spare) memset(value, 0, map->value_size);
+        map->has_spare = TRUE;
+        return value;
+    }
+
+    guint slot = find_slot(map, (gint32)pid);
+    if (map->keys[slot] == pid) return value_at(map, slot);
+
+    // Keep the slots at most half full
+    if ((map->count + 1) * 2 > map->mask + 1) {
+        grow(map);
+        slot = find_slot(map, (gint32)pid);
+    }
+    map->keys[slot] = (gint32)pid;
+    map->count++;
+    gpointer value = value_at(map, slot);
+    memset(value, 0, map->value_size);
+    return value;
+}
+
+// Empty slot, then move later members of its cluster back into the gap
+// unless that would put them before their home slot
+static void remove_slot(PidMap *map, guint slot) {
+    guint hole = slot;
+    guint next = (slot + 1) & map->mask;
+    while (map->keys[next] != PID_MAP_EMPTY) {
+        guint home = pid_home(map, map->keys[next]);
+        if (((next - home) & map->mask) >= ((next - hole) & map->mask)) {
+            map->keys[hole] = map->keys[next];
+            memcpy(value_at(map, hole), value_at(map, next), map->value_size);
+            hole = next;
+        }
+        next = (next + 1) & map->mask;
+    }
+    map->keys[hole] = PID_MAP_EMPTY;
+    map->count--;
+}
+
+gboolean pid_map_remove(PidMap *map, pid_t pid) {
+    if ((gint32)pid == PID_MAP_EMPTY) {
+        gboolean had = map->has_spare;
+        map->has_spare = FALSE;
+        return had;
+    }
+
+    guint slot = find_slot(map, (gint32)pid);
+    if (map->keys[slot] == PID_MAP_EMPTY) return FALSE;
+    remove_slot(map, slot);
+    return TRUE;
+}
+
+guint pid_map_remove_if(PidMap *map, PidMapPredicate predicate, gpointer user_data) {
+    guint removed = 0;
+
+    if (map->has_spare && predicate(PID_MAP_EMPTY, value_at(map, spare_slot(map)), user_data)) {
+        map->has_spare = FALSE;
+        removed++;
+    }
+    if (map->count == 0) return removed;
+
+    // Start the walk at an empty slot (one exists at half load): no cluster
+    // wraps past it, so entries shifted back by a removal land on the
+    // current slot or ahead of it and each entry is visited exactly once
+    guint slots = map->mask + 1;
+    guint slot = 0;
+    while (map->keys[slot] != PID_MAP_EMPTY) slot++;
+
+    for (guint visited = 0; visited < slots;) {
+        if (map->keys[slot] != PID_MAP_EMPTY &&
+            predicate(map->keys[slot], value_at(map, slot), user_data)) {
+            remove_slot(map, slot);
+            removed++;
+            continue;  // Look at whatever moved into the slot
+        }
+        slot = (slot + 1) & map->mask;
+        visited++;
+    }
+    return removed;
+}
+
+guint pid_map_sweep(PidMap *map, guint *cursor, guint slot_budget,
+                    PidMapPredicate predicate, gpointer user_data) {
+    guint removed = 0;
+
+    if (map->has_spare && predicate(PID_MAP_EMPTY, value_at(map, spare_slot(map)), user_data)) {
+        map->has_spare = FALSE;
+        removed++;
+    }
+
+    // Entries shifted back by a removal land on the current slot or ahead
+    // of it, never on one already visited
+    guint slot = *cursor & map->mask;
+    for (guint visited = 0; visited < slot_budget && map->count > 0;) {
+        if (map->keys[slot] != PID_MAP_EMPTY &&
+            predicate(map->keys[slot], value_at(map, slot), user_data)) {
+            remove_slot(map, slot);
+            removed++;
+            continue;
+        }
+        slot = (slot + 1) & map->mask;
+        visited++;
+    }
+    *cursor = slot;
+    return removed;
+}
+
+gboolean pid_map_iter_next(const PidMap *map, guint *iter, pid_t *pid, gpointer *value) {
+    guint slots = map->mask + 1;
+    while (*iter < slots) {
+        guint slot = (*iter)++;
+        if (map->keys[slot] == PID_MAP_EMPTY) continue;
+        if (pid) *pid = map->keys[slot];
+        if (value) *value = value_at(map, slot);
+        return TRUE;
+    }
+    if (*iter == slots) {
+        (*iter)++;
+        if (map->has_spare) {
+            if (pid) *pid = PID_MAP_EMPTY;
+            if (value) *value = value_at(map, spare_slot(map));
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
@@ -0,0 +1,66 @@
+#ifndef PID_MAP_H
+#define PID_MAP_H
+
+#include <glib.h>
+#include <sys/types.h>
+
+// Map from PID to a fixed-size value stored inline. Replaces GHashTables
+// keyed by g_strdup'd PID strings (or GINT_TO_POINTER) with g_malloc'd
+// values: one key array and one value array, no allocation per entry.
+//
+//     PidMap *rates = pid_map_new(sizeof(double), 0);
+//     *(double*)pid_map_insert(rates, pid) = 1024.0;
+//     double *rate = pid_map_lookup(rates, pid);     // NULL if absent
+//
+// Value pointers returned by insert/lookup are invalidated by the next
+// insert or remove. Not thread safe; callers lock as they did for their
+// hash tables.
+//
+// OPTIMIZATION: Open addressing with linear probing over Fibonacci-hashed
+// PIDs, kept at most half full. Removal shifts the rest of the cluster
+// back instead of leaving tombstones, so lookups never slow down over time.
+
+typedef struct PidMap PidMap;
+
+// Visitor for pid_map_remove_if(); TRUE removes the entry
+typedef gboolean (*PidMapPredicate)(pid_t pid, gpointer value, gpointer user_data);
+
+PidMap* pid_map_new(gsize value_size, guint capacity_hint);
+void pid_map_free(PidMap *map);
+
+// Remove all entries but keep the allocated storage
+void pid_map_clear(PidMap *map);
+
+guint pid_map_size(const PidMap *map);
+
+// Memory held by the key and value arrays
+gsize pid_map_bytes(const PidMap *map);
+
+// Slots in the table; sweeping this many covers the whole map
+guint pid_map_slots(const PidMap *map);
+
+// Value stored for pid, or NULL
+gpointer pid_map_lookup(const PidMap *map, pid_t pid);
+
+// Value slot for pid: the stored one, or a new zeroed one
+gpointer pid_map_insert(PidMap *map, pid_t pid);
+
+// TRUE if pid was present
+gboolean pid_map_remove(PidMap *map, pid_t pid);
+
+// Remove every entry the predicate accepts; returns the number removed.
+// The predicate sees each entry once and must not modify the map.
+guint pid_map_remove_if(PidMap *map, PidMapPredicate predicate, gpointer user_data);
+
+// Incremental remove_if: look at up to slot_budget slots starting at
+// *cursor (0 at first) and leave *cursor where the next call resumes.
+// Repeated calls cover the whole map; removal keeps already-visited
+// entries in place, so none is skipped.
+guint pid_map_sweep(PidMap *map, guint *cursor, guint slot_budget,
+                    PidMapPredicate predicate, gpointer user_data);
+
+// Walk the entries in no particular order. Start with *iter = 0; the map
+// must not change during the walk.
+gboolean pid_map_iter_next(const PidMap *map, guint *iter, pid_t *pid, gpointer *value);
+
+#endif // PID_MAP_H
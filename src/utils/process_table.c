@@ -0,0 +1,172 @@
+#include "process_table.h"
+#include "string_intern.h"
+#include <string.h>
+
+#define PROCESS_TABLE_MIN_CAPACITY 256
+#define PROCESS_TABLE_RECYCLE_MAX 4   // Tables kept for reuse (in flight + spare)
+
+// Released tables waiting to be reused, protected by recycle_mutex
+static ProcessTable *recycled_tables[PROCESS_TABLE_RECYCLE_MAX];
+static int recycled_count = 0;
+static GMutex recycle_mutex;
+
+const char* process_name(const ProcessSample *proc) {
+    return string_intern_text(proc->name_id);
+}
+
+void process_set_name(ProcessSample *proc, const char *name, gssize len) {
+    proc->name_id = string_intern(name, len);
+}
+
+// Fibonacci hashing spreads sequential PIDs across the slots
+static inline guint pid_slot(pid_t pid, guint mask) {
+    return ((guint32)pid * 2654435761u) & mask;
+}
+
+static void rebuild_index(ProcessTable *table, guint slot_count) {
+    g_free(table->index);
+    table->index = g_new(gint32, slot_count);
+    table->index_mask = slot_count - 1;
+    memset(table->index, 0xff, slot_count * sizeof(gint32));  // All -1
+
+    for (guint i = 0; i < table->count; i++) {
+        guint slot = pid_slot(table->items[i].pid, table->index_mask);
+        while (table->index[slot] >= 0) {
+            slot = (slot + 1) & table->index_mask;
+        }
+        table->index[slot] = (gint32)i;
+    }
+}
+
+// Make room for one more row; keeps the index at most half full
+static void ensure_capacity(ProcessTable *table) {
+    if (table->count < table->capacity) return;
+
+    guint new_capacity = table->capacity ? table->capacity * 2 : PROCESS_TABLE_MIN_CAPACITY;
+    table->items = g_renew(ProcessSample, table->items, new_capacity);
+    table->capacity = new_capacity;
+    rebuild_index(table, new_capacity * 2);
+}
+
+ProcessTable* process_table_new(guint capacity_hint) {
+    ProcessTable *table = g_new0(ProcessTable, 1);
+
+    guint capacity = PROCESS_TABLE_MIN_CAPACITY;
+    while (capacity < capacity_hint) capacity *= 2;
+
+    table->items = g_new(ProcessSample, capacity);
+    table->capacity = capacity;
+    rebuild_index(table, capacity * 2);
+    return table;
+}
+
+void process_table_free(ProcessTable *table) {
+    if (!table) return;
+    process_table_clear(table);
+    g_free(table->items);
+    g_free(table->index);
+    g_free(table);
+}
+
+void process_table_clear(ProcessTable *table) {
+    if (!table) return;
+    for (guint i = 0; i < table->count; i++) {
+        string_intern_unref(table->items[i].name_id);
+    }
+    table->count = 0;
+    memset(table->index, 0xff, (table->index_mask + 1) * sizeof(gint32));
+}
+
+// Slot holding pid, or the empty slot where it would be inserted
+static guint find_slot(const ProcessTable *table, pid_t pid) {
+    guint slot = pid_slot(pid, table->index_mask);
+    while (table->index[slot] >= 0 && table->items[table->index[slot]].pid != pid) {
+        slot = (slot + 1) & table->index_mask;
+    }
+    return slot;
+}
+
+ProcessSample* process_table_add(ProcessTable *table, const ProcessSample *sample) {
+    if (!table || !sample) return NULL;
+
+    guint slot = find_slot(table, sample->pid);
+    if (table->index[slot] >= 0) {
+        ProcessSample *existing = &table->items[table->index[slot]];
+        guint32 old_name = existing->name_id;
+        *existing = *sample;
+        string_intern_ref(existing->name_id);
+        string_intern_unref(old_name);
+        return existing;
+    }
+
+    if (table->count >= table->capacity) {
+        ensure_capacity(table);
+        slot = find_slot(table, sample->pid);
+    }
+
+    ProcessSample *row = &table->items[table->count];
+    *row = *sample;
+    string_intern_ref(row->name_id);
+    table->index[slot] = (gint32)table->count;
+    table->count++;
+    return row;
+}
+
+ProcessSample* process_table_lookup(const ProcessTable *table, pid_t pid) {
+    if (!table || table->count == 0) return NULL;
+
+    guint slot = find_slot(table, pid);
+    return table->index[slot] >= 0 ? &table->items[table->index[slot]] : NULL;
+}
+
+ProcessTable* process_table_copy(const ProcessTable *table) {
+    if (!table) return NULL;
+
+    ProcessTable *copy = g_new0(ProcessTable, 1);
+    copy->items = g_new(ProcessSample, table->capacity);
+    memcpy(copy->items, table->items, table->count * sizeof(ProcessSample));
+    for (guint i = 0; i < table->count; i++) {
+        string_intern_ref(copy->items[i].name_id);
+    }
+    copy->count = table->count;
+    copy->capacity = table->capacity;
+    copy->index = g_new(gint32, table->index_mask + 1);
+    memcpy(copy->index, table->index, (table->index_mask + 1) * sizeof(gint32));
+    copy->index_mask = table->index_mask;
+    return copy;
+}
+
+ProcessTable* process_table_acquire(void) {
+    ProcessTable *table = NULL;
+
+    g_mutex_lock(&recycle_mutex);
+    if (recycled_count > 0) {
+        table = recycled_tables[--recycled_count];
+    }
+    g_mutex_unlock(&recycle_mutex);
+
+    return table ? table : process_table_new(0);
+}
+
+void process_table_release(ProcessTable *table) {
+    if (!table) return;
+
+    process_table_clear(table);
+
+    g_mutex_lock(&recycle_mutex);
+    if (recycled_count < PROCESS_TABLE_RECYCLE_MAX) {
+        recycled_tables[recycled_count++] = table;
+        table = NULL;
+    }
+    g_mutex_unlock(&recycle_mutex);
+
+    process_table_free(table);  // Recycler full
+}
+
+void process_table_recycler_cleanup(void) {
+    g_mutex_lock(&recycle_mutex);
+    while (recycled_count > 0) {
+        process_table_free(recycled_tables[--recycled_count]);
+    }
+    g_mutex_unlock(&recycle_mutex);
+}
@@ -0,0 +1,48 @@
+#ifndef PROCESS_TABLE_H
+#define PROCESS_TABLE_H
+
+#include <glib.h>
+#include "../common/types.h"
+
+// Contiguous process table. Rows live in one array and are walked by index:
+//
+//     for (guint i = 0; i < table->count; i++) {
+//         ProcessSample *proc = &table->items[i];
+//     }
+//
+// Pointers returned by add/lookup are invalidated by the next add.
+//
+// Rows hold a reference on their interned name, so names stay valid for as
+// long as the table (and any snapshot carrying it) lives. Change a stored
+// row's name only by adding the sample again.
+
+// Interned name of a sample, "" if it has none
+const char* process_name(const ProcessSample *proc);
+
+// Intern the first len bytes of name (len < 0: all of it) as proc's name.
+// Samples outside a table borrow the ID (see utils/string_intern.h).
+void process_set_name(ProcessSample *proc, const char *name, gssize len);
+
+ProcessTable* process_table_new(guint capacity_hint);
+void process_table_free(ProcessTable *table);
+
+// Remove all rows but keep the allocated storage
+void process_table_clear(ProcessTable *table);
+
+// Copy sample into the table. A PID that is already present is overwritten,
+// so each PID appears at most once. Returns the stored row.
+ProcessSample* process_table_add(ProcessTable *table, const ProcessSample *sample);
+
+// Row for pid, or NULL
+ProcessSample* process_table_lookup(const ProcessTable *table, pid_t pid);
+
+// Independent copy with the same rows and order
+ProcessTable* process_table_copy(const ProcessTable *table);
+
+// OPTIMIZATION: Recycled tables for per-cycle snapshots. acquire() returns an
+// empty table, reusing the storage of a previously released one if possible.
+ProcessTable* process_table_acquire(void);
+void process_table_release(ProcessTable *table);
+void process_table_recycler_cleanup(void);
+
+#endif // PROCESS_TABLE_H
@@ -0,0 +1,104 @@
+#include "rate_store.h"
+#include "pid_map.h"
+#include "../common/config.h"
+#include <string.h>
+
+typedef struct {
+    guint64 start_time;             // Process behind the PID when the entry was made
+    guint32 epoch;                  // Cycle of the last update
+    guint32 valid;                  // Bit per counter holding a sample
+    guint64 value[RATE_COUNTER_COUNT];
+    gint64 sample_us[RATE_COUNTER_COUNT];
+} RateEntry;
+
+struct RateStore {
+    PidMap *entries;                // PID -> RateEntry
+    guint max_entries;
+    guint32 epoch;
+    guint sweep_cursor;
+    gboolean swept_full;            // Full sweep already tried this cycle
+    guint64 evicted;
+    guint64 rejected;
+};
+
+RateStore* rate_store_new(guint max_entries) {
+    RateStore *store = g_new0(RateStore, 1);
+    store->entries = pid_map_new(sizeof(RateEntry), 0);
+    store->max_entries = max_entries > 0 ? max_entries : RATE_STORE_MAX_ENTRIES;
+    return store;
+}
+
+void rate_store_free(RateStore *store) {
+    if (!store) return;
+    pid_map_free(store->entries);
+    g_free(store);
+}
+
+static gboolean entry_is_stale(pid_t pid, gpointer value, gpointer user_data) {
+    (void)pid;
+    const RateStore *store = user_data;
+    const RateEntry *entry = value;
+    return store->epoch - entry->epoch > RATE_STORE_STALE_CYCLES;
+}
+
+// Entry for a PID not in the store yet, NULL if the store is full
+static RateEntry* entry_add(RateStore *store, pid_t pid) {
+    if (pid_map_size(store->entries) >= store->max_entries && !store->swept_full) {
+        // Make room from the whole store at once, at most once per cycle
+        store->evicted += pid_map_remove_if(store->entries, entry_is_stale, store);
+        store->swept_full = TRUE;
+    }
+    if (pid_map_size(store->entries) >= store->max_entries) {
+        store->rejected++;
+        return NULL;  // SECURITY: No rate for this process rather than unbounded growth
+    }
+    return pid_map_insert(store->entries, pid);
+}
+
+gboolean rate_store_update(RateStore *store, pid_t pid, guint64 start_time,
+                           RateCounter counter, guint64 value, gint64 now_us,
+                           RateDelta *delta) {
+    RateEntry *entry = pid_map_lookup(store->entries, pid);
+    if (!entry) {
+        entry = entry_add(store, pid);
+        if (!entry) return FALSE;
+        entry->start_time = start_time;
+    } else if (entry->start_time != start_time) {
+        // The PID now belongs to another process
+        memset(entry, 0, sizeof(*entry));
+        entry->start_time = start_time;
+    }
+    entry->epoch = store->epoch;
+
+    guint32 bit = 1u << counter;
+    gboolean have_previous = (entry->valid & bit) != 0;
+    if (have_previous && delta) {
+        delta->increase = value > entry->value[counter] ? value - entry->value[counter] : 0;
+        delta->seconds = (now_us - entry->sample_us[counter]) / 1e6;
+    }
+    entry->value[counter] = value;
+    entry->sample_us[counter] = now_us;
+    entry->valid |= bit;
+    return have_previous;
+}
+
+guint rate_store_advance(RateStore *store) {
+    store->epoch++;
+    store->swept_full = FALSE;
+
+    // OPTIMIZATION: A slice of the map per cycle instead of a full walk.
+    // Sized by slots, not entries, so a pass takes as long after a mass exit.
+    guint slots = pid_map_slots(store->entries);
+    guint budget = MAX(RATE_STORE_SWEEP_SLOTS, (slots + RATE_STORE_SWEEP_CYCLES - 1) / RATE_STORE_SWEEP_CYCLES);
+    guint evicted = pid_map_sweep(store->entries, &store->sweep_cursor, budget, entry_is_stale, store);
+    store->evicted += evicted;
+    return evicted;
+}
+
+void rate_store_get_stats(const RateStore *store, RateStoreStats *stats) {
+    if (!stats) return;
+    stats->entries = pid_map_size(store->entries);
+    stats->evicted = store->evicted;
+    stats->rejected = store->rejected;
+    stats->bytes = sizeof(*store) + pid_map_bytes(store->entries);
+}
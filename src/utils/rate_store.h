@@ -0,0 +1,70 @@
+#ifndef RATE_STORE_H
+#define RATE_STORE_H
+
+#include <glib.h>
+#include <sys/types.h>
+
+// Last cumulative counters of each process, for turning two samples into
+// a rate. Entries are keyed by PID and carry the process start time, so a
+// reused PID starts over instead of diffing against its predecessor.
+//
+// Each entry is tagged with the cycle that last updated it. Every
+// rate_store_advance() sweeps part of the store and drops entries that
+// were not updated for RATE_STORE_STALE_CYCLES cycles; a full pass takes
+// RATE_STORE_SWEEP_CYCLES. A process that exited is forgotten at most
+// RATE_STORE_STALE_CYCLES + RATE_STORE_SWEEP_CYCLES advances after its
+// last update (the pass restarts if the store grows meanwhile).
+// The store never holds more than its max_entries; past that, new
+// processes get no rate until space frees up.
+//
+//     RateDelta delta;
+//     if (rate_store_update(store, pid, start_time, RATE_COUNTER_NET_BYTES,
+//                           bytes, now_us, &delta) && delta.seconds > 0.3) {
+//         rate = delta.increase / delta.seconds;
+//     }
+//     ...
+//     rate_store_advance(store);      // Once per collection cycle
+//
+// Not thread safe; callers lock as for any per-collector state.
+
+// Counters tracked per process. Each is sampled on its own schedule.
+typedef enum {
+    RATE_COUNTER_CPU_TICKS,         // utime + stime (cpu_accounting)
+    RATE_COUNTER_NET_BYTES,         // Bytes in + out (nettop)
+    RATE_COUNTER_COUNT
+} RateCounter;
+
+// Change of a counter between two samples
+typedef struct {
+    guint64 increase;               // 0 if the counter went backwards
+    double seconds;                 // Time between the samples
+} RateDelta;
+
+typedef struct {
+    guint entries;                  // Processes tracked now
+    guint64 evicted;                // Dropped by the sweep as stale
+    guint64 rejected;               // Updates refused because the store was full
+    gsize bytes;                    // Memory held by the store
+} RateStoreStats;
+
+typedef struct RateStore RateStore;
+
+// max_entries 0: RATE_STORE_MAX_ENTRIES
+RateStore* rate_store_new(guint max_entries);
+void rate_store_free(RateStore *store);
+
+// Record a cumulative counter of (pid, start_time) sampled at now_us.
+// Returns TRUE with the change since the previous sample of the same
+// counter, FALSE if there is none: a new process, a reused PID, or a
+// full store.
+gboolean rate_store_update(RateStore *store, pid_t pid, guint64 start_time,
+                           RateCounter counter, guint64 value, gint64 now_us,
+                           RateDelta *delta);
+
+// End a collection cycle and sweep part of the store. Returns the number
+// of stale entries dropped.
+guint rate_store_advance(RateStore *store);
+
+void rate_store_get_stats(const RateStore *store, RateStoreStats *stats);
+
+#endif // RATE_STORE_H
@@ -0,0 +1,144 @@
+#include "sample_arena.h"
+#include <string.h>
+
+#define SAMPLE_ARENA_CHUNK 4096             // First chunk of a new arena
+#define SAMPLE_ARENA_RECYCLE_MAX 4          // Arenas kept for reuse (in flight + spare)
+#define SAMPLE_ARENA_ALIGN (2 * sizeof(gpointer))
+
+// Header is four words, so data[] keeps the allocator's alignment
+typedef struct ArenaChunk {
+    struct ArenaChunk *next;    // Older, full chunk
+    gsize size;
+    gsize used;
+    gsize reserved;
+    char data[];
+} ArenaChunk;
+
+struct SampleArena {
+    ArenaChunk *chunks;         // Current chunk first
+    gsize used;                 // Bytes handed out across all chunks
+};
+
+// Released arenas waiting to be reused, protected by recycle_mutex
+static SampleArena *recycled_arenas[SAMPLE_ARENA_RECYCLE_MAX];
+static int recycled_count = 0;
+static SampleArenaStats arena_stats;
+static GMutex recycle_mutex;
+
+static ArenaChunk* chunk_new(gsize size) {
+    ArenaChunk *chunk = g_malloc(sizeof(ArenaChunk) + size);
+    chunk->next = NULL;
+    chunk->size = size;
+    chunk->used = 0;
+    return chunk;
+}
+
+SampleArena* sample_arena_acquire(void) {
+    SampleArena *arena = NULL;
+
+    g_mutex_lock(&recycle_mutex);
+    arena_stats.acquired++;
+    if (recycled_count > 0) {
+        arena = recycled_arenas[--recycled_count];
+        arena_stats.reused++;
+    }
+    g_mutex_unlock(&recycle_mutex);
+
+    if (!arena) {
+        arena = g_new0(SampleArena, 1);
+        arena->chunks = chunk_new(SAMPLE_ARENA_CHUNK);
+    }
+    return arena;
+}
+
+static void arena_free(SampleArena *arena) {
+    while (arena->chunks) {
+        ArenaChunk *next = arena->chunks->next;
+        g_free(arena->chunks);
+        arena->chunks = next;
+    }
+    g_free(arena);
+}
+
+void sample_arena_release(SampleArena *arena) {
+    if (!arena) return;
+
+    gsize used = arena->used;
+    gboolean grown = arena->chunks->next != NULL;
+    if (grown) {
+        // Next time the whole sample fits in the first chunk
+        gsize size = arena->chunks->size;
+        while (size < used) size *= 2;
+        while (arena->chunks) {
+            ArenaChunk *next = arena->chunks->next;
+            g_free(arena->chunks);
+            arena->chunks = next;
+        }
+        arena->chunks = chunk_new(size);
+    }
+    arena->chunks->used = 0;
+    arena->used = 0;
+
+    g_mutex_lock(&recycle_mutex);
+    arena_stats.last_bytes = used;
+    arena_stats.peak_bytes = MAX(arena_stats.peak_bytes, used);
+    if (grown) arena_stats.grown++;
+    if (recycled_count < SAMPLE_ARENA_RECYCLE_MAX) {
+        recycled_arenas[recycled_count++] = arena;
+        arena = NULL;
+    }
+    g_mutex_unlock(&recycle_mutex);
+
+    if (arena) arena_free(arena);  // Recycler full
+}
+
+void sample_arena_recycler_cleanup(void) {
+    g_mutex_lock(&recycle_mutex);
+    while (recycled_count > 0) {
+        arena_free(recycled_arenas[--recycled_count]);
+    }
+    g_mutex_unlock(&recycle_mutex);
+}
+
+static gpointer arena_bump(SampleArena *arena, gsize size) {
+    size = (size + SAMPLE_ARENA_ALIGN - 1) & ~(gsize)(SAMPLE_ARENA_ALIGN - 1);
+
+    ArenaChunk *chunk = arena->chunks;
+    if (chunk->size - chunk->used < size) {
+        chunk = chunk_new(MAX(chunk->size * 2, size));
+        chunk->next = arena->chunks;
+        arena->chunks = chunk;
+    }
+
+    gpointer memory = chunk->data + chunk->used;
+    chunk->used += size;
+    arena->used += size;
+    return memory;
+}
+
+gpointer sample_arena_alloc(SampleArena *arena, gsize size) {
+    gpointer memory = arena_bump(arena, size);
+    memset(memory, 0, size);
+    return memory;
+}
+
+char* sample_arena_strndup(SampleArena *arena, const char *text, gssize len) {
+    if (!text) return NULL;
+
+    gsize length = len < 0 ? strlen(text) : strnlen(text, (gsize)len);
+    char *copy = arena_bump(arena, length + 1);
+    memcpy(copy, text, length);
+    copy[length] = '\0';
+    return copy;
+}
+
+gsize sample_arena_used(const SampleArena *arena) {
+    return arena ? arena->used : 0;
+}
+
+void sample_arena_get_stats(SampleArenaStats *stats) {
+    if (!stats) return;
+    g_mutex_lock(&recycle_mutex);
+    *stats = arena_stats;
+    g_mutex_unlock(&recycle_mutex);
+}
@@ -0,0 +1,39 @@
+#ifndef SAMPLE_ARENA_H
+#define SAMPLE_ARENA_H
+
+#include <glib.h>
+
+// Bump-pointer arena for the small allocations of one collection sample
+// (the UpdateData, its strings, the snapshot wrapping it). Allocation is a
+// pointer increment; nothing is freed individually - releasing the arena
+// frees the whole sample at once.
+//
+// OPTIMIZATION: Released arenas are recycled. An arena that needed more
+// than its first chunk comes back as one chunk large enough for the whole
+// sample, so steady-state cycles allocate nothing from the heap.
+typedef struct SampleArena SampleArena;
+
+typedef struct {
+    guint64 acquired;           // sample_arena_acquire() calls
+    guint64 reused;             // ... served from the recycler
+    gsize peak_bytes;           // Most bytes one arena has held
+    gsize last_bytes;           // Bytes held by the last released arena
+    guint64 grown;              // Releases that had to coalesce extra chunks
+} SampleArenaStats;
+
+// Empty arena, recycled if possible. Release with sample_arena_release().
+SampleArena* sample_arena_acquire(void);
+void sample_arena_release(SampleArena *arena);
+void sample_arena_recycler_cleanup(void);
+
+// Zero-filled, aligned for any type; valid until the arena is released
+gpointer sample_arena_alloc(SampleArena *arena, gsize size);
+
+// NUL-terminated copy of the first len bytes of text (len < 0: all of it)
+char* sample_arena_strndup(SampleArena *arena, const char *text, gssize len);
+
+gsize sample_arena_used(const SampleArena *arena);
+
+void sample_arena_get_stats(SampleArenaStats *stats);
+
+#endif // SAMPLE_ARENA_H
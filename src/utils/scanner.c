@@ -0,0 +1,295 @@
+#define _GNU_SOURCE
+#include "scanner.h"
+#include <errno.h>
+#include <unistd.h>
+
+#define SCANNER_MIN_CAPACITY 4096
+#define SCANNER_MIN_READ 4096           // Free space guaranteed before each read()
+#define SCANNER_MAX_LINE (64 * 1024)    // SECURITY: Longer lines are returned in pieces
+
+// ---- String views ----
+
+gboolean str_view_equal(StrView view, const char *str) {
+    gsize len = strlen(str);
+    return view.len == len && memcmp(view.ptr, str, len) == 0;
+}
+
+gboolean str_view_has_prefix(StrView view, const char *prefix) {
+    gsize len = strlen(prefix);
+    return view.len >= len && memcmp(view.ptr, prefix, len) == 0;
+}
+
+gboolean str_view_contains(StrView view, const char *needle) {
+    gsize len = strlen(needle);
+    if (len == 0) return TRUE;
+
+    const char *pos = view.ptr;
+    const char *last = view.ptr + view.len;
+    while ((gsize)(last - pos) >= len) {
+        pos = memchr(pos, needle[0], (gsize)(last - pos) - len + 1);
+        if (!pos) return FALSE;
+        if (memcmp(pos, needle, len) == 0) return TRUE;
+        pos++;
+    }
+    return FALSE;
+}
+
+static inline gboolean is_blank(char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+StrView str_view_trim(StrView view) {
+    while (view.len > 0 && is_blank(view.ptr[0])) {
+        view.ptr++;
+        view.len--;
+    }
+    while (view.len > 0 && is_blank(view.ptr[view.len - 1])) view.len--;
+    return view;
+}
+
+void str_view_copy(StrView view, char *dest, gsize dest_size) {
+    if (!dest || dest_size == 0) return;
+    gsize len = MIN(view.len, dest_size - 1);
+    memcpy(dest, view.ptr, len);
+    dest[len] = '\0';
+}
+
+guint str_view_split_fields(StrView line, StrView *fields, guint max_fields) {
+    const char *pos = line.ptr;
+    const char *end = line.ptr + line.len;
+    guint count = 0;
+
+    while (count < max_fields) {
+        while (pos < end && is_blank(*pos)) pos++;
+        if (pos == end) break;
+
+        const char *start = pos;
+        while (pos < end && !is_blank(*pos)) pos++;
+        fields[count].ptr = start;
+        fields[count].len = (gsize)(pos - start);
+        count++;
+    }
+    return count;
+}
+
+guint str_view_split(StrView line, char separator, StrView *fields, guint max_fields) {
+    const char *pos = line.ptr;
+    const char *end = line.ptr + line.len;
+    guint count = 0;
+
+    while (count < max_fields) {
+        const char *sep = count + 1 < max_fields ? memchr(pos, separator, (gsize)(end - pos)) : NULL;
+        fields[count].ptr = pos;
+        fields[count].len = (gsize)((sep ? sep : end) - pos);
+        count++;
+        if (!sep) break;
+        pos = sep + 1;
+    }
+    return count;
+}
+
+// ---- Numbers ----
+
+gboolean str_view_to_int64(StrView view, gint64 *value) {
+    const char *pos = view.ptr;
+    const char *end = view.ptr + view.len;
+    gboolean negative = FALSE;
+
+    if (pos < end && (*pos == '+' || *pos == '-')) negative = *pos++ == '-';
+    if (pos == end) return FALSE;
+
+    guint64 result = 0;
+    for (; pos < end; pos++) {
+        unsigned digit = (unsigned)(*pos - '0');
+        if (digit > 9) return FALSE;
+        if (result > ((guint64)G_MAXINT64 - digit) / 10) return FALSE;  // Overflow
+        result = result * 10 + digit;
+    }
+
+    *value = negative ? -(gint64)result : (gint64)result;
+    return TRUE;
+}
+
+// Exact powers of ten representable as doubles
+static const double pow10_table[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+gboolean str_view_to_double(StrView view, double *value) {
+    const char *pos = view.ptr;
+    const char *end = view.ptr + view.len;
+    gboolean negative = FALSE;
+
+    if (pos < end && (*pos == '+' || *pos == '-')) negative = *pos++ == '-';
+
+    guint64 mantissa = 0;
+    int digits = 0, significant = 0, fraction = 0;
+    gboolean seen_point = FALSE;
+    for (; pos < end; pos++) {
+        if (*pos == '.' && !seen_point) {
+            seen_point = TRUE;
+            continue;
+        }
+        unsigned digit = (unsigned)(*pos - '0');
+        if (digit > 9) return FALSE;
+        digits++;
+        if (seen_point) fraction++;
+        if (mantissa == 0 && digit == 0) continue;  // Leading zeros are free
+        if (++significant > 19) break;
+        mantissa = mantissa * 10 + digit;
+    }
+    if (digits == 0) return FALSE;
+
+    // OPTIMIZATION: With at most 15 significant digits the mantissa and the
+    // power of ten are exact doubles, so one division is correctly rounded
+    // (the same result as strtod)
+    if (significant <= 15 && fraction <= 22) {
+        double result = (double)mantissa / pow10_table[fraction];
+        *value = negative ? -result : result;
+        return TRUE;
+    }
+
+    // Rare long numbers: let the C library do it on a copy
+    char copy[64];
+    if (view.len >= sizeof(copy)) return FALSE;
+    str_view_copy(view, copy, sizeof(copy));
+    char *parsed_end = NULL;
+    *value = g_ascii_strtod(copy, &parsed_end);
+    return parsed_end == copy + view.len;
+}
+
+gboolean str_view_to_size(StrView view, guint64 *bytes) {
+    view = str_view_trim(view);
+    if (view.len > 0 && (view.ptr[view.len - 1] == '+' || view.ptr[view.len - 1] == '-')) view.len--;
+    if (view.len == 0) return FALSE;
+
+    guint64 multiplier = 1;
+    switch (view.ptr[view.len - 1]) {
+        case 'B': case 'b': multiplier = 1; view.len--; break;
+        case 'K': case 'k': multiplier = 1024ULL; view.len--; break;
+        case 'M': case 'm': multiplier = 1024ULL * 1024; view.len--; break;
+        case 'G': case 'g': multiplier = 1024ULL * 1024 * 1024; view.len--; break;
+        case 'T': case 't': multiplier = 1024ULL * 1024 * 1024 * 1024; view.len--; break;
+        default: break;
+    }
+
+    // Whole numbers stay in integer arithmetic
+    gint64 whole;
+    if (str_view_to_int64(view, &whole)) {
+        if (whole < 0) return FALSE;
+        *bytes = (guint64)whole * multiplier;
+        return TRUE;
+    }
+
+    double value;
+    if (!str_view_to_double(view, &value) || value < 0) return FALSE;
+    *bytes = (guint64)(value * (double)multiplier);
+    return TRUE;
+}
+
+// ---- Line scanner ----
+
+void line_scanner_init(LineScanner *scanner, gsize initial_capacity) {
+    memset(scanner, 0, sizeof(*scanner));
+    scanner->capacity = MAX(initial_capacity, SCANNER_MIN_CAPACITY);
+    scanner->buffer = g_malloc(scanner->capacity);
+}
+
+void line_scanner_clear(LineScanner *scanner) {
+    g_free(scanner->buffer);
+    memset(scanner, 0, sizeof(*scanner));
+}
+
+// Make room for at least extra more bytes plus a terminator. Moves the
+// unreturned tail to the front first, so the buffer only grows for data
+// that is really pending.
+static void reserve(LineScanner *scanner, gsize extra) {
+    if (scanner->start > 0) {
+        gsize pending = scanner->end - scanner->start;
+        memmove(scanner->buffer, scanner->buffer + scanner->start, pending);
+        scanner->scan -= scanner->start;
+        scanner->end = pending;
+        scanner->start = 0;
+    }
+
+    if (scanner->end + extra + 1 > scanner->capacity) {
+        gsize capacity = scanner->capacity;
+        while (scanner->end + extra + 1 > capacity) capacity *= 2;
+        scanner->buffer = g_realloc(scanner->buffer, capacity);
+        scanner->capacity = capacity;
+    }
+}
+
+void line_scanner_feed(LineScanner *scanner, const char *data, gsize len) {
+    reserve(scanner, len);
+    memcpy(scanner->buffer + scanner->end, data, len);
+    scanner->end += len;
+}
+
+void line_scanner_finish(LineScanner *scanner) {
+    scanner->eof = TRUE;
+}
+
+void line_scanner_reset(LineScanner *scanner) {
+    scanner->start = scanner->scan = scanner->end = 0;
+    scanner->eof = FALSE;
+}
+
+gboolean line_scanner_fill(LineScanner *scanner, FILE *fp) {
+    return fp && line_scanner_fill_fd(scanner, fileno(fp));
+}
+
+gboolean line_scanner_fill_fd(LineScanner *scanner, int fd) {
+    if (scanner->eof || fd < 0) return FALSE;
+
+    // OPTIMIZATION: read() straight into the scanner - no stdio copy, and
+    // lines are handed out as soon as they arrive instead of after EOF
+    reserve(scanner, SCANNER_MIN_READ);
+    for (;;) {
+        ssize_t n = read(fd, scanner->buffer + scanner->end,
+                         scanner->capacity - scanner->end - 1);
+        if (n > 0) {
+            scanner->end += (gsize)n;
+            return TRUE;
+        }
+        if (n < 0 && errno == EINTR) continue;
+        scanner->eof = TRUE;
+        return FALSE;
+    }
+}
+
+static StrView take_line(LineScanner *scanner, gsize line_end, gsize next_start) {
+    StrView line = { scanner->buffer + scanner->start, line_end - scanner->start };
+    scanner->buffer[line_end] = '\0';
+    scanner->start = next_start;
+    scanner->scan = next_start;
+    return line;
+}
+
+gboolean line_scanner_next(LineScanner *scanner, StrView *line) {
+    if (scanner->start == scanner->end) return FALSE;
+
+    const char *newline = memchr(scanner->buffer + scanner->scan, '\n', scanner->end - scanner->scan);
+    if (newline) {
+        gsize line_end = (gsize)(newline - scanner->buffer);
+        *line = take_line(scanner, line_end, line_end + 1);
+        return TRUE;
+    }
+    scanner->scan = scanner->end;
+
+    // Last unterminated line, or a line too long to keep buffering. The
+    // buffer always has a spare byte for the terminator.
+    if (scanner->eof || scanner->end - scanner->start >= SCANNER_MAX_LINE) {
+        *line = take_line(scanner, scanner->end, scanner->end);
+        return TRUE;
+    }
+    return FALSE;
+}
+
+gboolean line_scanner_read_line(LineScanner *scanner, FILE *fp, StrView *line) {
+    while (!line_scanner_next(scanner, line)) {
+        if (!line_scanner_fill(scanner, fp)) return line_scanner_next(scanner, line);
+    }
+    return TRUE;
+}
@@ -0,0 +1,86 @@
+#ifndef SCANNER_H
+#define SCANNER_H
+
+#include <stdio.h>
+#include <string.h>
+#include <glib.h>
+
+// Allocation-free parsing of command output (top, ps, nettop). Lines and
+// fields are views into the read buffer; numbers are converted straight from
+// the views. Everything here is reentrant: all state lives in the caller's
+// LineScanner and StrView values.
+
+// Borrowed slice of a buffer, valid as long as the buffer is
+typedef struct {
+    const char *ptr;
+    gsize len;
+} StrView;
+
+static inline StrView str_view_from_cstr(const char *str) {
+    StrView view = { str, str ? strlen(str) : 0 };
+    return view;
+}
+
+gboolean str_view_equal(StrView view, const char *str);
+gboolean str_view_has_prefix(StrView view, const char *prefix);
+gboolean str_view_contains(StrView view, const char *needle);
+StrView str_view_trim(StrView view);
+
+// Copy into dest as a NUL-terminated string, truncating to dest_size - 1
+void str_view_copy(StrView view, char *dest, gsize dest_size);
+
+// Split on runs of spaces/tabs. Returns the number of fields stored; at most
+// max_fields, the rest of the line is ignored.
+guint str_view_split_fields(StrView line, StrView *fields, guint max_fields);
+
+// Split on every separator (empty fields kept), e.g. CSV. The last stored
+// field extends to the end of the line.
+guint str_view_split(StrView line, char separator, StrView *fields, guint max_fields);
+
+// Numbers. The whole view must be the number; no locale, no allocation.
+gboolean str_view_to_int64(StrView view, gint64 *value);         // [+-]digits
+gboolean str_view_to_double(StrView view, double *value);        // [+-]digits[.digits]
+
+// Size with optional unit, e.g. "512K", "2.5G", "1598M". A trailing '+' or
+// '-' (top's change markers) is ignored; units are powers of 1024.
+gboolean str_view_to_size(StrView view, guint64 *bytes);
+
+// Incremental line splitter over a growable buffer. Bytes are appended as
+// they arrive (from a pipe or pushed by the caller) and complete lines are
+// handed out in place. Each line is NUL-terminated in the buffer (the '\n'
+// is overwritten), so it can also be passed to C string functions.
+// Lines stay valid until the next fill or feed.
+typedef struct {
+    char *buffer;
+    gsize capacity;
+    gsize start;        // First byte not yet returned
+    gsize scan;         // Bytes before this offset contain no '\n'
+    gsize end;          // End of buffered data
+    gboolean eof;       // No more data will be added
+} LineScanner;
+
+void line_scanner_init(LineScanner *scanner, gsize initial_capacity);
+void line_scanner_clear(LineScanner *scanner);
+
+// Drop all buffered data and start over (keeps the buffer)
+void line_scanner_reset(LineScanner *scanner);
+
+// Append len bytes
+void line_scanner_feed(LineScanner *scanner, const char *data, gsize len);
+
+// Mark the input finished so a last unterminated line is returned
+void line_scanner_finish(LineScanner *scanner);
+
+// Read whatever fp's descriptor has available (one read(), blocking only
+// until some bytes arrive). Returns FALSE and finishes the scanner at end of
+// input. fp must not be read through stdio as well.
+gboolean line_scanner_fill(LineScanner *scanner, FILE *fp);
+gboolean line_scanner_fill_fd(LineScanner *scanner, int fd);
+
+// Next complete line without its terminator, FALSE if none is buffered
+gboolean line_scanner_next(LineScanner *scanner, StrView *line);
+
+// Next line from fp, reading more as needed. FALSE at end of input.
+gboolean line_scanner_read_line(LineScanner *scanner, FILE *fp, StrView *line);
+
+#endif // SCANNER_H
@@ -1,4 +1,6 @@
 #include "utils.h"
+#include "command_runner.h"
+#include "../common/config.h"
 #include <ctype.h>
 
 // SECURITY: Input validation for commands - allows safe system commands
@@ -50,6 +52,16 @@ gboolean is_safe_command(const char *cmd) {
     return TRUE;
 }
 
+// SECURITY: Row limit for one collection. Scales with the core count since
+// the /proc scan is sharded across cores; TASKMINI_MAX_PROCESSES overrides
+// it. Either way it stays under MAX_PROCESSES_HARD_LIMIT.
+guint get_max_processes_per_update(void) {
+    const char *override = g_getenv("TASKMINI_MAX_PROCESSES");
+    guint64 limit = override ? g_ascii_strtoull(override, NULL, 10) : 0;
+    if (limit == 0) limit = (guint64)MAX_PROCESSES_PER_UPDATE * g_get_num_processors();
+    return (guint)MIN(limit, (guint64)MAX_PROCESSES_HARD_LIMIT);
+}
+
 // SECURITY: Safe string operations with bounds checking
 void safe_strncpy(char *dest, const char *src, size_t dest_size) {
     if (!dest || !src || dest_size == 0) return;
@@ -70,6 +82,46 @@ void safe_strncat(char *dest, const char *src, size_t dest_size) {
     }
 }
 
+// Number of child processes spawned since the last reset
+static gint spawned_children = 0;
+
+void track_spawned_child(void) {
+    g_atomic_int_inc(&spawned_children);
+}
+
+// popen() wrapper that counts every child process the collectors spawn
+FILE* tracked_popen(const char *cmd, const char *mode) {
+    track_spawned_child();
+    return popen(cmd, mode);
+}
+
+// Long-lived child with its stdout on a pipe (stderr discarded). The caller
+// owns the pid and must reap it.
+// SECURITY: argv is exec'd directly - no shell, so arguments are never parsed
+gboolean tracked_spawn_reader(char **argv, GPid *child_pid, int *stdout_fd) {
+    if (!argv || !argv[0]) return FALSE;
+
+    GError *error = NULL;
+    if (!g_spawn_async_with_pipes(NULL, argv, NULL,
+                                  G_SPAWN_SEARCH_PATH | G_SPAWN_DO_NOT_REAP_CHILD | G_SPAWN_STDERR_TO_DEV_NULL,
+                                  NULL, NULL, child_pid, NULL, stdout_fd, NULL, &error)) {
+        g_warning("Cannot start %s: %s", argv[0], error->message);
+        g_error_free(error);
+        return FALSE;
+    }
+    track_spawned_child();
+    return TRUE;
+}
+
+guint get_spawned_child_count(void) {
+    return (guint)g_atomic_int_get(&spawned_children);
+}
+
+// Returns the count accumulated since the previous reset (one collection cycle)
+guint reset_spawned_child_count(void) {
+    return (guint)g_atomic_int_and((guint*)&spawned_children, 0);
+}
+
 // Helper to run a command and get its trimmed output as string
 char* run_command(const char *cmd) {
     // SECURITY: Validate command before execution
@@ -77,25 +129,15 @@ char* run_command(const char *cmd) {
         return strdup("N/A");
     }
     
-    FILE *fp = popen(cmd, "r");
-    if (fp == NULL) return strdup("N/A");
-
-    char *buffer = get_cached_buffer(256);
-    if (fgets(buffer, 256, fp) == NULL) {
-        return_cached_buffer(buffer, 256);
-        pclose(fp);
-        return strdup("N/A");
-    }
-    
-    // OPTIMIZATION: In-place newline removal (faster than strcspn)
-    char *newline = strchr(buffer, '\n');
-    if (newline) *newline = '\0';
+    // OPTIMIZATION: posix_spawn (no shell for plain commands) into a cached
+    // buffer; SECURITY: the command is killed at MAX_UPDATE_TIME_MS
+    CommandOutput output = { get_cached_buffer(256), 256, 0 };
+    command_run(cmd, MAX_UPDATE_TIME_MS, 255, &output, NULL);
     
-    pclose(fp);
-    
-    // Create final result and return buffer to cache
-    char *result = strdup(buffer);
-    return_cached_buffer(buffer, 256);
+    // First line only
+    output.data[strcspn(output.data, "\n")] = '\0';
+    char *result = strdup(output.len > 0 ? output.data : "N/A");
+    return_cached_buffer(output.data, output.size);
     return result;
 }
 
@@ -105,41 +147,24 @@ char* get_full_output(const char *cmd) {
         return NULL;
     }
     
-    FILE *fp = popen(cmd, "r");
-    if (fp == NULL) return NULL;
-
-    size_t buffer_size = 8192;  // Start with larger buffer
-    size_t total_len = 0;
-    char *buffer = get_cached_buffer(buffer_size);
-    char chunk[2048];  // Larger read chunks for better performance
-    size_t bytes_read = 0;
-
-    while ((bytes_read = fread(chunk, 1, sizeof(chunk), fp)) > 0) {
-        if (total_len + bytes_read + 1 > buffer_size) {
-            buffer_size *= 2;
-            char *new_buffer = malloc(buffer_size);
-            memcpy(new_buffer, buffer, total_len);
-            return_cached_buffer(buffer, buffer_size / 2);
-            buffer = new_buffer;
-        }
-        
-        // OPTIMIZATION: Direct memory copy instead of strncat (much faster)
-        memcpy(buffer + total_len, chunk, bytes_read);
-        total_len += bytes_read;
+    // Working buffer comes from the cache and goes back to it if it stayed
+    // a reasonable size
+    CommandOutput output = { get_cached_buffer(8192), 8192, 0 };
+    CommandResult status;
+    command_run(cmd, MAX_UPDATE_TIME_MS, MAX_COMMAND_OUTPUT_SIZE, &output, &status);
+    if (status.exit_status < 0 && output.len == 0) {
+        return_cached_buffer(output.data, output.size);
+        return NULL;  // Could not run, or killed before writing anything
     }
     
-    buffer[total_len] = '\0';
-    pclose(fp);
-    
     // Create final result with exact size needed
-    char *result = malloc(total_len + 1);
-    memcpy(result, buffer, total_len + 1);
+    char *result = malloc(output.len + 1);
+    memcpy(result, output.data, output.len + 1);
     
-    // Return working buffer to cache if it's a reasonable size
-    if (buffer_size <= 32768) {
-        return_cached_buffer(buffer, buffer_size);
+    if (output.size <= 32768) {
+        return_cached_buffer(output.data, output.size);
     } else {
-        free(buffer);  // Too large for cache
+        free(output.data);  // Too large for cache
     }
     
     return result;
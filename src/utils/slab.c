@@ -0,0 +1,192 @@
+#include "slab.h"
+#include "../common/config.h"
+#include <string.h>
+
+#define SLAB_ALIGN (2 * sizeof(gpointer))
+
+// Free objects of one cache owned by one thread. Holds up to two exchanges'
+// worth so that alternating alloc/free at the boundary does not bounce
+// between refill and flush.
+typedef struct {
+    SlabCache *cache;
+    gint generation;
+    guint count;
+    guint64 allocs;                 // Since the last exchange
+    guint64 frees;
+    gpointer objects[2 * SLAB_MAGAZINE_SIZE];
+} SlabMagazine;
+
+typedef struct {
+    SlabMagazine magazines[SLAB_MAX_CACHES];
+} SlabThreadCache;
+
+static void flush_thread_cache(gpointer data);
+
+static GPrivate thread_cache_key = G_PRIVATE_INIT(flush_thread_cache);
+static gint next_cache_id = 0;
+
+// Depot access; counts the exchanges that had to wait for the lock
+static void depot_lock(SlabCache *cache) {
+    gboolean contended = !g_mutex_trylock(&cache->mutex);
+    if (contended) g_mutex_lock(&cache->mutex);
+    cache->stats.exchanges++;
+    if (contended) cache->stats.contended++;
+}
+
+// Add one slab to the free list. Called with the depot locked.
+static void depot_grow(SlabCache *cache) {
+    char *slab = g_malloc(cache->object_size * cache->objects_per_slab);
+    for (guint i = cache->objects_per_slab; i-- > 0;) {
+        gpointer object = slab + i * cache->object_size;
+        *(gpointer *)object = cache->free_list;
+        cache->free_list = object;
+    }
+    cache->slabs = g_slist_prepend(cache->slabs, slab);
+    cache->stats.slabs++;
+    cache->stats.objects += cache->objects_per_slab;
+    cache->stats.depot_free += cache->objects_per_slab;
+}
+
+static gpointer depot_pop(SlabCache *cache) {
+    if (!cache->free_list) depot_grow(cache);
+    gpointer object = cache->free_list;
+    cache->free_list = *(gpointer *)object;
+    cache->stats.depot_free--;
+    cache->stats.outstanding++;
+    return object;
+}
+
+static void depot_push(SlabCache *cache, gpointer object) {
+    *(gpointer *)object = cache->free_list;
+    cache->free_list = object;
+    cache->stats.depot_free++;
+    cache->stats.outstanding--;
+}
+
+// Fold the magazine's operation counts into the cache. Depot locked.
+static void fold_counts(SlabCache *cache, SlabMagazine *magazine) {
+    cache->stats.allocs += magazine->allocs;
+    cache->stats.frees += magazine->frees;
+    magazine->allocs = 0;
+    magazine->frees = 0;
+}
+
+// Return a whole magazine to its cache at thread exit
+static void flush_thread_cache(gpointer data) {
+    SlabThreadCache *thread_cache = data;
+    for (guint i = 0; i < SLAB_MAX_CACHES; i++) {
+        SlabMagazine *magazine = &thread_cache->magazines[i];
+        SlabCache *cache = magazine->cache;
+        if (!cache || magazine->generation != g_atomic_int_get(&cache->generation)) continue;
+
+        depot_lock(cache);
+        while (magazine->count > 0) depot_push(cache, magazine->objects[--magazine->count]);
+        fold_counts(cache, magazine);
+        g_mutex_unlock(&cache->mutex);
+    }
+    g_free(thread_cache);
+}
+
+// This thread's magazine for cache, NULL if the cache has none
+static SlabMagazine* thread_magazine(SlabCache *cache) {
+    if (cache->id >= SLAB_MAX_CACHES) return NULL;
+
+    SlabThreadCache *thread_cache = g_private_get(&thread_cache_key);
+    if (!thread_cache) {
+        thread_cache = g_new0(SlabThreadCache, 1);
+        g_private_set(&thread_cache_key, thread_cache);
+    }
+
+    SlabMagazine *magazine = &thread_cache->magazines[cache->id];
+    gint generation = g_atomic_int_get(&cache->generation);
+    if (magazine->cache != cache || magazine->generation != generation) {
+        // First use, or the objects it held were freed by slab_cache_clear()
+        magazine->cache = cache;
+        magazine->generation = generation;
+        magazine->count = 0;
+        magazine->allocs = 0;
+        magazine->frees = 0;
+    }
+    return magazine;
+}
+
+void slab_cache_init(SlabCache *cache, gsize object_size, guint objects_per_slab) {
+    memset(cache, 0, sizeof(*cache));
+    object_size = MAX(object_size, sizeof(gpointer));
+    cache->object_size = (object_size + SLAB_ALIGN - 1) / SLAB_ALIGN * SLAB_ALIGN;
+    cache->objects_per_slab = MAX(objects_per_slab, 1);
+    cache->id = (guint)g_atomic_int_add(&next_cache_id, 1);
+    g_mutex_init(&cache->mutex);
+    cache->stats.object_size = cache->object_size;
+    cache->stats.objects_per_slab = cache->objects_per_slab;
+}
+
+void slab_cache_clear(SlabCache *cache) {
+    g_mutex_lock(&cache->mutex);
+    g_atomic_int_inc(&cache->generation);
+    g_slist_free_full(cache->slabs, g_free);
+    cache->slabs = NULL;
+    cache->free_list = NULL;
+    memset(&cache->stats, 0, sizeof(cache->stats));
+    cache->stats.object_size = cache->object_size;
+    cache->stats.objects_per_slab = cache->objects_per_slab;
+    g_mutex_unlock(&cache->mutex);
+}
+
+gpointer slab_alloc(SlabCache *cache) {
+    SlabMagazine *magazine = thread_magazine(cache);
+    gpointer object;
+
+    if (!magazine) {
+        depot_lock(cache);
+        object = depot_pop(cache);
+        cache->stats.allocs++;
+        g_mutex_unlock(&cache->mutex);
+    } else {
+        if (magazine->count == 0) {
+            depot_lock(cache);
+            while (magazine->count < SLAB_MAGAZINE_SIZE) {
+                magazine->objects[magazine->count++] = depot_pop(cache);
+            }
+            fold_counts(cache, magazine);
+            g_mutex_unlock(&cache->mutex);
+        }
+        object = magazine->objects[--magazine->count];
+        magazine->allocs++;
+    }
+
+    // Outside any lock; also clears the free-list link
+    memset(object, 0, cache->object_size);
+    return object;
+}
+
+void slab_free(SlabCache *cache, gpointer object) {
+    if (!object) return;
+
+    SlabMagazine *magazine = thread_magazine(cache);
+    if (!magazine) {
+        depot_lock(cache);
+        depot_push(cache, object);
+        cache->stats.frees++;
+        g_mutex_unlock(&cache->mutex);
+        return;
+    }
+
+    if (magazine->count == G_N_ELEMENTS(magazine->objects)) {
+        depot_lock(cache);
+        for (guint i = 0; i < SLAB_MAGAZINE_SIZE; i++) {
+            depot_push(cache, magazine->objects[--magazine->count]);
+        }
+        fold_counts(cache, magazine);
+        g_mutex_unlock(&cache->mutex);
+    }
+    magazine->objects[magazine->count++] = object;
+    magazine->frees++;
+}
+
+void slab_cache_get_stats(SlabCache *cache, SlabStats *stats) {
+    if (!cache || !stats) return;
+    g_mutex_lock(&cache->mutex);
+    *stats = cache->stats;
+    g_mutex_unlock(&cache->mutex);
+}
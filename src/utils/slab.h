@@ -0,0 +1,60 @@
+#ifndef SLAB_H
+#define SLAB_H
+
+#include <glib.h>
+
+// Slab allocator for fixed-size objects. Memory is added a slab (a block of
+// objects_per_slab objects) at a time and threaded onto an intrusive free
+// list, so allocation never scans and never falls back to malloc: when the
+// free list runs dry the cache grows by one slab.
+//
+// OPTIMIZATION: Every thread keeps a magazine of free objects per cache and
+// allocates and frees from it without locking. Only an empty or full
+// magazine exchanges SLAB_MAGAZINE_SIZE objects with the shared depot, so
+// the cache mutex is taken once per that many operations at most.
+//
+// Objects can be freed on any thread. Slabs are released by
+// slab_cache_clear() only, which invalidates every outstanding object.
+
+#define SLAB_MAX_CACHES 8           // Caches with a per-thread magazine; later ones lock per call
+
+typedef struct {
+    gsize object_size;
+    guint objects_per_slab;
+    guint64 slabs;
+    guint64 objects;                // Capacity of all slabs
+    guint64 depot_free;             // Free objects in the shared depot
+    guint64 outstanding;            // Objects held by threads: in use or cached in a magazine
+    guint64 exchanges;              // Magazine refills and flushes (one lock each)
+    guint64 contended;              // Exchanges that found the lock taken
+    guint64 allocs;                 // Magazine counts are folded in at each exchange,
+    guint64 frees;                  // so these trail by up to two magazines per thread
+} SlabStats;
+
+// Usually static: threads may still hold a magazine for the cache after
+// slab_cache_clear(), and check its generation on next use.
+typedef struct {
+    gsize object_size;              // Rounded up for alignment and the free-list link
+    guint objects_per_slab;
+    guint id;                       // Magazine index in every thread
+    gint generation;                // Bumped by clear(); stale magazines are dropped
+
+    GMutex mutex;                   // Protects the depot below
+    gpointer free_list;
+    GSList *slabs;
+    SlabStats stats;
+} SlabCache;
+
+void slab_cache_init(SlabCache *cache, gsize object_size, guint objects_per_slab);
+
+// Free every slab. The cache stays usable and grows again on demand; no
+// other thread may use it during the call.
+void slab_cache_clear(SlabCache *cache);
+
+// Zero-filled object; never NULL
+gpointer slab_alloc(SlabCache *cache);
+void slab_free(SlabCache *cache, gpointer object);
+
+void slab_cache_get_stats(SlabCache *cache, SlabStats *stats);
+
+#endif // SLAB_H
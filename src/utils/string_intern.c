@@ -0,0 +1,243 @@
+#include "string_intern.h"
+#include "../common/config.h"
+#include <string.h>
+
+#define INTERN_SHARD_BITS 4
+#define INTERN_SHARDS (1u << INTERN_SHARD_BITS)
+#define INTERN_PAGE_BITS 6
+#define INTERN_PAGE_ENTRIES (1u << INTERN_PAGE_BITS)
+#define INTERN_MAX_PAGES 1024               // Per shard: 64k strings
+#define INTERN_MIN_INDEX 64
+
+typedef struct {
+    gint refs;
+    gint last_used;                 // Generation of the last intern or release
+    guint32 hash;
+    guint32 next_free;              // Evicted entries: next free index + 1, 0 = end
+    guint8 len;
+    guint8 live;
+    char text[STRING_INTERN_MAX];
+} InternEntry;
+
+typedef struct {
+    GMutex mutex;                   // Protects everything but the entries' text and refs
+    InternEntry *pages[INTERN_MAX_PAGES];   // Set once, read without the lock
+    guint32 allocated;              // Entries handed out from the pages
+    guint32 free_head;              // Evicted entries (index + 1, 0 = none)
+    guint32 *index;                 // Open addressing over entry index + 1, 0 = empty
+    guint32 index_mask;
+    guint entries;
+    guint64 lookups;
+    guint64 hits;
+    guint64 evicted;
+} InternShard;
+
+static InternShard shards[INTERN_SHARDS];
+static gint generation = 1;
+
+// FNV-1a; the top bits pick the shard, the low bits the index slot
+static guint32 hash_text(const char *text, gsize len) {
+    guint32 hash = 2166136261u;
+    for (gsize i = 0; i < len; i++) {
+        hash = (hash ^ (guint8)text[i]) * 16777619u;
+    }
+    return hash;
+}
+
+static inline guint32 make_id(guint shard, guint32 index) {
+    return ((index + 1) << INTERN_SHARD_BITS) | shard;
+}
+
+static inline InternEntry* shard_entry(InternShard *shard, guint32 index) {
+    InternEntry *page = g_atomic_pointer_get(&shard->pages[index >> INTERN_PAGE_BITS]);
+    return page ? &page[index & (INTERN_PAGE_ENTRIES - 1)] : NULL;
+}
+
+// Entry behind a non-zero id, NULL if it was never handed out
+static InternEntry* id_entry(guint32 id) {
+    guint32 index = (id >> INTERN_SHARD_BITS) - 1;
+    if (index >= INTERN_MAX_PAGES * INTERN_PAGE_ENTRIES) return NULL;
+    return shard_entry(&shards[id & (INTERN_SHARDS - 1)], index);
+}
+
+static void index_insert(InternShard *shard, guint32 index, guint32 hash) {
+    guint32 slot = hash & shard->index_mask;
+    while (shard->index[slot]) slot = (slot + 1) & shard->index_mask;
+    shard->index[slot] = index + 1;
+}
+
+// Also drops evicted entries from the index. Shard locked.
+static void index_rebuild(InternShard *shard, guint32 slots) {
+    g_free(shard->index);
+    shard->index = g_new0(guint32, slots);
+    shard->index_mask = slots - 1;
+    for (guint32 i = 0; i < shard->allocated; i++) {
+        InternEntry *entry = shard_entry(shard, i);
+        if (entry->live) index_insert(shard, i, entry->hash);
+    }
+}
+
+// Storage for a new entry, NULL if the shard is full. Shard locked.
+static InternEntry* entry_alloc(InternShard *shard, guint32 *index) {
+    if (shard->free_head) {
+        *index = shard->free_head - 1;
+        InternEntry *entry = shard_entry(shard, *index);
+        shard->free_head = entry->next_free;
+        return entry;
+    }
+
+    if (shard->allocated == INTERN_MAX_PAGES * INTERN_PAGE_ENTRIES) return NULL;
+    if ((shard->allocated & (INTERN_PAGE_ENTRIES - 1)) == 0) {
+        g_atomic_pointer_set(&shard->pages[shard->allocated >> INTERN_PAGE_BITS],
+                             g_new0(InternEntry, INTERN_PAGE_ENTRIES));
+    }
+    *index = shard->allocated++;
+    return shard_entry(shard, *index);
+}
+
+guint32 string_intern(const char *text, gssize len) {
+    if (!text) return 0;
+
+    gsize length = len < 0 ? strlen(text) : strnlen(text, (gsize)len);
+    length = MIN(length, STRING_INTERN_MAX - 1);
+    if (length == 0) return 0;
+
+    guint32 hash = hash_text(text, length);
+    guint shard_id = hash >> (32 - INTERN_SHARD_BITS);
+    InternShard *shard = &shards[shard_id];
+    gint now = g_atomic_int_get(&generation);
+
+    g_mutex_lock(&shard->mutex);
+    shard->lookups++;
+    if (!shard->index) index_rebuild(shard, INTERN_MIN_INDEX);
+
+    guint32 slot = hash & shard->index_mask;
+    while (shard->index[slot]) {
+        guint32 index = shard->index[slot] - 1;
+        InternEntry *entry = shard_entry(shard, index);
+        if (entry->hash == hash && entry->len == length && memcmp(entry->text, text, length) == 0) {
+            g_atomic_int_set(&entry->last_used, now);
+            shard->hits++;
+            g_mutex_unlock(&shard->mutex);
+            return make_id(shard_id, index);
+        }
+        slot = (slot + 1) & shard->index_mask;
+    }
+
+    guint32 index;
+    InternEntry *entry = entry_alloc(shard, &index);
+    if (!entry) {
+        g_mutex_unlock(&shard->mutex);
+        return 0;  // SECURITY: Table full - the row goes unnamed rather than growing further
+    }
+    g_atomic_int_set(&entry->refs, 0);
+    g_atomic_int_set(&entry->last_used, now);
+    entry->hash = hash;
+    entry->next_free = 0;
+    entry->len = (guint8)length;
+    memcpy(entry->text, text, length);
+    entry->text[length] = '\0';
+    entry->live = 1;
+    shard->entries++;
+
+    // Keep the index at most half full
+    if (shard->entries * 2 > shard->index_mask + 1) {
+        index_rebuild(shard, (shard->index_mask + 1) * 2);
+    } else {
+        shard->index[slot] = index + 1;
+    }
+    g_mutex_unlock(&shard->mutex);
+    return make_id(shard_id, index);
+}
+
+const char* string_intern_text(guint32 id) {
+    if (id == 0) return "";
+    InternEntry *entry = id_entry(id);
+    return entry ? entry->text : "";
+}
+
+void string_intern_ref(guint32 id) {
+    if (id == 0) return;
+    InternEntry *entry = id_entry(id);
+    if (entry) g_atomic_int_inc(&entry->refs);
+}
+
+void string_intern_unref(guint32 id) {
+    if (id == 0) return;
+    InternEntry *entry = id_entry(id);
+    if (entry && g_atomic_int_dec_and_test(&entry->refs)) {
+        // The grace period starts when the last holder lets go
+        g_atomic_int_set(&entry->last_used, g_atomic_int_get(&generation));
+    }
+}
+
+guint string_intern_advance(void) {
+    guint32 now = (guint32)g_atomic_int_add(&generation, 1) + 1;
+    guint evicted = 0;
+
+    for (guint s = 0; s < INTERN_SHARDS; s++) {
+        InternShard *shard = &shards[s];
+        guint shard_evicted = 0;
+
+        g_mutex_lock(&shard->mutex);
+        for (guint32 i = 0; i < shard->allocated; i++) {
+            InternEntry *entry = shard_entry(shard, i);
+            if (!entry->live || g_atomic_int_get(&entry->refs) > 0) continue;
+            if (now - (guint32)g_atomic_int_get(&entry->last_used) <= STRING_INTERN_GRACE_CYCLES) continue;
+
+            entry->live = 0;
+            entry->next_free = shard->free_head;
+            shard->free_head = i + 1;
+            shard->entries--;
+            shard_evicted++;
+        }
+        if (shard_evicted > 0) {
+            shard->evicted += shard_evicted;
+            index_rebuild(shard, shard->index_mask + 1);
+        }
+        g_mutex_unlock(&shard->mutex);
+        evicted += shard_evicted;
+    }
+    return evicted;
+}
+
+void string_intern_get_stats(StringInternStats *stats) {
+    if (!stats) return;
+    memset(stats, 0, sizeof(*stats));
+
+    for (guint s = 0; s < INTERN_SHARDS; s++) {
+        InternShard *shard = &shards[s];
+        g_mutex_lock(&shard->mutex);
+        stats->lookups += shard->lookups;
+        stats->hits += shard->hits;
+        stats->evicted += shard->evicted;
+        stats->entries += shard->entries;
+        for (guint32 i = 0; i < shard->allocated; i++) {
+            InternEntry *entry = shard_entry(shard, i);
+            if (entry->live && g_atomic_int_get(&entry->refs) > 0) stats->referenced++;
+        }
+        guint32 pages = (shard->allocated + INTERN_PAGE_ENTRIES - 1) / INTERN_PAGE_ENTRIES;
+        stats->bytes += pages * INTERN_PAGE_ENTRIES * sizeof(InternEntry);
+        if (shard->index) stats->bytes += (shard->index_mask + 1) * sizeof(guint32);
+        g_mutex_unlock(&shard->mutex);
+    }
+}
+
+void string_intern_cleanup(void) {
+    for (guint s = 0; s < INTERN_SHARDS; s++) {
+        InternShard *shard = &shards[s];
+        g_mutex_lock(&shard->mutex);
+        for (guint p = 0; p < INTERN_MAX_PAGES && shard->pages[p]; p++) {
+            g_free(shard->pages[p]);
+            shard->pages[p] = NULL;
+        }
+        g_free(shard->index);
+        shard->index = NULL;
+        shard->index_mask = 0;
+        shard->allocated = 0;
+        shard->free_head = 0;
+        shard->entries = 0;
+        shard->lookups = shard->hits = shard->evicted = 0;
+        g_mutex_unlock(&shard->mutex);
+    }
+}
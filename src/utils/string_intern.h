@@ -0,0 +1,50 @@
+#ifndef STRING_INTERN_H
+#define STRING_INTERN_H
+
+#include <glib.h>
+
+// Process-wide table of short strings (process names) with stable 32-bit
+// IDs. Equal strings get the same ID, so comparing IDs compares the text,
+// and each distinct string is stored once no matter how many rows or
+// snapshots refer to it. ID 0 is the empty string and is never stored.
+//
+// Lifetime: string_intern() returns a borrowed ID that stays valid until
+// the string has gone unreferenced for STRING_INTERN_GRACE_CYCLES calls of
+// string_intern_advance(). Holders that outlive that (ProcessTable rows)
+// take a reference with string_intern_ref().
+//
+// OPTIMIZATION: The table is split into shards by hash, each with its own
+// lock, so parallel scan workers rarely meet. Text lookups take no lock.
+
+#define STRING_INTERN_MAX 48        // Bytes per string including the NUL; longer text is cut
+
+typedef struct {
+    guint64 lookups;                // string_intern() calls
+    guint64 hits;                   // ... that found the string already stored
+    guint64 evicted;                // Entries dropped by string_intern_advance()
+    guint entries;                  // Strings stored now
+    guint referenced;               // ... of which have references
+    gsize bytes;                    // Memory held by entries and indexes
+} StringInternStats;
+
+// ID of the first len bytes of text (len < 0: up to the NUL)
+guint32 string_intern(const char *text, gssize len);
+
+// Text of id; "" for 0. Valid while id is (see above).
+const char* string_intern_text(guint32 id);
+
+void string_intern_ref(guint32 id);
+void string_intern_unref(guint32 id);
+
+// Start a new generation and evict strings that nobody references and
+// nobody interned for STRING_INTERN_GRACE_CYCLES generations. Called once
+// per collection cycle by whoever publishes snapshots. Returns the number
+// of strings evicted.
+guint string_intern_advance(void);
+
+void string_intern_get_stats(StringInternStats *stats);
+
+// Free everything; no ID may be used afterwards
+void string_intern_cleanup(void);
+
+#endif // STRING_INTERN_H
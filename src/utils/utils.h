@@ -6,15 +6,26 @@
 #include <string.h>
 #include <glib.h>
 #include "../common/types.h"
+#include "pid_map.h"
+#include "process_table.h"
+#include "rate_store.h"
+#include "sample_arena.h"
+#include "string_intern.h"
 
 // Memory management functions
 void init_process_pool(void);
 void cleanup_process_pool(void);
-Process* alloc_process(void);
-void free_process(Process *proc);
-Process* copy_process(const Process *proc);
+ProcessSample* alloc_process(void);
+void free_process(ProcessSample *proc);
+ProcessSample* copy_process(const ProcessSample *proc);
 void free_update_data(UpdateData *data);
 
+// Arena-backed UpdateData: the struct and its strings live in one
+// SampleArena that free_update_data() releases in a single step
+UpdateData* update_data_new(void);
+char* update_data_strndup(UpdateData *data, const char *text, gssize len);
+void update_data_set_text(UpdateData *data, char **field, const char *text);
+
 char* get_cached_buffer(size_t min_size);
 void return_cached_buffer(char *buffer, size_t size);
 
@@ -22,17 +33,34 @@ void return_cached_buffer(char *buffer, size_t size);
 gboolean is_safe_command(const char *cmd);
 void safe_strncpy(char *dest, const char *src, size_t dest_size);
 void safe_strncat(char *dest, const char *src, size_t dest_size);
+guint get_max_processes_per_update(void);
 
-// Command execution functions
+// Command execution functions (posix_spawn with a MAX_UPDATE_TIME_MS deadline)
 char* run_command(const char *cmd);
 char* get_full_output(const char *cmd);
 
+// Child process accounting (every collector popen goes through tracked_popen)
+FILE* tracked_popen(const char *cmd, const char *mode);
+gboolean tracked_spawn_reader(char **argv, GPid *child_pid, int *stdout_fd);
+void track_spawned_child(void);     // For children started by other means
+guint get_spawned_child_count(void);
+guint reset_spawned_child_count(void);
+
 // String parsing and formatting functions
 long long parse_bytes(const char *str);
 char* format_bytes_human_readable(long long bytes);
+void format_bytes_buf(long long bytes, char *buf, size_t buf_size);
 long long parse_memory_string(const char *str);
 char* format_memory_human_readable(const char *mem_str);
+char* format_memory_bytes_human_readable(long long bytes);
 long long parse_runtime_to_seconds(const char *str);
+void format_elapsed_time(long long seconds, char *buf, size_t buf_size);
+
+// Lazy formatters for ProcessSample fields (write into caller buffers)
+void format_memory_bytes_buf(long long bytes, char *buf, size_t buf_size);
+void format_network_rate(guint64 bytes_per_sec, char *buf, size_t buf_size);
+void format_process_runtime(gint64 start_time, char *buf, size_t buf_size);
+const char* process_type_label(gboolean is_system);
 
 // Cleanup functions
 void cleanup_resources(void);
@@ -0,0 +1,173 @@
+#include "worker_pool.h"
+
+struct WorkerPool {
+    GThread *threads[WORKER_POOL_MAX_THREADS];
+    guint thread_count;
+
+    GMutex mutex;
+    GCond work_cond;
+    WorkerTask *queue;          // Ordered by budget, costliest first
+    gboolean shutdown;
+};
+
+// ---- Batches ----
+
+void worker_batch_init(WorkerBatch *batch) {
+    g_mutex_init(&batch->mutex);
+    g_cond_init(&batch->cond);
+    batch->pending = 0;
+}
+
+void worker_batch_clear(WorkerBatch *batch) {
+    g_mutex_clear(&batch->mutex);
+    g_cond_clear(&batch->cond);
+}
+
+static void worker_batch_add(WorkerBatch *batch) {
+    g_mutex_lock(&batch->mutex);
+    batch->pending++;
+    g_mutex_unlock(&batch->mutex);
+}
+
+static void worker_batch_complete(WorkerBatch *batch) {
+    g_mutex_lock(&batch->mutex);
+    if (--batch->pending == 0) g_cond_broadcast(&batch->cond);
+    g_mutex_unlock(&batch->mutex);
+}
+
+void worker_batch_wait(WorkerBatch *batch) {
+    g_mutex_lock(&batch->mutex);
+    while (batch->pending > 0) g_cond_wait(&batch->cond, &batch->mutex);
+    g_mutex_unlock(&batch->mutex);
+}
+
+gboolean worker_batch_wait_until(WorkerBatch *batch, gint64 deadline_us) {
+    g_mutex_lock(&batch->mutex);
+    while (batch->pending > 0) {
+        if (!g_cond_wait_until(&batch->cond, &batch->mutex, deadline_us)) break;
+    }
+    gboolean done = batch->pending == 0;
+    g_mutex_unlock(&batch->mutex);
+    return done;
+}
+
+gboolean worker_batch_done(WorkerBatch *batch) {
+    g_mutex_lock(&batch->mutex);
+    gboolean done = batch->pending == 0;
+    g_mutex_unlock(&batch->mutex);
+    return done;
+}
+
+// ---- Workers ----
+
+static void run_task(WorkerPool *pool, WorkerTask *task) {
+    gint64 start = g_get_monotonic_time();
+    task->func(task->data);
+    gint64 elapsed = g_get_monotonic_time() - start;
+
+    task->runs++;
+    task->last_us = elapsed;
+    task->total_us += elapsed;
+    if (elapsed > task->max_us) task->max_us = elapsed;
+    if (task->budget_ms > 0 && elapsed > (gint64)task->budget_ms * 1000) task->overruns++;
+
+    // Released under the pool lock, which worker_pool_submit() checks it
+    // under. The task may be resubmitted from here on; don't touch it after.
+    WorkerTaskFunc done = task->done;
+    gpointer data = task->data;
+    g_mutex_lock(&pool->mutex);
+    WorkerBatch *batch = task->batch;
+    task->batch = NULL;
+    g_mutex_unlock(&pool->mutex);
+
+    if (done) done(data);
+    worker_batch_complete(batch);
+}
+
+static gpointer worker_thread(gpointer data) {
+    WorkerPool *pool = data;
+
+    g_mutex_lock(&pool->mutex);
+    for (;;) {
+        while (!pool->queue && !pool->shutdown) g_cond_wait(&pool->work_cond, &pool->mutex);
+        if (!pool->queue) break;  // Shutting down with nothing left
+
+        WorkerTask *task = pool->queue;
+        pool->queue = task->next;
+        g_mutex_unlock(&pool->mutex);
+
+        run_task(pool, task);
+
+        g_mutex_lock(&pool->mutex);
+    }
+    g_mutex_unlock(&pool->mutex);
+    return NULL;
+}
+
+WorkerPool* worker_pool_new(guint threads) {
+    if (threads == 0) threads = g_get_num_processors();
+    threads = CLAMP(threads, 1, WORKER_POOL_MAX_THREADS);
+
+    WorkerPool *pool = g_new0(WorkerPool, 1);
+    g_mutex_init(&pool->mutex);
+    g_cond_init(&pool->work_cond);
+
+    for (guint i = 0; i < threads; i++) {
+        pool->threads[i] = g_thread_new("collector_worker", worker_thread, pool);
+    }
+    pool->thread_count = threads;
+    return pool;
+}
+
+void worker_pool_free(WorkerPool *pool) {
+    if (!pool) return;
+
+    g_mutex_lock(&pool->mutex);
+    pool->shutdown = TRUE;
+    g_cond_broadcast(&pool->work_cond);
+    g_mutex_unlock(&pool->mutex);
+
+    for (guint i = 0; i < pool->thread_count; i++) {
+        g_thread_join(pool->threads[i]);
+    }
+    g_mutex_clear(&pool->mutex);
+    g_cond_clear(&pool->work_cond);
+    g_free(pool);
+}
+
+guint worker_pool_size(const WorkerPool *pool) {
+    return pool ? pool->thread_count : 0;
+}
+
+gboolean worker_pool_submit(WorkerPool *pool, WorkerBatch *batch, WorkerTask *task) {
+    if (!pool || !batch || !task || !task->func) return FALSE;
+
+    g_mutex_lock(&pool->mutex);
+    if (task->batch || pool->shutdown) {
+        g_mutex_unlock(&pool->mutex);
+        return FALSE;
+    }
+    task->batch = batch;
+    worker_batch_add(batch);
+
+    // OPTIMIZATION: Longest budget first - slow sources start at once and
+    // cheap ones fill the gaps, so the batch finishes sooner
+    WorkerTask **slot = &pool->queue;
+    while (*slot && (*slot)->budget_ms >= task->budget_ms) slot = &(*slot)->next;
+    task->next = *slot;
+    *slot = task;
+
+    g_cond_signal(&pool->work_cond);
+    g_mutex_unlock(&pool->mutex);
+    return TRUE;
+}
+
+void worker_pool_run(WorkerPool *pool, WorkerTask *tasks, guint count) {
+    WorkerBatch batch;
+    worker_batch_init(&batch);
+    for (guint i = 0; i < count; i++) {
+        worker_pool_submit(pool, &batch, &tasks[i]);
+    }
+    worker_batch_wait(&batch);
+    worker_batch_clear(&batch);
+}
@@ -0,0 +1,65 @@
+#ifndef WORKER_POOL_H
+#define WORKER_POOL_H
+
+#include <glib.h>
+
+// Fixed set of worker threads fed from one job queue. Threads are created
+// once and reused for every collection cycle; callers group the tasks of a
+// cycle in a WorkerBatch and wait on it as a completion barrier.
+
+#define WORKER_POOL_MAX_THREADS 64
+
+typedef void (*WorkerTaskFunc)(gpointer data);
+
+typedef struct WorkerBatch WorkerBatch;
+
+// A schedulable unit of work. The caller owns the struct; it must stay
+// alive until its batch completes and can be resubmitted after that.
+typedef struct WorkerTask {
+    const char *name;
+    WorkerTaskFunc func;
+    gpointer data;
+    guint budget_ms;            // Expected cost; costlier tasks are started first
+    WorkerTaskFunc done;        // Optional: called with data once the task can be
+                                // resubmitted, before its batch completes
+
+    // Updated by the pool; stable once the batch has completed
+    guint runs;
+    guint overruns;             // Runs that took longer than budget_ms
+    gint64 last_us;
+    gint64 max_us;
+    gint64 total_us;
+
+    // Private
+    struct WorkerTask *next;
+    WorkerBatch *batch;         // Non-NULL while queued or running
+} WorkerTask;
+
+// Completion barrier for a group of tasks
+struct WorkerBatch {
+    GMutex mutex;
+    GCond cond;
+    guint pending;
+};
+
+typedef struct WorkerPool WorkerPool;
+
+// threads == 0 sizes the pool to the number of cores
+WorkerPool* worker_pool_new(guint threads);
+void worker_pool_free(WorkerPool *pool);   // Runs queued tasks, then joins the threads
+guint worker_pool_size(const WorkerPool *pool);
+
+// Queue a task as part of batch. FALSE if the task is still pending from
+// an earlier submission.
+gboolean worker_pool_submit(WorkerPool *pool, WorkerBatch *batch, WorkerTask *task);
+
+// Submit count tasks and wait for all of them
+void worker_pool_run(WorkerPool *pool, WorkerTask *tasks, guint count);
+
+void worker_batch_init(WorkerBatch *batch);
+void worker_batch_clear(WorkerBatch *batch);
+void worker_batch_wait(WorkerBatch *batch);
+gboolean worker_batch_wait_until(WorkerBatch *batch, gint64 deadline_us);  // Monotonic; FALSE on timeout
+gboolean worker_batch_done(WorkerBatch *batch);
+
+#endif // WORKER_POOL_H
@@ -0,0 +1,95 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../src/system/snapshot.h"
+#include "../src/utils/utils.h"
+#include "bench_common.h"
+
+// Life of one collection sample outside the process rows: the UpdateData,
+// its summary and GPU strings and the snapshot wrapping it, published
+// through a SnapshotSlot while a reader keeps the previous one (as the UI
+// model does). Heap allocation per object against one SampleArena per
+// sample:
+//   - samples per second with a /proc-sized summary
+//   - the same with a 64-core summary, larger than the first arena chunk
+//   - peak arena size and reuse rate afterwards
+//
+// Usage: tests/bench_arena [samples]
+
+typedef UpdateData* (*MakeSample)(const char *summary);
+
+static UpdateData* make_heap_sample(const char *summary) {
+    UpdateData *data = g_malloc0(sizeof(UpdateData));
+    data->gpu_usage = g_strdup("N/A");
+    data->system_summary = g_strdup(summary);
+    update_data_set_text(data, &data->gpu_usage, "12.50%");
+    return data;
+}
+
+static UpdateData* make_arena_sample(const char *summary) {
+    UpdateData *data = update_data_new();
+    data->gpu_usage = update_data_strndup(data, "N/A", -1);
+    data->system_summary = update_data_strndup(data, summary, -1);
+    update_data_set_text(data, &data->gpu_usage, "12.50%");
+    return data;
+}
+
+static double bench_samples(MakeSample make, const char *summary, int samples) {
+    SnapshotSlot slot;
+    snapshot_slot_init(&slot);
+    Snapshot *held = NULL;
+
+    double start = now_s();
+    for (int i = 0; i < samples; i++) {
+        snapshot_slot_publish(&slot, make(summary));
+        snapshot_unref(held);
+        held = snapshot_slot_acquire(&slot);
+    }
+    snapshot_unref(held);
+    snapshot_slot_clear(&slot);
+    return samples / (now_s() - start);
+}
+
+static char* build_summary(int cores) {
+    GString *summary = g_string_new("Processes: 412 total, 3 running, 409 sleeping\n"
+                                    "Load Avg: 0.52, 0.61, 0.70\n"
+                                    "CPU usage: 4.10% user, 2.05% sys, 93.85% idle\n");
+    g_string_append(summary, "CPU cores:");
+    for (int i = 0; i < cores; i++) g_string_append_printf(summary, " %d%%", (i * 7) % 100);
+    for (int i = 0; i < cores; i++) {
+        g_string_append_printf(summary, "\nCore %d: %.1f%% user %.1f%% sys", i, i * 0.7, i * 0.3);
+    }
+    g_string_append(summary, "\nPhysMem: 5.2 GB used, 10.4 GB available\n");
+    return g_string_free(summary, FALSE);
+}
+
+int main(int argc, char *argv[]) {
+    int samples = argc > 1 ? atoi(argv[1]) : 200000;
+    if (samples <= 0) samples = 200000;
+
+    char *small = build_summary(8);
+    char *large = build_summary(64);
+    printf("🚀 Sample Arena Benchmark (%d samples, summaries of %zu and %zu bytes)\n\n",
+           samples, strlen(small), strlen(large));
+
+    printf("%-8s %16s %16s\n", "", "8 cores", "64 cores");
+    printf("%-8s %12.2f M/s %12.2f M/s\n", "heap",
+           bench_samples(make_heap_sample, small, samples) / 1e6,
+           bench_samples(make_heap_sample, large, samples) / 1e6);
+    printf("%-8s %12.2f M/s %12.2f M/s\n", "arena",
+           bench_samples(make_arena_sample, small, samples) / 1e6,
+           bench_samples(make_arena_sample, large, samples) / 1e6);
+
+    SampleArenaStats stats;
+    sample_arena_get_stats(&stats);
+    printf("\n%llu arenas acquired, %.2f%% reused, %llu grown; peak %zu bytes, last %zu bytes\n",
+           (unsigned long long)stats.acquired,
+           stats.acquired ? 100.0 * stats.reused / stats.acquired : 0.0,
+           (unsigned long long)stats.grown, stats.peak_bytes, stats.last_bytes);
+
+    sample_arena_recycler_cleanup();
+    g_free(small);
+    g_free(large);
+    return 0;
+}
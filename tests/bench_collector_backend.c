@@ -0,0 +1,95 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+
+#include "../src/system/collector_backend.h"
+#include "../src/utils/utils.h"
+#include "bench_common.h"
+
+// Compares collector backends: samples per second and CPU cost per sample.
+// CPU time includes reaped children, so fork/exec of top/ps is accounted for.
+//
+// Usage: tests/bench_collector_backend [iterations] [backend...]
+
+static double tv_ms(struct timeval tv) {
+    return tv.tv_sec * 1000.0 + tv.tv_usec / 1000.0;
+}
+
+// User + system CPU time of this process and all waited-for children
+static double get_cpu_time_ms(void) {
+    struct rusage self, children;
+    getrusage(RUSAGE_SELF, &self);
+    getrusage(RUSAGE_CHILDREN, &children);
+    return tv_ms(self.ru_utime) + tv_ms(self.ru_stime) +
+           tv_ms(children.ru_utime) + tv_ms(children.ru_stime);
+}
+
+static void bench_backend(const char *name, int iterations) {
+    printf("=== Backend: %s ===\n", name);
+
+    CollectorBackend *backend = collector_backend_create(name);
+    if (!backend) {
+        printf("Not available on this platform, skipping\n\n");
+        return;
+    }
+
+    // Warm-up sample primes per-process CPU deltas
+    UpdateData *data = collector_backend_collect(backend);
+    if (data) free_update_data(data);
+
+    int total_processes = 0;
+    int failures = 0;
+    guint spawned_children = 0;
+    double wall_start = now_ms();
+    double cpu_start = get_cpu_time_ms();
+
+    for (int i = 0; i < iterations; i++) {
+        data = collector_backend_collect(backend);
+        spawned_children += backend->last_spawned_children;
+        if (!data) {
+            failures++;
+            continue;
+        }
+        total_processes += data->processes ? data->processes->count : 0;
+        free_update_data(data);
+    }
+
+    double wall_ms = now_ms() - wall_start;
+    double cpu_ms = get_cpu_time_ms() - cpu_start;
+    int samples = iterations - failures;
+
+    printf("Samples: %d (%d failed), avg %.0f processes/sample\n",
+           samples, failures, samples > 0 ? (double)total_processes / samples : 0.0);
+    printf("Wall time: %.2f ms total, %.3f ms/sample, %.1f samples/sec\n",
+           wall_ms, wall_ms / iterations, wall_ms > 0 ? iterations * 1000.0 / wall_ms : 0.0);
+    printf("CPU time:  %.2f ms total, %.3f ms/sample (self + children)\n",
+           cpu_ms, cpu_ms / iterations);
+    printf("Children spawned: %u total, %.1f per sample\n\n",
+           spawned_children, (double)spawned_children / iterations);
+
+    collector_backend_destroy(backend);
+}
+
+int main(int argc, char *argv[]) {
+    int iterations = argc > 1 ? atoi(argv[1]) : 20;
+    if (iterations <= 0) iterations = 20;
+
+    init_process_pool();
+
+    printf("🚀 Collector Backend Benchmark (%d iterations)\n\n", iterations);
+
+    if (argc > 2) {
+        for (int i = 2; i < argc; i++) {
+            bench_backend(argv[i], iterations);
+        }
+    } else {
+        bench_backend("proc", iterations);
+        bench_backend("stream", iterations);
+        bench_backend("top", iterations);
+    }
+
+    cleanup_process_pool();
+    return 0;
+}
@@ -0,0 +1,120 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../src/system/collector_protocol.h"
+#include "../src/utils/utils.h"
+#include "bench_common.h"
+
+// Cost of the headless collector's wire format per snapshot: FULL frame
+// (what a client gets on connect or after falling behind) against DELTA
+// frame (steady state). The server encodes each frame once for all
+// clients; every client decodes its own copy.
+//
+// Usage: tests/bench_collector_protocol [cycles]
+
+static UpdateData* make_update(int process_count, int cycle) {
+    UpdateData *data = g_new0(UpdateData, 1);
+    data->processes = bench_make_table(process_count, cycle);
+    data->gpu_usage = g_strdup("12%");
+    data->system_summary = g_strdup("Processes: synthetic");
+    return data;
+}
+
+static UpdateData* decode(GBytes *frame, const UpdateData *base, guint64 base_sequence) {
+    gsize size;
+    const guint8 *bytes = g_bytes_get_data(frame, &size);
+    CollectorFrameHeader header;
+    memcpy(&header, bytes, sizeof(header));
+    return collector_frame_header_valid(&header)
+        ? collector_frame_decode(&header, bytes + sizeof(header), base, base_sequence)
+        : NULL;
+}
+
+// Returns the number of snapshots the DELTA mirror got wrong
+static int bench_frames(int process_count, int cycles) {
+    SnapshotSlot slot;
+    snapshot_slot_init(&slot);
+    snapshot_slot_publish(&slot, make_update(process_count, 0));
+
+    Snapshot *first = snapshot_slot_acquire(&slot);
+    GBytes *first_frame = collector_frame_encode_full(first);
+    UpdateData *mirror = decode(first_frame, NULL, 0);
+    g_bytes_unref(first_frame);
+    snapshot_unref(first);
+
+    double full_encode_ms = 0, delta_encode_ms = 0, full_decode_ms = 0, delta_decode_ms = 0;
+    double full_bytes = 0, delta_bytes = 0;
+    int mismatches = 0;
+
+    for (int cycle = 1; cycle <= cycles; cycle++) {
+        snapshot_slot_publish(&slot, make_update(process_count, cycle));
+        Snapshot *snapshot = snapshot_slot_acquire(&slot);
+
+        double start = now_ms();
+        GBytes *full = collector_frame_encode_full(snapshot);
+        full_encode_ms += now_ms() - start;
+
+        start = now_ms();
+        GBytes *delta = collector_frame_encode_delta(snapshot);
+        delta_encode_ms += now_ms() - start;
+
+        start = now_ms();
+        UpdateData *from_full = decode(full, NULL, 0);
+        full_decode_ms += now_ms() - start;
+
+        start = now_ms();
+        UpdateData *from_delta = decode(delta, mirror, snapshot->sequence - 1);
+        delta_decode_ms += now_ms() - start;
+
+        full_bytes += g_bytes_get_size(full);
+        delta_bytes += g_bytes_get_size(delta);
+
+        // The mirror must hold exactly the published rows
+        const ProcessTable *table = snapshot->data->processes;
+        if (!from_full || !from_delta || from_delta->processes->count != table->count) {
+            mismatches++;
+        } else {
+            for (guint i = 0; i < table->count; i++) {
+                const ProcessSample *row = process_table_lookup(from_delta->processes, table->items[i].pid);
+                if (!row || memcmp(row, &table->items[i], sizeof(*row)) != 0) {
+                    mismatches++;
+                    break;
+                }
+            }
+        }
+
+        free_update_data(from_full);
+        free_update_data(mirror);
+        mirror = from_delta;
+        g_bytes_unref(full);
+        g_bytes_unref(delta);
+        snapshot_unref(snapshot);
+    }
+
+    printf("=== %d processes ===\n", process_count);
+    printf("FULL:  %8.1f KB/frame, encode %.3f ms, decode %.3f ms\n",
+           full_bytes / cycles / 1024.0, full_encode_ms / cycles, full_decode_ms / cycles);
+    printf("DELTA: %8.1f KB/frame, encode %.3f ms, decode %.3f ms (%.1fx smaller)\n",
+           delta_bytes / cycles / 1024.0, delta_encode_ms / cycles, delta_decode_ms / cycles,
+           delta_bytes > 0 ? full_bytes / delta_bytes : 0.0);
+    printf("Mirror %s\n\n", mismatches == 0 ? "identical" : "DIFFERS");
+
+    free_update_data(mirror);
+    snapshot_slot_clear(&slot);
+    return mismatches;
+}
+
+int main(int argc, char *argv[]) {
+    int cycles = argc > 1 ? atoi(argv[1]) : 50;
+    if (cycles <= 0) cycles = 50;
+
+    init_process_pool();
+
+    printf("🚀 Collector Protocol Benchmark (%d snapshots, 5%% churn, 10%% CPU changes)\n\n", cycles);
+    int mismatches = bench_frames(2000, cycles);
+    mismatches += bench_frames(20000, cycles);
+
+    cleanup_process_pool();
+    return mismatches > 0 ? 1 : 0;
+}
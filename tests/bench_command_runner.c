@@ -0,0 +1,81 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../src/utils/command_runner.h"
+#include "../src/utils/utils.h"
+#include "bench_common.h"
+
+// Spawn latency of popen (fork + /bin/sh + exec) against the posix_spawn
+// command runner (direct exec for plain commands), plus deadline handling
+// for commands that hang.
+//
+// Usage: tests/bench_command_runner [iterations]
+
+static double bench_popen(const char *cmd, int iterations) {
+    char chunk[4096];
+    double start = now_ms();
+    for (int i = 0; i < iterations; i++) {
+        FILE *fp = popen(cmd, "r");
+        if (!fp) continue;
+        while (fread(chunk, 1, sizeof(chunk), fp) > 0) {}
+        pclose(fp);
+    }
+    return (now_ms() - start) / iterations;
+}
+
+static double bench_runner(const char *cmd, int iterations, CommandOutput *output) {
+    double start = now_ms();
+    for (int i = 0; i < iterations; i++) {
+        command_run(cmd, 5000, 64 * 1024, output, NULL);
+    }
+    return (now_ms() - start) / iterations;
+}
+
+static void compare(const char *cmd, int iterations, CommandOutput *output) {
+    double popen_ms = bench_popen(cmd, iterations);
+    double runner_ms = bench_runner(cmd, iterations, output);
+    printf("%-28s popen %7.3f ms   runner %7.3f ms   (%.1fx)\n",
+           cmd, popen_ms, runner_ms, runner_ms > 0 ? popen_ms / runner_ms : 0.0);
+}
+
+static void check_deadline(const char *cmd, guint timeout_ms, CommandOutput *output) {
+    CommandResult result;
+    double start = now_ms();
+    command_run(cmd, timeout_ms, 1024, output, &result);
+    printf("%-28s deadline %u ms: returned after %.0f ms, %s, output \"%.*s\"\n",
+           cmd, timeout_ms, now_ms() - start, result.timed_out ? "killed" : "NOT killed",
+           (int)strcspn(output->data, "\n"), output->data);
+}
+
+int main(int argc, char *argv[]) {
+    int iterations = argc > 1 ? atoi(argv[1]) : 200;
+    if (iterations <= 0) iterations = 200;
+
+    // One buffer reused by every run, as run_command()/get_full_output() do
+    CommandOutput output = { 0 };
+
+    printf("🚀 Command Runner Benchmark (%d iterations)\n\n", iterations);
+    compare("true", iterations, &output);
+    compare("uname -s", iterations, &output);
+    compare("ps -eo pid,rss", iterations / 4 + 1, &output);
+    compare("echo a b c | tr a-c x-z", iterations, &output);  // Needs /bin/sh either way
+
+    printf("\n");
+    check_deadline("sleep 10", 200, &output);
+    check_deadline("echo partial; sleep 10", 200, &output);
+    check_deadline("sleep 10 | cat", 200, &output);           // Whole pipeline is killed
+
+    CommandStats stats[COMMAND_STATS_MAX];
+    guint count = command_runner_get_stats(stats, COMMAND_STATS_MAX);
+    printf("\n%-10s %6s %8s %8s %10s %10s %10s\n", "command", "runs", "timeouts", "failures",
+           "avg ms", "max ms", "spawn ms");
+    for (guint i = 0; i < count; i++) {
+        printf("%-10s %6u %8u %8u %10.3f %10.3f %10.3f\n", stats[i].name, stats[i].runs,
+               stats[i].timeouts, stats[i].failures, stats[i].total_us / 1000.0 / stats[i].runs,
+               stats[i].max_us / 1000.0, stats[i].spawn_us / 1000.0 / stats[i].runs);
+    }
+
+    command_output_clear(&output);
+    return 0;
+}
@@ -0,0 +1,55 @@
+#ifndef BENCH_COMMON_H
+#define BENCH_COMMON_H
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "../src/utils/utils.h"
+
+// Helpers shared by the tests/bench_* programs: a monotonic clock and the
+// synthetic process table the snapshot benchmarks churn through.
+
+static inline double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static inline double now_ms(void) {
+    return now_ns() / 1e6;
+}
+
+static inline double now_s(void) {
+    return now_ns() / 1e9;
+}
+
+// 5% of PIDs change every cycle to model process churn
+static inline pid_t bench_pid(int i, int cycle) {
+    return (i % 20 == 0) ? 100000 + cycle * 1000 + i : 100 + i;
+}
+
+// Row i of a cycle: churned PID, a CPU value that changes between cycles on
+// about one row in ten, and the name "process-<i>"
+static inline void bench_fill_sample(ProcessSample *sample, int i, int cycle) {
+    memset(sample, 0, sizeof(*sample));
+    sample->pid = bench_pid(i, cycle);
+    sample->cpu = (float)((i * 7 + (i % 10 == 0 ? cycle : 0)) % 1000) / 10.0f;
+    sample->rss_bytes = (guint64)(i + 1) * 4096;
+    char name[STRING_INTERN_MAX];
+    snprintf(name, sizeof(name), "process-%d", i);
+    process_set_name(sample, name, -1);
+}
+
+// All rows of a cycle in a new table. Free with process_table_free().
+static inline ProcessTable* bench_make_table(int process_count, int cycle) {
+    ProcessTable *table = process_table_new((guint)process_count);
+    for (int i = 0; i < process_count; i++) {
+        ProcessSample sample;
+        bench_fill_sample(&sample, i, cycle);
+        process_table_add(table, &sample);
+    }
+    return table;
+}
+
+#endif // BENCH_COMMON_H
@@ -0,0 +1,109 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "../src/system/collector_backend.h"
+#include "../src/system/cpu_accounting.h"
+#include "../src/utils/utils.h"
+#include "bench_common.h"
+
+// Delta-based CPU accounting:
+//   - time from backend creation to the first usable sample (first paint)
+//   - interval accuracy: this process burns one core between two samples
+//   - engine cost per process per sample
+//
+// Usage: tests/bench_cpu_accounting [samples] [backend...]
+
+#define BENCH_PROCESSES 2000
+#define BURN_MS 300
+
+static const ProcessSample* find_process(const UpdateData *data, pid_t pid) {
+    for (guint i = 0; i < data->processes->count; i++) {
+        if (data->processes->items[i].pid == pid) return &data->processes->items[i];
+    }
+    return NULL;
+}
+
+static guint count_busy(const UpdateData *data) {
+    guint busy = 0;
+    for (guint i = 0; i < data->processes->count; i++) busy += data->processes->items[i].cpu > 0.0f;
+    return busy;
+}
+
+static void burn(double ms) {
+    volatile unsigned long spin = 0;
+    double end = now_ms() + ms;
+    while (now_ms() < end) spin++;
+}
+
+static void bench_first_sample(const char *name) {
+    double start = now_ms();
+    CollectorBackend *backend = collector_backend_create(name);
+    if (!backend) {
+        printf("%-8s not available on this platform\n", name);
+        return;
+    }
+    UpdateData *data = collector_backend_collect(backend);
+    double first_ms = now_ms() - start;
+    if (!data) {
+        printf("%-8s no data\n", name);
+        collector_backend_destroy(backend);
+        return;
+    }
+    printf("%-8s first sample after %8.2f ms: %u processes, %u with CPU > 0, system %.1f%%\n",
+           name, first_ms, data->processes->count, count_busy(data), data->system_cpu_usage);
+    free_update_data(data);
+
+    // One core busy for BURN_MS between two samples
+    burn(BURN_MS);
+    data = collector_backend_collect(backend);
+    if (data) {
+        const ProcessSample *self = find_process(data, getpid());
+        int cores = (int)sysconf(_SC_NPROCESSORS_ONLN);
+        if (self) {
+            printf("%-8s busy loop over %d ms: %.1f%% (%.0f%% of one core, expected ~100%%)\n",
+                   name, BURN_MS, self->cpu, self->cpu * cores);
+        }
+        free_update_data(data);
+    }
+    collector_backend_destroy(backend);
+}
+
+static void bench_engine(int samples) {
+    CpuAccounting *acct = cpu_accounting_new(100, 8);
+    guint64 *ticks = g_new0(guint64, BENCH_PROCESSES);
+
+    double start = now_ms();
+    float checksum = 0.0f;
+    for (int s = 0; s < samples; s++) {
+        cpu_accounting_begin(acct, (gint64)(s + 1) * 1000000);
+        for (int i = 0; i < BENCH_PROCESSES; i++) {
+            ticks[i] += (guint64)(i % 50);
+            checksum += cpu_accounting_process(acct, 100 + i, (guint64)i, ticks[i], 60.0);
+        }
+        cpu_accounting_end(acct);
+    }
+    double elapsed = now_ms() - start;
+
+    printf("engine   %d processes: %.3f ms/sample, %.1f ns/process (checksum %.0f)\n",
+           BENCH_PROCESSES, elapsed / samples, elapsed * 1e6 / samples / BENCH_PROCESSES, checksum);
+    g_free(ticks);
+    cpu_accounting_free(acct);
+}
+
+int main(int argc, char *argv[]) {
+    int samples = argc > 1 ? atoi(argv[1]) : 200;
+    if (samples <= 0) samples = 200;
+
+    printf("🚀 CPU Accounting Benchmark\n\n");
+    if (argc > 2) {
+        for (int i = 2; i < argc; i++) bench_first_sample(argv[i]);
+    } else {
+        bench_first_sample("proc");
+        bench_first_sample("top");
+    }
+    printf("\n");
+    bench_engine(samples);
+    return 0;
+}
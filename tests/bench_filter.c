@@ -0,0 +1,135 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../src/ui/filter.h"
+#include "../src/utils/utils.h"
+#include "bench_common.h"
+
+// Filter throughput over a synthetic process table:
+//   reparse  - filter text parsed for every row (the old process_matches_filter)
+//   compiled - FilterProgram compiled once, evaluated row by row
+//   columns  - FilterProgram over the struct-of-arrays copy (load included)
+//   select   - columns already loaded, as when refiltering the same snapshot
+//
+// Usage: tests/bench_filter [rows] [iterations]
+
+static const char *names[] = {
+    "kernel_task", "launchd", "WindowServer", "Google Chrome Helper", "Safari",
+    "mds_stores", "Terminal", "Xcode", "Slack Helper (Renderer)", "coreaudiod"
+};
+
+static ProcessTable* make_table(int rows) {
+    ProcessTable *table = process_table_new((guint)rows);
+    srand(42);
+
+    for (int i = 0; i < rows; i++) {
+        ProcessSample sample;
+        memset(&sample, 0, sizeof(sample));
+        sample.pid = 100 + i;
+        sample.cpu = (float)(rand() % 1000) / 10.0f;
+        sample.rss_bytes = (guint64)(rand() % 4096) * 1024 * 1024;
+        sample.net_bps = (guint64)(rand() % 100000);
+        if (i % 3 == 0) {
+            sample.gpu = (float)(rand() % 100);
+            sample.flags |= PROCESS_FLAG_HAS_GPU;
+        }
+        if (i % 4 == 0) sample.flags |= PROCESS_FLAG_SYSTEM;
+        char name[STRING_INTERN_MAX];
+        snprintf(name, sizeof(name), "%s %d", names[i % 10], i);
+        process_set_name(&sample, name, -1);
+        process_table_add(table, &sample);
+    }
+    return table;
+}
+
+static void set_field(char *dest, size_t size, const char *text) {
+    strncpy(dest, text, size - 1);
+    dest[size - 1] = '\0';
+}
+
+// Returns 1 when the three evaluation paths disagree on the match count
+static int bench_criteria(const char *label, const FilterCriteria *criteria,
+                          const ProcessTable *table, int iterations) {
+    FilterProgram program;
+    FilterColumns cols = {0};
+    guint8 *mask = g_new(guint8, table->count);
+    guint reparse_hits = 0, compiled_hits = 0, column_hits = 0;
+    double rows = (double)table->count * iterations;
+
+    double start = now_ms();
+    for (int it = 0; it < iterations; it++) {
+        reparse_hits = 0;
+        for (guint i = 0; i < table->count; i++) {
+            filter_program_compile(&program, criteria);
+            reparse_hits += filter_program_matches(&program, &table->items[i]);
+        }
+    }
+    double reparse_ms = now_ms() - start;
+
+    filter_program_compile(&program, criteria);
+    start = now_ms();
+    for (int it = 0; it < iterations; it++) {
+        compiled_hits = 0;
+        for (guint i = 0; i < table->count; i++) {
+            compiled_hits += filter_program_matches(&program, &table->items[i]);
+        }
+    }
+    double compiled_ms = now_ms() - start;
+
+    start = now_ms();
+    for (int it = 0; it < iterations; it++) {
+        filter_columns_load(&cols, table, program.checks);
+        column_hits = filter_program_select(&program, &cols, mask);
+    }
+    double column_ms = now_ms() - start;
+
+    start = now_ms();
+    for (int it = 0; it < iterations; it++) {
+        column_hits = filter_program_select(&program, &cols, mask);
+    }
+    double select_ms = now_ms() - start;
+
+    int mismatch = !(reparse_hits == compiled_hits && compiled_hits == column_hits);
+    printf("=== %s ===\n", label);
+    printf("Matches: %u of %u%s\n", compiled_hits, table->count, mismatch ? "  MISMATCH" : "");
+    printf("Reparse:  %8.2f ms, %7.1f M rows/s\n", reparse_ms, rows / reparse_ms / 1000.0);
+    printf("Compiled: %8.2f ms, %7.1f M rows/s (%.1fx)\n", compiled_ms, rows / compiled_ms / 1000.0,
+           compiled_ms > 0 ? reparse_ms / compiled_ms : 0.0);
+    printf("Columns:  %8.2f ms, %7.1f M rows/s (%.1fx)\n", column_ms, rows / column_ms / 1000.0,
+           column_ms > 0 ? reparse_ms / column_ms : 0.0);
+    printf("Select:   %8.2f ms, %7.1f M rows/s (%.1fx)\n\n", select_ms, rows / select_ms / 1000.0,
+           select_ms > 0 ? reparse_ms / select_ms : 0.0);
+
+    filter_columns_clear(&cols);
+    g_free(mask);
+    return mismatch;
+}
+
+int main(int argc, char *argv[]) {
+    int rows = argc > 1 ? atoi(argv[1]) : 100000;
+    int iterations = argc > 2 ? atoi(argv[2]) : 10;
+    if (rows <= 0) rows = 100000;
+    if (iterations <= 0) iterations = 10;
+
+    ProcessTable *table = make_table(rows);
+    printf("🚀 Filter Benchmark (%d rows, %d iterations)\n\n", rows, iterations);
+
+    FilterCriteria criteria;
+    memset(&criteria, 0, sizeof(criteria));
+    criteria.active = TRUE;
+    set_field(criteria.cpu_filter, sizeof(criteria.cpu_filter), "15%+");
+    set_field(criteria.memory_filter, sizeof(criteria.memory_filter), "[100MB,2GB]");
+    int mismatches = 0;
+    mismatches += bench_criteria("CPU 15%+, Memory [100MB,2GB]", &criteria, table, iterations);
+
+    set_field(criteria.network_filter, sizeof(criteria.network_filter), "1KB/s+");
+    set_field(criteria.type_filter, sizeof(criteria.type_filter), "User");
+    mismatches += bench_criteria("+ Network 1KB/s+, Type User", &criteria, table, iterations);
+
+    set_field(criteria.name_filter, sizeof(criteria.name_filter), "chrome");
+    mismatches += bench_criteria("+ Name \"chrome\"", &criteria, table, iterations);
+
+    process_table_free(table);
+    return mismatches > 0 ? 1 : 0;
+}
@@ -0,0 +1,344 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../src/utils/pid_map.h"
+#include "bench_common.h"
+#include "taskmini_tests.h"
+
+// Per-PID tables as the collector stages use them each cycle: fill with
+// every live process, look each one up while merging, clear for the next
+// cycle. Three ways to hold a PID -> double map:
+//   - GHashTable keyed by g_strdup'd PID strings, g_malloc'd values
+//     (the old process_cpu / process_network / prev_times tables)
+//   - GHashTable keyed by GINT_TO_POINTER(pid), g_malloc'd values
+//   - PidMap with the value stored inline
+// at 2k, 20k and 100k PIDs, in ns per operation.
+//
+// First checks PidMap against a GHashTable through a random mix of
+// inserts, removes, remove_if, resumable sweeps and clears while the
+// map grows and shrinks, with PIDs that cluster across the end of the
+// slot array and PID -1 (held outside the slots).
+//
+// Usage: tests/bench_pid_map [ops_per_size]
+
+#define PID_MAX 4194304             // Linux pid_max on 64-bit systems
+#define CHECK_STEPS 400000
+#define CHECK_KEYS 12000
+
+typedef struct {
+    double insert;
+    double lookup;
+    double clear;
+} OpCosts;
+
+// Distinct PIDs scattered over the PID space, in enumeration order
+static pid_t* make_pids(int count) {
+    pid_t *pids = g_new(pid_t, count);
+    guint8 *used = g_new0(guint8, PID_MAX);
+    guint32 state = 12345;
+    for (int i = 0; i < count;) {
+        state = state * 1103515245u + 12345u;
+        pid_t pid = 1 + (pid_t)((state >> 8) % (PID_MAX - 1));
+        if (used[pid]) continue;
+        used[pid] = 1;
+        pids[i++] = pid;
+    }
+    g_free(used);
+    return pids;
+}
+
+static OpCosts bench_string_table(const pid_t *pids, int count, int rounds) {
+    GHashTable *table = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_free);
+    OpCosts costs = {0};
+    volatile double sink = 0;
+
+    for (int r = 0; r < rounds; r++) {
+        double start = now_s();
+        for (int i = 0; i < count; i++) {
+            double *value = g_malloc(sizeof(double));
+            *value = i;
+            g_hash_table_insert(table, g_strdup_printf("%d", (int)pids[i]), value);
+        }
+        double mid = now_s();
+        for (int i = 0; i < count; i++) {
+            char key[16];
+            snprintf(key, sizeof(key), "%d", (int)pids[i]);
+            double *value = g_hash_table_lookup(table, key);
+            if (value) sink += *value;
+        }
+        double end = now_s();
+        g_hash_table_remove_all(table);
+        costs.insert += mid - start;
+        costs.lookup += end - mid;
+        costs.clear += now_s() - end;
+    }
+    g_hash_table_destroy(table);
+    (void)sink;
+    return costs;
+}
+
+static OpCosts bench_direct_table(const pid_t *pids, int count, int rounds) {
+    GHashTable *table = g_hash_table_new_full(g_direct_hash, g_direct_equal, NULL, g_free);
+    OpCosts costs = {0};
+    volatile double sink = 0;
+
+    for (int r = 0; r < rounds; r++) {
+        double start = now_s();
+        for (int i = 0; i < count; i++) {
+            double *value = g_malloc(sizeof(double));
+            *value = i;
+            g_hash_table_insert(table, GINT_TO_POINTER(pids[i]), value);
+        }
+        double mid = now_s();
+        for (int i = 0; i < count; i++) {
+            double *value = g_hash_table_lookup(table, GINT_TO_POINTER(pids[i]));
+            if (value) sink += *value;
+        }
+        double end = now_s();
+        g_hash_table_remove_all(table);
+        costs.insert += mid - start;
+        costs.lookup += end - mid;
+        costs.clear += now_s() - end;
+    }
+    g_hash_table_destroy(table);
+    (void)sink;
+    return costs;
+}
+
+static OpCosts bench_pid_map(const pid_t *pids, int count, int rounds) {
+    PidMap *map = pid_map_new(sizeof(double), 0);
+    OpCosts costs = {0};
+    volatile double sink = 0;
+
+    for (int r = 0; r < rounds; r++) {
+        double start = now_s();
+        for (int i = 0; i < count; i++) {
+            *(double*)pid_map_insert(map, pids[i]) = i;
+        }
+        double mid = now_s();
+        for (int i = 0; i < count; i++) {
+            double *value = pid_map_lookup(map, pids[i]);
+            if (value) sink += *value;
+        }
+        double end = now_s();
+        pid_map_clear(map);
+        costs.insert += mid - start;
+        costs.lookup += end - mid;
+        costs.clear += now_s() - end;
+    }
+    pid_map_free(map);
+    (void)sink;
+    return costs;
+}
+
+static void print_costs(const char *label, OpCosts costs, int count, int rounds) {
+    double ops = (double)count * rounds;
+    printf("  %-22s insert %7.1f ns   lookup %7.1f ns   clear %7.1f ns\n", label,
+           costs.insert / ops * 1e9, costs.lookup / ops * 1e9, costs.clear / ops * 1e9);
+}
+
+static guint32 next_random(guint32 *state) {
+    *state = *state * 1103515245u + 12345u;
+    return *state >> 8;
+}
+
+// Candidate keys: small PIDs, PID -1, PIDs whose home slot is the last or
+// first slot for each table size the map passes through (so clusters wrap
+// around the end), and PIDs scattered over the PID space
+static pid_t* make_check_keys(guint32 *state) {
+    pid_t *keys = g_new(pid_t, CHECK_KEYS);
+    int n = 0;
+    keys[n++] = -1;
+    for (pid_t pid = 0; pid < 512; pid++) keys[n++] = pid;
+    for (guint bits = 4; bits <= 15; bits++) {
+        guint last = (1u << bits) - 1;
+        for (int found = 0; found < 48;) {
+            pid_t pid = 1 + (pid_t)(next_random(state) % (PID_MAX - 1));
+            guint home = ((guint32)pid * 2654435761u) >> (32 - bits);
+            if (home == last || (home == 0 && found % 4 == 0)) {
+                keys[n++] = pid;
+                found++;
+            }
+        }
+    }
+    while (n < CHECK_KEYS) keys[n++] = 1 + (pid_t)(next_random(state) % (PID_MAX - 1));
+    return keys;
+}
+
+typedef struct {
+    GHashTable *reference;          // GINT_TO_POINTER(pid) -> GUINT_TO_POINTER(value)
+    GHashTable *seen;               // PIDs the predicate was called with
+    guint32 salt;
+    guint mismatches;               // Entries the predicate saw that the reference does not hold
+    guint repeats;                  // Entries seen twice
+} CheckState;
+
+// Removes about one entry in four, mirroring each removal in the reference
+static gboolean check_predicate(pid_t pid, gpointer value, gpointer user_data) {
+    CheckState *check = user_data;
+    gpointer expected;
+    if (!g_hash_table_lookup_extended(check->reference, GINT_TO_POINTER(pid), NULL, &expected) ||
+        GPOINTER_TO_UINT(expected) != *(guint32*)value) {
+        check->mismatches++;
+    }
+    if (g_hash_table_contains(check->seen, GINT_TO_POINTER(pid))) check->repeats++;
+    g_hash_table_add(check->seen, GINT_TO_POINTER(pid));
+
+    if (((*(guint32*)value ^ check->salt) & 3) != 0) return FALSE;
+    g_hash_table_remove(check->reference, GINT_TO_POINTER(pid));
+    return TRUE;
+}
+
+static guint map_slots(const PidMap *map) {
+    // Inverse of pid_map_bytes(): slots * key + (slots + 1) * value
+    return (guint)((pid_map_bytes(map) - sizeof(guint32)) / (sizeof(gint32) + sizeof(guint32)));
+}
+
+// Same entries with the same values, both through iteration and lookup
+static gboolean map_matches(const PidMap *map, GHashTable *reference) {
+    if (pid_map_size(map) != g_hash_table_size(reference)) return FALSE;
+
+    guint iter = 0, walked = 0;
+    pid_t pid;
+    gpointer value, expected;
+    while (pid_map_iter_next(map, &iter, &pid, &value)) {
+        if (!g_hash_table_lookup_extended(reference, GINT_TO_POINTER(pid), NULL, &expected) ||
+            GPOINTER_TO_UINT(expected) != *(guint32*)value) {
+            return FALSE;
+        }
+        walked++;
+    }
+    if (walked != g_hash_table_size(reference)) return FALSE;
+
+    GHashTableIter ref_iter;
+    gpointer key;
+    g_hash_table_iter_init(&ref_iter, reference);
+    while (g_hash_table_iter_next(&ref_iter, &key, &expected)) {
+        guint32 *stored = pid_map_lookup(map, GPOINTER_TO_INT(key));
+        if (!stored || *stored != GPOINTER_TO_UINT(expected)) return FALSE;
+    }
+    return TRUE;
+}
+
+int test_pid_map_randomized() {
+    TEST_CASE("PidMap matches GHashTable under random operations");
+
+    guint32 state = 4242;
+    pid_t *keys = make_check_keys(&state);
+    PidMap *map = pid_map_new(sizeof(guint32), 0);
+    CheckState check = { g_hash_table_new(g_direct_hash, g_direct_equal),
+                         g_hash_table_new(g_direct_hash, g_direct_equal), 0, 0, 0 };
+    guint cursor = 0, peak = 0, removed_total = 0;
+
+    for (int step = 1; step <= CHECK_STEPS; step++) {
+        // Grow for a while, then shrink, four times over
+        gboolean growing = (step / (CHECK_STEPS / 8)) % 2 == 0;
+        guint32 op = next_random(&state) % 1000;
+        pid_t pid = keys[next_random(&state) % CHECK_KEYS];
+        gpointer expected;
+        gboolean present = g_hash_table_lookup_extended(check.reference, GINT_TO_POINTER(pid),
+                                                        NULL, &expected);
+
+        if (op < (growing ? 600u : 300u)) {
+            guint32 *value = pid_map_insert(map, pid);
+            ASSERT_EQUAL(present ? GPOINTER_TO_UINT(expected) : 0u, *value,
+                         "Insert should return the stored value, or a zeroed one");
+            *value = next_random(&state) | 1;
+            g_hash_table_insert(check.reference, GINT_TO_POINTER(pid), GUINT_TO_POINTER(*value));
+        } else if (op < 930) {
+            ASSERT_EQUAL(present, pid_map_remove(map, pid), "Remove should report presence");
+            g_hash_table_remove(check.reference, GINT_TO_POINTER(pid));
+        } else if (op < 998) {
+            // Resumable sweep with a small budget, interleaved with the rest
+            check.salt = next_random(&state);
+            g_hash_table_remove_all(check.seen);
+            guint before = g_hash_table_size(check.reference);
+            guint removed = pid_map_sweep(map, &cursor, 1 + next_random(&state) % 16,
+                                          check_predicate, &check);
+            ASSERT_EQUAL(before - g_hash_table_size(check.reference), removed,
+                         "Sweep should count what it removed");
+            removed_total += removed;
+        } else if (op == 998) {
+            check.salt = next_random(&state);
+            g_hash_table_remove_all(check.seen);
+            guint before = g_hash_table_size(check.reference);
+            check.repeats = 0;
+            guint removed = pid_map_remove_if(map, check_predicate, &check);
+            ASSERT_EQUAL(0u, check.repeats, "remove_if should see each entry once");
+            ASSERT_EQUAL(before, g_hash_table_size(check.seen), "remove_if should see every entry");
+            ASSERT_EQUAL(before - g_hash_table_size(check.reference), removed,
+                         "remove_if should count what it removed");
+            removed_total += removed;
+        } else if (!growing) {
+            pid_map_clear(map);
+            g_hash_table_remove_all(check.reference);
+        }
+        ASSERT_EQUAL(0u, check.mismatches, "Predicate should see the stored entries only");
+        ASSERT_EQUAL(g_hash_table_size(check.reference), pid_map_size(map), "Sizes should match");
+        peak = MAX(peak, pid_map_size(map));
+
+        if (step % 5000 == 0) {
+            ASSERT_TRUE(map_matches(map, check.reference), "Contents should match");
+
+            // Sweeps totalling one slot array visit every entry present at the start
+            GHashTable *start = g_hash_table_new(g_direct_hash, g_direct_equal);
+            GHashTableIter iter;
+            gpointer key;
+            g_hash_table_iter_init(&iter, check.reference);
+            while (g_hash_table_iter_next(&iter, &key, NULL)) g_hash_table_add(start, key);
+
+            check.salt = next_random(&state);
+            g_hash_table_remove_all(check.seen);
+            for (guint budget = 0, slots = map_slots(map); budget < slots; budget += 7) {
+                removed_total += pid_map_sweep(map, &cursor, MIN(7, slots - budget),
+                                               check_predicate, &check);
+            }
+            g_hash_table_iter_init(&iter, start);
+            guint missed = 0;
+            while (g_hash_table_iter_next(&iter, &key, NULL)) {
+                if (!g_hash_table_contains(check.seen, key)) missed++;
+            }
+            g_hash_table_destroy(start);
+            ASSERT_EQUAL(0u, missed, "A full round of sweeps should visit every entry");
+            ASSERT_TRUE(map_matches(map, check.reference), "Contents should match after sweeping");
+        }
+    }
+    ASSERT_TRUE(map_matches(map, check.reference), "Final contents should match");
+    printf("(peak %u) ", peak);
+    ASSERT_TRUE(peak > 2048, "Map should have grown through several sizes");
+    ASSERT_TRUE(removed_total > 0, "Sweeps should have removed entries");
+
+    g_hash_table_destroy(check.reference);
+    g_hash_table_destroy(check.seen);
+    pid_map_free(map);
+    g_free(keys);
+    TEST_PASS();
+}
+
+int main(int argc, char *argv[]) {
+    int ops = argc > 1 ? atoi(argv[1]) : 2000000;
+    if (ops <= 0) ops = 2000000;
+
+    TEST_SUITE("PID Map");
+    test_pid_map_randomized();
+    if (test_failed > 0) {
+        TEST_SUMMARY();
+    }
+
+    static const int sizes[] = { 2000, 20000, 100000 };
+    printf("\n🚀 PID Map Benchmark (%d operations per size, ns per entry)\n", ops);
+
+    for (size_t s = 0; s < G_N_ELEMENTS(sizes); s++) {
+        int count = sizes[s];
+        int rounds = MAX(1, ops / count);
+        pid_t *pids = make_pids(count);
+
+        printf("\n%d PIDs, %d cycles:\n", count, rounds);
+        print_costs("GHashTable (strings)", bench_string_table(pids, count, rounds), count, rounds);
+        print_costs("GHashTable (direct)", bench_direct_table(pids, count, rounds), count, rounds);
+        print_costs("PidMap", bench_pid_map(pids, count, rounds), count, rounds);
+        g_free(pids);
+    }
+    return 0;
+}
@@ -0,0 +1,61 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../src/system/collector_backend.h"
+#include "../src/system/proc_reader.h"
+#include "../src/utils/utils.h"
+#include "bench_common.h"
+
+// Per-process file I/O of the proc backend, io_uring against pread():
+// syscalls spent on /proc/[pid]/stat and statm per cycle, and wall time per
+// cycle. The first cycle opens every file; the steady state only re-reads.
+// Set TASKMINI_PROC_ROOT to measure a synthetic tree instead of /proc.
+//
+// Usage: tests/bench_proc_io [samples]
+
+static void bench_mode(const char *mode, int samples) {
+    setenv("TASKMINI_PROC_IO", mode, 1);
+    CollectorBackend *backend = collector_backend_create("proc");
+    if (!backend) {
+        printf("proc backend not available on this platform\n");
+        return;
+    }
+
+    // First cycle: opens every process's files
+    double start = now_ms();
+    UpdateData *data = collector_backend_collect(backend);
+    double first_ms = now_ms() - start;
+    guint64 first_syscalls = backend->last_file_syscalls;
+    guint rows = data ? data->processes->count : 0;
+    if (data) free_update_data(data);
+
+    guint64 syscalls = 0;
+    start = now_ms();
+    for (int i = 0; i < samples; i++) {
+        data = collector_backend_collect(backend);
+        syscalls += backend->last_file_syscalls;
+        if (!data) continue;
+        rows = data->processes->count;
+        free_update_data(data);
+    }
+    double per_cycle = (now_ms() - start) / samples;
+    double per_cycle_syscalls = (double)syscalls / samples;
+    collector_backend_destroy(backend);
+
+    printf("%-9s first cycle %8.2f ms %7llu syscalls | steady %8.2f ms %9.1f syscalls (%.2f/process)  %6u rows\n",
+           mode, first_ms, (unsigned long long)first_syscalls, per_cycle, per_cycle_syscalls,
+           rows ? per_cycle_syscalls / rows : 0.0, rows);
+}
+
+int main(int argc, char *argv[]) {
+    int samples = argc > 1 ? atoi(argv[1]) : 20;
+    if (samples <= 0) samples = 20;
+
+    printf("🚀 Proc File I/O Benchmark (%d samples, io_uring %s)\n\n", samples,
+           proc_io_uring_available() ? "available" : "unavailable - both rows use pread");
+
+    bench_mode("pread", samples);
+    bench_mode("uring", samples);
+    return 0;
+}
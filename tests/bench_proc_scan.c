@@ -0,0 +1,127 @@
+#define _XOPEN_SOURCE 700
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ftw.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "../src/system/collector_backend.h"
+#include "../src/utils/utils.h"
+#include "bench_common.h"
+
+// Scan time of the proc backend against the number of scan threads, on a
+// synthetic /proc tree (TASKMINI_PROC_ROOT) with a build-host-sized PID
+// count. Real /proc files are generated by the kernel on read, so absolute
+// times there are higher; the scaling is what this measures.
+//
+// Usage: tests/bench_proc_scan [processes] [samples] [max_threads]
+
+static void write_file(const char *root, const char *name, const char *text) {
+    char path[1024];
+    snprintf(path, sizeof(path), "%s/%s", root, name);
+    FILE *fp = fopen(path, "w");
+    if (!fp) return;
+    fputs(text, fp);
+    fclose(fp);
+}
+
+static void build_tree(const char *root, int processes) {
+    write_file(root, "stat", "cpu  4705 150 1120 16250 520 0 30 0 0 0\n"
+                             "cpu0 2350 75 560 8125 260 0 15 0 0 0\n"
+                             "cpu1 2355 75 560 8125 260 0 15 0 0 0\n"
+                             "intr 0\n");
+    write_file(root, "meminfo", "MemTotal:       65536000 kB\nMemFree:        1024000 kB\n"
+                                "MemAvailable:   32768000 kB\n");
+    write_file(root, "loadavg", "12.50 11.75 10.90 3/60000 123456\n");
+    write_file(root, "uptime", "86400.00 1000000.00\n");
+
+    char name[64], text[512];
+    for (int i = 0; i < processes; i++) {
+        int pid = 100 + i;
+        snprintf(name, sizeof(name), "%d", pid);
+        char dir[1024];
+        snprintf(dir, sizeof(dir), "%s/%s", root, name);
+        mkdir(dir, 0755);
+
+        snprintf(name, sizeof(name), "%d/stat", pid);
+        snprintf(text, sizeof(text),
+                 "%d (worker %d) %c 1 %d %d 0 -1 4194560 100 0 0 0 %d %d 0 0 20 0 1 0 %d "
+                 "10000000 500 18446744073709551615 0 0 0 0 0 0 0 0 0 0 0 0 17 0 0 0 0 0 0\n",
+                 pid, i, i % 7 == 0 ? 'R' : 'S', pid, pid, i % 500, i % 300, 1000 + i);
+        write_file(root, name, text);
+
+        snprintf(name, sizeof(name), "%d/statm", pid);
+        snprintf(text, sizeof(text), "%d %d 100 10 0 200 0\n", 2000 + i, 500 + i % 1000);
+        write_file(root, name, text);
+    }
+}
+
+static int remove_entry(const char *path, const struct stat *st, int flag, struct FTW *ftw) {
+    (void)st; (void)flag; (void)ftw;
+    return remove(path);
+}
+
+static void bench_threads(int threads, int samples) {
+    char value[16];
+    snprintf(value, sizeof(value), "%d", threads);
+    setenv("TASKMINI_PROC_THREADS", value, 1);
+
+    CollectorBackend *backend = collector_backend_create("proc");
+    if (!backend) {
+        printf("proc backend not available on this platform\n");
+        return;
+    }
+    // Shard 0 is read on this thread, like on the collector
+    WorkerPool *pool = threads > 1 ? worker_pool_new((guint)threads - 1) : NULL;
+    backend->pool = pool;
+    UpdateData *data = collector_backend_collect(backend);  // Warm page cache and buffers
+    if (data) free_update_data(data);
+
+    guint rows = 0;
+    double start = now_ms();
+    for (int i = 0; i < samples; i++) {
+        data = collector_backend_collect(backend);
+        if (!data) continue;
+        rows = data->processes->count;
+        free_update_data(data);
+    }
+    double per_scan = (now_ms() - start) / samples;
+    collector_backend_destroy(backend);
+    worker_pool_free(pool);
+
+    static double single_thread_ms = 0;
+    if (threads == 1) single_thread_ms = per_scan;
+    printf("%2d thread%s %9.2f ms/scan  %6u rows  %5.2fx\n", threads, threads == 1 ? " " : "s",
+           per_scan, rows, single_thread_ms > 0 ? single_thread_ms / per_scan : 1.0);
+}
+
+int main(int argc, char *argv[]) {
+    int processes = argc > 1 ? atoi(argv[1]) : 20000;
+    int samples = argc > 2 ? atoi(argv[2]) : 5;
+    int max_threads = argc > 3 ? atoi(argv[3]) : 16;
+    if (processes <= 0) processes = 20000;
+    if (samples <= 0) samples = 5;
+    if (max_threads <= 0) max_threads = 16;
+
+    char root[] = "/tmp/taskmini_proc_XXXXXX";
+    if (!mkdtemp(root)) {
+        perror("mkdtemp");
+        return 1;
+    }
+
+    printf("🚀 Proc Scan Benchmark (%d processes, %d samples, %u cores)\n\n",
+           processes, samples, g_get_num_processors());
+    double start = now_ms();
+    build_tree(root, processes);
+    printf("synthetic tree built in %.0f ms\n\n", now_ms() - start);
+
+    setenv("TASKMINI_PROC_ROOT", root, 1);
+    setenv("TASKMINI_MAX_PROCESSES", "131072", 1);
+    for (int threads = 1; threads <= max_threads; threads *= 2) {
+        bench_threads(threads, samples);
+    }
+
+    nftw(root, remove_entry, 16, FTW_DEPTH | FTW_PHYS);
+    return 0;
+}
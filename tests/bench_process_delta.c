@@ -0,0 +1,228 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../src/system/process_delta.h"
+#include "../src/system/snapshot.h"
+#include "../src/ui/process_model.h"
+#include "../src/utils/utils.h"
+#include "bench_common.h"
+#include "taskmini_tests.h"
+
+// Checks process_delta_compute() against a hand-built pair of tables
+// covering added, removed, changed and unchanged rows, and that the
+// process model signals exactly those rows on both of its update paths
+// (collector delta and local diff). Then times the delta on a large table.
+//
+// Usage: tests/bench_process_delta [cycles] [processes]
+
+static ProcessSample make_sample(pid_t pid, const char *name) {
+    ProcessSample sample;
+    memset(&sample, 0, sizeof(sample));
+    sample.pid = pid;
+    sample.uid = 501;
+    sample.cpu = 1.5f;
+    sample.rss_bytes = 64ULL << 20;
+    sample.net_bps = 1024;
+    sample.start_time = 1700000000;
+    sample.flags = PROCESS_FLAG_HAS_START;
+    process_set_name(&sample, name, -1);
+    return sample;
+}
+
+// PIDs 100-111 with identical fields
+static UpdateData* make_old_data(void) {
+    UpdateData *data = g_new0(UpdateData, 1);
+    data->processes = process_table_new(0);
+    for (pid_t pid = 100; pid <= 111; pid++) {
+        ProcessSample sample = make_sample(pid, "worker");
+        process_table_add(data->processes, &sample);
+    }
+    return data;
+}
+
+// The next cycle: 110 and 111 exited, 200-202 started (rows 0, 6 and 12),
+// 100-103 are unchanged and 104-109 each change in one way
+static UpdateData* make_new_data(void) {
+    UpdateData *data = g_new0(UpdateData, 1);
+    data->processes = process_table_new(0);
+    ProcessTable *table = data->processes;
+    ProcessSample sample;
+
+    sample = make_sample(200, "new-a");
+    process_table_add(table, &sample);
+    for (pid_t pid = 100; pid <= 109; pid++) {
+        if (pid == 105) {
+            sample = make_sample(201, "new-b");
+            process_table_add(table, &sample);
+        }
+        sample = make_sample(pid, "worker");
+        switch (pid) {
+            case 104: sample.cpu = 42.0f; sample.net_bps = 4096; break;
+            case 105: process_set_name(&sample, "renamed", -1); break;
+            case 106: sample.rss_bytes = 65ULL << 20; break;
+            case 107: sample.gpu = 0.0f; sample.flags |= PROCESS_FLAG_HAS_GPU; break;
+            case 108: sample.flags |= PROCESS_FLAG_SYSTEM; break;
+            case 109: sample.start_time++; break;
+            default: break;
+        }
+        process_table_add(table, &sample);
+    }
+    sample = make_sample(202, "new-c");
+    process_table_add(table, &sample);
+    return data;
+}
+
+static const guint32 expected_added[] = { 0, 6, 12 };
+static const pid_t expected_removed[] = { 110, 111 };
+static const ProcessChange expected_changed[] = {
+    { 104, 5, PROCESS_FIELD_CPU | PROCESS_FIELD_NET },
+    { 105, 7, PROCESS_FIELD_NAME },
+    { 106, 8, PROCESS_FIELD_MEM },
+    { 107, 9, PROCESS_FIELD_GPU },
+    { 108, 10, PROCESS_FIELD_TYPE },
+    { 109, 11, PROCESS_FIELD_START },
+};
+#define EXPECTED_TOUCHED (G_N_ELEMENTS(expected_added) + G_N_ELEMENTS(expected_removed) + \
+                          G_N_ELEMENTS(expected_changed))
+
+int test_delta_exact() {
+    TEST_CASE("Delta of added, removed, changed and unchanged rows");
+
+    UpdateData *old_data = make_old_data();
+    UpdateData *new_data = make_new_data();
+    ASSERT_EQUAL(13u, new_data->processes->count, "New table should have 13 rows");
+
+    ProcessDelta *delta = process_delta_compute(old_data->processes, new_data->processes);
+
+    ASSERT_EQUAL(G_N_ELEMENTS(expected_added), delta->added->len, "Added row count");
+    for (guint i = 0; i < delta->added->len; i++) {
+        ASSERT_EQUAL(expected_added[i], g_array_index(delta->added, guint32, i), "Added row index");
+    }
+    ASSERT_EQUAL(G_N_ELEMENTS(expected_removed), delta->removed->len, "Removed row count");
+    for (guint i = 0; i < delta->removed->len; i++) {
+        ASSERT_EQUAL(expected_removed[i], g_array_index(delta->removed, pid_t, i), "Removed PID");
+    }
+    ASSERT_EQUAL(G_N_ELEMENTS(expected_changed), delta->changed->len, "Changed row count");
+    for (guint i = 0; i < delta->changed->len; i++) {
+        const ProcessChange *change = &g_array_index(delta->changed, ProcessChange, i);
+        ASSERT_EQUAL(expected_changed[i].pid, change->pid, "Changed PID");
+        ASSERT_EQUAL(expected_changed[i].index, change->index, "Changed row index");
+        ASSERT_EQUAL(expected_changed[i].fields, change->fields, "Changed fields");
+    }
+    process_delta_free(delta);
+
+    // Same table on both sides: nothing
+    delta = process_delta_compute(new_data->processes, new_data->processes);
+    ASSERT_EQUAL(0u, delta->added->len + delta->removed->len + delta->changed->len,
+                 "Identical tables should give an empty delta");
+    process_delta_free(delta);
+
+    // No previous table: every row is added, in order
+    delta = process_delta_compute(NULL, old_data->processes);
+    ASSERT_EQUAL(12u, delta->added->len, "Every row should be added without an old table");
+    ASSERT_EQUAL(11u, g_array_index(delta->added, guint32, 11), "Added rows should be in table order");
+    ASSERT_EQUAL(0u, delta->removed->len + delta->changed->len, "Nothing removed or changed");
+    process_delta_free(delta);
+
+    free_update_data(old_data);
+    free_update_data(new_data);
+    TEST_PASS();
+}
+
+// Rows the model signalled for old -> new, NULL slot: local diff
+static guint model_rows_touched(SnapshotSlot *slot, ProcessModelStats *stats) {
+    ProcessModel *model = process_model_new();
+    Snapshot *old_snapshot, *new_snapshot;
+
+    if (slot) {
+        snapshot_slot_publish(slot, make_old_data());
+        old_snapshot = snapshot_slot_acquire(slot);
+        snapshot_slot_publish(slot, make_new_data());
+        new_snapshot = snapshot_slot_acquire(slot);
+    } else {
+        old_snapshot = snapshot_new(make_old_data());
+        new_snapshot = snapshot_new(make_new_data());
+    }
+
+    process_model_set_snapshot(model, old_snapshot);
+    ProcessModelStats before;
+    process_model_get_stats(model, &before);
+
+    process_model_set_snapshot(model, new_snapshot);
+    process_model_get_stats(model, stats);
+    stats->rows_inserted -= before.rows_inserted;
+    stats->rows_deleted -= before.rows_deleted;
+    stats->rows_changed -= before.rows_changed;
+
+    snapshot_unref(old_snapshot);
+    snapshot_unref(new_snapshot);
+    g_object_unref(model);
+    return stats->rows_touched_last;
+}
+
+int test_model_rows_touched() {
+    TEST_CASE("Process model signals exactly the delta rows");
+
+    SnapshotSlot slot;
+    snapshot_slot_init(&slot);
+    ProcessModelStats stats;
+
+    // Consecutive snapshots: the model uses the collector's delta
+    guint touched = model_rows_touched(&slot, &stats);
+    ASSERT_EQUAL(EXPECTED_TOUCHED, touched, "rows_touched_last with the collector delta");
+    ASSERT_EQUAL(G_N_ELEMENTS(expected_added), stats.rows_inserted, "Inserted rows");
+    ASSERT_EQUAL(G_N_ELEMENTS(expected_removed), stats.rows_deleted, "Deleted rows");
+    ASSERT_EQUAL(G_N_ELEMENTS(expected_changed), stats.rows_changed, "Changed rows");
+    snapshot_slot_clear(&slot);
+
+    // Unpublished snapshots: the model diffs locally, same result
+    touched = model_rows_touched(NULL, &stats);
+    ASSERT_EQUAL(EXPECTED_TOUCHED, touched, "rows_touched_last with a local diff");
+    ASSERT_EQUAL(G_N_ELEMENTS(expected_changed), stats.rows_changed, "Changed rows (local diff)");
+
+    TEST_PASS();
+}
+
+int main(int argc, char *argv[]) {
+    int cycles = argc > 1 ? atoi(argv[1]) : 50;
+    int process_count = argc > 2 ? atoi(argv[2]) : 10000;
+    if (cycles <= 0) cycles = 50;
+    if (process_count <= 0) process_count = 10000;
+
+    init_process_pool();
+
+    TEST_SUITE("Process Delta");
+    test_delta_exact();
+    test_model_rows_touched();
+    if (test_failed > 0) {
+        TEST_SUMMARY();
+    }
+
+    printf("\n🚀 Process Delta Benchmark (%d cycles, %d processes, 5%% churn)\n\n", cycles, process_count);
+
+    ProcessTable *previous = bench_make_table(process_count, 0);
+    double total_ms = 0, worst_ms = 0;
+    guint64 rows = 0;
+    for (int cycle = 1; cycle <= cycles; cycle++) {
+        ProcessTable *table = bench_make_table(process_count, cycle);
+
+        double start = now_ms();
+        ProcessDelta *delta = process_delta_compute(previous, table);
+        double elapsed = now_ms() - start;
+
+        rows += delta->added->len + delta->removed->len + delta->changed->len;
+        process_delta_free(delta);
+        process_table_free(previous);
+        previous = table;
+        total_ms += elapsed;
+        if (elapsed > worst_ms) worst_ms = elapsed;
+    }
+    process_table_free(previous);
+
+    printf("Delta: %.3f ms avg, %.3f ms worst, %.0f rows per cycle\n",
+           total_ms / cycles, worst_ms, (double)rows / cycles);
+
+    cleanup_process_pool();
+    return 0;
+}
@@ -0,0 +1,116 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../src/utils/utils.h"
+#include "bench_common.h"
+
+// One collection cycle on a synthetic snapshot: build the rows, merge
+// per-PID values into them, diff against the previous cycle and free.
+// Compares the recycled contiguous ProcessTable with a GList of pooled
+// samples (the previous UpdateData layout).
+//
+// Usage: tests/bench_process_table [cycles] [processes]
+
+static guint64 bench_table(int cycles, int process_count, double *elapsed_ms) {
+    ProcessTable *previous = NULL;
+    guint64 matched = 0;
+    double start = now_ms();
+
+    for (int cycle = 0; cycle < cycles; cycle++) {
+        ProcessTable *table = process_table_acquire();
+        for (int i = 0; i < process_count; i++) {
+            ProcessSample sample;
+            bench_fill_sample(&sample, i, cycle);
+            process_table_add(table, &sample);
+        }
+
+        // Merge: per-PID update through the index
+        for (int i = 0; i < process_count; i++) {
+            ProcessSample *proc = process_table_lookup(table, bench_pid(i, cycle));
+            if (proc) proc->rss_bytes = (guint64)i * 4096;
+        }
+
+        // Diff: which rows existed in the previous cycle
+        for (guint i = 0; previous && i < table->count; i++) {
+            if (process_table_lookup(previous, table->items[i].pid)) matched++;
+        }
+
+        process_table_release(previous);
+        previous = table;
+    }
+    process_table_release(previous);
+
+    *elapsed_ms = now_ms() - start;
+    return matched;
+}
+
+static guint64 bench_list(int cycles, int process_count, double *elapsed_ms) {
+    GList *previous = NULL;
+    guint64 matched = 0;
+    double start = now_ms();
+
+    for (int cycle = 0; cycle < cycles; cycle++) {
+        GList *list = NULL;
+        for (int i = 0; i < process_count; i++) {
+            ProcessSample *proc = alloc_process();
+            bench_fill_sample(proc, i, cycle);
+            list = g_list_prepend(list, proc);
+        }
+        list = g_list_reverse(list);
+
+        // Merge and diff through a PID hash, as the old code did per cycle
+        GHashTable *by_pid = g_hash_table_new(g_direct_hash, g_direct_equal);
+        for (GList *l = list; l; l = l->next) {
+            ProcessSample *proc = l->data;
+            g_hash_table_insert(by_pid, GINT_TO_POINTER(proc->pid), proc);
+        }
+        for (int i = 0; i < process_count; i++) {
+            ProcessSample *proc = g_hash_table_lookup(by_pid, GINT_TO_POINTER(bench_pid(i, cycle)));
+            if (proc) proc->rss_bytes = (guint64)i * 4096;
+        }
+        g_hash_table_destroy(by_pid);
+
+        GHashTable *prev_pids = g_hash_table_new(g_direct_hash, g_direct_equal);
+        for (GList *l = previous; l; l = l->next) {
+            ProcessSample *proc = l->data;
+            g_hash_table_add(prev_pids, GINT_TO_POINTER(proc->pid));
+        }
+        for (GList *l = list; previous && l; l = l->next) {
+            ProcessSample *proc = l->data;
+            if (g_hash_table_contains(prev_pids, GINT_TO_POINTER(proc->pid))) matched++;
+        }
+        g_hash_table_destroy(prev_pids);
+
+        g_list_free_full(previous, (GDestroyNotify)free_process);
+        previous = list;
+    }
+    g_list_free_full(previous, (GDestroyNotify)free_process);
+
+    *elapsed_ms = now_ms() - start;
+    return matched;
+}
+
+int main(int argc, char *argv[]) {
+    int cycles = argc > 1 ? atoi(argv[1]) : 200;
+    int process_count = argc > 2 ? atoi(argv[2]) : 2000;
+    if (cycles <= 0) cycles = 200;
+    if (process_count <= 0) process_count = 2000;
+
+    init_process_pool();
+
+    printf("🚀 Process Table Benchmark (%d cycles, %d processes)\n\n", cycles, process_count);
+
+    double table_ms, list_ms;
+    guint64 table_matched = bench_table(cycles, process_count, &table_ms);
+    guint64 list_matched = bench_list(cycles, process_count, &list_ms);
+
+    printf("ProcessTable: %.3f ms/cycle (%llu rows matched)\n",
+           table_ms / cycles, (unsigned long long)table_matched);
+    printf("GList:        %.3f ms/cycle (%llu rows matched)\n",
+           list_ms / cycles, (unsigned long long)list_matched);
+
+    process_table_recycler_cleanup();
+    cleanup_process_pool();
+    return 0;
+}
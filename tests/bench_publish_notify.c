@@ -0,0 +1,138 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../src/system/snapshot.h"
+#include "../src/utils/utils.h"
+
+// Publish notifications delivered to a GLib main loop, coalesced the way the
+// UI does it (one queued callback at a time, reading the latest snapshot):
+//   - main loop wakeups against publishes, for a steady 500 ms cadence and
+//     for bursts faster than the loop can render
+//   - delay from publish to the render of that snapshot, against the
+//     average half interval of the old 1 s polling timer
+//   - wakeups while nothing is published
+//
+// Usage: tests/bench_publish_notify [processes]
+
+typedef struct {
+    SnapshotSlot slot;
+    GMainLoop *loop;
+    int process_count;
+    gint pending;
+
+    // Main loop only
+    guint64 rendered_sequence;
+    guint wakeups;
+    guint renders;
+    double latency_total_ms;
+    double latency_max_ms;
+
+    gint64 published_us[1024];  // By sequence % 1024, written before publish
+} BenchState;
+
+typedef struct {
+    BenchState *state;
+    int count;
+    int interval_ms;
+    int tail_ms;                // Quiet time after the last publish
+} WriterArgs;
+
+static UpdateData* make_update_data(int process_count, guint seed) {
+    UpdateData *data = g_malloc0(sizeof(UpdateData));
+    data->processes = process_table_acquire();
+    for (int i = 0; i < process_count; i++) {
+        ProcessSample proc;
+        memset(&proc, 0, sizeof(proc));
+        proc.pid = 100 + i;
+        proc.cpu = (float)((i + seed) % 100);
+        proc.rss_bytes = (guint64)(i + 1) * 4096;
+        char name[STRING_INTERN_MAX];
+        snprintf(name, sizeof(name), "process-%d", i);
+        process_set_name(&proc, name, -1);
+        process_table_add(data->processes, &proc);
+    }
+    data->system_summary = g_strdup("Processes: synthetic");
+    data->gpu_usage = g_strdup("0.0%");
+    return data;
+}
+
+static gboolean ready_callback(gpointer data) {
+    BenchState *state = data;
+    state->wakeups++;
+    g_atomic_int_set(&state->pending, 0);
+
+    Snapshot *snapshot = snapshot_slot_acquire(&state->slot);
+    if (snapshot && snapshot->sequence != state->rendered_sequence) {
+        double latency = (g_get_monotonic_time() - state->published_us[snapshot->sequence % 1024]) / 1000.0;
+        state->latency_total_ms += latency;
+        state->latency_max_ms = MAX(state->latency_max_ms, latency);
+        state->rendered_sequence = snapshot->sequence;
+        state->renders++;
+    }
+    snapshot_unref(snapshot);
+    return G_SOURCE_REMOVE;
+}
+
+static void on_published(guint64 sequence, gpointer user_data) {
+    (void)sequence;
+    BenchState *state = user_data;
+    if (g_atomic_int_compare_and_exchange(&state->pending, 0, 1)) {
+        g_main_context_invoke(NULL, ready_callback, state);
+    }
+}
+
+static gboolean quit_callback(gpointer data) {
+    g_main_loop_quit(data);
+    return G_SOURCE_REMOVE;
+}
+
+static gpointer writer_thread(gpointer data) {
+    WriterArgs *args = data;
+    BenchState *state = args->state;
+
+    for (int i = 0; i < args->count; i++) {
+        // The writer is the slot's only publisher, so it knows the next number
+        state->published_us[state->slot.next_sequence % 1024] = g_get_monotonic_time();
+        snapshot_slot_publish(&state->slot, make_update_data(state->process_count, (guint)i));
+        if (args->interval_ms > 0) g_usleep((gulong)args->interval_ms * 1000);
+    }
+    g_usleep((gulong)args->tail_ms * 1000);
+    g_main_context_invoke(NULL, quit_callback, state->loop);
+    return NULL;
+}
+
+static void run_case(const char *label, int process_count, int count, int interval_ms, int tail_ms) {
+    BenchState *state = g_new0(BenchState, 1);
+    snapshot_slot_init(&state->slot);
+    state->loop = g_main_loop_new(NULL, FALSE);
+    state->process_count = process_count;
+    snapshot_slot_set_notify(&state->slot, on_published, state);
+
+    WriterArgs args = { state, count, interval_ms, tail_ms };
+    GThread *thread = g_thread_new("writer", writer_thread, &args);
+    g_main_loop_run(state->loop);
+    g_thread_join(thread);
+
+    printf("%-22s %5d publishes  %5u wakeups  %5u renders  latency avg %7.3f ms  max %7.3f ms\n",
+           label, count, state->wakeups, state->renders,
+           state->renders ? state->latency_total_ms / state->renders : 0.0, state->latency_max_ms);
+
+    snapshot_slot_clear(&state->slot);
+    g_main_loop_unref(state->loop);
+    g_free(state);
+}
+
+int main(int argc, char *argv[]) {
+    int processes = argc > 1 ? atoi(argv[1]) : 500;
+    if (processes <= 0) processes = 500;
+
+    printf("🚀 Publish Notification Benchmark (%d processes)\n\n", processes);
+
+    run_case("steady 500 ms", processes, 8, 500, 100);
+    run_case("burst, no pause", processes, 1000, 0, 100);
+    run_case("idle 2 s", processes, 0, 0, 2000);
+
+    printf("\n1 s polling timer: 1 wakeup/s even when idle, average delay 500 ms\n");
+    return 0;
+}
@@ -0,0 +1,252 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../src/utils/pid_map.h"
+#include "../src/utils/rate_store.h"
+#include "../src/common/config.h"
+#include "bench_common.h"
+#include "taskmini_tests.h"
+
+// Network rate state on a host with constant short-lived processes (a CI
+// runner): each cycle a share of the live processes exits and new ones
+// start with fresh PIDs. The old prev_net_bytes / prev_times maps kept an
+// entry for every PID ever seen; the RateStore sweeps exited processes.
+//   - entries and memory held after growing numbers of cycles
+//   - cost per rate update
+// First checks the eviction bound, PID reuse and the entry cap.
+//
+// Usage: tests/bench_rate_store [live_processes] [churn_percent] [cycles]
+
+#define PID_MAX 4194304             // Linux pid_max on 64-bit systems
+
+typedef struct {
+    pid_t pid;
+    guint64 start_time;
+    guint64 bytes;
+} LiveProcess;
+
+#define EVICT_PROCESSES 5000
+
+static guint store_entries(const RateStore *store) {
+    RateStoreStats stats;
+    rate_store_get_stats(store, &stats);
+    return stats.entries;
+}
+
+// Processes that stop being updated are kept for RATE_STORE_STALE_CYCLES
+// advances and gone after RATE_STORE_SWEEP_CYCLES more, even when the
+// store is far larger than one cycle's sweep
+int test_stale_eviction() {
+    TEST_CASE("Exited processes are evicted within the documented cycles");
+
+    RateStore *store = rate_store_new(0);
+    for (pid_t pid = 1; pid <= EVICT_PROCESSES; pid++) {
+        rate_store_update(store, pid, 1, RATE_COUNTER_NET_BYTES, 100, 0, NULL);
+    }
+    rate_store_advance(store);
+
+    // Half keep running; the rest exit after the first cycle
+    for (int cycle = 2; cycle <= RATE_STORE_STALE_CYCLES + RATE_STORE_SWEEP_CYCLES; cycle++) {
+        for (pid_t pid = 1; pid <= EVICT_PROCESSES / 2; pid++) {
+            RateDelta delta;
+            ASSERT_TRUE(rate_store_update(store, pid, 1, RATE_COUNTER_NET_BYTES, 100u * cycle,
+                                          cycle * 1000000LL, &delta),
+                        "Running processes should keep their rate");
+        }
+        if (cycle <= RATE_STORE_STALE_CYCLES + 1) {
+            ASSERT_EQUAL(EVICT_PROCESSES, store_entries(store), "Nothing is stale yet");
+        }
+        rate_store_advance(store);
+    }
+    ASSERT_EQUAL(EVICT_PROCESSES / 2, store_entries(store),
+                 "Exited processes should be gone after STALE + SWEEP cycles");
+
+    RateStoreStats stats;
+    rate_store_get_stats(store, &stats);
+    ASSERT_EQUAL((guint64)EVICT_PROCESSES / 2, stats.evicted, "Evictions should be counted");
+    ASSERT_EQUAL(0u, stats.rejected, "Nothing should be rejected");
+    rate_store_free(store);
+    TEST_PASS();
+}
+
+// A PID taken by a new process diffs against nothing, then against the
+// new process's own samples
+int test_pid_reuse() {
+    TEST_CASE("Reused PID starts over");
+
+    RateStore *store = rate_store_new(0);
+    RateDelta delta = { 0, 0 };
+    ASSERT_FALSE(rate_store_update(store, 500, 10, RATE_COUNTER_NET_BYTES, 1000, 0, &delta),
+                 "First sample has no rate");
+    ASSERT_TRUE(rate_store_update(store, 500, 10, RATE_COUNTER_NET_BYTES, 1500, 1000000, &delta),
+                "Second sample of the same process has a rate");
+    ASSERT_EQUAL(500u, delta.increase, "Increase since the first sample");
+    ASSERT_TRUE(delta.seconds == 1.0, "One second between samples");
+
+    delta = (RateDelta){ 12345, 99.0 };
+    ASSERT_FALSE(rate_store_update(store, 500, 20, RATE_COUNTER_NET_BYTES, 40, 2000000, &delta),
+                 "New start time should reset the entry");
+    ASSERT_EQUAL(12345u, delta.increase, "No delta for a reused PID");
+    ASSERT_TRUE(rate_store_update(store, 500, 20, RATE_COUNTER_NET_BYTES, 90, 3000000, &delta),
+                "The new process has a rate from its second sample");
+    ASSERT_EQUAL(50u, delta.increase, "Increase against the new process only");
+
+    // Counters are independent, and one going backwards gives no increase
+    ASSERT_FALSE(rate_store_update(store, 500, 20, RATE_COUNTER_CPU_TICKS, 7, 3000000, &delta),
+                 "First CPU sample has no rate");
+    ASSERT_TRUE(rate_store_update(store, 500, 20, RATE_COUNTER_NET_BYTES, 10, 4000000, &delta),
+                "Counter reset still has a previous sample");
+    ASSERT_EQUAL(0u, delta.increase, "Counter going backwards gives no increase");
+    ASSERT_EQUAL(1u, store_entries(store), "One entry per PID");
+
+    rate_store_free(store);
+    TEST_PASS();
+}
+
+int test_max_entries() {
+    TEST_CASE("Store stays within max_entries");
+
+    const guint max = 64;
+    RateStore *store = rate_store_new(max);
+    for (pid_t pid = 1; pid <= (pid_t)max; pid++) {
+        rate_store_update(store, pid, 1, RATE_COUNTER_NET_BYTES, 1, 0, NULL);
+    }
+    ASSERT_FALSE(rate_store_update(store, 1000, 1, RATE_COUNTER_NET_BYTES, 1, 0, NULL),
+                 "A full store should refuse a new process");
+    ASSERT_TRUE(rate_store_update(store, 1, 1, RATE_COUNTER_NET_BYTES, 2, 1000000, NULL),
+                "A full store should still update tracked processes");
+    RateStoreStats stats;
+    rate_store_get_stats(store, &stats);
+    ASSERT_EQUAL(max, stats.entries, "Entries at the cap");
+    ASSERT_EQUAL(1u, stats.rejected, "The refused update should be counted");
+
+    // Every tracked process keeps running: newcomers are refused each cycle
+    for (int cycle = 1; cycle <= 2 * (RATE_STORE_STALE_CYCLES + RATE_STORE_SWEEP_CYCLES); cycle++) {
+        for (pid_t pid = 1; pid <= (pid_t)max; pid++) {
+            rate_store_update(store, pid, 1, RATE_COUNTER_NET_BYTES, 2, 0, NULL);
+        }
+        rate_store_update(store, 1000 + cycle, 1, RATE_COUNTER_NET_BYTES, 1, 0, NULL);
+        rate_store_advance(store);
+    }
+    rate_store_get_stats(store, &stats);
+    ASSERT_EQUAL(max, stats.entries, "Entries should never exceed the cap");
+    ASSERT_EQUAL(1u + 2 * (RATE_STORE_STALE_CYCLES + RATE_STORE_SWEEP_CYCLES), stats.rejected,
+                 "Every refused newcomer should be counted");
+    ASSERT_EQUAL(0u, stats.evicted, "Running processes should not be evicted");
+
+    // Once half of them exit and go stale, newcomers fit again
+    for (int cycle = 0; cycle <= RATE_STORE_STALE_CYCLES; cycle++) {
+        for (pid_t pid = 1; pid <= (pid_t)max / 2; pid++) {
+            rate_store_update(store, pid, 1, RATE_COUNTER_NET_BYTES, 3, 0, NULL);
+        }
+        rate_store_advance(store);
+    }
+    for (pid_t pid = 2000; pid < 2000 + (pid_t)max; pid++) {
+        rate_store_update(store, pid, 1, RATE_COUNTER_NET_BYTES, 1, 0, NULL);
+    }
+    rate_store_get_stats(store, &stats);
+    ASSERT_EQUAL(max, stats.entries, "Freed room should be refilled up to the cap");
+    ASSERT_EQUAL((guint64)max / 2, stats.evicted, "Stale entries should make room");
+    ASSERT_EQUAL(1u + 2 * (RATE_STORE_STALE_CYCLES + RATE_STORE_SWEEP_CYCLES) + max / 2, stats.rejected,
+                 "Newcomers past the cap should be counted");
+
+    rate_store_free(store);
+    TEST_PASS();
+}
+
+int main(int argc, char *argv[]) {
+    int live = argc > 1 ? atoi(argv[1]) : 2000;
+    int churn = argc > 2 ? atoi(argv[2]) : 20;
+    int cycles = argc > 3 ? atoi(argv[3]) : 2000;
+    if (live <= 0) live = 2000;
+    if (churn < 0 || churn > 100) churn = 20;
+    if (cycles <= 0) cycles = 2000;
+
+    TEST_SUITE("Rate Store");
+    test_stale_eviction();
+    test_pid_reuse();
+    test_max_entries();
+    if (test_failed > 0) {
+        TEST_SUMMARY();
+    }
+
+    printf("\n🚀 Rate Store Benchmark (%d live processes, %d%% replaced per cycle, %d cycles)\n\n",
+           live, churn, cycles);
+
+    LiveProcess *procs = g_new0(LiveProcess, live);
+    pid_t next_pid = 300;
+    for (int i = 0; i < live; i++) {
+        procs[i].pid = next_pid++;
+        procs[i].start_time = 1;
+    }
+
+    PidMap *prev_net_bytes = pid_map_new(sizeof(long long), 0);
+    PidMap *prev_times = pid_map_new(sizeof(double), 0);
+    RateStore *store = rate_store_new(0);
+    double maps_s = 0.0, store_s = 0.0;
+    guint64 updates = 0;
+    volatile double sink = 0.0;
+    guint32 state = 12345;
+
+    printf("%8s %20s %20s\n", "cycles", "PID maps", "RateStore");
+    for (int c = 1; c <= cycles; c++) {
+        // Exits and starts; PIDs count up and wrap like the kernel's
+        for (int i = 0; i < live; i++) {
+            state = state * 1103515245u + 12345u;
+            if ((int)((state >> 8) % 100) < churn) {
+                procs[i].pid = next_pid++;
+                procs[i].start_time = (guint64)c;
+                procs[i].bytes = 0;
+                if (next_pid >= PID_MAX) next_pid = 300;
+            }
+            procs[i].bytes += 1000 + i;
+        }
+        gint64 now_us = (gint64)c * 1000000;
+
+        double start = now_s();
+        for (int i = 0; i < live; i++) {
+            long long *prev_bytes = pid_map_lookup(prev_net_bytes, procs[i].pid);
+            double *prev_time = pid_map_lookup(prev_times, procs[i].pid);
+            if (prev_bytes && prev_time) sink += (procs[i].bytes - *prev_bytes) / (c - *prev_time);
+            *(long long*)pid_map_insert(prev_net_bytes, procs[i].pid) = (long long)procs[i].bytes;
+            *(double*)pid_map_insert(prev_times, procs[i].pid) = c;
+        }
+        double mid = now_s();
+        for (int i = 0; i < live; i++) {
+            RateDelta delta;
+            if (rate_store_update(store, procs[i].pid, procs[i].start_time, RATE_COUNTER_NET_BYTES,
+                                  procs[i].bytes, now_us, &delta)) {
+                sink += delta.increase / delta.seconds;
+            }
+        }
+        rate_store_advance(store);
+        maps_s += mid - start;
+        store_s += now_s() - mid;
+        updates += live;
+
+        if (c == 10 || c == 100 || c % 1000 == 0 || c == cycles) {
+            RateStoreStats stats;
+            rate_store_get_stats(store, &stats);
+            gsize maps_bytes = pid_map_bytes(prev_net_bytes) + pid_map_bytes(prev_times);
+            printf("%8d %9u / %6.2f MB %9u / %6.2f MB\n", c,
+                   pid_map_size(prev_net_bytes), maps_bytes / 1048576.0,
+                   stats.entries, stats.bytes / 1048576.0);
+        }
+    }
+
+    RateStoreStats stats;
+    rate_store_get_stats(store, &stats);
+    printf("\nUpdate cost: PID maps %.1f ns, RateStore %.1f ns (sweep included)\n",
+           maps_s / updates * 1e9, store_s / updates * 1e9);
+    printf("RateStore: %llu evicted, %llu rejected, stale after %d cycles\n",
+           (unsigned long long)stats.evicted, (unsigned long long)stats.rejected,
+           RATE_STORE_STALE_CYCLES);
+
+    (void)sink;
+    pid_map_free(prev_net_bytes);
+    pid_map_free(prev_times);
+    rate_store_free(store);
+    g_free(procs);
+    return 0;
+}
@@ -0,0 +1,225 @@
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../src/system/system.h"
+#include "../src/utils/scanner.h"
+#include "../src/utils/utils.h"
+#include "bench_common.h"
+
+// Cost of turning top output into ProcessSample rows. The old path buffered
+// the whole output, strdup'd the second sample, split lines with strtok,
+// copied every line and tokenized it with strtok_r/atof. The scanner path
+// parses lines in place as chunks arrive from the pipe.
+//
+// Usage: tests/bench_scanner [iterations] [recorded-top-output]
+// Without a file a 2-sample capture of 2,000 processes is synthesized.
+
+#define PIPE_CHUNK 4096         // Typical pipe read size
+#define MAX_ROWS 100000
+
+// Output of `top -l 2 -s 1 -o cpu -stats pid,command,cpu,mem,time`
+static GString* synthesize_capture(int process_count) {
+    static const char *names[] = {
+        "kernel_task", "WindowServer", "Google Chrome Helper (Renderer)", "mds_stores",
+        "Code Helper (Plugin)", "launchd", "Finder", "syslogd", "Terminal", "coreaudiod"
+    };
+    static const char *units[] = { "K", "M", "M", "G", "B" };
+    GString *out = g_string_new(NULL);
+
+    for (int sample = 0; sample < TOP_SAMPLE_COUNT; sample++) {
+        g_string_append_printf(out, "Processes: %d total, 3 running, %d sleeping, 4210 threads\n",
+                               process_count, process_count - 3);
+        g_string_append_printf(out, "2024/05/01 12:00:0%d\n", sample);
+        g_string_append(out, "Load Avg: 2.41, 2.77, 2.90\n");
+        g_string_append(out, "CPU usage: 7.31% user, 5.12% sys, 87.55% idle\n");
+        g_string_append(out, "SharedLibs: 512M resident, 98M data, 41M linkedit.\n");
+        g_string_append(out, "MemRegions: 254113 total, 6214M resident, 310M private, 2466M shared.\n");
+        g_string_append(out, "PhysMem: 15G used (2101M wired, 1024M compressor), 823M unused.\n");
+        g_string_append(out, "VM: 229T vsize, 4865M framework vsize, 0(0) swapins, 0(0) swapouts.\n");
+        g_string_append(out, "Networks: packets: 10481290/11G in, 5310821/1290M out.\n");
+        g_string_append(out, "Disks: 4210331/71G read, 3120553/66G written.\n\n");
+        g_string_append(out, "PID    COMMAND          %CPU MEM    TIME\n");
+
+        for (int i = 0; i < process_count; i++) {
+            int pid = i == 0 ? 0 : 100 + i * 3;
+            g_string_append_printf(out, "%-6d %-16s %.1f %d%s %02d:%02d.%02d\n",
+                                   pid, names[i % 10], (double)((i * 37 + sample * 11) % 1000) / 10.0,
+                                   1 + (i * 13) % 900, units[i % 5], i % 60, (i * 7) % 60, i % 100);
+        }
+    }
+    return out;
+}
+
+static GString* load_capture(const char *path) {
+    gchar *contents = NULL;
+    gsize length = 0;
+    if (!g_file_get_contents(path, &contents, &length, NULL)) return NULL;
+    GString *out = g_string_new_len(contents, (gssize)length);
+    g_free(contents);
+    return out;
+}
+
+// ---- Old path (as it was in system_info.c / threaded_collector.c) ----
+
+static gboolean legacy_parse_line(const char *line, ProcessSample *proc) {
+    if (!line || !proc || !isdigit((unsigned char)line[0])) return FALSE;
+
+    char line_copy[512];
+    safe_strncpy(line_copy, line, sizeof(line_copy));
+
+    char *tokens[20];
+    int token_count = 0;
+    char *save_ptr = NULL;
+    char *token = strtok_r(line_copy, " \t", &save_ptr);
+    while (token && token_count < 20) {
+        tokens[token_count++] = token;
+        token = strtok_r(NULL, " \t", &save_ptr);
+    }
+    if (token_count < 5) return FALSE;
+
+    memset(proc, 0, sizeof(*proc));
+    proc->pid = (pid_t)atoi(tokens[0]);
+
+    float raw_cpu = atof(tokens[token_count - 3]);
+    if (raw_cpu < 0) raw_cpu = 0;
+    if (raw_cpu > 999.9) raw_cpu = 999.9;
+    proc->cpu = raw_cpu / (cpu_cores > 0 ? cpu_cores : 1);
+
+    long long mem_bytes = parse_memory_string(tokens[token_count - 2]);
+    proc->rss_bytes = mem_bytes > 0 ? (guint64)mem_bytes : 0;
+
+    char name[STRING_INTERN_MAX] = "";
+    for (int i = 1; i < token_count - 3 && i < 10; i++) {
+        if (i > 1) safe_strncat(name, " ", sizeof(name));
+        safe_strncat(name, tokens[i], sizeof(name));
+    }
+    process_set_name(proc, name, -1);
+    proc->uid = PROCESS_UID_UNKNOWN;
+    return TRUE;
+}
+
+static guint parse_legacy(const GString *capture, ProcessSample *rows) {
+    // get_top_output(): read everything in 1 KB chunks into a growing buffer
+    size_t buffer_size = 65536, total_len = 0;
+    char *buffer = malloc(buffer_size);
+    for (size_t pos = 0; pos < capture->len; pos += 1024) {
+        size_t bytes_read = MIN((size_t)1024, capture->len - pos);
+        if (total_len + bytes_read + 1 > buffer_size) {
+            buffer_size *= 2;
+            buffer = realloc(buffer, buffer_size);
+        }
+        memcpy(buffer + total_len, capture->str + pos, bytes_read);
+        total_len += bytes_read;
+        buffer[total_len] = '\0';
+    }
+
+    char *output = buffer;
+    char *first = strstr(buffer, "Processes:");
+    char *second = first ? strstr(first + 1, "Processes:") : NULL;
+    if (second) {
+        output = strdup(second);
+        free(buffer);
+    }
+
+    // Collector loop: strtok over lines, strdup each one
+    guint count = 0;
+    gboolean in_processes = FALSE;
+    char *line = strtok(output, "\n");
+    while (line && count < MAX_ROWS) {
+        char *copy = strdup(line);
+        if (strstr(copy, "PID") && strstr(copy, "COMMAND")) {
+            in_processes = TRUE;
+        } else if (in_processes && legacy_parse_line(copy, &rows[count])) {
+            count++;
+        }
+        free(copy);
+        line = strtok(NULL, "\n");
+    }
+    free(output);
+    return count;
+}
+
+// ---- Scanner path (TopReader fed from a pipe) ----
+
+static guint parse_scanner(const GString *capture, ProcessSample *rows) {
+    LineScanner scanner;
+    line_scanner_init(&scanner, 64 * 1024);
+
+    guint count = 0, sample = 0;
+    gboolean in_processes = FALSE;
+    gsize pos = 0;
+    for (;;) {
+        StrView line;
+        if (!line_scanner_next(&scanner, &line)) {
+            if (pos >= capture->len) {
+                if (scanner.eof) break;
+                line_scanner_finish(&scanner);
+                continue;
+            }
+            gsize chunk = MIN((gsize)PIPE_CHUNK, capture->len - pos);
+            line_scanner_feed(&scanner, capture->str + pos, chunk);
+            pos += chunk;
+            continue;
+        }
+
+        if (str_view_has_prefix(line, "Processes:")) sample++;
+        if (sample < TOP_SAMPLE_COUNT) continue;
+
+        if (!in_processes) {
+            in_processes = str_view_contains(line, "PID") && str_view_contains(line, "COMMAND");
+        } else if (count < MAX_ROWS && parse_top_process_fields(line, &rows[count])) {
+            count++;
+        }
+    }
+    line_scanner_clear(&scanner);
+    return count;
+}
+
+static gboolean rows_equal(const ProcessSample *a, const ProcessSample *b) {
+    return a->pid == b->pid && a->cpu == b->cpu && a->rss_bytes == b->rss_bytes &&
+           a->name_id == b->name_id;
+}
+
+int main(int argc, char *argv[]) {
+    int iterations = argc > 1 ? atoi(argv[1]) : 200;
+    if (iterations <= 0) iterations = 200;
+
+    GString *capture = argc > 2 ? load_capture(argv[2]) : synthesize_capture(2000);
+    if (!capture) {
+        fprintf(stderr, "Cannot read %s\n", argv[2]);
+        return 1;
+    }
+
+    ProcessSample *legacy_rows = g_new0(ProcessSample, MAX_ROWS);
+    ProcessSample *scanner_rows = g_new0(ProcessSample, MAX_ROWS);
+    guint lines = 0;
+    for (gsize i = 0; i < capture->len; i++) lines += capture->str[i] == '\n';
+
+    guint legacy_count = 0, scanner_count = 0;
+    double start = now_ms();
+    for (int i = 0; i < iterations; i++) legacy_count = parse_legacy(capture, legacy_rows);
+    double legacy_ms = (now_ms() - start) / iterations;
+
+    start = now_ms();
+    for (int i = 0; i < iterations; i++) scanner_count = parse_scanner(capture, scanner_rows);
+    double scanner_ms = (now_ms() - start) / iterations;
+
+    int mismatches = legacy_count == scanner_count ? 0 : 1;
+    for (guint i = 0; !mismatches && i < scanner_count; i++) {
+        if (!rows_equal(&legacy_rows[i], &scanner_rows[i])) mismatches++;
+    }
+
+    printf("🚀 top Parser Benchmark (%u lines, %.1f KB, %u rows, %d iterations)\n\n",
+           lines, capture->len / 1024.0, scanner_count, iterations);
+    printf("strtok/strdup:  %7.3f ms/parse, %6.1f M lines/s\n", legacy_ms, lines / legacy_ms / 1000.0);
+    printf("LineScanner:    %7.3f ms/parse, %6.1f M lines/s (%.1fx faster)\n",
+           scanner_ms, lines / scanner_ms / 1000.0, scanner_ms > 0 ? legacy_ms / scanner_ms : 0.0);
+    printf("Rows %s\n", mismatches == 0 ? "identical" : "DIFFER");
+
+    g_free(legacy_rows);
+    g_free(scanner_rows);
+    g_string_free(capture, TRUE);
+    return mismatches == 0 ? 0 : 1;
+}
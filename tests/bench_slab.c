@@ -0,0 +1,234 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../src/utils/memory_pool.h"
+#include "../src/utils/process_table.h"
+#include "../src/utils/string_intern.h"
+#include "../src/common/config.h"
+#include "bench_common.h"
+#include "taskmini_tests.h"
+
+// ProcessSample pool under the stress_tests.c scenarios and with real
+// threads, slab caches against the previous pool (1024 slots scanned under
+// one global mutex, malloc once they are taken):
+//   - allocate a batch, free it, allocate half again (stress_test_memory_pool)
+//   - rounds of allocate then free in reverse order (stress_test_concurrent_access)
+//   - the same rounds on several threads at once
+//   - a producer thread allocating and a consumer freeing, like the
+//     collector handing rows to the UI
+// First checks that the threaded runs hand every row back to the pool
+// (stress_tests.c covers the slab cache itself).
+//
+// Usage: tests/bench_slab [threads] [rounds]
+
+#define LEGACY_POOL_SIZE 1024
+#define BATCH 100
+#define HANDOFF 64
+
+typedef struct {
+    ProcessSample processes[LEGACY_POOL_SIZE];
+    int used[LEGACY_POOL_SIZE];
+    int next_free;
+    GMutex mutex;
+} LegacyPool;
+
+static LegacyPool legacy;
+
+static ProcessSample* legacy_alloc(void) {
+    g_mutex_lock(&legacy.mutex);
+    for (int i = 0; i < LEGACY_POOL_SIZE; i++) {
+        int idx = (legacy.next_free + i) % LEGACY_POOL_SIZE;
+        if (!legacy.used[idx]) {
+            legacy.used[idx] = 1;
+            legacy.next_free = (idx + 1) % LEGACY_POOL_SIZE;
+            memset(&legacy.processes[idx], 0, sizeof(ProcessSample));
+            g_mutex_unlock(&legacy.mutex);
+            return &legacy.processes[idx];
+        }
+    }
+    g_mutex_unlock(&legacy.mutex);
+    return calloc(1, sizeof(ProcessSample));
+}
+
+static void legacy_free(ProcessSample *proc) {
+    g_mutex_lock(&legacy.mutex);
+    if (proc >= &legacy.processes[0] && proc < &legacy.processes[LEGACY_POOL_SIZE]) {
+        legacy.used[proc - legacy.processes] = 0;
+        memset(proc, 0, sizeof(ProcessSample));
+    } else {
+        free(proc);
+    }
+    g_mutex_unlock(&legacy.mutex);
+}
+
+typedef struct {
+    const char *name;
+    ProcessSample* (*alloc)(void);
+    void (*free)(ProcessSample *proc);
+} Allocator;
+
+static const Allocator allocators[] = {
+    { "mutex pool", legacy_alloc, legacy_free },
+    { "slab",       get_process_from_pool_fast, return_process_to_pool_fast },
+};
+
+typedef struct {
+    const Allocator *allocator;
+    int rounds;
+    int batch;
+} ChurnArgs;
+
+// stress_test_concurrent_access: allocate a batch, free it in reverse
+static gpointer churn_thread(gpointer data) {
+    ChurnArgs *args = data;
+    ProcessSample **procs = g_new(ProcessSample *, args->batch);
+    for (int round = 0; round < args->rounds; round++) {
+        for (int i = 0; i < args->batch; i++) {
+            procs[i] = args->allocator->alloc();
+            procs[i]->pid = i;
+        }
+        for (int i = args->batch - 1; i >= 0; i--) args->allocator->free(procs[i]);
+    }
+    g_free(procs);
+    return NULL;
+}
+
+// stress_test_memory_pool: batch, free, half a batch again
+static double bench_alloc_free_realloc(const Allocator *allocator, int rounds) {
+    ProcessSample *procs[BATCH];
+    double start = now_s();
+    for (int round = 0; round < rounds; round++) {
+        for (int i = 0; i < BATCH; i++) {
+            procs[i] = allocator->alloc();
+            char name[STRING_INTERN_MAX];
+            snprintf(name, sizeof(name), "TestProc%d", i);
+            process_set_name(procs[i], name, -1);
+        }
+        for (int i = 0; i < BATCH; i++) allocator->free(procs[i]);
+        for (int i = 0; i < BATCH / 2; i++) allocator->free(allocator->alloc());
+    }
+    return rounds * BATCH * 2.0 / (now_s() - start);
+}
+
+static double bench_churn(const Allocator *allocator, int threads, int rounds, int batch) {
+    GThread *workers[64];
+    ChurnArgs args = { allocator, rounds, batch };
+    double start = now_s();
+    for (int t = 0; t < threads; t++) workers[t] = g_thread_new("churn", churn_thread, &args);
+    for (int t = 0; t < threads; t++) g_thread_join(workers[t]);
+    return (double)threads * rounds * batch * 2 / (now_s() - start);
+}
+
+// Producer/consumer handoff in chunks of HANDOFF rows
+typedef struct {
+    const Allocator *allocator;
+    int chunks;
+    GMutex mutex;
+    GCond cond;
+    ProcessSample *slot[HANDOFF];
+    gboolean full;
+} Handoff;
+
+static gpointer consumer_thread(gpointer data) {
+    Handoff *handoff = data;
+    ProcessSample *chunk[HANDOFF];
+    for (int c = 0; c < handoff->chunks; c++) {
+        g_mutex_lock(&handoff->mutex);
+        while (!handoff->full) g_cond_wait(&handoff->cond, &handoff->mutex);
+        memcpy(chunk, handoff->slot, sizeof(chunk));
+        handoff->full = FALSE;
+        g_cond_signal(&handoff->cond);
+        g_mutex_unlock(&handoff->mutex);
+        for (int i = 0; i < HANDOFF; i++) handoff->allocator->free(chunk[i]);
+    }
+    return NULL;
+}
+
+static double bench_handoff(const Allocator *allocator, int chunks) {
+    Handoff handoff = { .allocator = allocator, .chunks = chunks };
+    g_mutex_init(&handoff.mutex);
+    g_cond_init(&handoff.cond);
+
+    double start = now_s();
+    GThread *consumer = g_thread_new("consumer", consumer_thread, &handoff);
+    ProcessSample *chunk[HANDOFF];
+    for (int c = 0; c < chunks; c++) {
+        for (int i = 0; i < HANDOFF; i++) chunk[i] = allocator->alloc();
+        g_mutex_lock(&handoff.mutex);
+        while (handoff.full) g_cond_wait(&handoff.cond, &handoff.mutex);
+        memcpy(handoff.slot, chunk, sizeof(chunk));
+        handoff.full = TRUE;
+        g_cond_signal(&handoff.cond);
+        g_mutex_unlock(&handoff.mutex);
+    }
+    g_thread_join(consumer);
+    double ops = chunks * HANDOFF * 2.0 / (now_s() - start);
+
+    g_cond_clear(&handoff.cond);
+    g_mutex_clear(&handoff.mutex);
+    return ops;
+}
+
+// Rows held by threads, including the main thread's magazine
+static guint64 pool_outstanding(void) {
+    SlabStats stats;
+    get_memory_pool_stats(&stats, NULL);
+    return stats.outstanding;
+}
+
+int test_threads_return_rows() {
+    TEST_CASE("Threaded runs return every row to the pool");
+
+    const Allocator *slab = &allocators[1];
+    guint64 before = pool_outstanding();
+    bench_churn(slab, 4, 50, 2000);
+    ASSERT_EQUAL(before, pool_outstanding(), "Churn threads should free every row");
+
+    // The producer (this thread) allocates from its magazine, the consumer
+    // frees into its own and flushes it at exit: at most one refill more
+    bench_handoff(slab, 100);
+    guint64 after = pool_outstanding();
+    ASSERT_RANGE(after, before, before + SLAB_MAGAZINE_SIZE, "Consumer should free every row");
+
+    SlabStats stats;
+    get_memory_pool_stats(&stats, NULL);
+    ASSERT_EQUAL(stats.objects, stats.depot_free + stats.outstanding, "Pool accounting should balance");
+    TEST_PASS();
+}
+
+int main(int argc, char *argv[]) {
+    int threads = argc > 1 ? atoi(argv[1]) : 4;
+    int rounds = argc > 2 ? atoi(argv[2]) : 20000;
+    if (threads <= 0 || threads > 64) threads = 4;
+    if (rounds <= 0) rounds = 20000;
+
+    printf("🚀 Slab Allocator Benchmark (%d threads, %d rounds, magazine %d)\n\n",
+           threads, rounds, SLAB_MAGAZINE_SIZE);
+    g_mutex_init(&legacy.mutex);
+    init_memory_pools();
+
+    TEST_SUITE("Slab Pool");
+    test_threads_return_rows();
+    if (test_failed > 0) {
+        TEST_SUMMARY();
+    }
+
+    printf("\n%-11s %14s %14s %14s %14s %14s\n", "", "alloc/realloc", "reverse free",
+           "threaded", "threaded 2000", "handoff");
+    for (size_t a = 0; a < G_N_ELEMENTS(allocators); a++) {
+        const Allocator *allocator = &allocators[a];
+        printf("%-11s %10.2f M/s %10.2f M/s %10.2f M/s %10.2f M/s %10.2f M/s\n", allocator->name,
+               bench_alloc_free_realloc(allocator, rounds) / 1e6,
+               bench_churn(allocator, 1, rounds, BATCH) / 1e6,
+               bench_churn(allocator, threads, rounds, BATCH) / 1e6,
+               // More live rows than the old pool had slots
+               bench_churn(allocator, threads, rounds / 20, 2000) / 1e6,
+               bench_handoff(allocator, rounds) / 1e6);
+    }
+
+    printf("\n");
+    print_memory_pool_stats();
+    cleanup_memory_pools();
+    return 0;
+}
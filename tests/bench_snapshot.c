@@ -0,0 +1,159 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../src/system/snapshot.h"
+#include "../src/utils/utils.h"
+#include "bench_common.h"
+
+// Reader latency for the latest-data handoff while a writer publishes
+// continuously. Compares snapshot references against the previous approach
+// (mutex-protected bin + deep copy of the process table on every read).
+//
+// Usage: tests/bench_snapshot [reads] [processes]
+
+typedef enum {
+    MODE_SNAPSHOT,
+    MODE_LOCKED_COPY
+} BenchMode;
+
+typedef struct {
+    BenchMode mode;
+    int process_count;
+    gint stop;
+    gint publishes;
+
+    SnapshotSlot slot;          // MODE_SNAPSHOT
+    UpdateData *bin;            // MODE_LOCKED_COPY
+    GMutex bin_mutex;
+} BenchState;
+
+static UpdateData* make_update_data(int process_count, guint seed) {
+    UpdateData *data = g_malloc0(sizeof(UpdateData));
+    data->processes = process_table_acquire();
+    for (int i = 0; i < process_count; i++) {
+        ProcessSample proc;
+        memset(&proc, 0, sizeof(proc));
+        proc.pid = 100 + i;
+        proc.cpu = (float)((i + seed) % 100);
+        proc.rss_bytes = (guint64)(i + 1) * 4096;
+        char name[STRING_INTERN_MAX];
+        snprintf(name, sizeof(name), "process-%d", i);
+        process_set_name(&proc, name, -1);
+        process_table_add(data->processes, &proc);
+    }
+    data->system_summary = g_strdup("Processes: synthetic");
+    data->gpu_usage = g_strdup("0.0%");
+    return data;
+}
+
+// Publishes new data as fast as it can, like a collector with no sleep
+static gpointer writer_thread(gpointer user_data) {
+    BenchState *state = user_data;
+    guint seed = 0;
+
+    while (!g_atomic_int_get(&state->stop)) {
+        UpdateData *data = make_update_data(state->process_count, seed++);
+        if (state->mode == MODE_SNAPSHOT) {
+            snapshot_slot_publish(&state->slot, data);
+        } else {
+            g_mutex_lock(&state->bin_mutex);
+            UpdateData *old = state->bin;
+            state->bin = data;
+            g_mutex_unlock(&state->bin_mutex);
+            free_update_data(old);
+        }
+        g_atomic_int_inc(&state->publishes);
+    }
+    return NULL;
+}
+
+static void read_once(BenchState *state) {
+    if (state->mode == MODE_SNAPSHOT) {
+        Snapshot *snapshot = snapshot_slot_acquire(&state->slot);
+        snapshot_unref(snapshot);
+        return;
+    }
+
+    UpdateData *copy = NULL;
+    g_mutex_lock(&state->bin_mutex);
+    if (state->bin) {
+        copy = g_malloc0(sizeof(UpdateData));
+        copy->processes = process_table_copy(state->bin->processes);
+        copy->system_summary = g_strdup(state->bin->system_summary);
+        copy->gpu_usage = g_strdup(state->bin->gpu_usage);
+    }
+    g_mutex_unlock(&state->bin_mutex);
+    free_update_data(copy);
+}
+
+static int compare_doubles(const void *a, const void *b) {
+    double da = *(const double*)a, db = *(const double*)b;
+    return (da > db) - (da < db);
+}
+
+static void bench_mode(BenchMode mode, const char *label, int reads, int process_count) {
+    printf("=== %s ===\n", label);
+
+    BenchState state;
+    memset(&state, 0, sizeof(state));
+    state.mode = mode;
+    state.process_count = process_count;
+    snapshot_slot_init(&state.slot);
+    g_mutex_init(&state.bin_mutex);
+
+    // Seed one dataset so the first reads have something to return
+    if (mode == MODE_SNAPSHOT) {
+        snapshot_slot_publish(&state.slot, make_update_data(process_count, 0));
+    } else {
+        state.bin = make_update_data(process_count, 0);
+    }
+
+    GThread *writer = g_thread_new("bench_writer", writer_thread, &state);
+    
+    // Only measure once the writer is actually publishing
+    while (g_atomic_int_get(&state.publishes) == 0) {
+        g_thread_yield();
+    }
+
+    double *latencies = g_new(double, reads);
+    double start = now_ns();
+    for (int i = 0; i < reads; i++) {
+        double t0 = now_ns();
+        read_once(&state);
+        latencies[i] = now_ns() - t0;
+    }
+    double elapsed_ms = (now_ns() - start) / 1e6;
+
+    g_atomic_int_set(&state.stop, 1);
+    g_thread_join(writer);
+
+    qsort(latencies, reads, sizeof(double), compare_doubles);
+    double total = 0;
+    for (int i = 0; i < reads; i++) total += latencies[i];
+
+    printf("Reads: %d in %.2f ms, concurrent publishes: %d\n", reads, elapsed_ms, g_atomic_int_get(&state.publishes));
+    printf("Read latency: avg %.0f ns, p50 %.0f ns, p99 %.0f ns, max %.0f ns\n\n",
+           total / reads, latencies[reads / 2], latencies[(int)(reads * 0.99)], latencies[reads - 1]);
+
+    g_free(latencies);
+    snapshot_slot_clear(&state.slot);
+    free_update_data(state.bin);
+    g_mutex_clear(&state.bin_mutex);
+}
+
+int main(int argc, char *argv[]) {
+    int reads = argc > 1 ? atoi(argv[1]) : 20000;
+    int process_count = argc > 2 ? atoi(argv[2]) : 500;
+    if (reads <= 0) reads = 20000;
+    if (process_count <= 0) process_count = 500;
+
+    init_process_pool();
+
+    printf("🚀 Snapshot Publication Benchmark (%d reads, %d processes)\n\n", reads, process_count);
+    bench_mode(MODE_SNAPSHOT, "Snapshot reference (lock-free)", reads, process_count);
+    bench_mode(MODE_LOCKED_COPY, "Mutex + deep copy (previous)", reads, process_count);
+
+    cleanup_process_pool();
+    return 0;
+}
@@ -0,0 +1,124 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../src/ui/sort_order.h"
+#include "../src/ui/ui.h"
+#include "../src/system/process_delta.h"
+#include "../src/utils/utils.h"
+#include "bench_common.h"
+
+// Per-refresh cost of keeping the process rows sorted by CPU (descending):
+//   resort      - sort every row again with process_sample_compare()
+//   keyed sort  - sort every row again on precomputed sort keys
+//   incremental - keep the previous order, drop exited rows, re-place rows
+//                 whose CPU changed and insert new rows (sort_order_repair)
+// Each refresh has 5% PID churn and CPU changes on 10% of the rows. The
+// delta comes from the collector in the app, so it is not timed here.
+//
+// Usage: tests/bench_sort_order [cycles]
+
+static gint compare_samples(gconstpointer a, gconstpointer b, gpointer user_data) {
+    const ProcessTable *table = user_data;
+    const ProcessSample *pa = &table->items[*(const guint32*)a];
+    const ProcessSample *pb = &table->items[*(const guint32*)b];
+    gint ret = -process_sample_compare(pa, pb, COL_CPU);
+    return ret != 0 ? ret : (pa->pid > pb->pid) - (pa->pid < pb->pid);
+}
+
+// Returns the number of refreshes whose orders differed
+static int bench_rows(int process_count, int cycles) {
+    ProcessTable *previous = bench_make_table(process_count, 0);
+    guint64 *keys = g_new(guint64, process_count);
+    guint8 *flags = g_new0(guint8, process_count);
+    GArray *rows = g_array_new(FALSE, FALSE, sizeof(guint32));
+    guint32 *scratch = g_new(guint32, process_count);
+    double resort_ms = 0, keyed_ms = 0, incremental_ms = 0;
+    int mismatches = 0;
+
+    // Initial order
+    SortOrder order = { previous->items, keys, COL_CPU, TRUE };
+    sort_order_compute_keys(previous->items, previous->count, COL_CPU, keys);
+    for (guint32 i = 0; i < previous->count; i++) g_array_append_val(rows, i);
+    sort_order_sort(&order, (guint32*)rows->data, rows->len, NULL);
+
+    for (int cycle = 1; cycle <= cycles; cycle++) {
+        ProcessTable *table = bench_make_table(process_count, cycle);
+        ProcessDelta *delta = process_delta_compute(previous, table);
+        guint count = table->count;
+
+        // Full re-sort with the column compare function
+        double start = now_ms();
+        for (guint32 i = 0; i < count; i++) scratch[i] = i;
+        g_qsort_with_data(scratch, (gint)count, sizeof(guint32), compare_samples, table);
+        resort_ms += now_ms() - start;
+
+        // Full re-sort on precomputed keys
+        guint32 *keyed = g_new(guint32, count);
+        start = now_ms();
+        order.items = table->items;
+        sort_order_compute_keys(table->items, count, COL_CPU, keys);
+        for (guint32 i = 0; i < count; i++) keyed[i] = i;
+        sort_order_sort(&order, keyed, count, NULL);
+        keyed_ms += now_ms() - start;
+
+        // Incremental: map survivors, repair, insert new rows
+        memset(flags, 0, count);
+        for (guint i = 0; i < delta->changed->len; i++) {
+            const ProcessChange *change = &g_array_index(delta->changed, ProcessChange, i);
+            if (change->fields & PROCESS_FIELD_CPU) flags[change->index] = 1;
+        }
+        start = now_ms();
+        guint kept = 0;
+        for (guint pos = 0; pos < rows->len; pos++) {
+            pid_t pid = previous->items[g_array_index(rows, guint32, pos)].pid;
+            const ProcessSample *proc = process_table_lookup(table, pid);
+            if (proc) g_array_index(rows, guint32, kept++) = (guint32)(proc - table->items);
+        }
+        g_array_set_size(rows, kept);
+        sort_order_compute_keys(table->items, count, COL_CPU, keys);
+        sort_order_repair(&order, (guint32*)rows->data, rows->len, flags, 1, NULL);
+        for (guint i = 0; i < delta->added->len; i++) {
+            guint32 index = g_array_index(delta->added, guint32, i);
+            guint position = sort_order_position(&order, (const guint32*)rows->data, rows->len, index);
+            g_array_insert_val(rows, position, index);
+        }
+        incremental_ms += now_ms() - start;
+
+        if (rows->len != count ||
+            memcmp(rows->data, scratch, count * sizeof(guint32)) != 0 ||
+            memcmp(keyed, scratch, count * sizeof(guint32)) != 0) {
+            mismatches++;
+        }
+
+        g_free(keyed);
+        process_delta_free(delta);
+        process_table_free(previous);
+        previous = table;
+    }
+
+    printf("=== %d rows ===\n", process_count);
+    printf("Resort:      %.3f ms/refresh\n", resort_ms / cycles);
+    printf("Keyed sort:  %.3f ms/refresh (%.1fx)\n", keyed_ms / cycles,
+           keyed_ms > 0 ? resort_ms / keyed_ms : 0.0);
+    printf("Incremental: %.3f ms/refresh (%.1fx)\n", incremental_ms / cycles,
+           incremental_ms > 0 ? resort_ms / incremental_ms : 0.0);
+    printf("Orders %s\n\n", mismatches == 0 ? "identical" : "DIFFER");
+
+    process_table_free(previous);
+    g_array_free(rows, TRUE);
+    g_free(scratch);
+    g_free(flags);
+    g_free(keys);
+    return mismatches;
+}
+
+int main(int argc, char *argv[]) {
+    int cycles = argc > 1 ? atoi(argv[1]) : 50;
+    if (cycles <= 0) cycles = 50;
+
+    printf("🚀 Sort Order Benchmark (%d refreshes, 5%% churn, 10%% CPU changes)\n\n", cycles);
+    int mismatches = bench_rows(2000, cycles);
+    mismatches += bench_rows(20000, cycles);
+    return mismatches > 0 ? 1 : 0;
+}
@@ -0,0 +1,219 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "../src/system/stream_source.h"
+#include "../src/system/system.h"
+#include "../src/utils/utils.h"
+#include "bench_common.h"
+#include "taskmini_tests.h"
+
+// Relaunching a sampling tool per cycle against one long-lived stream.
+// The tool is this program in --emit mode, printing top-style samples, so
+// the benchmark runs anywhere (no macOS top needed):
+//
+//   relaunch: popen("tool -l 2 -s INTERVAL") per cycle, parse the 2nd sample
+//   stream:   one tool -l 0 for the session, take the newest frame
+//
+// Like the continuous collector, each cycle sleeps 1.5 intervals and then
+// collects; the figure of merit is how long collection blocks. The stream
+// tool also exits every few frames to exercise restart handling.
+//
+// First checks that a paused source, as the background collector uses it,
+// yields a frame sampled after the resume rather than one from before the
+// pause.
+//
+// Usage: tests/bench_stream_source [cycles] [interval_ms]
+//        tests/bench_stream_source --emit INTERVAL_MS SAMPLES PROCESSES
+
+#define BENCH_PROCESSES 2000
+#define FRAMES_PER_LAUNCH 10        // Stream tool exits after this many
+#define PAUSE_MS 600
+
+// Fake top: SAMPLES samples (0 = forever), INTERVAL_MS apart
+static int emit(int interval_ms, int samples, int processes) {
+    for (int sample = 0; samples == 0 || sample < samples; sample++) {
+        if (sample > 0) g_usleep((gulong)interval_ms * 1000);
+        printf("Processes: %d total, 2 running, %d sleeping, 3100 threads\n", processes, processes - 2);
+        printf("Sampled: %.3f\n", now_ms());  // In place of top's date line
+        printf("Load Avg: 1.52, 1.61, 1.70\n");
+        printf("CPU usage: 6.10%% user, 4.20%% sys, 89.70%% idle\n");
+        printf("PhysMem: 15G used (2048M wired), 1024M unused.\n\n");
+        printf("PID    COMMAND          %%CPU MEM    TIME\n");
+        for (int i = 0; i < processes; i++) {
+            printf("%-6d process-%-8d %.1f %dM %02d:%02d.%02d\n",
+                   100 + i, i, (double)((i * 7 + sample) % 1000) / 10.0, 1 + i % 900, i % 60, i % 60, i % 100);
+        }
+        fflush(stdout);
+    }
+    return 0;
+}
+
+// Rows of a frame that parse as process lines
+static guint count_rows(const char *text, gsize len) {
+    LineScanner scanner;
+    line_scanner_init(&scanner, len + 1);
+    line_scanner_feed(&scanner, text, len);
+    line_scanner_finish(&scanner);
+
+    guint rows = 0;
+    StrView line;
+    ProcessSample sample;
+    while (line_scanner_next(&scanner, &line)) rows += parse_top_process_fields(line, &sample);
+    line_scanner_clear(&scanner);
+    return rows;
+}
+
+// Monotonic time the fake top wrote the frame, -1 without a frame
+static double frame_sampled_ms(GBytes *frame) {
+    if (!frame) return -1;
+    gsize len;
+    const char *text = g_bytes_get_data(frame, &len);
+    const char *line = g_strstr_len(text, (gssize)len, "Sampled: ");
+    return line ? g_ascii_strtod(line + 9, NULL) : -1;
+}
+
+int test_paused_frame_is_fresh(const char *self, int interval_ms) {
+    TEST_CASE("Paused source yields a frame sampled after the resume");
+
+    char interval[16];
+    snprintf(interval, sizeof(interval), "%d", interval_ms);
+    char *argv[] = { (char *)self, "--emit", interval, "0", "50", NULL };
+    const char *const markers[] = { "Processes:", NULL };
+    StreamSource *source = stream_source_start(argv, markers, 0);
+
+    guint64 sequence = 0;
+    GBytes *frame = stream_source_wait_frame(source, &sequence, 5000);
+    ASSERT_NOT_NULL(frame, "Source should publish a first frame");
+    g_bytes_unref(frame);
+
+    // The frame completed by the resume predates it
+    stream_source_set_paused(source, TRUE);
+    g_usleep(PAUSE_MS * 1000);
+    double resumed = now_ms();
+    stream_source_set_paused(source, FALSE);
+    frame = stream_source_wait_frame(source, &sequence, 5000);
+    double sampled = frame_sampled_ms(frame);
+    if (frame) g_bytes_unref(frame);
+    ASSERT_TRUE(sampled >= 0 && sampled < resumed, "First frame after a resume is from before the pause");
+
+    // Two background cycles, the second after a frame was cut by the pause
+    for (int cycle = 0; cycle < 2; cycle++) {
+        stream_source_set_paused(source, TRUE);
+        g_usleep(PAUSE_MS * 1000);
+        resumed = now_ms();
+        frame = stream_source_wait_resumed_frame(source, &sequence, 5000);
+        double waited = now_ms() - resumed;
+        sampled = frame_sampled_ms(frame);
+        if (frame) g_bytes_unref(frame);
+        ASSERT_TRUE(sampled >= resumed, "Frame should be sampled after the resume");
+        ASSERT_TRUE(waited < 3 * interval_ms, "Fresh frame should follow within about one interval");
+    }
+
+    stream_source_stop(source);
+    TEST_PASS();
+}
+
+static void bench_relaunch(const char *self, int cycles, int interval_ms) {
+    char cmd[1024];
+    snprintf(cmd, sizeof(cmd), "'%s' --emit %d 2 %d", self, interval_ms, BENCH_PROCESSES);
+
+    guint rows = 0;
+    double blocked_ms = 0;
+    reset_spawned_child_count();
+    for (int i = 0; i < cycles; i++) {
+        g_usleep((gulong)interval_ms * 1500);
+        double start = now_ms();
+        FILE *fp = tracked_popen(cmd, "r");
+        if (!fp) continue;
+
+        // Everything from the second "Processes:" line on, like TopReader
+        LineScanner scanner;
+        line_scanner_init(&scanner, 0);
+        guint sample = 0;
+        StrView line;
+        ProcessSample proc;
+        while (line_scanner_read_line(&scanner, fp, &line)) {
+            if (str_view_has_prefix(line, "Processes:")) sample++;
+            if (sample >= 2) rows += parse_top_process_fields(line, &proc);
+        }
+        line_scanner_clear(&scanner);
+        pclose(fp);
+        blocked_ms += now_ms() - start;
+    }
+
+    printf("relaunch: %8.2f ms blocked/sample, %u rows/sample, %u children\n",
+           blocked_ms / cycles, rows / cycles, get_spawned_child_count());
+}
+
+static void bench_stream(const char *self, int cycles, int interval_ms) {
+    char interval[16], samples[16], processes[16];
+    snprintf(interval, sizeof(interval), "%d", interval_ms);
+    snprintf(samples, sizeof(samples), "%d", FRAMES_PER_LAUNCH);
+    snprintf(processes, sizeof(processes), "%d", BENCH_PROCESSES);
+    char *argv[] = { (char *)self, "--emit", interval, samples, processes, NULL };
+    const char *const markers[] = { "Processes:", NULL };
+
+    reset_spawned_child_count();
+    StreamSource *source = stream_source_start(argv, markers, 0);
+
+    // First frame includes the launch; measure steady state from there
+    guint64 sequence = 0;
+    GBytes *frame = stream_source_wait_frame(source, &sequence, 5000);
+    if (frame) g_bytes_unref(frame);
+
+    guint rows = 0, received = 0, incomplete = 0;
+    double wait_ms = 0, parse_ms = 0;
+    for (int i = 0; i < cycles; i++) {
+        g_usleep((gulong)interval_ms * 1500);
+        double start = now_ms();
+        frame = stream_source_wait_frame(source, &sequence, 5000);
+        wait_ms += now_ms() - start;
+        if (!frame) continue;
+
+        start = now_ms();
+        gsize len;
+        const char *text = g_bytes_get_data(frame, &len);
+        guint frame_rows = count_rows(text, len);
+        parse_ms += now_ms() - start;
+
+        rows += frame_rows;
+        incomplete += frame_rows != BENCH_PROCESSES;
+        received++;
+        g_bytes_unref(frame);
+    }
+
+    StreamSourceStats stats;
+    stream_source_get_stats(source, &stats);
+    stream_source_stop(source);
+
+    printf("stream:   %8.2f ms blocked/sample (%.2f ms parsing), %u rows/sample, %u children\n",
+           (wait_ms + parse_ms) / cycles, parse_ms / cycles, received ? rows / received : 0,
+           get_spawned_child_count());
+    printf("          %u/%d frames received, %u incomplete, %llu restarts\n",
+           received, cycles, incomplete, (unsigned long long)stats.restarts);
+}
+
+int main(int argc, char *argv[]) {
+    if (argc == 5 && strcmp(argv[1], "--emit") == 0) {
+        return emit(atoi(argv[2]), atoi(argv[3]), atoi(argv[4]));
+    }
+
+    int cycles = argc > 1 ? atoi(argv[1]) : 12;
+    int interval_ms = argc > 2 ? atoi(argv[2]) : 200;
+    if (cycles <= 0) cycles = 12;
+    if (interval_ms <= 0) interval_ms = 200;
+
+    TEST_SUITE("Stream Source");
+    test_paused_frame_is_fresh(argv[0], interval_ms);
+    if (test_failed > 0) {
+        TEST_SUMMARY();
+    }
+
+    printf("\n🚀 Stream Source Benchmark (%d samples, %d processes, %d ms sample interval)\n\n",
+           cycles, BENCH_PROCESSES, interval_ms);
+    bench_relaunch(argv[0], cycles, interval_ms);
+    bench_stream(argv[0], cycles, interval_ms);
+    return 0;
+}
@@ -0,0 +1,161 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../src/utils/utils.h"
+#include "../src/common/config.h"
+#include "bench_common.h"
+
+// Interned process names against the inline char name[48] they replace,
+// for a process list where many rows share a name:
+//   - naming every row of a cycle: copying 48 bytes against interning
+//     (one thread, and the proc backend's scan workers in parallel)
+//   - diffing two cycles by name: strcmp against comparing IDs
+//   - memory for the names of the snapshots in flight
+//   - eviction: short-lived processes with unique names, ID count bounded
+//
+// Usage: tests/bench_string_intern [rows] [distinct_names] [threads]
+
+#define INLINE_NAME 48
+#define SNAPSHOTS_IN_FLIGHT 4       // Collector slot, UI model, protocol base, spare
+#define CYCLES 500
+
+typedef char InlineName[INLINE_NAME];
+
+typedef struct {
+    InlineName *names;
+    int rows;
+    int cycles;
+} InternArgs;
+
+static gpointer intern_thread(gpointer data) {
+    InternArgs *args = data;
+    volatile guint32 sink = 0;
+    for (int c = 0; c < args->cycles; c++) {
+        for (int i = 0; i < args->rows; i++) sink ^= string_intern(args->names[i], -1);
+    }
+    (void)sink;
+    return NULL;
+}
+
+static double bench_intern(InlineName *names, int rows, int threads) {
+    InternArgs args = { names, rows, CYCLES };
+    GThread *workers[64];
+    double start = now_s();
+    for (int t = 0; t < threads; t++) workers[t] = g_thread_new("intern", intern_thread, &args);
+    for (int t = 0; t < threads; t++) g_thread_join(workers[t]);
+    return (double)threads * rows * CYCLES / (now_s() - start);
+}
+
+static double bench_copy(InlineName *names, int rows) {
+    InlineName *rows_out = g_new(InlineName, rows);
+    volatile char sink = 0;
+    double start = now_s();
+    for (int c = 0; c < CYCLES; c++) {
+        for (int i = 0; i < rows; i++) memcpy(rows_out[i], names[i], INLINE_NAME);
+        sink ^= rows_out[c % rows][c % INLINE_NAME];
+    }
+    (void)sink;
+    double rate = (double)rows * CYCLES / (now_s() - start);
+    g_free(rows_out);
+    return rate;
+}
+
+int main(int argc, char *argv[]) {
+    int rows = argc > 1 ? atoi(argv[1]) : 2000;
+    int distinct = argc > 2 ? atoi(argv[2]) : 300;
+    int threads = argc > 3 ? atoi(argv[3]) : 4;
+    if (rows <= 0) rows = 2000;
+    if (distinct <= 0 || distinct > rows) distinct = MIN(300, rows);
+    if (threads <= 0 || threads > 64) threads = 4;
+
+    printf("🚀 String Intern Benchmark (%d rows, %d distinct names, %d threads)\n\n",
+           rows, distinct, threads);
+
+    // Names cycle through the distinct set, like many workers of one program
+    InlineName *names = g_new0(InlineName, rows);
+    guint32 *ids = g_new(guint32, rows);
+    guint32 *next_ids = g_new(guint32, rows);
+    for (int i = 0; i < rows; i++) {
+        snprintf(names[i], INLINE_NAME, "/usr/lib/app-%03d/worker", i % distinct);
+        ids[i] = string_intern(names[i], -1);
+    }
+
+    printf("Naming rows:    copy %8.2f M/s   intern %8.2f M/s   intern x%d %8.2f M/s\n",
+           bench_copy(names, rows) / 1e6, bench_intern(names, rows, 1) / 1e6,
+           threads, bench_intern(names, rows, threads) / 1e6);
+
+    // Diff against the next cycle, where every tenth row was renamed
+    InlineName *next_names = g_new0(InlineName, rows);
+    for (int i = 0; i < rows; i++) {
+        snprintf(next_names[i], INLINE_NAME, "/usr/lib/app-%03d/worker",
+                 (i % 10 == 0 ? i + 1 : i) % distinct);
+        next_ids[i] = string_intern(next_names[i], -1);
+    }
+    volatile int changed = 0;
+    double start = now_s();
+    for (int c = 0; c < CYCLES; c++) {
+        for (int i = 0; i < rows; i++) changed += strcmp(names[i], next_names[i]) != 0;
+    }
+    double strcmp_rate = (double)rows * CYCLES / (now_s() - start);
+    start = now_s();
+    for (int c = 0; c < CYCLES; c++) {
+        for (int i = 0; i < rows; i++) changed += ids[i] != next_ids[i];
+    }
+    double id_rate = (double)rows * CYCLES / (now_s() - start);
+    printf("Diffing names:  strcmp %6.0f M/s   ID compare %6.0f M/s\n", strcmp_rate / 1e6, id_rate / 1e6);
+
+    // Names of the snapshots in flight, held by their tables
+    ProcessTable *tables[SNAPSHOTS_IN_FLIGHT];
+    for (int t = 0; t < SNAPSHOTS_IN_FLIGHT; t++) {
+        tables[t] = process_table_new(rows);
+        for (int i = 0; i < rows; i++) {
+            ProcessSample sample;
+            memset(&sample, 0, sizeof(sample));
+            sample.pid = 100 + i;
+            sample.name_id = ids[i];
+            process_table_add(tables[t], &sample);
+        }
+    }
+    for (int g = 0; g <= STRING_INTERN_GRACE_CYCLES; g++) string_intern_advance();
+    StringInternStats stats;
+    string_intern_get_stats(&stats);
+    gsize inline_bytes = (gsize)SNAPSHOTS_IN_FLIGHT * rows * INLINE_NAME;
+    gsize intern_bytes = (gsize)SNAPSHOTS_IN_FLIGHT * rows * sizeof(guint32) + stats.bytes;
+    printf("Name memory:    inline %zu KB   interned %zu KB (%u strings)\n",
+           inline_bytes / 1024, intern_bytes / 1024, stats.entries);
+
+    // Churn: each cycle a tenth of the rows are new processes with fresh
+    // names; the tables turn over and IDs of exited processes are evicted
+    guint peak = 0;
+    for (int c = 0; c < CYCLES; c++) {
+        ProcessTable *table = tables[c % SNAPSHOTS_IN_FLIGHT];
+        process_table_clear(table);
+        for (int i = 0; i < rows; i++) {
+            ProcessSample sample;
+            memset(&sample, 0, sizeof(sample));
+            sample.pid = 100 + i;
+            if (i % 10 == 0) {
+                char name[STRING_INTERN_MAX];
+                snprintf(name, sizeof(name), "job-%d-%d", c, i);
+                process_set_name(&sample, name, -1);
+            } else {
+                sample.name_id = ids[i];
+            }
+            process_table_add(table, &sample);
+        }
+        string_intern_advance();
+        string_intern_get_stats(&stats);
+        peak = MAX(peak, stats.entries);
+    }
+    printf("Churn:          %d cycles, %u strings now, peak %u, %llu evicted\n",
+           CYCLES, stats.entries, peak, (unsigned long long)stats.evicted);
+
+    for (int t = 0; t < SNAPSHOTS_IN_FLIGHT; t++) process_table_free(tables[t]);
+    string_intern_cleanup();
+    g_free(names);
+    g_free(next_names);
+    g_free(ids);
+    g_free(next_ids);
+    return 0;
+}
@@ -1,4 +1,6 @@
-#include "../TaskMini.c"
+#include "../src/utils/utils.h"
+#include "../src/system/system.h"
+#include "../src/common/config.h"
 #include "taskmini_tests.h"
 
 // Integration tests - test full application workflows
@@ -45,32 +47,52 @@ int test_full_update_cycle() {
     init_process_pool();
     
     // Mock the update data collection (normally done in background thread)
-    UpdateData *update_data = malloc(sizeof(UpdateData));
+    UpdateData *update_data = update_data_new();
     ASSERT_NOT_NULL(update_data, "Update data allocation should succeed");
     
-    update_data->processes = NULL;
-    update_data->gpu_usage = strdup("25.5%");
-    update_data->system_summary = strdup("Network: 1GB downloaded, 500MB uploaded");
+    update_data->processes = process_table_acquire();
+    update_data_set_text(update_data, &update_data->gpu_usage, "25.5%");
+    update_data_set_text(update_data, &update_data->system_summary,
+                         "Network: 1GB downloaded, 500MB uploaded");
     
     // Create some test processes
+    gint64 now = (gint64)time(NULL);
     for (int i = 0; i < 5; i++) {
-        Process *proc = alloc_process();
-        snprintf(proc->pid, sizeof(proc->pid), "%d", 1000 + i);
-        snprintf(proc->name, sizeof(proc->name), "TestProc%d", i);
-        snprintf(proc->cpu, sizeof(proc->cpu), "%.1f", 5.0 + i);
-        snprintf(proc->mem, sizeof(proc->mem), "%dMB", 100 + i * 50);
-        snprintf(proc->gpu, sizeof(proc->gpu), "N/A");
-        snprintf(proc->net, sizeof(proc->net), "%.1f KB/s", 1.0 + i);
-        snprintf(proc->runtime, sizeof(proc->runtime), "00:%02d:30", i + 10);
+        ProcessSample proc = {0};
+        char name[32];
+        snprintf(name, sizeof(name), "TestProc%d", i);
+        process_set_name(&proc, name, -1);
+        proc.pid = 1000 + i;
+        proc.uid = 501;
+        proc.cpu = 5.0f + i;
+        proc.rss_bytes = (guint64)(100 + i * 50) * 1024 * 1024;
+        proc.net_bps = (guint64)(1 + i) * 1024;
+        proc.start_time = now - (10 + i) * 60 - 30;
+        proc.flags |= PROCESS_FLAG_HAS_START;
         
-        determine_process_type(proc);
+        determine_process_type(&proc);
         
-        update_data->processes = g_list_append(update_data->processes, proc);
+        process_table_add(update_data->processes, &proc);
     }
     
-    // Verify processes were created correctly
-    int process_count = g_list_length(update_data->processes);
-    ASSERT_EQUAL(5, process_count, "Should have created 5 test processes");
+    // Verify processes were created correctly, in collection order
+    ProcessTable *processes = update_data->processes;
+    ASSERT_EQUAL(5, processes->count, "Should have created 5 test processes");
+    for (guint i = 0; i < processes->count; i++) {
+        ASSERT_EQUAL(1000 + (int)i, processes->items[i].pid, "Rows should keep collection order");
+    }
+    ASSERT_TRUE(process_table_lookup(processes, 1003) == &processes->items[3],
+                "PID lookup should find the row");
+    ASSERT_NULL(process_table_lookup(processes, 999), "Unknown PID should not be found");
+    
+    // Verify the lazily formatted columns
+    const ProcessSample *first = &processes->items[0];
+    char text[32];
+    ASSERT_STR_EQUAL("TestProc0", process_name(first), "Name should round-trip through the intern table");
+    format_memory_bytes_buf(first->rss_bytes, text, sizeof(text));
+    ASSERT_STR_CONTAINS(text, "100", "Memory column should show 100 MB");
+    format_process_runtime(first->start_time, text, sizeof(text));
+    ASSERT_STR_CONTAINS(text, "10:", "Runtime column should show the elapsed time");
     
     // Verify GPU usage
     ASSERT_STR_EQUAL("25.5%", update_data->gpu_usage, "GPU usage should match");
@@ -79,17 +101,9 @@ int test_full_update_cycle() {
     ASSERT_TRUE(strstr(update_data->system_summary, "Network:") != NULL, 
                 "System summary should contain network info");
     
-    // Cleanup (simulate UI update function cleanup)
-    GList *l;
-    for (l = update_data->processes; l != NULL; l = l->next) {
-        Process *proc = (Process *)l->data;
-        free_process(proc);
-    }
-    g_list_free(update_data->processes);
-    
-    free(update_data->gpu_usage);
-    free(update_data->system_summary);
-    free(update_data);
+    // Cleanup (as the UI does after applying an update): the table goes
+    // back to the recycler, the strings with the arena
+    free_update_data(update_data);
     
     cleanup_process_pool();
     
@@ -103,37 +117,42 @@ int test_process_filtering() {
     init_process_pool();
     
     // Create test processes with different types
+    // UIDs are known, as they are after the metadata pass, so the
+    // classification is deterministic and never spawns ps
     struct {
         const char *name;
-        const char *pid;
+        pid_t pid;
+        int uid;
         gboolean expected_system;
     } test_processes[] = {
-        {"kernel_task", "0", TRUE},
-        {"launchd", "1", TRUE},
-        {"WindowServer", "100", TRUE},
-        {"Safari", "1000", FALSE},
-        {"Terminal", "2000", FALSE},
-        {"systemstats", "50", TRUE},
-        {"Google Chrome", "3000", FALSE}
+        {"kernel_task", 0, 0, TRUE},
+        {"launchd", 1, 0, TRUE},
+        {"WindowServer", 100, 88, TRUE},
+        {"Safari", 1000, 501, FALSE},
+        {"Terminal", 2000, 501, FALSE},
+        {"systemstats", 50, 0, TRUE},
+        {"Google Chrome", 3000, 501, FALSE}
     };
     
     int num_tests = sizeof(test_processes) / sizeof(test_processes[0]);
     
     for (int i = 0; i < num_tests; i++) {
-        Process *proc = alloc_process();
-        strcpy(proc->name, test_processes[i].name);
-        strcpy(proc->pid, test_processes[i].pid);
+        ProcessSample *proc = alloc_process();
+        process_set_name(proc, test_processes[i].name, -1);
+        proc->pid = test_processes[i].pid;
+        proc->uid = test_processes[i].uid;
         
         determine_process_type(proc);
         
-        ASSERT_EQUAL(test_processes[i].expected_system, proc->is_system, 
+        gboolean is_system = (proc->flags & PROCESS_FLAG_SYSTEM) != 0;
+        ASSERT_EQUAL(test_processes[i].expected_system, is_system, 
                     "Process type detection should be correct");
         
-        if (proc->is_system) {
-            ASSERT_TRUE(strstr(proc->type, "System") != NULL, 
+        if (is_system) {
+            ASSERT_TRUE(strstr(process_type_label(is_system), "System") != NULL, 
                        "System processes should have 'System' in type");
         } else {
-            ASSERT_STR_EQUAL("User", proc->type, "User processes should show 'User'");
+            ASSERT_STR_EQUAL("User", process_type_label(is_system), "User processes should show 'User'");
         }
         
         free_process(proc);
@@ -150,7 +169,7 @@ int test_network_workflow() {
     
     // Initialize network cache
     if (net_cache) {
-        g_hash_table_destroy(net_cache);
+        pid_map_free(net_cache);
     }
     net_cache = NULL;
     
@@ -159,8 +178,8 @@ int test_network_workflow() {
     ASSERT_NOT_NULL(net_cache, "Network cache should be initialized");
     
     // Test cache usage
-    long long bytes1 = get_net_bytes("123");  // This should use cache
-    long long bytes2 = get_net_bytes("456");  // This should also use cache
+    long long bytes1 = get_net_bytes(123);  // This should use cache
+    long long bytes2 = get_net_bytes(456);  // This should also use cache
     
     ASSERT_TRUE(bytes1 >= 0, "Network bytes should be non-negative");
     ASSERT_TRUE(bytes2 >= 0, "Network bytes should be non-negative");
@@ -169,12 +188,12 @@ int test_network_workflow() {
     last_net_collection = time(NULL) - 2;  // Force cache expiration
     
     // This should trigger a new collection
-    long long bytes3 = get_net_bytes("789");
+    long long bytes3 = get_net_bytes(789);
     ASSERT_TRUE(bytes3 >= 0, "Network bytes after cache refresh should be non-negative");
     
     // Cleanup
     if (net_cache) {
-        g_hash_table_destroy(net_cache);
+        pid_map_free(net_cache);
         net_cache = NULL;
     }
     
@@ -301,36 +320,33 @@ int test_performance_workflow() {
     double start_time = get_current_time();
     
     // Simulate a heavy update cycle
-    GList *processes = NULL;
+    ProcessTable *processes = process_table_new(100);
     
     for (int i = 0; i < 100; i++) {
-        Process *proc = alloc_process();
-        
-        snprintf(proc->pid, sizeof(proc->pid), "%d", i + 1000);
-        snprintf(proc->name, sizeof(proc->name), "Process%d", i);
-        snprintf(proc->cpu, sizeof(proc->cpu), "%.1f", (double)(i % 50));
+        ProcessSample proc = {0};
         
-        char *formatted = format_memory_human_readable("512M");
-        safe_strncpy(proc->mem, formatted, sizeof(proc->mem));
-        free(formatted);
+        char name[32];
+        snprintf(name, sizeof(name), "Process%d", i);
+        process_set_name(&proc, name, -1);
+        proc.pid = i + 1000;
+        proc.uid = 501;
+        proc.cpu = (float)(i % 50);
+        proc.rss_bytes = (guint64)parse_memory_string("512M");
         
-        determine_process_type(proc);
+        determine_process_type(&proc);
         
-        processes = g_list_append(processes, proc);
+        process_table_add(processes, &proc);
     }
     
     double end_time = get_current_time();
     double duration = end_time - start_time;
     
     printf("(%.3fs for 100 processes) ", duration);
+    ASSERT_EQUAL(100, processes->count, "Every process should have a row");
     ASSERT_TRUE(duration < 1.0, "Should process 100 items in under 1 second");
     
     // Cleanup
-    GList *l;
-    for (l = processes; l != NULL; l = l->next) {
-        free_process((Process*)l->data);
-    }
-    g_list_free(processes);
+    process_table_free(processes);
     
     cleanup_process_pool();
     
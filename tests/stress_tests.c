@@ -1,4 +1,8 @@
-#include "../TaskMini.c"
+#include "../src/utils/utils.h"
+#include "../src/utils/memory_pool.h"
+#include "../src/utils/slab.h"
+#include "../src/system/system.h"
+#include "../src/common/config.h"
 #include "taskmini_tests.h"
 
 // Stress test configuration - reduced for faster execution
@@ -48,7 +52,8 @@ int stress_test_memory_pool() {
     
     init_process_pool();
     
-    Process *processes[STRESS_ITERATIONS];
+    ProcessSample *processes[STRESS_ITERATIONS];
+    int allocated = 0;
     
     // Allocate many processes
     for (int i = 0; i < STRESS_ITERATIONS; i++) {
@@ -59,20 +64,23 @@ int stress_test_memory_pool() {
         
         processes[i] = alloc_process();
         ASSERT_NOT_NULL(processes[i], "Allocation should succeed in stress test");
+        allocated++;
         
         // Fill with test data
-        snprintf(processes[i]->pid, sizeof(processes[i]->pid), "%d", i);
-        snprintf(processes[i]->name, sizeof(processes[i]->name), "TestProc%d", i);
+        char name[32];
+        snprintf(name, sizeof(name), "TestProc%d", i);
+        processes[i]->pid = i;
+        process_set_name(processes[i], name, -1);
     }
     
     // Free all processes
-    for (int i = 0; i < STRESS_ITERATIONS; i++) {
+    for (int i = 0; i < allocated; i++) {
         free_process(processes[i]);
     }
     
     // Allocate again to test reuse
     for (int i = 0; i < STRESS_ITERATIONS / 2; i++) {
-        Process *proc = alloc_process();
+        ProcessSample *proc = alloc_process();
         ASSERT_NOT_NULL(proc, "Reallocation should succeed");
         free_process(proc);
     }
@@ -185,32 +193,201 @@ int stress_test_security_validation() {
     TEST_PASS();
 }
 
+// Rows each concurrent thread holds at once; more than two magazines so
+// every round goes through the shared depot
+#define STRESS_BATCH (4 * SLAB_MAGAZINE_SIZE + 3)
+
+typedef struct {
+    SlabCache *cache;               // NULL: the process pool
+    ProcessSample **procs;
+    int thread;
+    int rounds;
+    gint *errors;
+} SlabWorker;
+
+static ProcessSample* worker_alloc(SlabWorker *worker) {
+    return worker->cache ? slab_alloc(worker->cache) : alloc_process();
+}
+
+static void worker_free(SlabWorker *worker, ProcessSample *proc) {
+    if (worker->cache) slab_free(worker->cache, proc);
+    else free_process(proc);
+}
+
+// Tag every row of a batch with its owner and check the tags once the batch
+// is complete: an object handed out twice carries the other holder's tag
+static gpointer churn_thread(gpointer data) {
+    SlabWorker *worker = data;
+    ProcessSample *procs[STRESS_BATCH];
+
+    for (int round = 0; round < worker->rounds; round++) {
+        for (int i = 0; i < STRESS_BATCH; i++) {
+            procs[i] = worker_alloc(worker);
+            if (procs[i]->pid != 0 || procs[i]->uid != 0) g_atomic_int_inc(worker->errors);
+            procs[i]->pid = worker->thread;
+            procs[i]->uid = i;
+        }
+        for (int i = STRESS_BATCH - 1; i >= 0; i--) {
+            if (procs[i]->pid != worker->thread || procs[i]->uid != i) g_atomic_int_inc(worker->errors);
+            worker_free(worker, procs[i]);
+        }
+    }
+    return NULL;
+}
+
+static gpointer fill_thread(gpointer data) {
+    SlabWorker *worker = data;
+    for (int i = 0; i < STRESS_BATCH; i++) {
+        worker->procs[i] = worker_alloc(worker);
+        worker->procs[i]->pid = worker->thread;
+        worker->procs[i]->uid = i;
+    }
+    return NULL;
+}
+
+static gpointer drain_thread(gpointer data) {
+    SlabWorker *worker = data;
+    for (int i = 0; i < STRESS_BATCH; i++) {
+        if (worker->procs[i]->pid != worker->thread || worker->procs[i]->uid != i) {
+            g_atomic_int_inc(worker->errors);
+        }
+        worker_free(worker, worker->procs[i]);
+    }
+    return NULL;
+}
+
 // Test concurrent access safety
 int stress_test_concurrent_access() {
     TEST_CASE("Concurrent Access Safety Test");
     
-    // This is a simplified concurrency test
-    // In a real scenario, you'd use pthreads to test true concurrency
-    
     init_process_pool();
+    SlabStats before, after;
+    get_memory_pool_stats(&before, NULL);
+    
+    // Allocate and free in reverse order on several threads at once
+    gint errors = 0;
+    SlabWorker workers[STRESS_CONCURRENT_THREADS];
+    GThread *threads[STRESS_CONCURRENT_THREADS];
+    for (int t = 0; t < STRESS_CONCURRENT_THREADS; t++) {
+        workers[t] = (SlabWorker){ NULL, NULL, t + 1, STRESS_ITERATIONS, &errors };
+        threads[t] = g_thread_new("churn", churn_thread, &workers[t]);
+    }
+    for (int t = 0; t < STRESS_CONCURRENT_THREADS; t++) {
+        g_thread_join(threads[t]);
+    }
+    ASSERT_EQUAL(0, errors, "No process should be handed to two holders or arrive dirty");
     
-    // Simulate concurrent access patterns
-    Process *procs[100];
+    // Exiting threads return their magazines
+    get_memory_pool_stats(&after, NULL);
+    ASSERT_EQUAL(before.outstanding, after.outstanding, "Threads should return every process");
+    ASSERT_EQUAL(after.objects, after.depot_free + after.outstanding, "Pool accounting should balance");
     
-    for (int round = 0; round < 10; round++) {
-        // Allocate
-        for (int i = 0; i < 100; i++) {
-            procs[i] = alloc_process();
-            ASSERT_NOT_NULL(procs[i], "Concurrent allocation should succeed");
-        }
-        
-        // Free in different order
-        for (int i = 99; i >= 0; i--) {
-            free_process(procs[i]);
-        }
+    cleanup_process_pool();
+    
+    TEST_PASS();
+}
+
+// Objects allocated on one thread and freed on another
+int stress_test_slab_cross_thread_free() {
+    TEST_CASE("Slab Cross-Thread Free Test");
+    
+    static SlabCache cache;
+    slab_cache_init(&cache, sizeof(ProcessSample), 64);
+    
+    gint errors = 0;
+    ProcessSample *procs[STRESS_BATCH];
+    for (int round = 0; round < STRESS_ITERATIONS; round++) {
+        SlabWorker worker = { &cache, procs, round + 1, 1, &errors };
+        g_thread_join(g_thread_new("fill", fill_thread, &worker));
+        g_thread_join(g_thread_new("drain", drain_thread, &worker));
     }
+    ASSERT_EQUAL(0, errors, "Objects should arrive intact on the freeing thread");
     
-    cleanup_process_pool();
+    SlabStats stats;
+    slab_cache_get_stats(&cache, &stats);
+    ASSERT_EQUAL(0u, stats.outstanding, "Every object should be back in the depot");
+    ASSERT_EQUAL(stats.objects, stats.depot_free, "Depot should hold the whole capacity");
+    ASSERT_TRUE(stats.slabs <= (STRESS_BATCH + 63) / 64 + 1, "Freed objects should be reused");
+    ASSERT_EQUAL(stats.allocs, stats.frees, "Allocs and frees should match");
+    
+    slab_cache_clear(&cache);
+    TEST_PASS();
+}
+
+// clear() frees the slabs under the objects cached in magazines; the next
+// allocation must not hand one of them out
+int stress_test_slab_clear() {
+    TEST_CASE("Slab Clear Invalidation Test");
+    
+    static SlabCache cache;
+    slab_cache_init(&cache, sizeof(ProcessSample), 64);
+    
+    // Leave objects in this thread's magazine, then churn on other threads
+    for (int i = 0; i < 3; i++) slab_free(&cache, slab_alloc(&cache));
+    gint errors = 0;
+    SlabWorker worker = { &cache, NULL, 1, STRESS_ITERATIONS / 10, &errors };
+    g_thread_join(g_thread_new("churn", churn_thread, &worker));
+    ASSERT_EQUAL(0, errors, "No object should be handed out twice");
+    
+    gint generation = cache.generation;
+    slab_cache_clear(&cache);
+    ASSERT_EQUAL(generation + 1, cache.generation, "Clear should start a new generation");
+    
+    SlabStats stats;
+    slab_cache_get_stats(&cache, &stats);
+    ASSERT_EQUAL(0u, stats.slabs + stats.objects + stats.outstanding + stats.depot_free,
+                 "Clear should release everything");
+    
+    // The stale magazine is dropped: this comes from a fresh slab
+    ProcessSample *proc = slab_alloc(&cache);
+    slab_cache_get_stats(&cache, &stats);
+    ASSERT_EQUAL(1u, stats.slabs, "Allocation after clear should grow a new slab");
+    ASSERT_EQUAL((guint64)SLAB_MAGAZINE_SIZE, stats.outstanding, "Magazine should refill from the depot");
+    char *slab = cache.slabs->data;
+    ASSERT_TRUE((char *)proc >= slab && (char *)proc < slab + cache.object_size * cache.objects_per_slab,
+                "Object should lie in the new slab");
+    slab_free(&cache, proc);
+    
+    slab_cache_clear(&cache);
+    TEST_PASS();
+}
+
+// Workers of the collector run commands at once; each buffer must have a
+// single holder at a time
+static gpointer string_cache_thread(gpointer data) {
+    SlabWorker *worker = data;
+    for (int round = 0; round < worker->rounds; round++) {
+        char *buf1 = get_cached_buffer(256);
+        char *buf2 = get_cached_buffer(1024);
+        memset(buf1, 'a' + worker->thread, 256);
+        memset(buf2, 'a' + worker->thread, 1024);
+        g_thread_yield();
+        for (int i = 0; i < 256; i++) {
+            if (buf1[i] != 'a' + worker->thread || buf2[i] != 'a' + worker->thread) {
+                g_atomic_int_inc(worker->errors);
+                break;
+            }
+        }
+        return_cached_buffer(buf2, 1024);
+        return_cached_buffer(buf1, 256);
+    }
+    return NULL;
+}
+
+int stress_test_string_cache_concurrent() {
+    TEST_CASE("Concurrent String Cache Test");
+    
+    gint errors = 0;
+    SlabWorker workers[STRESS_CONCURRENT_THREADS];
+    GThread *threads[STRESS_CONCURRENT_THREADS];
+    for (int t = 0; t < STRESS_CONCURRENT_THREADS; t++) {
+        workers[t] = (SlabWorker){ NULL, NULL, t, STRESS_ITERATIONS * 10, &errors };
+        threads[t] = g_thread_new("buffers", string_cache_thread, &workers[t]);
+    }
+    for (int t = 0; t < STRESS_CONCURRENT_THREADS; t++) {
+        g_thread_join(threads[t]);
+    }
+    ASSERT_EQUAL(0, errors, "No buffer should be handed to two threads");
     
     TEST_PASS();
 }
@@ -256,7 +433,10 @@ int test_performance_regression() {
     double start_time = get_current_time();
     
     for (int i = 0; i < 100; i++) {
-        Process *proc = alloc_process();
+        ProcessSample *proc = alloc_process();
+        process_set_name(proc, "TestProc", -1);
+        proc->pid = 1000 + i;
+        proc->uid = 501;  // Known UID: classification without spawning ps
         determine_process_type(proc);
         
         char *formatted = format_memory_human_readable("512M");
@@ -291,8 +471,11 @@ int main() {
     // Run stress tests
     stress_test_memory_pool();
     stress_test_string_cache();
+    stress_test_string_cache_concurrent();
     stress_test_security_validation();
     stress_test_concurrent_access();
+    stress_test_slab_cross_thread_free();
+    stress_test_slab_clear();
     test_memory_leaks();
     test_performance_regression();
     
@@ -135,6 +135,9 @@ int test_runtime_parsing();
 int test_process_type_detection();
 int test_resource_limits();
 int test_error_handling();
+int test_sort_order_repair();
+int test_filter_program();
+int test_collector_protocol();
 
 // Enhanced regression detection tests
 int test_edge_cases();
@@ -146,7 +149,7 @@ int test_performance_regression();
 int test_ui_stability();
 int test_system_compatibility();
 
-// Utility functions (declare after including TaskMini.c in test files)
+// Utility functions (defined by the test files that use them)
 size_t get_memory_usage();
 double get_current_time();
 void simulate_system_load();
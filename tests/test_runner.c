@@ -1,4 +1,14 @@
-#include "../TaskMini.c"  // Include source first to define types
+#include <math.h>
+
+#include "../src/utils/utils.h"
+#include "../src/utils/memory_pool.h"
+#include "../src/system/system.h"
+#include "../src/system/process_delta.h"
+#include "../src/system/collector_protocol.h"
+#include "../src/ui/filter.h"
+#include "../src/ui/sort_order.h"
+#include "../src/ui/ui.h"
+#include "../src/common/config.h"
 #include "taskmini_tests.h"
 
 // Mock data for testing
@@ -58,15 +68,15 @@ double get_current_time() {
     return ts.tv_sec + ts.tv_nsec / 1000000000.0;
 }
 
-// Parse top output into process list (simplified for testing)
-GList* parse_top_output(const char *output) {
-    GList *processes = NULL;
+// Parse top output into a process table with the collector's line parser
+ProcessTable* parse_top_output(const char *output) {
+    ProcessTable *processes = process_table_new(0);
     
     if (!output || strlen(output) == 0) {
         return processes;
     }
     
-    char *line_start = strstr(output, "PID COMMAND");
+    const char *line_start = strstr(output, "PID COMMAND");
     if (!line_start) {
         return processes;  // No process data found
     }
@@ -82,37 +92,11 @@ GList* parse_top_output(const char *output) {
     char *line = strtok(line_copy, "\n");
     
     while (line != NULL) {
-        // Skip empty lines
-        if (strlen(line) < 10) {
-            line = strtok(NULL, "\n");
-            continue;
-        }
-        
-        Process *proc = alloc_process();
-        if (proc) {
-            // Simple parsing - just extract first few fields
-            int pid;
-            char name[50], cpu_str[10], mem_str[20], time_str[20];
-            
-            int parsed = sscanf(line, "%d %49s %9s %19s %19s", 
-                               &pid, name, cpu_str, mem_str, time_str);
-            
-            if (parsed >= 3) {
-                snprintf(proc->pid, sizeof(proc->pid), "%d", pid);
-                safe_strncpy(proc->name, name, sizeof(proc->name));
-                safe_strncpy(proc->cpu, cpu_str, sizeof(proc->cpu));
-                if (parsed >= 4) {
-                    safe_strncpy(proc->mem, mem_str, sizeof(proc->mem));
-                }
-                if (parsed >= 5) {
-                    safe_strncpy(proc->runtime, time_str, sizeof(proc->runtime));
-                }
-                
-                determine_process_type(proc);
-                processes = g_list_append(processes, proc);
-            } else {
-                free_process(proc);
-            }
+        ProcessSample proc;
+        if (parse_top_process_line(line, &proc)) {
+            proc.uid = 501;  // Known UID: no ps per row
+            determine_process_type(&proc);
+            process_table_add(processes, &proc);
         }
         
         line = strtok(NULL, "\n");
@@ -128,12 +112,13 @@ int test_memory_pool() {
     
     // Initialize pool
     init_process_pool();
-    ASSERT_NOT_NULL(process_pool, "Process pool should be initialized");
-    ASSERT_NOT_NULL(pool_used, "Pool tracking array should be initialized");
+    SlabStats stats;
+    get_memory_pool_stats(&stats, NULL);
+    ASSERT_TRUE(stats.object_size >= sizeof(ProcessSample), "Process pool should hold samples");
     
     // Allocate processes
-    Process *proc1 = alloc_process();
-    Process *proc2 = alloc_process();
+    ProcessSample *proc1 = alloc_process();
+    ProcessSample *proc2 = alloc_process();
     
     ASSERT_NOT_NULL(proc1, "First allocation should succeed");
     ASSERT_NOT_NULL(proc2, "Second allocation should succeed");
@@ -144,7 +129,7 @@ int test_memory_pool() {
     free_process(proc2);
     
     // Test reuse
-    Process *proc3 = alloc_process();
+    ProcessSample *proc3 = alloc_process();
     ASSERT_TRUE(proc3 == proc1 || proc3 == proc2, "Should reuse freed memory");
     
     free_process(proc3);
@@ -234,6 +219,16 @@ int test_process_parsing() {
     seconds = parse_runtime_to_seconds("1-02:30:15");
     ASSERT_EQUAL(1*86400 + 2*3600 + 30*60 + 15, seconds, "Should parse days-hours:min:sec");
     
+    // Test top output parsing into a process table
+    ProcessTable *processes = parse_top_output(mock_top_output);
+    ASSERT_EQUAL(3, processes->count, "Should parse every process line");
+    ASSERT_EQUAL(123, processes->items[0].pid, "Rows should keep output order");
+    const ProcessSample *proc = process_table_lookup(processes, 456);
+    ASSERT_NOT_NULL(proc, "Should find a parsed process by PID");
+    ASSERT_STR_EQUAL("SystemProc", process_name(proc), "Should parse the command name");
+    ASSERT_EQUAL(128LL * 1024 * 1024, (long long)proc->rss_bytes, "Should parse memory to bytes");
+    process_table_free(processes);
+    
     TEST_PASS();
 }
 
@@ -262,8 +257,21 @@ int test_gpu_detection() {
 int test_network_parsing() {
     TEST_CASE("Network Data Parsing");
     
-    // Test individual network lookup (fallback)
-    long long net_bytes = get_net_bytes_individual("123");
+    // Test nettop row parsing: PID after the last dot, bytes in + out
+    char row[] = "15:30:45.123456,Google Chrome H.1234,,,1000,2000,";
+    StrView view = { row, strlen(row) };
+    pid_t pid = 0;
+    guint64 total = 0;
+    ASSERT_TRUE(parse_nettop_line(view, &pid, &total), "nettop row should parse");
+    ASSERT_EQUAL(1234, pid, "PID should follow the last dot");
+    ASSERT_EQUAL(3000, total, "Bytes in and out should be summed");
+    
+    char header[] = "time,,interface,state,bytes_in,bytes_out,";
+    StrView header_view = { header, strlen(header) };
+    ASSERT_FALSE(parse_nettop_line(header_view, &pid, &total), "Header row should be rejected");
+    
+    // Test cached lookup
+    long long net_bytes = get_net_bytes(123);
     ASSERT_TRUE(net_bytes >= 0, "Network bytes should be non-negative");
     
     // Test network cache functionality
@@ -326,13 +334,15 @@ int test_process_type_detection() {
     ASSERT_FALSE(is_system_process("Terminal", "2000"), "Terminal should be user process");
     
     // Test process type setting
-    Process proc = {0};
-    strcpy(proc.name, "kernel_task");
-    strcpy(proc.pid, "0");
+    ProcessSample proc = {0};
+    process_set_name(&proc, "kernel_task", -1);
+    proc.pid = 0;
+    proc.uid = 0;
     
     determine_process_type(&proc);
-    ASSERT_TRUE(proc.is_system, "kernel_task should be marked as system");
-    ASSERT_TRUE(strstr(proc.type, "System") != NULL, "Type should contain 'System'");
+    gboolean is_system = (proc.flags & PROCESS_FLAG_SYSTEM) != 0;
+    ASSERT_TRUE(is_system, "kernel_task should be marked as system");
+    ASSERT_TRUE(strstr(process_type_label(is_system), "System") != NULL, "Type should contain 'System'");
     
     TEST_PASS();
 }
@@ -380,26 +390,388 @@ int test_error_handling() {
     TEST_PASS();
 }
 
+// Names that tie on their 8-byte sort key prefix, differ only in case, or
+// are empty
+static const char *sort_test_names[] = {
+    "", "", "a", "alphabet", "alphabet-soup", "alphabet-stew", "Zeta", "zeta", "kernel_task",
+};
+
+static guint32 sort_test_random(guint32 *state) {
+    *state = *state * 1103515245u + 12345u;
+    return *state >> 8;
+}
+
+static void sort_test_fill(ProcessSample *sample, guint32 *state) {
+    process_set_name(sample, sort_test_names[sort_test_random(state) % G_N_ELEMENTS(sort_test_names)], -1);
+    sample->cpu = (float)(sort_test_random(state) % 8) * 12.5f;  // Many equal values
+}
+
+// Next refresh: about 10% of rows exit, 20% change name or CPU, new PIDs start
+static ProcessTable* sort_test_next_table(const ProcessTable *previous, pid_t *next_pid, guint32 *state) {
+    ProcessTable *table = process_table_new(previous->count + 32);
+    for (guint i = 0; i < previous->count; i++) {
+        guint32 roll = sort_test_random(state) % 10;
+        if (roll == 0) continue;
+        ProcessSample sample = previous->items[i];
+        if (roll == 1) sort_test_fill(&sample, state);
+        if (roll == 2) sample.cpu += 12.5f;
+        process_table_add(table, &sample);
+        if (sort_test_random(state) % 12 == 0) {
+            ProcessSample added;
+            memset(&added, 0, sizeof(added));
+            added.pid = (*next_pid)++;
+            sort_test_fill(&added, state);
+            process_table_add(table, &added);
+        }
+    }
+    return table;
+}
+
+// Incremental repair of the displayed order must give the full re-sort,
+// which must agree with process_sample_compare()
+int test_sort_order_repair() {
+    TEST_CASE("Sort Order Repair Matches Full Sort");
+    
+    static const gint columns[] = { COL_NAME, COL_CPU };
+    for (guint c = 0; c < G_N_ELEMENTS(columns) * 2; c++) {
+        gint column = columns[c / 2];
+        gboolean descending = c % 2;
+        guint32 state = 777 + c;
+        pid_t next_pid = 1;
+        
+        ProcessTable *previous = process_table_new(200);
+        for (int i = 0; i < 200; i++) {
+            ProcessSample sample;
+            memset(&sample, 0, sizeof(sample));
+            sample.pid = next_pid++;
+            sort_test_fill(&sample, &state);
+            process_table_add(previous, &sample);
+        }
+        
+        guint64 *keys = g_new(guint64, 1024);
+        guint8 *flags = g_new0(guint8, 1024);
+        guint32 *full = g_new(guint32, 1024);
+        GArray *rows = g_array_new(FALSE, FALSE, sizeof(guint32));
+        SortOrder order = { previous->items, keys, column, descending };
+        sort_order_compute_keys(previous->items, previous->count, column, keys);
+        for (guint32 i = 0; i < previous->count; i++) g_array_append_val(rows, i);
+        sort_order_sort(&order, (guint32*)rows->data, rows->len, NULL);
+        
+        for (int round = 0; round < 30; round++) {
+            ProcessTable *table = sort_test_next_table(previous, &next_pid, &state);
+            ASSERT_TRUE(table->count <= 1024, "Test table should stay small");
+            ProcessDelta *delta = process_delta_compute(previous, table);
+            
+            // Survivors keep their place, rows whose key may have changed are re-placed
+            memset(flags, 0, table->count);
+            for (guint i = 0; i < delta->changed->len; i++) {
+                const ProcessChange *change = &g_array_index(delta->changed, ProcessChange, i);
+                if (change->fields & sort_order_column_field(column)) flags[change->index] = 1;
+            }
+            guint kept = 0;
+            for (guint pos = 0; pos < rows->len; pos++) {
+                pid_t pid = previous->items[g_array_index(rows, guint32, pos)].pid;
+                const ProcessSample *proc = process_table_lookup(table, pid);
+                if (proc) g_array_index(rows, guint32, kept++) = (guint32)(proc - table->items);
+            }
+            g_array_set_size(rows, kept);
+            order.items = table->items;
+            sort_order_compute_keys(table->items, table->count, column, keys);
+            sort_order_repair(&order, (guint32*)rows->data, rows->len, flags, 1, NULL);
+            for (guint i = 0; i < delta->added->len; i++) {
+                guint32 index = g_array_index(delta->added, guint32, i);
+                guint position = sort_order_position(&order, (const guint32*)rows->data, rows->len, index);
+                g_array_insert_val(rows, position, index);
+            }
+            
+            for (guint32 i = 0; i < table->count; i++) full[i] = i;
+            sort_order_sort(&order, full, table->count, NULL);
+            ASSERT_EQUAL(table->count, rows->len, "Repaired order should hold every row");
+            ASSERT_TRUE(memcmp(rows->data, full, table->count * sizeof(guint32)) == 0,
+                        "Repaired order should equal the full sort");
+            for (guint i = 1; i < table->count; i++) {
+                const ProcessSample *a = &table->items[full[i - 1]], *b = &table->items[full[i]];
+                gint ret = process_sample_compare(a, b, column);
+                if (descending) ret = -ret;
+                ASSERT_TRUE(ret < 0 || (ret == 0 && a->pid < b->pid),
+                            "Full sort should follow process_sample_compare, then PID");
+            }
+            
+            process_delta_free(delta);
+            process_table_free(previous);
+            previous = table;
+        }
+        
+        process_table_free(previous);
+        g_array_free(rows, TRUE);
+        g_free(full);
+        g_free(flags);
+        g_free(keys);
+    }
+    
+    TEST_PASS();
+}
+
+// Per-row parse of the CPU, memory, network and name filters, as
+// process_matches_filter() did before filters were compiled
+static gboolean filter_test_reference(const FilterCriteria *criteria, const ProcessSample *proc) {
+    if (criteria->cpu_filter[0]) {
+        double cpu = proc->cpu, min_val, max_val, value;
+        char op;
+        if (parse_range_filter(criteria->cpu_filter, &min_val, &max_val)) {
+            if (cpu < min_val || cpu > max_val) return FALSE;
+        } else if (parse_numeric_filter(criteria->cpu_filter, &value, &op, "%")) {
+            if (op == '+' && cpu < value) return FALSE;
+            if (op == '-' && cpu > value) return FALSE;
+            if (op == '=' && fabs(cpu - value) > 0.1) return FALSE;
+        }
+    }
+    if (criteria->memory_filter[0]) {
+        long long mem = (long long)proc->rss_bytes, min_bytes, max_bytes, value;
+        char op;
+        if (parse_memory_range_filter(criteria->memory_filter, &min_bytes, &max_bytes)) {
+            if (mem < min_bytes || mem > max_bytes) return FALSE;
+        } else if (parse_memory_filter(criteria->memory_filter, &value, &op)) {
+            if (op == '+' && mem < value) return FALSE;
+            if (op == '-' && mem > value) return FALSE;
+            if (op == '=' && value > 0 && llabs(mem - value) > value * 0.1) return FALSE;
+        }
+    }
+    if (criteria->network_filter[0]) {
+        long long net = (long long)proc->net_bps, min_bps, max_bps, value;
+        char op;
+        if (parse_network_range_filter(criteria->network_filter, &min_bps, &max_bps)) {
+            if (net < min_bps || net > max_bps) return FALSE;
+        } else if (parse_network_filter(criteria->network_filter, &value, &op)) {
+            if (op == '+' && net < value) return FALSE;
+            if (op == '-' && net > value) return FALSE;
+            if (op == '=' && value > 0 && llabs(net - value) > value * 0.1) return FALSE;
+        }
+    }
+    if (criteria->name_filter[0]) {
+        gchar *name = g_ascii_strdown(process_name(proc), -1);
+        gchar *needle = g_ascii_strdown(criteria->name_filter, -1);
+        gboolean found = strstr(name, needle) != NULL;
+        g_free(needle);
+        g_free(name);
+        if (!found) return FALSE;
+    }
+    return TRUE;
+}
+
+// A compiled filter, row by row or over columns, must keep exactly the rows
+// the per-row parse keeps, including rows on the bounds
+int test_filter_program() {
+    TEST_CASE("Compiled Filter Matches Per-Row Parse");
+    
+    long long mem_min, mem_max;
+    ASSERT_TRUE(parse_memory_range_filter("[100MB,2GB]", &mem_min, &mem_max), "Memory range should parse");
+    const float cpus[] = { 0.0f, 14.9f, 14.99f, nextafterf(15.0f, 0.0f), 15.0f, 15.01f, 15.1f, 100.0f };
+    const guint64 mems[] = { 0, mem_min - 1, mem_min, mem_min + 1, mem_max - 1, mem_max, mem_max + 1 };
+    const guint64 nets[] = { 0, 921, 922, 1023, 1024, 1025, 1126, 1127 };
+    const char *names[] = { "Google Chrome Helper", "CHROMEDRIVER", "chrom", "kernel_task" };
+    
+    ProcessTable *table = process_table_new(G_N_ELEMENTS(cpus) * G_N_ELEMENTS(mems) *
+                                            G_N_ELEMENTS(nets) * G_N_ELEMENTS(names));
+    pid_t pid = 1;
+    for (guint c = 0; c < G_N_ELEMENTS(cpus); c++)
+    for (guint m = 0; m < G_N_ELEMENTS(mems); m++)
+    for (guint n = 0; n < G_N_ELEMENTS(nets); n++)
+    for (guint k = 0; k < G_N_ELEMENTS(names); k++) {
+        ProcessSample sample;
+        memset(&sample, 0, sizeof(sample));
+        sample.pid = pid++;
+        sample.cpu = cpus[c];
+        sample.rss_bytes = mems[m];
+        sample.net_bps = nets[n];
+        process_set_name(&sample, names[k], -1);
+        process_table_add(table, &sample);
+    }
+    
+    // cpu, memory, network, name
+    static const char *filters[][4] = {
+        { "15%+", "", "", "" },
+        { "15%-", "", "", "" },
+        { "15%", "", "", "" },
+        { "[14.99,15.01]", "", "", "" },
+        { "", "[100MB,2GB]", "", "" },
+        { "", "100MB+", "", "" },
+        { "", "", "1KB/s+", "" },
+        { "", "", "1KB/s", "" },
+        { "", "", "[1023B/s,1KB/s]", "" },
+        { "", "", "", "CHROME" },
+        { "15%+", "[100MB,2GB]", "1KB/s+", "Chrome" },
+    };
+    FilterColumns cols = {0};
+    guint8 *mask = g_new(guint8, table->count);
+    for (guint f = 0; f < G_N_ELEMENTS(filters); f++) {
+        FilterCriteria criteria;
+        memset(&criteria, 0, sizeof(criteria));
+        criteria.active = TRUE;
+        g_strlcpy(criteria.cpu_filter, filters[f][0], sizeof(criteria.cpu_filter));
+        g_strlcpy(criteria.memory_filter, filters[f][1], sizeof(criteria.memory_filter));
+        g_strlcpy(criteria.network_filter, filters[f][2], sizeof(criteria.network_filter));
+        g_strlcpy(criteria.name_filter, filters[f][3], sizeof(criteria.name_filter));
+        
+        FilterProgram program;
+        filter_program_compile(&program, &criteria);
+        ASSERT_TRUE(program.checks != 0, "Filter should compile to at least one check");
+        filter_columns_load(&cols, table, program.checks);
+        guint selected = filter_program_select(&program, &cols, mask);
+        
+        guint expected = 0;
+        for (guint i = 0; i < table->count; i++) {
+            gboolean reference = filter_test_reference(&criteria, &table->items[i]);
+            expected += reference;
+            ASSERT_EQUAL(reference, filter_program_matches(&program, &table->items[i]),
+                         "filter_program_matches() should equal the per-row parse");
+            ASSERT_EQUAL(reference, mask[i], "filter_program_select() should equal the per-row parse");
+        }
+        ASSERT_EQUAL(expected, selected, "filter_program_select() should count the kept rows");
+        ASSERT_TRUE(expected > 0 && expected < table->count, "Boundary rows should fall on both sides");
+    }
+    
+    filter_columns_clear(&cols);
+    g_free(mask);
+    process_table_free(table);
+    TEST_PASS();
+}
+
+// Snapshot of one collector cycle: every eighth PID is replaced per cycle,
+// every fifth row changes CPU and the odd rows change name
+static UpdateData* protocol_test_update(int cycle) {
+    UpdateData *data = update_data_new();
+    data->processes = process_table_new(40);
+    data->system_cpu_usage = 10.0f + cycle;
+    update_data_set_text(data, &data->gpu_usage, cycle % 2 ? "3%" : "4%");
+    update_data_set_text(data, &data->system_summary, "Processes: 40");
+    for (int i = 0; i < 40; i++) {
+        ProcessSample sample;
+        memset(&sample, 0, sizeof(sample));
+        sample.pid = (i % 8 == 0) ? 1000 + cycle * 100 + i : 100 + i;
+        sample.cpu = (float)(i % 5 == 0 ? i + cycle : i);
+        sample.rss_bytes = (guint64)(i + 1) * 4096;
+        char name[32];
+        snprintf(name, sizeof(name), "proc-%d-%d", i, i % 2 ? cycle : 0);
+        process_set_name(&sample, name, -1);
+        process_table_add(data->processes, &sample);
+    }
+    return data;
+}
+
+// Decode frame as if its header announced payload_len bytes. The payload is
+// copied into a buffer of exactly that size so overreads are caught.
+static UpdateData* protocol_test_decode(GBytes *frame, gsize payload_len,
+                                        const UpdateData *base, guint64 base_sequence) {
+    gsize size;
+    const guint8 *bytes = g_bytes_get_data(frame, &size);
+    CollectorFrameHeader header;
+    memcpy(&header, bytes, sizeof(header));
+    header.payload_len = (guint32)payload_len;
+    if (!collector_frame_header_valid(&header)) return NULL;
+
+    guint8 *payload = g_malloc0(payload_len + 1);
+    memcpy(payload, bytes + sizeof(header), MIN(payload_len, size - sizeof(header)));
+    UpdateData *data = collector_frame_decode(&header, payload, base, base_sequence);
+    g_free(payload);
+    return data;
+}
+
+static gboolean protocol_test_same(const UpdateData *decoded, const UpdateData *sent) {
+    if (!decoded || decoded->processes->count != sent->processes->count) return FALSE;
+    if (decoded->system_cpu_usage != sent->system_cpu_usage ||
+        g_strcmp0(decoded->gpu_usage, sent->gpu_usage) != 0 ||
+        g_strcmp0(decoded->system_summary, sent->system_summary) != 0) {
+        return FALSE;
+    }
+    for (guint i = 0; i < sent->processes->count; i++) {
+        const ProcessSample *row = process_table_lookup(decoded->processes, sent->processes->items[i].pid);
+        if (!row || memcmp(row, &sent->processes->items[i], sizeof(*row)) != 0) return FALSE;
+    }
+    return TRUE;
+}
+
+// FULL then DELTA must rebuild each published snapshot; a DELTA against
+// the wrong base and truncated or oversized payloads must be rejected
+int test_collector_protocol() {
+    TEST_CASE("Collector Protocol Round Trip");
+    
+    init_process_pool();
+    SnapshotSlot slot;
+    snapshot_slot_init(&slot);
+    snapshot_slot_publish(&slot, protocol_test_update(0));
+    Snapshot *first = snapshot_slot_acquire(&slot);
+    GBytes *full = collector_frame_encode_full(first);
+    ASSERT_NOT_NULL(full, "FULL frame should encode");
+    gsize full_payload = g_bytes_get_size(full) - sizeof(CollectorFrameHeader);
+    UpdateData *mirror = protocol_test_decode(full, full_payload, NULL, 0);
+    ASSERT_TRUE(protocol_test_same(mirror, first->data), "FULL frame should rebuild the snapshot");
+    
+    for (gsize len = 0; len < full_payload; len++) {
+        ASSERT_TRUE(protocol_test_decode(full, len, NULL, 0) == NULL, "Truncated FULL frame should be rejected");
+    }
+    ASSERT_TRUE(protocol_test_decode(full, full_payload + 1, NULL, 0) == NULL,
+                "FULL frame with trailing bytes should be rejected");
+    ASSERT_TRUE(protocol_test_decode(full, MAX_COLLECTOR_FRAME_SIZE + 1, NULL, 0) == NULL,
+                "Payload over MAX_COLLECTOR_FRAME_SIZE should be rejected");
+    g_bytes_unref(full);
+    snapshot_unref(first);
+    
+    for (int cycle = 1; cycle <= 3; cycle++) {
+        snapshot_slot_publish(&slot, protocol_test_update(cycle));
+        Snapshot *snapshot = snapshot_slot_acquire(&slot);
+        GBytes *delta = collector_frame_encode_delta(snapshot);
+        ASSERT_NOT_NULL(delta, "DELTA frame should encode");
+        gsize delta_payload = g_bytes_get_size(delta) - sizeof(CollectorFrameHeader);
+        guint64 base_sequence = snapshot->sequence - 1;
+        
+        ASSERT_TRUE(protocol_test_decode(delta, delta_payload, NULL, base_sequence) == NULL,
+                    "DELTA frame without a base should be rejected");
+        ASSERT_TRUE(protocol_test_decode(delta, delta_payload, mirror, base_sequence + 1) == NULL,
+                    "DELTA frame against the wrong base should be rejected");
+        for (gsize len = 0; len < delta_payload; len++) {
+            ASSERT_TRUE(protocol_test_decode(delta, len, mirror, base_sequence) == NULL,
+                        "Truncated DELTA frame should be rejected");
+        }
+        ASSERT_TRUE(protocol_test_decode(delta, delta_payload + 1, mirror, base_sequence) == NULL,
+                    "DELTA frame with trailing bytes should be rejected");
+        
+        UpdateData *next = protocol_test_decode(delta, delta_payload, mirror, base_sequence);
+        ASSERT_TRUE(protocol_test_same(next, snapshot->data), "DELTA frame should rebuild the snapshot");
+        free_update_data(mirror);
+        mirror = next;
+        g_bytes_unref(delta);
+        snapshot_unref(snapshot);
+    }
+    
+    free_update_data(mirror);
+    snapshot_slot_clear(&slot);
+    cleanup_process_pool();
+    TEST_PASS();
+}
+
 // Test edge cases that commonly cause regressions
 int test_edge_cases() {
     TEST_CASE("Edge Case Handling");
     
     // Test with empty/null inputs
-    Process *proc = alloc_process();
+    ProcessSample *proc = alloc_process();
     ASSERT_NOT_NULL(proc, "Process allocation should succeed");
     
     // Test with empty strings
-    strcpy(proc->name, "");
-    strcpy(proc->pid, "");
+    process_set_name(proc, "", -1);
+    proc->uid = 501;
     determine_process_type(proc);
-    ASSERT_TRUE(strlen(proc->type) > 0, "Should handle empty process name gracefully");
+    ASSERT_STR_EQUAL("", process_name(proc), "Empty name should stay empty");
+    ASSERT_TRUE(strlen(process_type_label((proc->flags & PROCESS_FLAG_SYSTEM) != 0)) > 0,
+                "Should handle empty process name gracefully");
     
     // Test with very long process name
     char long_name[256];
     memset(long_name, 'A', 255);
     long_name[255] = '\0';
-    safe_strncpy(proc->name, long_name, sizeof(proc->name));
-    ASSERT_TRUE(strlen(proc->name) < sizeof(proc->name), "Should truncate long names safely");
+    process_set_name(proc, long_name, -1);
+    ASSERT_TRUE(strlen(process_name(proc)) < STRING_INTERN_MAX, "Should truncate long names safely");
     
     free_process(proc);
     TEST_PASS();
@@ -413,19 +785,18 @@ int test_malformed_input() {
     const char *malformed_top = "Invalid\nGarbage\nData\n123 BadFormat 25.5\n";
     
     // Should not crash or leak memory
-    GList *processes = parse_top_output(malformed_top);
+    ProcessTable *processes = parse_top_output(malformed_top);
     
-    // Should handle gracefully (empty list or valid processes only)
-    int count = g_list_length(processes);
-    ASSERT_TRUE(count >= 0, "Should handle malformed input without crashing");
+    // Should handle gracefully: no header, so no rows
+    ASSERT_EQUAL(0, processes->count, "Should handle malformed input without crashing");
+    process_table_free(processes);
     
-    // Cleanup
-    GList *l;
-    for (l = processes; l != NULL; l = l->next) {
-        Process *proc = (Process *)l->data;
-        free_process(proc);
-    }
-    g_list_free(processes);
+    // Lines that are too short or start with garbage are skipped
+    const char *bad_rows = "PID COMMAND %CPU MEM TIME\n123 BadFormat 25.5\nabc x 1.0 1M 00:01\n7 ok 1.0 1M 00:01\n";
+    processes = parse_top_output(bad_rows);
+    ASSERT_EQUAL(1, processes->count, "Only the well-formed row should be kept");
+    ASSERT_EQUAL(7, processes->items[0].pid, "The well-formed row should be parsed");
+    process_table_free(processes);
     
     TEST_PASS();
 }
@@ -436,28 +807,28 @@ int test_boundary_conditions() {
     
     init_process_pool();
     
-    // Test maximum process pool allocation
-    Process *processes[PROCESS_POOL_SIZE + 1];
+    // Fill a whole slab, then cross into the next one
+    ProcessSample *processes[PROCESS_POOL_SIZE + 1];
     int i;
     
-    // Fill entire pool
-    for (i = 0; i < PROCESS_POOL_SIZE; i++) {
+    for (i = 0; i < PROCESS_POOL_SIZE + 1; i++) {
         processes[i] = alloc_process();
-        if (processes[i] == NULL) break;
+        ASSERT_NOT_NULL(processes[i], "Pool should grow instead of failing");
     }
     
-    ASSERT_TRUE(i == PROCESS_POOL_SIZE || i > PROCESS_POOL_SIZE * 0.9, 
-                "Should allocate most or all of process pool");
-    
-    // Try to allocate one more (should handle gracefully)
-    Process *overflow = alloc_process();
-    // Should either succeed (fallback malloc) or return NULL
+    // No sample may be handed out twice
+    GHashTable *seen = g_hash_table_new(g_direct_hash, g_direct_equal);
+    for (int j = 0; j < i; j++) {
+        g_hash_table_add(seen, processes[j]);
+    }
+    guint distinct = g_hash_table_size(seen);
+    g_hash_table_destroy(seen);
+    ASSERT_EQUAL((guint)i, distinct, "Every allocation should be a distinct sample");
     
     // Free all allocated processes
     for (int j = 0; j < i; j++) {
         free_process(processes[j]);
     }
-    if (overflow) free_process(overflow);
     
     cleanup_process_pool();
     TEST_PASS();
@@ -475,10 +846,13 @@ int test_performance_regression() {
     // Simulate typical workload
     const int iterations = 1000;
     for (int i = 0; i < iterations; i++) {
-        Process *proc = alloc_process();
+        ProcessSample *proc = alloc_process();
         if (proc) {
-            snprintf(proc->pid, sizeof(proc->pid), "%d", i);
-            snprintf(proc->name, sizeof(proc->name), "TestProc%d", i);
+            char name[32];
+            snprintf(name, sizeof(name), "TestProc%d", i);
+            proc->pid = i;
+            proc->uid = 501;  // Known UID: no ps per sample
+            process_set_name(proc, name, -1);
             determine_process_type(proc);
             free_process(proc);
         }
@@ -553,6 +927,9 @@ int main() {
     test_process_type_detection();
     test_resource_limits();
     test_error_handling();
+    test_sort_order_repair();
+    test_filter_program();
+    test_collector_protocol();
     
     // Run regression detection tests
     printf("\n=== Regression Detection Tests ===\n");